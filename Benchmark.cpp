@@ -0,0 +1,492 @@
+/******************************************************************************/
+/*!
+\file		Benchmark.cpp
+\author		Justin Leow
+\brief
+	Microbenchmarks for the math hot paths. See Benchmark.h.
+
+	Inputs are random but seeded identically every run, so two runs (and
+	two builds) time exactly the same work. Every op writes its result to
+	an output array, which keeps the compiler from optimizing it away.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "SNova.h"
+#include "Benchmark.h"
+#include "Quat.h"
+#include "QuatBatch.h"
+#include "Rotator.h"
+#include "Vector3D.h"
+#include "Matrix3x3.h"
+#include "Matrix3x4.h"
+#include "Transform.h"
+#include "MatrixCompose.h"
+#include "Vector3DPacked.h"
+#include "Vec3Stream.h"
+#include "QuatCompress.h"
+#include "QuatSpline.h"
+#include "Culling.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <random>
+
+namespace SNova
+{
+namespace Benchmark
+{
+
+namespace
+{
+	// Transforms are heavy (component, observers, tag), so the Transform
+	// case cycles through at most this many instead of allocating 1M
+	static constexpr size_t MAX_TRANSFORMS = 4096;
+
+	static constexpr unsigned SEED = 12345u;
+
+	struct Random
+	{
+		std::mt19937 rng{ SEED };
+		std::uniform_real_distribution<float> unit{ -1.f, 1.f };
+
+		float Unit() { return unit(rng); }
+		float Between(float min, float max) { return min + (max - min) * (unit(rng) * 0.5f + 0.5f); }
+
+		Vec3 Vector() { return Vec3{ Unit(), Unit(), Unit() } * 10.f; }
+		Quat Quaternion() { return Quat{ Unit(), Unit(), Unit(), Unit() }.GetNormalized(); }
+		Rotator Angles() { return Rotator{ Between(-89.f, 89.f), Between(-180.f, 180.f), Between(-180.f, 180.f) }; }
+		Matrix3x3 Matrix()
+		{
+			// Rotation * scale, so it is always invertible
+			Matrix3x3 m = Angles().Matrix();
+			const float s = Between(0.5f, 2.f);
+			for (int i = 0; i < 3; ++i)
+				for (int j = 0; j < 3; ++j)
+					m.m2[i][j] *= s;
+			return m;
+		}
+	};
+
+	template <typename T, typename Gen>
+	std::vector<T> MakeArray(size_t n, Gen gen)
+	{
+		std::vector<T> v;
+		v.reserve(n);
+		for (size_t i = 0; i < n; ++i)
+			v.push_back(gen());
+		return v;
+	}
+
+	// Case whose data is arrays of In1/In2 and an array of Out
+	template <typename In1, typename In2, typename Out, typename Gen1, typename Gen2, typename Op>
+	Case MakeBinaryCase(const std::string& name, Gen1 gen1, Gen2 gen2, Op op)
+	{
+		return Case{ name, [=](size_t n) -> std::function<void()>
+		{
+			struct Data { std::vector<In1> a; std::vector<In2> b; std::vector<Out> out; };
+			Random random;
+			auto data = std::make_shared<Data>();
+			data->a = MakeArray<In1>(n, [&] { return gen1(random); });
+			data->b = MakeArray<In2>(n, [&] { return gen2(random); });
+			data->out.resize(n);
+
+			return [data, op]()
+			{
+				const size_t count = data->out.size();
+				for (size_t i = 0; i < count; ++i)
+					op(data->a[i], data->b[i], data->out[i]);
+			};
+		} };
+	}
+
+	// Case whose data is an array of In and an array of Out
+	template <typename In, typename Out, typename Gen, typename Op>
+	Case MakeUnaryCase(const std::string& name, Gen gen, Op op)
+	{
+		return MakeBinaryCase<In, char, Out>(name, gen, [](Random&) { return char{}; },
+			[op](const In& a, char, Out& out) { op(a, out); });
+	}
+
+	std::string FormatCount(size_t n)
+	{
+		if (n >= 1000000 && n % 1000000 == 0)
+			return std::to_string(n / 1000000) + "M";
+		if (n >= 1000 && n % 1000 == 0)
+			return std::to_string(n / 1000) + "K";
+		return std::to_string(n);
+	}
+}
+
+std::vector<Case> DefaultCases()
+{
+	auto quat = [](Random& r) { return r.Quaternion(); };
+	auto vec = [](Random& r) { return r.Vector(); };
+	auto rot = [](Random& r) { return r.Angles(); };
+	auto mtx = [](Random& r) { return r.Matrix(); };
+	auto alpha = [](Random& r) { return r.Between(0.f, 1.f); };
+	auto affine = [](Random& r) { return Matrix3x4::FromTRS(r.Vector(), r.Quaternion(), Vec3{ r.Between(0.5f, 2.f), 1.f, 1.f }); };
+
+	std::vector<Case> cases;
+
+	// ----------- Single-element API ------------
+
+	cases.push_back(MakeBinaryCase<Quat, Quat, Quat>("Quat::operator*", quat, quat,
+		[](const Quat& a, const Quat& b, Quat& out) { out = a * b; }));
+
+	cases.push_back(MakeBinaryCase<Quat, Vec3, Vec3>("Quat::RotateVector", quat, vec,
+		[](const Quat& a, const Vec3& v, Vec3& out) { out = a.RotateVector(v); }));
+
+	cases.push_back(Case{ "Quat::Slerp", [=](size_t n) -> std::function<void()>
+	{
+		struct Data { std::vector<Quat> a, b, out; std::vector<float> t; };
+		Random random;
+		auto data = std::make_shared<Data>();
+		data->a = MakeArray<Quat>(n, [&] { return quat(random); });
+		data->b = MakeArray<Quat>(n, [&] { return quat(random); });
+		data->t = MakeArray<float>(n, [&] { return alpha(random); });
+		data->out.resize(n);
+
+		return [data]()
+		{
+			for (size_t i = 0; i < data->out.size(); ++i)
+				data->out[i] = Quat::Slerp(data->a[i], data->b[i], data->t[i]);
+		};
+	} });
+
+	cases.push_back(MakeBinaryCase<Vec3, Vec3, Quat>("Quat::LookRotation", vec, vec,
+		[](const Vec3& forward, const Vec3& up, Quat& out) { out = Quat::LookRotation(forward, up); }));
+
+	cases.push_back(MakeBinaryCase<Quat, Vec3, Quat>("Quat::IntegrateAngularVelocity", quat, vec,
+		[](const Quat& q, const Vec3& omega, Quat& out) { out = q; out.IntegrateAngularVelocity(omega, 1.f / 120.f); }));
+
+	cases.push_back(MakeUnaryCase<Quat, Rotator>("Quat::GetRotator", quat,
+		[](const Quat& q, Rotator& out) { out = q.GetRotator(); }));
+
+	cases.push_back(MakeUnaryCase<Rotator, Quat>("Rotator::Quaternion", rot,
+		[](const Rotator& r, Quat& out) { out = r.Quaternion(); }));
+
+	cases.push_back(MakeUnaryCase<Rotator, Matrix3x3>("Rotator::Matrix", rot,
+		[](const Rotator& r, Matrix3x3& out) { out = r.Matrix(); }));
+
+	cases.push_back(MakeBinaryCase<Matrix3x3, Matrix3x3, Matrix3x3>("Matrix3x3::operator*", mtx, mtx,
+		[](const Matrix3x3& a, const Matrix3x3& b, Matrix3x3& out) { out = a * b; }));
+
+	cases.push_back(MakeUnaryCase<Matrix3x3, Matrix3x3>("Mtx33Inverse", mtx,
+		[](const Matrix3x3& m, Matrix3x3& out) { out = Mtx33Inverse(m); }));
+
+	cases.push_back(MakeBinaryCase<Matrix3x4, Matrix3x4, Matrix3x4>("Matrix3x4::operator*", affine, affine,
+		[](const Matrix3x4& a, const Matrix3x4& b, Matrix3x4& out) { out = a * b; }));
+
+	cases.push_back(MakeBinaryCase<Matrix3x4, Vec3, Vec3>("Matrix3x4::TransformPoint", affine, vec,
+		[](const Matrix3x4& m, const Vec3& v, Vec3& out) { out = m.TransformPoint(v); }));
+
+	cases.push_back(MakeUnaryCase<Vec3, Vec3>("Vector3D::Normalize", vec,
+		[](const Vec3& v, Vec3& out) { out = v; out.Normalize(); }));
+
+	cases.push_back(MakeBinaryCase<Vec3, Vec3, float>("Vector3DDistanceSquared", vec, vec,
+		[](const Vec3& a, const Vec3& b, float& out) { out = Vector3DDistanceSquared(a, b); }));
+
+	cases.push_back(MakeBinaryCase<Vec3A, Vec3A, float>("Vec3A DistanceSquared",
+		[](Random& r) { return Vec3A{ r.Vector() }; }, [](Random& r) { return Vec3A{ r.Vector() }; },
+		[](const Vec3A& a, const Vec3A& b, float& out) { out = Vector3DDistanceSquared(a, b); }));
+
+	// Matrix rebuild after a position change (what Transform::UpdateMtx does
+	// on the next read), over a pool of up to MAX_TRANSFORMS transforms
+	cases.push_back(Case{ "Transform::UpdateMtx", [=](size_t n) -> std::function<void()>
+	{
+		struct Data
+		{
+			std::vector<Transform> transforms;
+			std::vector<Vec3> positions;
+			std::vector<Mtx44> out;
+		};
+		Random random;
+		auto data = std::make_shared<Data>();
+		data->transforms.resize(Math::Min(n, MAX_TRANSFORMS));
+		for (Transform& t : data->transforms)
+			t.rotation = quat(random);
+		data->positions = MakeArray<Vec3>(n, [&] { return vec(random); });
+		data->out.resize(n);
+
+		return [data]()
+		{
+			const size_t poolSize = data->transforms.size();
+			for (size_t i = 0; i < data->out.size(); ++i)
+			{
+				Transform& t = data->transforms[i % poolSize];
+				t.SetPosition(data->positions[i]);
+				data->out[i] = t.GetTransform();
+			}
+		};
+	} });
+
+	// ----------- Batched API, for comparison ------------
+
+	cases.push_back(Case{ "QuatBatch::Multiply", [=](size_t n) -> std::function<void()>
+	{
+		struct Data { QuatBatch a, b, out; };
+		Random random;
+		auto data = std::make_shared<Data>();
+		data->a.Resize(n);
+		data->b.Resize(n);
+		data->out.Resize(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			data->a.Set(i, quat(random));
+			data->b.Set(i, quat(random));
+		}
+
+		return [data]() { QuatBatch::Multiply(data->a, data->b, data->out); };
+	} });
+
+	cases.push_back(Case{ "QuatBatch::RotateVectors", [=](size_t n) -> std::function<void()>
+	{
+		struct Data { QuatBatch q; Vec3Batch v, out; };
+		Random random;
+		auto data = std::make_shared<Data>();
+		data->q.Resize(n);
+		data->v.Resize(n);
+		data->out.Resize(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			data->q.Set(i, quat(random));
+			data->v.Set(i, vec(random));
+		}
+
+		return [data]() { data->q.RotateVectors(data->v, data->out); };
+	} });
+
+	cases.push_back(Case{ "Quat::LookRotationN", [=](size_t n) -> std::function<void()>
+	{
+		struct Data { std::vector<Vec3> forward, up; std::vector<Quat> out; };
+		Random random;
+		auto data = std::make_shared<Data>();
+		data->forward = MakeArray<Vec3>(n, [&] { return vec(random); });
+		data->up = MakeArray<Vec3>(n, [&] { return vec(random); });
+		data->out.resize(n);
+
+		return [data]() { Quat::LookRotationN(data->forward.data(), data->up.data(), data->out.data(), data->out.size()); };
+	} });
+
+	cases.push_back(Case{ "Quat::SlerpN", [=](size_t n) -> std::function<void()>
+	{
+		struct Data { std::vector<Quat> a, b, out; std::vector<float> t; };
+		Random random;
+		auto data = std::make_shared<Data>();
+		data->a = MakeArray<Quat>(n, [&] { return quat(random); });
+		data->b = MakeArray<Quat>(n, [&] { return quat(random); });
+		data->t = MakeArray<float>(n, [&] { return alpha(random); });
+		data->out.resize(n);
+
+		return [data]() { Quat::SlerpN(data->a.data(), data->b.data(), data->t.data(), data->out.data(), data->out.size()); };
+	} });
+
+	cases.push_back(Case{ "Quat::IntegrateAngularVelocityN", [=](size_t n) -> std::function<void()>
+	{
+		struct Data { std::vector<Quat> q; std::vector<Vec3> omega; AngularIntegration integration; };
+		Random random;
+		auto data = std::make_shared<Data>();
+		data->q = MakeArray<Quat>(n, [&] { return quat(random); });
+		data->omega = MakeArray<Vec3>(n, [&] { return vec(random); });
+
+		return [data]() { Quat::IntegrateAngularVelocityN(data->q.data(), data->omega.data(), 1.f / 120.f, data->q.size(), data->integration); };
+	} });
+
+	cases.push_back(Case{ "QuatSpline::Sample", [=](size_t n) -> std::function<void()>
+	{
+		// A 16-key track played back at n steps
+		struct Data { QuatSpline spline; std::vector<float> times; std::vector<Quat> out; };
+		Random random;
+		auto data = std::make_shared<Data>();
+		float keyTime = 0.f;
+		const std::vector<float> keyTimes = MakeArray<float>(16, [&] { return keyTime += random.Between(0.5f, 2.f); });
+		const std::vector<Quat> keys = MakeArray<Quat>(16, [&] { return quat(random); });
+		data->spline.SetKeys(keyTimes.data(), keys.data(), keys.size());
+		for (size_t i = 0; i < n; ++i)
+			data->times.push_back(data->spline.StartTime() + (data->spline.EndTime() - data->spline.StartTime()) * i / n);
+		data->out.resize(n);
+
+		return [data]() { data->spline.Sample(data->times.data(), data->out.data(), data->out.size()); };
+	} });
+
+	cases.push_back(Case{ "CompressQuats32", [=](size_t n) -> std::function<void()>
+	{
+		struct Data { std::vector<Quat> in; std::vector<uint32_t> out; };
+		Random random;
+		auto data = std::make_shared<Data>();
+		data->in = MakeArray<Quat>(n, [&] { return quat(random); });
+		data->out.resize(n);
+
+		return [data]() { CompressQuats32(data->in.data(), data->out.data(), data->out.size()); };
+	} });
+
+	cases.push_back(Case{ "DecompressQuats32", [=](size_t n) -> std::function<void()>
+	{
+		struct Data { std::vector<uint32_t> in; std::vector<Quat> out; };
+		Random random;
+		auto data = std::make_shared<Data>();
+		const std::vector<Quat> quats = MakeArray<Quat>(n, [&] { return quat(random); });
+		data->in.resize(n);
+		CompressQuats32(quats.data(), data->in.data(), n);
+		data->out.resize(n);
+
+		return [data]() { DecompressQuats32(data->in.data(), data->out.data(), data->out.size()); };
+	} });
+
+	cases.push_back(Case{ "TransformPoints", [=](size_t n) -> std::function<void()>
+	{
+		struct Data { Matrix3x4 m; std::vector<Vec3> in, out; };
+		Random random;
+		auto data = std::make_shared<Data>();
+		data->m = affine(random);
+		data->in = MakeArray<Vec3>(n, [&] { return vec(random); });
+		data->out.resize(n);
+
+		return [data]() { TransformPoints(data->m, data->in.data(), data->out.data(), data->out.size()); };
+	} });
+
+	cases.push_back(Case{ "CullAABBs", [=](size_t n) -> std::function<void()>
+	{
+		struct Data { Frustum frustum; std::vector<Mtx44> mtx; std::vector<AABB> bounds; std::vector<uint32_t> visible; };
+		Random random;
+		auto data = std::make_shared<Data>();
+
+		// 90 degree frustum down -z, near 0.1, far 100
+		const float s = 0.70710678f;
+		data->frustum = Frustum{ {
+			{ Vec3{ s, 0.f, -s }, 0.f }, { Vec3{ -s, 0.f, -s }, 0.f },
+			{ Vec3{ 0.f, s, -s }, 0.f }, { Vec3{ 0.f, -s, -s }, 0.f },
+			{ Vec3{ 0.f, 0.f, -1.f }, -0.1f }, { Vec3{ 0.f, 0.f, 1.f }, 100.f } } };
+		data->mtx = MakeArray<Mtx44>(n, [&]
+		{
+			Mtx44 m;
+			Mtx44ComposeTRS(m, 10.f * vec(random), quat(random), Vec3{ 1.f, 1.f, 1.f });
+			return m;
+		});
+		data->bounds = MakeArray<AABB>(n, [&] { return AABB{ Vec3{ -1.f, -1.f, -1.f }, Vec3{ 1.f, 1.f, 1.f } }; });
+		data->visible.resize(VisibilityWords(n));
+
+		return [data]() { CullAABBs(data->frustum, data->mtx.data(), data->bounds.data(), data->bounds.size(), data->visible.data()); };
+	} });
+
+	cases.push_back(Case{ "Vec3Stream::DistanceSquared", [=](size_t n) -> std::function<void()>
+	{
+		struct Data { Vec3Batch a, b; std::vector<float> out; };
+		Random random;
+		auto data = std::make_shared<Data>();
+		data->a.Resize(n);
+		data->b.Resize(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			data->a.Set(i, vec(random));
+			data->b.Set(i, vec(random));
+		}
+		data->out.resize(n);
+
+		return [data]() { Vec3Stream::DistanceSquared(data->a, data->b, data->out.data()); };
+	} });
+
+	cases.push_back(Case{ "Vec3Stream::Normalize", [=](size_t n) -> std::function<void()>
+	{
+		struct Data { Vec3Batch in, out; };
+		Random random;
+		auto data = std::make_shared<Data>();
+		data->in.Resize(n);
+		data->out.Resize(n);
+		for (size_t i = 0; i < n; ++i)
+			data->in.Set(i, vec(random));
+
+		return [data]() { Vec3Stream::Normalize(data->in, data->out); };
+	} });
+
+	cases.push_back(Case{ "ComposeTRSN", [=](size_t n) -> std::function<void()>
+	{
+		struct Data { std::vector<Vec3> t, s; std::vector<Quat> q; std::vector<float> out; };
+		Random random;
+		auto data = std::make_shared<Data>();
+		data->t = MakeArray<Vec3>(n, [&] { return vec(random); });
+		data->q = MakeArray<Quat>(n, [&] { return quat(random); });
+		data->s = MakeArray<Vec3>(n, [&] { return vec(random); });
+		data->out.resize(n * AFFINE_FLOATS);
+
+		return [data]() { ComposeTRSN(data->t.data(), data->q.data(), data->s.data(), data->out.data(), data->q.size()); };
+	} });
+
+	return cases;
+}
+
+Result Measure(const Case& c, size_t batchSize, double minSeconds)
+{
+	typedef std::chrono::steady_clock Clock;
+
+	const std::function<void()> run = c.prepare(batchSize);
+
+	// Warm up caches and branch predictors
+	run();
+
+	// Double the number of passes until the run is long enough to trust
+	size_t passes = 1;
+	double seconds = 0.0;
+	for (;;)
+	{
+		const Clock::time_point start = Clock::now();
+		for (size_t p = 0; p < passes; ++p)
+			run();
+		seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		if (seconds >= minSeconds)
+			break;
+		passes *= 2;
+	}
+
+	const double ops = static_cast<double>(passes) * static_cast<double>(batchSize);
+	return Result{ c.name, batchSize, passes, seconds * 1e9 / ops, ops / seconds };
+}
+
+std::vector<Result> RunAll(std::ostream& out, size_t maxBatch, double minSeconds)
+{
+	return RunAll(DefaultCases(), out, maxBatch, minSeconds);
+}
+
+std::vector<Result> RunAll(const std::vector<Case>& cases, std::ostream& out, size_t maxBatch, double minSeconds)
+{
+	std::vector<Result> results;
+
+	out << std::left << std::setw(28) << "Benchmark" << std::right
+		<< std::setw(8) << "Batch" << std::setw(12) << "ns/op" << std::setw(14) << "Mops/s" << std::endl;
+
+	for (const Case& c : cases)
+	{
+		for (size_t batch = 1; batch <= maxBatch; batch *= 10)
+		{
+			const Result r = Measure(c, batch, minSeconds);
+			results.push_back(r);
+
+			out << std::left << std::setw(28) << r.name << std::right
+				<< std::setw(8) << FormatCount(r.batchSize)
+				<< std::fixed << std::setprecision(2)
+				<< std::setw(12) << r.nsPerOp
+				<< std::setw(14) << r.opsPerSecond * 1e-6
+				<< std::defaultfloat << std::endl;
+		}
+	}
+
+	return results;
+}
+
+void WriteCSV(std::ostream& out, const std::vector<Result>& results)
+{
+	out << "name,batch,passes,ns_per_op,ops_per_second\n";
+	for (const Result& r : results)
+		out << r.name << ',' << r.batchSize << ',' << r.passes << ',' << r.nsPerOp << ',' << r.opsPerSecond << '\n';
+}
+
+} // namespace Benchmark
+} // namespace SNova
\ No newline at end of file
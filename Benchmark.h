@@ -0,0 +1,70 @@
+/******************************************************************************/
+/*!
+\file		Benchmark.h
+\author		Justin Leow
+\brief
+	Microbenchmarks for the math hot paths (Quat, Rotator, Vector3D,
+	Matrix3x3, Transform), and for their batched versions next to them.
+
+	Each case is timed at batch sizes 1, 10, 100 ... up to 1M so small-call
+	overhead and cache effects both show. Results are in ns per op and ops
+	per second. Call RunAll() from a debug key or test build. Save the
+	WriteCSV() output to keep a baseline, and diff later runs against it.
+
+	Time measured from a Debug build is meaningless; run in Release.
+	Verify.h checks that each kernel timed here still matches its scalar
+	reference.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace SNova
+{
+namespace Benchmark
+{
+	struct Result
+	{
+		std::string name;
+		size_t batchSize;
+		size_t passes;			// times the whole batch was run
+		double nsPerOp;
+		double opsPerSecond;
+	};
+
+	/**
+	 * One benchmarked operation.
+	 * prepare(n) builds inputs for a batch of n and returns a function that
+	 * performs all n ops once. Everything it allocates is freed when that
+	 * function is destroyed, so only one case's data is alive at a time.
+	 */
+	struct Case
+	{
+		std::string name;
+		std::function<std::function<void()>(size_t batchSize)> prepare;
+	};
+
+	// Built-in cases, one per hot path
+	std::vector<Case> DefaultCases();
+
+	// Time one case at one batch size. Runs whole batches for at least minSeconds.
+	Result Measure(const Case& c, size_t batchSize, double minSeconds = 0.05);
+
+	// Run every case at batch sizes 1, 10, ..., maxBatch and print a table to out
+	std::vector<Result> RunAll(std::ostream& out = std::cout, size_t maxBatch = 1000000, double minSeconds = 0.05);
+	std::vector<Result> RunAll(const std::vector<Case>& cases, std::ostream& out, size_t maxBatch, double minSeconds);
+
+	// name,batch,passes,ns_per_op,ops_per_second
+	void WriteCSV(std::ostream& out, const std::vector<Result>& results);
+
+} // namespace Benchmark
+} // namespace SNova
\ No newline at end of file
@@ -0,0 +1,302 @@
+/******************************************************************************/
+/*!
+\file		Culling.cpp
+\author		Justin Leow
+\brief
+	Frustum culling kernels. See Culling.h.
+
+	Matrices and bounds are array-of-structs, so each block of CHUNK objects
+	goes through a small SoA staging buffer that stays in L1 (like
+	ComposeTRSN), then one lane kernel per bounds type transforms and tests
+	a register of objects at a time. A block is 64 objects, so it fills two
+	whole words of the bitmask and threads never share a word.
+
+	Box vs plane: the box is outside if its center is further behind the
+	plane than its extent projected on the normal, Dot(|n|, extent).
+	The world extent of a box under an affine matrix M is |M| * extent
+	(Arvo, "Transforming Axis-Aligned Bounding Boxes", Graphics Gems 1990).
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "SNova.h"
+#include "Culling.h"
+#include "TransformPool.h"
+#include "ParallelFor.h"
+#include "SIMD.h"
+#include <atomic>
+
+namespace SNova
+{
+
+namespace
+{
+	using namespace SIMD;
+
+	// Objects per staging block. Multiple of 32: blocks write whole bitmask words
+	static constexpr size_t CHUNK = 64;
+
+	// Blocks per ParallelFor chunk
+	static constexpr size_t GRAIN_BLOCKS = 64;
+
+	// Staged floats per matrix: the top 3 rows
+	static constexpr size_t MTX_LANES = 12;
+
+	typedef float Lanes[CHUNK];
+
+	// World-space center of the staged local points
+	template <typename L>
+	inline void TransformPoint(size_t i, const Lanes* m, const L* local, L* world)
+	{
+		for (int r = 0; r < 3; ++r)
+		{
+			const Lanes* row = m + 4 * r;
+			world[r] = L::Load(row[0] + i) * local[0] + L::Load(row[1] + i) * local[1]
+				+ L::Load(row[2] + i) * local[2] + L::Load(row[3] + i);
+		}
+	}
+
+	// Mask of the objects with center + radius in front of every plane.
+	// radius(plane) is how far the bounds reach towards the plane's inside
+	template <typename L, typename RadiusFn>
+	inline L InsideFrustum(const Frustum& frustum, const L* center, RadiusFn&& radius)
+	{
+		L inside;
+		for (int p = 0; p < Frustum::PLANE_COUNT; ++p)
+		{
+			const FrustumPlane& plane = frustum.planes[p];
+			const L dist = L::Set(plane.normal.x) * center[0] + L::Set(plane.normal.y) * center[1]
+				+ L::Set(plane.normal.z) * center[2] + L::Set(plane.distance);
+			const L test = CmpGE(dist + radius(plane), L::Set(0.f));
+			inside = (p == 0) ? test : And(inside, test);
+		}
+		return inside;
+	}
+
+	struct BoxCull
+	{
+		typedef AABB Bounds;
+
+		// min xyz, max xyz
+		static constexpr size_t LANES = 6;
+
+		static inline void Stage(const AABB& box, Lanes* lanes, size_t k)
+		{
+			lanes[0][k] = box.min.x; lanes[1][k] = box.min.y; lanes[2][k] = box.min.z;
+			lanes[3][k] = box.max.x; lanes[4][k] = box.max.y; lanes[5][k] = box.max.z;
+		}
+
+		static inline AABB Unstage(const Lanes* lanes, size_t k)
+		{
+			return AABB{ Vec3{ lanes[0][k], lanes[1][k], lanes[2][k] }, Vec3{ lanes[3][k], lanes[4][k], lanes[5][k] } };
+		}
+
+		template <typename L>
+		static inline L Kernel(size_t i, const Frustum& frustum, const Lanes* m, const Lanes* in, Lanes* out)
+		{
+			const L half = L::Set(0.5f);
+			L center[3], extent[3];
+			for (int a = 0; a < 3; ++a)
+			{
+				const L lo = L::Load(in[a] + i), hi = L::Load(in[3 + a] + i);
+				center[a] = (lo + hi) * half;
+				extent[a] = (hi - lo) * half;
+			}
+
+			L worldCenter[3], worldExtent[3];
+			TransformPoint(i, m, center, worldCenter);
+			for (int r = 0; r < 3; ++r)
+			{
+				const Lanes* row = m + 4 * r;
+				worldExtent[r] = Abs(L::Load(row[0] + i)) * extent[0] + Abs(L::Load(row[1] + i)) * extent[1]
+					+ Abs(L::Load(row[2] + i)) * extent[2];
+			}
+
+			for (int a = 0; a < 3; ++a)
+			{
+				(worldCenter[a] - worldExtent[a]).Store(out[a] + i);
+				(worldCenter[a] + worldExtent[a]).Store(out[3 + a] + i);
+			}
+
+			return InsideFrustum(frustum, worldCenter, [&](const FrustumPlane& plane)
+			{
+				return L::Set(Math::Abs(plane.normal.x)) * worldExtent[0] + L::Set(Math::Abs(plane.normal.y)) * worldExtent[1]
+					+ L::Set(Math::Abs(plane.normal.z)) * worldExtent[2];
+			});
+		}
+	};
+
+	struct SphereCull
+	{
+		typedef BoundingSphere Bounds;
+
+		// center xyz, radius
+		static constexpr size_t LANES = 4;
+
+		static inline void Stage(const BoundingSphere& sphere, Lanes* lanes, size_t k)
+		{
+			lanes[0][k] = sphere.center.x; lanes[1][k] = sphere.center.y; lanes[2][k] = sphere.center.z;
+			lanes[3][k] = sphere.radius;
+		}
+
+		static inline BoundingSphere Unstage(const Lanes* lanes, size_t k)
+		{
+			return BoundingSphere{ Vec3{ lanes[0][k], lanes[1][k], lanes[2][k] }, lanes[3][k] };
+		}
+
+		template <typename L>
+		static inline L Kernel(size_t i, const Frustum& frustum, const Lanes* m, const Lanes* in, Lanes* out)
+		{
+			const L center[3] = { L::Load(in[0] + i), L::Load(in[1] + i), L::Load(in[2] + i) };
+			L worldCenter[3];
+			TransformPoint(i, m, center, worldCenter);
+
+			// Largest axis scale: the longest of the first three columns
+			L maxScaleSq = L::Set(0.f);
+			for (int c = 0; c < 3; ++c)
+			{
+				const L x = L::Load(m[c] + i), y = L::Load(m[4 + c] + i), z = L::Load(m[8 + c] + i);
+				maxScaleSq = Max(maxScaleSq, x * x + y * y + z * z);
+			}
+			const L radius = L::Load(in[3] + i) * Sqrt(maxScaleSq);
+
+			for (int a = 0; a < 3; ++a)
+				worldCenter[a].Store(out[a] + i);
+			radius.Store(out[3] + i);
+
+			return InsideFrustum(frustum, worldCenter, [&](const FrustumPlane&) { return radius; });
+		}
+	};
+
+	inline size_t CountBits(uint64_t bits)
+	{
+		size_t count = 0;
+		for (; bits; bits &= bits - 1)
+			++count;
+		return count;
+	}
+
+	// Cull objects [begin, end). begin is a multiple of CHUNK
+	template <typename Cull>
+	size_t CullRange(const Frustum& frustum, const Mtx44* matrices, const typename Cull::Bounds* localBounds, const uint8_t* alive,
+		size_t begin, size_t end, uint32_t* visible, typename Cull::Bounds* worldBounds)
+	{
+		alignas(SIMD::ALIGNMENT) Lanes mtxLanes[MTX_LANES];
+		alignas(SIMD::ALIGNMENT) Lanes inLanes[Cull::LANES];
+		alignas(SIMD::ALIGNMENT) Lanes outLanes[Cull::LANES];
+
+		size_t visibleCount = 0;
+		for (size_t base = begin; base < end; base += CHUNK)
+		{
+			const size_t count = Math::Min(CHUNK, end - base);
+
+			for (size_t k = 0; k < count; ++k)
+			{
+				const Mtx44& mtx = matrices[base + k];
+				for (int r = 0; r < 3; ++r)
+				{
+					for (int c = 0; c < 4; ++c)
+						mtxLanes[4 * r + c][k] = mtx.m2[r][c];
+				}
+				Cull::Stage(localBounds[base + k], inLanes, k);
+			}
+
+			uint64_t bits = 0;
+			RunBatch(count, [&](size_t i, auto lane)
+			{
+				const auto inside = Cull::template Kernel<decltype(lane)>(i, frustum, mtxLanes, inLanes, outLanes);
+				bits |= static_cast<uint64_t>(MaskBits(inside)) << i;
+			});
+
+			if (alive)
+			{
+				for (size_t k = 0; k < count; ++k)
+				{
+					if (!alive[base + k])
+						bits &= ~(uint64_t{ 1 } << k);
+				}
+			}
+
+			visible[base / 32] = static_cast<uint32_t>(bits);
+			if (count > 32)
+				visible[base / 32 + 1] = static_cast<uint32_t>(bits >> 32);
+			visibleCount += CountBits(bits);
+
+			if (worldBounds)
+			{
+				for (size_t k = 0; k < count; ++k)
+					worldBounds[base + k] = Cull::Unstage(outLanes, k);
+			}
+		}
+		return visibleCount;
+	}
+
+	template <typename Cull>
+	size_t CullAll(const Frustum& frustum, const Mtx44* matrices, const typename Cull::Bounds* localBounds, const uint8_t* alive,
+		size_t count, uint32_t* visible, typename Cull::Bounds* worldBounds)
+	{
+		// Split by blocks rather than objects, so every range starts on a
+		// block whatever the ParallelFor backend does with the grain
+		const size_t blocks = (count + CHUNK - 1) / CHUNK;
+		std::atomic<size_t> visibleCount{ 0 };
+
+		ParallelFor(blocks, GRAIN_BLOCKS, [&](size_t beginBlock, size_t endBlock)
+		{
+			const size_t begin = beginBlock * CHUNK;
+			const size_t end = Math::Min(endBlock * CHUNK, count);
+			visibleCount += CullRange<Cull>(frustum, matrices, localBounds, alive, begin, end, visible, worldBounds);
+		});
+
+		return visibleCount;
+	}
+}
+
+Frustum Frustum::FromMatrix(const Mtx44& viewProjection)
+{
+	// Gribb & Hartmann, "Fast Extraction of Viewing Frustum Planes from the
+	// World-View-Projection Matrix": each plane is row 3 +- row 0/1/2
+	const auto& m = viewProjection.m2;
+	Frustum frustum;
+	for (int p = 0; p < PLANE_COUNT; ++p)
+	{
+		const int row = p / 2;
+		const float sign = (p % 2 == 0) ? 1.f : -1.f;
+
+		const Vec3 normal{ m[3][0] + sign * m[row][0], m[3][1] + sign * m[row][1], m[3][2] + sign * m[row][2] };
+		const float distance = m[3][3] + sign * m[row][3];
+
+		const float length = normal.Magnitude();
+		const float invLength = (length > 0.f) ? 1.f / length : 0.f;
+		frustum.planes[p] = FrustumPlane{ normal * invLength, distance * invLength };
+	}
+	return frustum;
+}
+
+size_t CullAABBs(const Frustum& frustum, const Mtx44* matrices, const AABB* localBounds, size_t count,
+	uint32_t* visible, AABB* worldBounds)
+{
+	return CullAll<BoxCull>(frustum, matrices, localBounds, nullptr, count, visible, worldBounds);
+}
+
+size_t CullSpheres(const Frustum& frustum, const Mtx44* matrices, const BoundingSphere* localBounds, size_t count,
+	uint32_t* visible, BoundingSphere* worldBounds)
+{
+	return CullAll<SphereCull>(frustum, matrices, localBounds, nullptr, count, visible, worldBounds);
+}
+
+size_t CullAABBs(const Frustum& frustum, const TransformPool& pool, const AABB* localBounds,
+	uint32_t* visible, AABB* worldBounds)
+{
+	return CullAll<BoxCull>(frustum, pool.Matrices(), localBounds, pool.SlotAlive(), pool.SlotCount(), visible, worldBounds);
+}
+
+size_t CullSpheres(const Frustum& frustum, const TransformPool& pool, const BoundingSphere* localBounds,
+	uint32_t* visible, BoundingSphere* worldBounds)
+{
+	return CullAll<SphereCull>(frustum, pool.Matrices(), localBounds, pool.SlotAlive(), pool.SlotCount(), visible, worldBounds);
+}
+
+} // namespace SNova
\ No newline at end of file
@@ -0,0 +1,122 @@
+/******************************************************************************/
+/*!
+\file		Culling.h
+\author		Justin Leow
+\brief
+	Frustum culling of many objects at once, straight from their Mtx44
+	world matrices.
+
+	Each object has local bounds (an AABB or a sphere, in the space its
+	matrix maps from). The cull functions transform all of them to world
+	space and test them against the frustum's six planes, a SIMD register
+	of objects at a time (8 with AVX2), with the array split over all cores
+	by ParallelFor. The result is a bitmask, bit i set if object i may be
+	visible, and optionally the world-space bounds.
+
+	Tests are conservative: an AABB is replaced by the world AABB that
+	encloses its transformed box, so objects near a frustum corner can be
+	kept when they are just outside. Nothing visible is ever culled.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "GenMath.h"
+#include "Vector3D.h"
+#include "Matrix4x4.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace SNova
+{
+class TransformPool;
+
+/////////////////////////////////////////////////////
+// Bounds
+
+struct AABB
+{
+	Vec3 min;
+	Vec3 max;
+};
+
+struct BoundingSphere
+{
+	Vec3 center;
+	float radius;
+};
+
+/////////////////////////////////////////////////////
+// Frustum
+
+// Points p with Dot(normal, p) + distance >= 0 are on the inside
+struct FrustumPlane
+{
+	Vec3 normal;
+	float distance;
+};
+
+struct Frustum
+{
+	enum Plane
+	{
+		PLANE_LEFT, PLANE_RIGHT,
+		PLANE_BOTTOM, PLANE_TOP,
+		PLANE_NEAR, PLANE_FAR,
+		PLANE_COUNT
+	};
+
+	FrustumPlane planes[PLANE_COUNT];
+
+	/**
+	 * Planes of projection * view, in world space, with unit normals.
+	 * Matrices map column vectors (like Mtx44ComposeTRS), to OpenGL clip
+	 * space: -w <= x, y, z <= w.
+	 */
+	static Frustum FromMatrix(const Mtx44& viewProjection);
+};
+
+/////////////////////////////////////////////////////
+// Visibility bitmask
+
+// Bit (i % 32) of word i / 32 is object i
+constexpr inline size_t VisibilityWords(size_t count)
+{
+	return (count + 31) / 32;
+}
+
+inline bool IsVisible(const uint32_t* visible, size_t i)
+{
+	return (visible[i / 32] >> (i % 32)) & 1u;
+}
+
+/////////////////////////////////////////////////////
+// Culling
+
+/**
+ * Cull count objects: matrices[i] maps localBounds[i] to world space.
+ * Writes VisibilityWords(count) words to visible (bits past count are 0)
+ * and, unless worldBounds is nullptr, the world bounds of every object.
+ * Returns the number of visible objects.
+ *
+ * Sphere radii are scaled by the largest axis scale of the matrix.
+ */
+size_t CullAABBs(const Frustum& frustum, const Mtx44* matrices, const AABB* localBounds, size_t count,
+	uint32_t* visible, AABB* worldBounds = nullptr);
+size_t CullSpheres(const Frustum& frustum, const Mtx44* matrices, const BoundingSphere* localBounds, size_t count,
+	uint32_t* visible, BoundingSphere* worldBounds = nullptr);
+
+/**
+ * Same over a TransformPool's hot arrays (call pool.UpdateHotData() first).
+ * localBounds, visible and worldBounds are indexed by slot, pool.SlotCount()
+ * long. Free slots are never visible.
+ */
+size_t CullAABBs(const Frustum& frustum, const TransformPool& pool, const AABB* localBounds,
+	uint32_t* visible, AABB* worldBounds = nullptr);
+size_t CullSpheres(const Frustum& frustum, const TransformPool& pool, const BoundingSphere* localBounds,
+	uint32_t* visible, BoundingSphere* worldBounds = nullptr);
+
+} // namespace SNova
\ No newline at end of file
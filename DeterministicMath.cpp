@@ -0,0 +1,218 @@
+/******************************************************************************/
+/*!
+\file		DeterministicMath.cpp
+\author		Justin Leow
+\brief
+	Bit-reproducible trig. See DeterministicMath.h.
+
+	The kernels and their coefficients are from fdlibm (Sun Microsystems),
+	evaluated in a fixed order with no library calls except std::sqrt,
+	floor and copysign, which are exact.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "DeterministicMath.h"
+#include "GenMath.h"
+#include <cmath>
+
+namespace SNova
+{
+namespace Math
+{
+namespace Deterministic
+{
+
+namespace
+{
+	/////////////////////////////////////////////////////
+	// Constants
+
+	// PI/2 split in 33-bit pieces, so n * piece is exact for |n| < 2^20 (Cody-Waite)
+	constexpr double INV_PIOVER2 = 6.36619772367581382433e-01;
+	constexpr double PIOVER2_1 = 1.57079632673412561417e+00;
+	constexpr double PIOVER2_2 = 6.07710050630396597660e-11;
+	constexpr double PIOVER2_2T = 2.02226624879595063154e-21;
+
+	// PI and PI/2 as a double plus the part a double cannot hold
+	constexpr double PI_HI = 3.14159265358979311600e+00;
+	constexpr double PI_LO = 1.22464679914735317720e-16;
+	constexpr double PIOVER2_HI = 1.57079632679489655800e+00;
+
+	// sin(x) - x and cos(x) - (1 - x^2 / 2) on [-PI/4, PI/4], in x^2
+	constexpr double S1 = -1.66666666666666324348e-01, S2 = 8.33333333332248946124e-03,
+		S3 = -1.98412698298579493134e-04, S4 = 2.75573137070700676789e-06,
+		S5 = -2.50507602534068634195e-08, S6 = 1.58969099521155010221e-10;
+	constexpr double C1 = 4.16666666666666019037e-02, C2 = -1.38888888888741095749e-03,
+		C3 = 2.48015872894767294178e-05, C4 = -2.75573143513906633035e-07,
+		C5 = 2.08757232129817482790e-09, C6 = -1.13596475577881948265e-11;
+
+	// atan of 0.5, 1, 1.5 and infinity, split as hi + lo
+	constexpr double ATAN_HI[4] = { 4.63647609000806093515e-01, 7.85398163397448278999e-01,
+		9.82793723247329054082e-01, 1.57079632679489655800e+00 };
+	constexpr double ATAN_LO[4] = { 2.26987774529616870924e-17, 3.06161699786838301793e-17,
+		1.39033110312309984516e-17, 6.12323399573676603587e-17 };
+
+	// atan(x) - x on [-7/16, 7/16], odd and even halves in x^4
+	constexpr double AT[11] = { 3.33333333333329318027e-01, -1.99999999998764832476e-01,
+		1.42857142725034663711e-01, -1.11111104054623557880e-01, 9.09088713343650656196e-02,
+		-7.69187620504482999495e-02, 6.66107313738753120669e-02, -5.83357013379057348645e-02,
+		4.97687799461593236017e-02, -3.65315727442169155270e-02, 1.62858201153657823623e-02 };
+
+	/////////////////////////////////////////////////////
+	// Helper Functions
+
+	inline double KernelSin(double x)
+	{
+		const double z = x * x;
+		return x + x * z * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)))));
+	}
+
+	inline double KernelCos(double x)
+	{
+		const double z = x * x;
+		return (1.0 - 0.5 * z) + z * z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6)))));
+	}
+}
+
+void SinCos(double rad, double& sinOut, double& cosOut)
+{
+	// Infinity and NaN give NaN
+	if (!(rad - rad == 0.0))
+	{
+		sinOut = cosOut = rad - rad;
+		return;
+	}
+
+	// rad = n * PI/2 + r with r in [-PI/4, PI/4]
+	const double n = floor(rad * INV_PIOVER2 + 0.5);
+	const double r = ((rad - n * PIOVER2_1) - n * PIOVER2_2) - n * PIOVER2_2T;
+	const double s = KernelSin(r);
+	const double c = KernelCos(r);
+
+	// n mod 4, exact for any integral double
+	switch (static_cast<int>(n - 4.0 * floor(n * 0.25)))
+	{
+	case 0: sinOut = s; cosOut = c; break;
+	case 1: sinOut = c; cosOut = -s; break;
+	case 2: sinOut = -s; cosOut = -c; break;
+	default: sinOut = -c; cosOut = s; break;
+	}
+}
+
+double Sin(double rad)
+{
+	double s, c;
+	SinCos(rad, s, c);
+	return s;
+}
+
+double Cos(double rad)
+{
+	double s, c;
+	SinCos(rad, s, c);
+	return c;
+}
+
+double Atan(double x)
+{
+	if (x != x)
+		return x;
+
+	const bool negative = x < 0.0;
+	double ax = negative ? -x : x;
+
+	// Reduce to |ax| < 7/16 around the nearest of 0, 0.5, 1, 1.5, infinity
+	int id = -1;
+	if (ax >= 0.4375)
+	{
+		if (ax < 0.6875)
+		{
+			id = 0;
+			ax = (2.0 * ax - 1.0) / (2.0 + ax);
+		}
+		else if (ax < 1.1875)
+		{
+			id = 1;
+			ax = (ax - 1.0) / (ax + 1.0);
+		}
+		else if (ax < 2.4375)
+		{
+			id = 2;
+			ax = (ax - 1.5) / (1.0 + 1.5 * ax);
+		}
+		else
+		{
+			id = 3;
+			ax = -1.0 / ax;
+		}
+	}
+
+	const double z = ax * ax;
+	const double w = z * z;
+	const double s1 = z * (AT[0] + w * (AT[2] + w * (AT[4] + w * (AT[6] + w * (AT[8] + w * AT[10])))));
+	const double s2 = w * (AT[1] + w * (AT[3] + w * (AT[5] + w * (AT[7] + w * AT[9]))));
+
+	const double r = (id < 0) ? ax - ax * (s1 + s2) : ATAN_HI[id] - ((ax * (s1 + s2) - ATAN_LO[id]) - ax);
+	return negative ? -r : r;
+}
+
+double Atan2(double y, double x)
+{
+	if (x != x || y != y)
+		return x + y;
+
+	const double ax = fabs(x), ay = fabs(y);
+	if (ax == 0.0 && ay != 0.0)
+		return std::copysign(PIOVER2_HI, y);
+
+	double r;
+	if (ay == 0.0)
+		r = 0.0;
+	else if (ax == ay)
+		r = ATAN_HI[1];	// Also both infinite
+	else
+		r = Atan(ay / ax);
+
+	// Left half plane, including -0
+	if (std::signbit(x))
+		r = PI_HI - (r - PI_LO);
+
+	return std::copysign(r, y);
+}
+
+double Acos(double x)
+{
+	// acos(x) = atan2(sin, cos); (1 - x)(1 + x) keeps its bits near +-1
+	return Atan2(std::sqrt((1.0 - x) * (1.0 + x)), x);
+}
+
+double Asin(double x)
+{
+	return Atan2(x, std::sqrt((1.0 - x) * (1.0 + x)));
+}
+
+/////////////////////////////////////////////////////
+// Float Versions
+
+void SinCos(float rad, float& sinOut, float& cosOut)
+{
+	double s, c;
+	SinCos(static_cast<double>(rad), s, c);
+	sinOut = static_cast<float>(s);
+	cosOut = static_cast<float>(c);
+}
+
+float Sin(float rad) { return static_cast<float>(Sin(static_cast<double>(rad))); }
+float Cos(float rad) { return static_cast<float>(Cos(static_cast<double>(rad))); }
+float Acos(float x) { return static_cast<float>(Acos(static_cast<double>(x))); }
+float Asin(float x) { return static_cast<float>(Asin(static_cast<double>(x))); }
+float Atan(float x) { return static_cast<float>(Atan(static_cast<double>(x))); }
+float Atan2(float y, float x) { return static_cast<float>(Atan2(static_cast<double>(y), static_cast<double>(x))); }
+
+} // namespace Deterministic
+} // namespace Math
+} // namespace SNova
\ No newline at end of file
@@ -0,0 +1,68 @@
+/******************************************************************************/
+/*!
+\file		DeterministicMath.h
+\author		Justin Leow
+\brief
+	Trig functions that give bit-identical results on every platform, for
+	lockstep simulation where clients exchange only inputs.
+
+	sinf, acosf, atan2f, ... in the C library differ in their last bits
+	between MSVC, glibc, Apple and Android. These are implemented with only
+	+ - * / and sqrt in double, which IEEE 754 rounds the same everywhere,
+	then rounded once to float. The double results are within ~1e-16, so
+	the float ones are as accurate as the C library's.
+
+	With SNOVA_DETERMINISTIC_MATH (GenMath.h) set, the TrigAccuracy::Exact
+	tier of FastTrig.h calls these instead of the C library, and SIMD.h
+	drops its estimate instructions (rsqrt, NEON reciprocal estimates) that
+	differ between CPU vendors. The High and Fast tiers, Math::InvSqrt and
+	sqrtf are already plain IEEE arithmetic. GenMath.h also rejects the
+	build settings that break reproducibility: fast-math, x87 and fused
+	multiply-add contraction.
+
+	The functions are always available (e.g. for tools), but only match
+	bit for bit when built with the settings GenMath.h enforces. For a
+	simulation that must not depend on float at all, see Fixed.h.
+
+	Sin/Cos keep full accuracy to ~1e6 radians; further out range reduction loses
+	bits, but the results stay reproducible.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+
+namespace SNova
+{
+namespace Math
+{
+namespace Deterministic
+{
+	void SinCos(double rad, double& sinOut, double& cosOut);
+	double Sin(double rad);
+	double Cos(double rad);
+
+	// NaN outside [-1, 1]
+	double Acos(double x);
+	double Asin(double x);
+
+	double Atan(double x);
+
+	// Same quadrant and signed zero rules as atan2
+	double Atan2(double y, double x);
+
+	// Float versions, the double result rounded once
+	void SinCos(float rad, float& sinOut, float& cosOut);
+	float Sin(float rad);
+	float Cos(float rad);
+	float Acos(float x);
+	float Asin(float x);
+	float Atan(float x);
+	float Atan2(float y, float x);
+
+} // namespace Deterministic
+} // namespace Math
+} // namespace SNova
\ No newline at end of file
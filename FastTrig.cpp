@@ -0,0 +1,64 @@
+/******************************************************************************/
+/*!
+\file		FastTrig.cpp
+\author		Justin Leow
+\brief
+	Array entry points of the fast trig functions. See FastTrig.h.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "FastTrig.h"
+#include "SIMD.h"
+#include <type_traits>
+
+namespace SNova
+{
+namespace Math
+{
+
+namespace
+{
+	// SinCos of exactly N angles, with the widest lane type that fits N
+	template <size_t N>
+	inline void SinCosFixed(const float* rad, float* sinOut, float* cosOut)
+	{
+		typedef typename std::conditional<(SIMD::Wide::Width <= N), SIMD::Wide, SIMD::Scalar>::type L;
+
+		for (size_t i = 0; i < N; i += L::Width)
+		{
+			L s, c;
+			SIMD::SinCos<DEFAULT_TRIG_ACCURACY>(L::Load(rad + i), s, c);
+			s.Store(sinOut + i);
+			c.Store(cosOut + i);
+		}
+	}
+}
+
+void SinCos4(const float* rad, float* sinOut, float* cosOut)
+{
+	SinCosFixed<4>(rad, sinOut, cosOut);
+}
+
+void SinCos8(const float* rad, float* sinOut, float* cosOut)
+{
+	SinCosFixed<8>(rad, sinOut, cosOut);
+}
+
+void SinCosN(const float* rad, float* sinOut, float* cosOut, size_t n)
+{
+	SIMD::RunBatch(n, [&](size_t i, auto lane)
+	{
+		typedef decltype(lane) L;
+		L s, c;
+		SIMD::SinCos<DEFAULT_TRIG_ACCURACY>(L::Load(rad + i), s, c);
+		s.Store(sinOut + i);
+		c.Store(cosOut + i);
+	});
+}
+
+} // namespace Math
+} // namespace SNova
\ No newline at end of file
@@ -0,0 +1,439 @@
+/******************************************************************************/
+/*!
+\file		FastTrig.h
+\author		Justin Leow
+\brief
+	Trig functions in selectable accuracy tiers, for scalars and for SIMD
+	lanes (see SIMD.h).
+
+	TrigAccuracy::Exact  - The C library (sinf, acosf, ...), or the
+	                       bit-reproducible DeterministicMath.h versions
+	                       when SNOVA_DETERMINISTIC_MATH is set.
+	TrigAccuracy::High   - Polynomials; max abs error ~1e-6.
+	TrigAccuracy::Fast   - Shorter polynomials; max abs error ~1e-4.
+
+	Every function takes the tier as a template argument. Without one it
+	uses SNOVA_TRIG_ACCURACY (GenMath.h), which also drives Math::SinCos, so
+	the Euler conversions and Slerp switch tiers together.
+
+	Sin/Cos errors are for |rad| up to a few thousand radians; beyond that
+	range reduction in float loses bits. Inverse functions clamp their input
+	to [-1, 1] instead of returning NaN.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "GenMath.h"
+#include "DeterministicMath.h"
+#include <cmath>
+#include <cstddef>
+
+namespace SNova
+{
+namespace Math
+{
+	enum class TrigAccuracy { Exact = 0, High = 1, Fast = 2 };
+
+	static constexpr TrigAccuracy DEFAULT_TRIG_ACCURACY = static_cast<TrigAccuracy>(SNOVA_TRIG_ACCURACY);
+
+	// Sine and cosine of the same angle, sharing range reduction
+	template <TrigAccuracy A = DEFAULT_TRIG_ACCURACY>
+	inline void SinCos(float rad, float& sinOut, float& cosOut);
+
+	template <TrigAccuracy A = DEFAULT_TRIG_ACCURACY>
+	inline float Sin(float rad);
+
+	template <TrigAccuracy A = DEFAULT_TRIG_ACCURACY>
+	inline float Cos(float rad);
+
+	template <TrigAccuracy A = DEFAULT_TRIG_ACCURACY>
+	inline float Acos(float x);
+
+	template <TrigAccuracy A = DEFAULT_TRIG_ACCURACY>
+	inline float Asin(float x);
+
+	template <TrigAccuracy A = DEFAULT_TRIG_ACCURACY>
+	inline float Atan(float x);
+
+	// Same quadrant rules as atan2f, except that -0 counts as +0. Atan2(0, 0) == 0
+	template <TrigAccuracy A = DEFAULT_TRIG_ACCURACY>
+	inline float Atan2(float y, float x);
+
+	/**
+	 * Compile-time sin/cos, for baking fixed rotations into constants.
+	 * Accurate to float precision, but evaluated as a long series, so use
+	 * SinCos/Sin/Cos for anything computed at runtime.
+	 */
+	constexpr inline void SinCosConstexpr(float rad, float& sinOut, float& cosOut);
+	constexpr inline float SinConstexpr(float rad);
+	constexpr inline float CosConstexpr(float rad);
+
+	// SinCos of 4 / 8 / n angles at once with the widest SIMD backend, at the default tier
+	void SinCos4(const float* rad, float* sinOut, float* cosOut);
+	void SinCos8(const float* rad, float* sinOut, float* cosOut);
+	void SinCosN(const float* rad, float* sinOut, float* cosOut, size_t n);
+
+	// The functions behind TrigAccuracy::Exact
+	namespace ExactTrig
+	{
+#if SNOVA_DETERMINISTIC_MATH
+		using Deterministic::SinCos;
+		using Deterministic::Sin;
+		using Deterministic::Cos;
+		using Deterministic::Acos;
+		using Deterministic::Asin;
+		using Deterministic::Atan2;
+#else
+		inline void SinCos(float rad, float& sinOut, float& cosOut) { sinOut = sinf(rad); cosOut = cosf(rad); }
+		inline float Sin(float rad) { return sinf(rad); }
+		inline float Cos(float rad) { return cosf(rad); }
+		inline float Acos(float x) { return acosf(x); }
+		inline float Asin(float x) { return asinf(x); }
+		inline float Atan2(float y, float x) { return atan2f(y, x); }
+#endif
+	}
+
+	/////////////////////////////////////////////////////
+	// Polynomial coefficients
+
+	namespace TrigCoeffs
+	{
+		// 2PI split in two so range reduction keeps its low bits (Cody-Waite)
+		static constexpr float PI2_HI = 6.28125f;
+		static constexpr float PI2_LO = 1.9353071795864769e-3f;
+		static constexpr float INV_PI2 = 0.15915494309189535f;
+		static constexpr float PI_F = 3.14159265358979324f;
+		static constexpr float PIOVER2_F = 1.57079632679489662f;
+
+		// Minimax on [-PI/2, PI/2]. sin is odd (powers 1, 3, ...), cos even (0, 2, ...)
+		static constexpr float SIN_HIGH[5] = { 0.99999997661f, -0.16666647645f, 8.3328999667e-3f, -1.9800905264e-4f, 2.5905016977e-6f };
+		static constexpr float COS_HIGH[5] = { 0.99999995365f, -0.49999905447f, 4.1663586152e-2f, -1.3853712195e-3f, 2.3154073743e-5f };
+		static constexpr float SIN_FAST[3] = { 0.99969678623f, -0.16567309728f, 7.5143825393e-3f };
+		static constexpr float COS_FAST[4] = { 0.99999332108f, -0.49991252425f, 4.1487816941e-2f, -1.2712254932e-3f };
+
+		// acos(x) = sqrt(1 - x) * P(x) on [0, 1]. Abramowitz & Stegun 4.4.46 / 4.4.45
+		static constexpr float ACOS_HIGH[8] = { 1.5707963050f, -0.2145988016f, 0.0889789874f, -0.0501743046f,
+			0.0308918810f, -0.0170881256f, 0.0066700901f, -0.0012624911f };
+		static constexpr float ACOS_FAST[4] = { 1.5707288f, -0.2121144f, 0.0742610f, -0.0187293f };
+
+		// atan(x) = x * P(x^2) on [0, 1]. Abramowitz & Stegun 4.4.49 / 4.4.47
+		static constexpr float ATAN_HIGH[9] = { 1.f, -0.3333314528f, 0.1999355085f, -0.1420889944f, 0.1065626393f,
+			-0.0752896400f, 0.0429096138f, -0.0161657367f, 0.0028662257f };
+		static constexpr float ATAN_FAST[5] = { 0.9998660f, -0.3302995f, 0.1801410f, -0.0851330f, 0.0208351f };
+
+		// A constant as a float or as a full SIMD lane
+		template <typename T>
+		inline T Splat(float f) { return T::Set(f); }
+
+		template <>
+		inline float Splat<float>(float f) { return f; }
+
+		// c[0] + c[1] * x + c[2] * x^2 + ... (Horner)
+		template <typename T, size_t N>
+		inline T Poly(const float (&c)[N], T x)
+		{
+			T r = Splat<T>(c[N - 1]);
+			for (size_t i = N - 1; i > 0; --i)
+				r = r * x + Splat<T>(c[i - 1]);
+			return r;
+		}
+	}
+
+	// ------------------------- INLINE / TEMPLATE IMPLEMENTATIONS ---------------------
+
+	template <TrigAccuracy A>
+	inline void SinCos(float rad, float& sinOut, float& cosOut)
+	{
+		using namespace TrigCoeffs;
+
+		if (A == TrigAccuracy::Exact)
+		{
+			ExactTrig::SinCos(rad, sinOut, cosOut);
+			return;
+		}
+
+		// Map to y in [-PI, PI], then fold into [-PI/2, PI/2] (sin(y) unchanged, cos flips sign)
+		const float quotient = floorf(rad * INV_PI2 + 0.5f);
+		float y = (rad - quotient * PI2_HI) - quotient * PI2_LO;
+		float cosSign = 1.f;
+		if (y > PIOVER2_F)
+		{
+			y = PI_F - y;
+			cosSign = -1.f;
+		}
+		else if (y < -PIOVER2_F)
+		{
+			y = -PI_F - y;
+			cosSign = -1.f;
+		}
+
+		const float y2 = y * y;
+		if (A == TrigAccuracy::High)
+		{
+			sinOut = y * Poly(SIN_HIGH, y2);
+			cosOut = cosSign * Poly(COS_HIGH, y2);
+		}
+		else
+		{
+			sinOut = y * Poly(SIN_FAST, y2);
+			cosOut = cosSign * Poly(COS_FAST, y2);
+		}
+	}
+
+	constexpr inline void SinCosConstexpr(float rad, float& sinOut, float& cosOut)
+	{
+		constexpr double PI_D = 3.14159265358979323846;
+		constexpr double PI2_D = PI_D * 2.0;
+
+		// Reduce to [-PI, PI] in double, then Taylor series (error < 1e-12 there)
+		const double r = static_cast<double>(rad);
+		const double quotient = static_cast<double>(static_cast<long long>(r / PI2_D + (r >= 0.0 ? 0.5 : -0.5)));
+		const double y = r - quotient * PI2_D;
+		const double y2 = y * y;
+
+		double sinTerm = y, sinSum = y;
+		double cosTerm = 1.0, cosSum = 1.0;
+		for (int n = 1; n <= 12; ++n)
+		{
+			sinTerm *= -y2 / ((2.0 * n) * (2.0 * n + 1.0));
+			cosTerm *= -y2 / ((2.0 * n - 1.0) * (2.0 * n));
+			sinSum += sinTerm;
+			cosSum += cosTerm;
+		}
+
+		sinOut = static_cast<float>(sinSum);
+		cosOut = static_cast<float>(cosSum);
+	}
+
+	constexpr inline float SinConstexpr(float rad)
+	{
+		float s = 0.f, c = 0.f;
+		SinCosConstexpr(rad, s, c);
+		return s;
+	}
+
+	constexpr inline float CosConstexpr(float rad)
+	{
+		float s = 0.f, c = 0.f;
+		SinCosConstexpr(rad, s, c);
+		return c;
+	}
+
+	template <TrigAccuracy A>
+	inline float Sin(float rad)
+	{
+		if (A == TrigAccuracy::Exact)
+			return ExactTrig::Sin(rad);
+
+		float s, c;
+		SinCos<A>(rad, s, c);
+		return s;
+	}
+
+	template <TrigAccuracy A>
+	inline float Cos(float rad)
+	{
+		if (A == TrigAccuracy::Exact)
+			return ExactTrig::Cos(rad);
+
+		float s, c;
+		SinCos<A>(rad, s, c);
+		return c;
+	}
+
+	template <TrigAccuracy A>
+	inline float Acos(float x)
+	{
+		using namespace TrigCoeffs;
+
+		x = Math::Min(Math::Max(x, -1.f), 1.f);
+		if (A == TrigAccuracy::Exact)
+			return ExactTrig::Acos(x);
+
+		const float ax = fabsf(x);
+		const float p = (A == TrigAccuracy::High) ? Poly(ACOS_HIGH, ax) : Poly(ACOS_FAST, ax);
+		const float r = sqrtf(1.f - ax) * p;
+		return (x >= 0.f) ? r : PI_F - r;
+	}
+
+	template <TrigAccuracy A>
+	inline float Asin(float x)
+	{
+		x = Math::Min(Math::Max(x, -1.f), 1.f);
+		if (A == TrigAccuracy::Exact)
+			return ExactTrig::Asin(x);
+
+		// asin(|x|) = PI/2 - acos(|x|), then restore the sign
+		const float r = TrigCoeffs::PIOVER2_F - Acos<A>(fabsf(x));
+		return (x >= 0.f) ? r : -r;
+	}
+
+	template <TrigAccuracy A>
+	inline float Atan(float x)
+	{
+		return Atan2<A>(x, 1.f);
+	}
+
+	template <TrigAccuracy A>
+	inline float Atan2(float y, float x)
+	{
+		using namespace TrigCoeffs;
+
+		if (A == TrigAccuracy::Exact)
+			return ExactTrig::Atan2(y, x);
+
+		// atan of the smaller/larger ratio, which is in [0, 1], then fix up the octant
+		const float ax = fabsf(x), ay = fabsf(y);
+		const float maxXY = Math::Max(ax, ay);
+		if (maxXY == 0.f)
+			return 0.f;
+
+		const float z = Math::Min(ax, ay) / maxXY;
+		const float z2 = z * z;
+		float r = z * ((A == TrigAccuracy::High) ? Poly(ATAN_HIGH, z2) : Poly(ATAN_FAST, z2));
+
+		if (ay > ax)
+			r = PIOVER2_F - r;
+		if (x < 0.f)
+			r = PI_F - r;
+		return (y < 0.f) ? -r : r;
+	}
+
+} // namespace Math
+
+namespace SIMD
+{
+	/**
+	 * Lane versions of the Math trig functions, for kernels templated over
+	 * the lane type (SIMD::Wide or SIMD::Scalar). Same tiers and the same
+	 * polynomials as the scalar functions. Exact runs the scalar Exact tier per lane.
+	 */
+	template <Math::TrigAccuracy A, typename L>
+	inline void SinCos(L rad, L& sinOut, L& cosOut);
+
+	// Sine only. The Exact tier then skips the per-lane cosine
+	template <Math::TrigAccuracy A, typename L>
+	inline L Sin(L rad);
+
+	template <Math::TrigAccuracy A, typename L>
+	inline L Acos(L x);
+
+	template <Math::TrigAccuracy A, typename L>
+	inline L Atan2(L y, L x);
+
+	// ------------------------- TEMPLATE IMPLEMENTATIONS ---------------------
+
+	template <typename L, typename Fn>
+	inline L PerLane(L x, Fn fn)
+	{
+		float lanes[L::Width];
+		x.Store(lanes);
+		for (size_t k = 0; k < L::Width; ++k)
+			lanes[k] = fn(lanes[k]);
+		return L::Load(lanes);
+	}
+
+	template <Math::TrigAccuracy A, typename L>
+	inline void SinCos(L rad, L& sinOut, L& cosOut)
+	{
+		using namespace Math::TrigCoeffs;
+
+		if (A == Math::TrigAccuracy::Exact)
+		{
+			// One range reduction per lane for both outputs
+			float s[L::Width], c[L::Width];
+			rad.Store(s);
+			for (size_t k = 0; k < L::Width; ++k)
+				Math::ExactTrig::SinCos(s[k], s[k], c[k]);
+			sinOut = L::Load(s);
+			cosOut = L::Load(c);
+			return;
+		}
+
+		const L one = L::Set(1.f);
+		const L pi = L::Set(PI_F), halfPi = L::Set(PIOVER2_F);
+
+		const L quotient = Round(rad * L::Set(INV_PI2));
+		L y = (rad - quotient * L::Set(PI2_HI)) - quotient * L::Set(PI2_LO);
+
+		const L aboveHalf = CmpGT(y, halfPi);
+		const L belowHalf = CmpLT(y, -halfPi);
+		y = Select(aboveHalf, pi - y, Select(belowHalf, -pi - y, y));
+		const L cosSign = Select(Or(aboveHalf, belowHalf), -one, one);
+
+		const L y2 = y * y;
+		if (A == Math::TrigAccuracy::High)
+		{
+			sinOut = y * Poly(SIN_HIGH, y2);
+			cosOut = cosSign * Poly(COS_HIGH, y2);
+		}
+		else
+		{
+			sinOut = y * Poly(SIN_FAST, y2);
+			cosOut = cosSign * Poly(COS_FAST, y2);
+		}
+	}
+
+	template <Math::TrigAccuracy A, typename L>
+	inline L Sin(L rad)
+	{
+		if (A == Math::TrigAccuracy::Exact)
+			return PerLane(rad, [](float f) { return Math::ExactTrig::Sin(f); });
+
+		// The polynomial cosine is dead code once inlined
+		L s, c;
+		SinCos<A>(rad, s, c);
+		return s;
+	}
+
+	template <Math::TrigAccuracy A, typename L>
+	inline L Acos(L x)
+	{
+		using namespace Math::TrigCoeffs;
+
+		const L one = L::Set(1.f);
+		x = Min(Max(x, -one), one);
+		if (A == Math::TrigAccuracy::Exact)
+			return PerLane(x, [](float f) { return Math::ExactTrig::Acos(f); });
+
+		const L ax = Abs(x);
+		const L p = (A == Math::TrigAccuracy::High) ? Poly(ACOS_HIGH, ax) : Poly(ACOS_FAST, ax);
+		const L r = Sqrt(one - ax) * p;
+		return Select(CmpGE(x, L::Set(0.f)), r, L::Set(PI_F) - r);
+	}
+
+	template <Math::TrigAccuracy A, typename L>
+	inline L Atan2(L y, L x)
+	{
+		using namespace Math::TrigCoeffs;
+
+		if (A == Math::TrigAccuracy::Exact)
+		{
+			float ys[L::Width], xs[L::Width];
+			y.Store(ys);
+			x.Store(xs);
+			for (size_t k = 0; k < L::Width; ++k)
+				ys[k] = Math::ExactTrig::Atan2(ys[k], xs[k]);
+			return L::Load(ys);
+		}
+
+		const L zero = L::Set(0.f);
+		const L ax = Abs(x), ay = Abs(y);
+		const L maxXY = Max(ax, ay);
+
+		// 0 / 0 lanes are replaced below
+		const L z = Min(ax, ay) / Select(CmpGT(maxXY, zero), maxXY, L::Set(1.f));
+		const L z2 = z * z;
+		L r = z * ((A == Math::TrigAccuracy::High) ? Poly(ATAN_HIGH, z2) : Poly(ATAN_FAST, z2));
+
+		r = Select(CmpGT(ay, ax), L::Set(PIOVER2_F) - r, r);
+		r = Select(CmpLT(x, zero), L::Set(PI_F) - r, r);
+		return Select(CmpLT(y, zero), -r, r);
+	}
+
+} // namespace SIMD
+} // namespace SNova
\ No newline at end of file
@@ -0,0 +1,296 @@
+/******************************************************************************/
+/*!
+\file		Fixed.h
+\author		Justin Leow
+\brief
+	Q16.16 fixed-point number, for simulation that must give bit-identical
+	results on every machine (lockstep multiplayer, replays).
+
+	Every operation is integer arithmetic, including Sqrt, SinCos and
+	Atan2 below, so results do not depend on the compiler, the FPU mode or
+	the SIMD backend. Range is [-32768, 32768) with a step of 1/65536
+	(~1.5e-5). Overflow wraps modulo 2^32 (the arithmetic is done in
+	uint32_t, so wrapping is well defined); nothing saturates. Products and
+	quotients are rounded to the nearest step. Floats and doubles converted
+	in must be inside the range.
+
+	Convert from float only where the input is already the same on every
+	machine (e.g. level data), and to float only for presentation.
+
+	Used as the scalar of the TVector3 / TQuat templates (see MathTypes.h).
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include <cstdint>
+
+namespace SNova
+{
+
+class Fixed
+{
+	/////////////////////////////////////////////////////
+	// Constants
+public:
+	static constexpr int FRACTION_BITS = 16;
+	static constexpr int32_t ONE_RAW = int32_t{ 1 } << FRACTION_BITS;
+
+	/////////////////////////////////////////////////////
+	// Data Members
+private:
+	int32_t m_Raw = 0;
+
+	/////////////////////////////////////////////////////
+	// Constructors
+public:
+	constexpr Fixed() = default;
+	constexpr Fixed(int value) : m_Raw{ Wrap(static_cast<uint32_t>(value) << FRACTION_BITS) } {}
+
+	// Rounded to the nearest step
+	constexpr explicit Fixed(float value) : m_Raw{ RoundToRaw(static_cast<double>(value)) } {}
+	constexpr explicit Fixed(double value) : m_Raw{ RoundToRaw(value) } {}
+
+	static constexpr Fixed FromRaw(int32_t raw)
+	{
+		Fixed f;
+		f.m_Raw = raw;
+		return f;
+	}
+
+	/////////////////////////////////////////////////////
+	// Member Functions
+public:
+	constexpr int32_t Raw() const { return m_Raw; }
+	constexpr float ToFloat() const { return static_cast<float>(m_Raw) / ONE_RAW; }
+	constexpr double ToDouble() const { return static_cast<double>(m_Raw) / ONE_RAW; }
+	constexpr explicit operator float() const { return ToFloat(); }
+	constexpr explicit operator double() const { return ToDouble(); }
+
+	constexpr Fixed operator-() const { return FromRaw(Wrap(0u - static_cast<uint32_t>(m_Raw))); }
+	constexpr Fixed operator+(Fixed rhs) const { return FromRaw(Wrap(static_cast<uint32_t>(m_Raw) + static_cast<uint32_t>(rhs.m_Raw))); }
+	constexpr Fixed operator-(Fixed rhs) const { return FromRaw(Wrap(static_cast<uint32_t>(m_Raw) - static_cast<uint32_t>(rhs.m_Raw))); }
+
+	constexpr Fixed operator*(Fixed rhs) const
+	{
+		return FromRaw(Wrap(static_cast<uint32_t>(RoundShift(static_cast<int64_t>(m_Raw) * rhs.m_Raw, FRACTION_BITS))));
+	}
+
+	// Division by zero gives the largest value of the dividend's sign
+	constexpr Fixed operator/(Fixed rhs) const
+	{
+		if (rhs.m_Raw == 0)
+			return FromRaw(m_Raw >= 0 ? INT32_MAX : INT32_MIN);
+
+		// Round half away from zero
+		const int64_t num = static_cast<int64_t>(m_Raw) * ONE_RAW;
+		const int64_t den = rhs.m_Raw;
+		const int64_t half = (den < 0 ? -den : den) / 2;
+		return FromRaw(Wrap(static_cast<uint32_t>(((num < 0) == (den < 0) ? num + half : num - half) / den)));
+	}
+
+	constexpr Fixed& operator+=(Fixed rhs) { return *this = *this + rhs; }
+	constexpr Fixed& operator-=(Fixed rhs) { return *this = *this - rhs; }
+	constexpr Fixed& operator*=(Fixed rhs) { return *this = *this * rhs; }
+	constexpr Fixed& operator/=(Fixed rhs) { return *this = *this / rhs; }
+
+	constexpr bool operator==(Fixed rhs) const { return m_Raw == rhs.m_Raw; }
+	constexpr bool operator!=(Fixed rhs) const { return m_Raw != rhs.m_Raw; }
+	constexpr bool operator<(Fixed rhs) const { return m_Raw < rhs.m_Raw; }
+	constexpr bool operator<=(Fixed rhs) const { return m_Raw <= rhs.m_Raw; }
+	constexpr bool operator>(Fixed rhs) const { return m_Raw > rhs.m_Raw; }
+	constexpr bool operator>=(Fixed rhs) const { return m_Raw >= rhs.m_Raw; }
+
+	/////////////////////////////////////////////////////
+	// Math (integer only)
+
+	// 0 for negative inputs
+	static constexpr Fixed Sqrt(Fixed x);
+
+	/**
+	 * sqrt(x^2 + y^2 + z^2), with the squares summed in 64 bits so it works
+	 * for any components (x * x alone wraps once |x| passes ~181). Lengths
+	 * past the range give the largest value
+	 */
+	static constexpr Fixed Length(Fixed x, Fixed y, Fixed z);
+	static constexpr void SinCos(Fixed rad, Fixed& sinOut, Fixed& cosOut);
+
+	// In [-PI, PI]. Atan2(0, 0) == 0
+	static constexpr Fixed Atan2(Fixed y, Fixed x);
+
+private:
+	/////////////////////////////////////////////////////
+	// Helper Functions
+
+	// Work precision of SinCos / Atan2: Q2.30 in an int64
+	static constexpr int WORK_BITS = 30;
+
+	// Two's complement value of the low 32 bits, without relying on the
+	// out of range unsigned to signed conversion
+	static constexpr int32_t Wrap(uint32_t bits)
+	{
+		return bits <= static_cast<uint32_t>(INT32_MAX)
+			? static_cast<int32_t>(bits)
+			: -static_cast<int32_t>(~bits) - 1;
+	}
+
+	static constexpr int32_t RoundToRaw(double value)
+	{
+		const double scaled = value * ONE_RAW;
+		return static_cast<int32_t>(scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5);
+	}
+
+	// value / 2^bits, rounded to nearest. Division instead of >> so
+	// negative values are well defined
+	static constexpr int64_t RoundShift(int64_t value, int bits)
+	{
+		const int64_t divisor = int64_t{ 1 } << bits;
+		return (value >= 0 ? value + divisor / 2 : value - divisor / 2) / divisor;
+	}
+
+	static constexpr int64_t WorkConstant(double value)
+	{
+		const double scaled = value * static_cast<double>(int64_t{ 1 } << WORK_BITS);
+		return static_cast<int64_t>(scaled >= 0.0 ? scaled + 0.5 : scaled - 0.5);
+	}
+
+	static constexpr int64_t WorkMul(int64_t a, int64_t b)
+	{
+		return RoundShift(a * b, WORK_BITS);
+	}
+
+	static constexpr uint64_t IntegerSqrt(uint64_t n);
+};
+
+/////////////////////////////////////////////////////
+// Inline Implementations
+
+constexpr uint64_t Fixed::IntegerSqrt(uint64_t n)
+{
+	// Bit by bit, floor(sqrt(n))
+	uint64_t result = 0;
+	uint64_t bit = uint64_t{ 1 } << 62;
+	while (bit > n)
+		bit >>= 2;
+
+	while (bit != 0)
+	{
+		if (n >= result + bit)
+		{
+			n -= result + bit;
+			result = (result >> 1) + bit;
+		}
+		else
+		{
+			result >>= 1;
+		}
+		bit >>= 2;
+	}
+	return result;
+}
+
+constexpr Fixed Fixed::Sqrt(Fixed x)
+{
+	if (x.m_Raw <= 0)
+		return Fixed{};
+
+	// sqrt(raw / 2^16) * 2^16 = sqrt(raw * 2^16)
+	return FromRaw(static_cast<int32_t>(IntegerSqrt(static_cast<uint64_t>(x.m_Raw) << FRACTION_BITS)));
+}
+
+constexpr Fixed Fixed::Length(Fixed x, Fixed y, Fixed z)
+{
+	// Each |raw| <= 2^31, so the sum of squares is below 3 * 2^62
+	const int64_t rx = x.m_Raw, ry = y.m_Raw, rz = z.m_Raw;
+	const uint64_t sumSq = static_cast<uint64_t>(rx * rx) + static_cast<uint64_t>(ry * ry) + static_cast<uint64_t>(rz * rz);
+
+	// sqrt(sum(raw^2)) is already the length in raw units
+	const uint64_t length = IntegerSqrt(sumSq);
+	return FromRaw(length > static_cast<uint64_t>(INT32_MAX) ? INT32_MAX : static_cast<int32_t>(length));
+}
+
+constexpr void Fixed::SinCos(Fixed rad, Fixed& sinOut, Fixed& cosOut)
+{
+	constexpr int64_t PI_W = WorkConstant(3.14159265358979323846);
+	constexpr int64_t PI2_W = 2 * PI_W;
+	constexpr int64_t PIOVER2_W = PI_W / 2;
+
+	// To [-PI, PI]
+	int64_t r = static_cast<int64_t>(rad.m_Raw) * (int64_t{ 1 } << (WORK_BITS - FRACTION_BITS));
+	r %= PI2_W;
+	if (r > PI_W)
+		r -= PI2_W;
+	else if (r < -PI_W)
+		r += PI2_W;
+
+	// To [-PI/2, PI/2]: sin(PI - r) = sin(r), cos(PI - r) = -cos(r)
+	int64_t cosSign = 1;
+	if (r > PIOVER2_W)
+	{
+		r = PI_W - r;
+		cosSign = -1;
+	}
+	else if (r < -PIOVER2_W)
+	{
+		r = -PI_W - r;
+		cosSign = -1;
+	}
+
+	// Taylor series to r^11 / r^10, error < 1e-8 on [-PI/2, PI/2]
+	constexpr int64_t S3 = WorkConstant(-1.0 / 6.0), S5 = WorkConstant(1.0 / 120.0), S7 = WorkConstant(-1.0 / 5040.0),
+		S9 = WorkConstant(1.0 / 362880.0), S11 = WorkConstant(-1.0 / 39916800.0);
+	constexpr int64_t C2 = WorkConstant(-1.0 / 2.0), C4 = WorkConstant(1.0 / 24.0), C6 = WorkConstant(-1.0 / 720.0),
+		C8 = WorkConstant(1.0 / 40320.0), C10 = WorkConstant(-1.0 / 3628800.0);
+	constexpr int64_t ONE_W = int64_t{ 1 } << WORK_BITS;
+
+	const int64_t r2 = WorkMul(r, r);
+	const int64_t s = WorkMul(r, ONE_W + WorkMul(r2, S3 + WorkMul(r2, S5 + WorkMul(r2, S7 + WorkMul(r2, S9 + WorkMul(r2, S11))))));
+	const int64_t c = ONE_W + WorkMul(r2, C2 + WorkMul(r2, C4 + WorkMul(r2, C6 + WorkMul(r2, C8 + WorkMul(r2, C10)))));
+
+	sinOut = FromRaw(static_cast<int32_t>(RoundShift(s, WORK_BITS - FRACTION_BITS)));
+	cosOut = FromRaw(static_cast<int32_t>(RoundShift(cosSign * c, WORK_BITS - FRACTION_BITS)));
+}
+
+constexpr Fixed Fixed::Atan2(Fixed y, Fixed x)
+{
+	if (x.m_Raw == 0 && y.m_Raw == 0)
+		return Fixed{};
+
+	constexpr int64_t PI_W = WorkConstant(3.14159265358979323846);
+	constexpr int64_t PIOVER2_W = PI_W / 2;
+	constexpr int64_t ONE_W = int64_t{ 1 } << WORK_BITS;
+
+	// atan(t) for t = min / max in [0, 1], then undo the octant folding
+	const int64_t ax = x.m_Raw < 0 ? -static_cast<int64_t>(x.m_Raw) : x.m_Raw;
+	const int64_t ay = y.m_Raw < 0 ? -static_cast<int64_t>(y.m_Raw) : y.m_Raw;
+	const bool swap = ay > ax;
+	const int64_t num = swap ? ax : ay;
+	const int64_t den = swap ? ay : ax;
+	const int64_t t = (num * ONE_W + den / 2) / den;
+
+	// Minimax polynomial in t^2, error < 2e-8 on [0, 1]
+	// (the coefficients of ATAN_HIGH in FastTrig.h)
+	constexpr int64_t A[9] = {
+		WorkConstant(1.0), WorkConstant(-0.3333314528), WorkConstant(0.1999355085), WorkConstant(-0.1420889944),
+		WorkConstant(0.1065626393), WorkConstant(-0.0752896400), WorkConstant(0.0429096138), WorkConstant(-0.0161657367),
+		WorkConstant(0.0028662257) };
+	const int64_t t2 = WorkMul(t, t);
+	int64_t p = A[8];
+	for (int i = 7; i >= 0; --i)
+		p = A[i] + WorkMul(t2, p);
+	int64_t angle = WorkMul(t, p);
+
+	if (swap)
+		angle = PIOVER2_W - angle;
+	if (x.m_Raw < 0)
+		angle = PI_W - angle;
+	if (y.m_Raw < 0)
+		angle = -angle;
+
+	return FromRaw(static_cast<int32_t>(RoundShift(angle, WORK_BITS - FRACTION_BITS)));
+}
+
+} // namespace SNova
\ No newline at end of file
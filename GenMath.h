@@ -7,6 +7,7 @@
 
 #include <sstream>
 #include <iomanip>
+#include <cfloat>
 
 namespace SNova
 {
@@ -36,6 +37,78 @@ namespace SNova
 
 	#define ENABLE_NAN_CHECK 0
 
+	// Per-thread counters/timers of the expensive calls (see Instrumentation.h).
+	// 0 = compiled out, 1 = counts, 2 = counts and times
+	#ifndef SNOVA_INSTRUMENTATION
+		#define SNOVA_INSTRUMENTATION 0
+	#endif
+
+	// Default accuracy of Math::SinCos and the other FastTrig.h functions.
+	// 0 = C library, 1 = polynomials good to ~1e-6, 2 = polynomials good to ~1e-4
+	#ifndef SNOVA_TRIG_ACCURACY
+		#define SNOVA_TRIG_ACCURACY 0
+	#endif
+
+	// Bit-identical results on every platform and SIMD backend, for lockstep
+	// simulation (see DeterministicMath.h). 0 = off, 1 = on
+	#ifndef SNOVA_DETERMINISTIC_MATH
+		#define SNOVA_DETERMINISTIC_MATH 0
+	#endif
+
+	#if SNOVA_DETERMINISTIC_MATH
+		#if defined(__FAST_MATH__) || defined(_M_FP_FAST)
+			#error "SNOVA_DETERMINISTIC_MATH: fast-math reorders float operations"
+		#endif
+		#if (defined(__i386__) && !defined(__SSE2_MATH__)) || (defined(_M_IX86) && (!defined(_M_IX86_FP) || _M_IX86_FP < 2))
+			#error "SNOVA_DETERMINISTIC_MATH: x87 keeps 80-bit intermediates, build with SSE2 math (-mfpmath=sse, /arch:SSE2)"
+		#endif
+
+		// FMA policy: never fuse a * b + c, whether or not the target has FMA
+		#if defined(_M_FP_CONTRACT)
+			#error "SNOVA_DETERMINISTIC_MATH: /fp:contract fuses a * b + c"
+		#elif defined(__clang__)
+			#pragma STDC FP_CONTRACT OFF
+		#elif defined(_MSC_VER)
+			#pragma fp_contract(off)
+		#elif defined(__GNUC__)
+			// GCC has no pragma for it and fuses by default (-ffp-contract=fast). On FMA
+			// targets its SLP vectorizer also emits vfmaddsub even with -ffp-contract=off
+			// (GCC 12). Neither flag is visible to the preprocessor, so the build
+			// confirms each with a define
+			#if !defined(SNOVA_FP_CONTRACT_OFF)
+				#error "SNOVA_DETERMINISTIC_MATH: build with -ffp-contract=off, then define SNOVA_FP_CONTRACT_OFF"
+			#endif
+			#if !defined(SNOVA_NO_SLP_VECTORIZE)
+				#error "SNOVA_DETERMINISTIC_MATH: build with -fno-tree-slp-vectorize, then define SNOVA_NO_SLP_VECTORIZE"
+			#endif
+		#endif
+	#endif
+
+	// SIMD backend for the batch kernels (see SIMD.h), picked from the compiler's
+	// target flags. Define SNOVA_FORCE_SCALAR to use the plain C++ fallback.
+	// The deterministic mode needs exact vector divide and sqrt, so NEON is AArch64 only there.
+	#if defined(SNOVA_FORCE_SCALAR)
+		#define SNOVA_SIMD_AVX2 0
+		#define SNOVA_SIMD_SSE 0
+		#define SNOVA_SIMD_NEON 0
+	#elif defined(__AVX2__)
+		#define SNOVA_SIMD_AVX2 1
+		#define SNOVA_SIMD_SSE 0
+		#define SNOVA_SIMD_NEON 0
+	#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define SNOVA_SIMD_AVX2 0
+		#define SNOVA_SIMD_SSE 1
+		#define SNOVA_SIMD_NEON 0
+	#elif (defined(__ARM_NEON) || defined(_M_ARM64)) && (!SNOVA_DETERMINISTIC_MATH || defined(__aarch64__) || defined(_M_ARM64))
+		#define SNOVA_SIMD_AVX2 0
+		#define SNOVA_SIMD_SSE 0
+		#define SNOVA_SIMD_NEON 1
+	#else
+		#define SNOVA_SIMD_AVX2 0
+		#define SNOVA_SIMD_SSE 0
+		#define SNOVA_SIMD_NEON 0
+	#endif
+
 	/*-----------------------------------------------------------------------------
 	Floating point constants.
 	-----------------------------------------------------------------------------*/
@@ -103,11 +176,12 @@ namespace SNova
 	namespace Math
 	{
 
-		inline bool IsFinite(float x) { return _finitef(x) != 0; }
-		inline bool IsNaN(float x) { return _isnanf(x) != 0; }
+		// Plain comparisons so they also work in constant expressions
+		constexpr inline bool IsNaN(float x) { return x != x; }
+		constexpr inline bool IsFinite(float x) { return x >= -FLT_MAX && x <= FLT_MAX; }
 
-		inline void SinCos(float rad, float& sinOut, float& cosOut);
-		inline bool FloatEqual(float x, float y, float tolerance = KINDA_SMALL_NUMBER);
+		// SinCos, Sin, Cos, Acos, Asin, Atan, Atan2 are in FastTrig.h
+		constexpr inline bool FloatEqual(float x, float y, float tolerance = KINDA_SMALL_NUMBER);
 
 		// Fast Inverse Square Root
 		inline float InvSqrt(float num);
@@ -121,17 +195,14 @@ namespace SNova
 		template <typename T>
 		constexpr inline T Min(const T A, const T B){ return (A <= B) ? A : B; }
 
-		// ------------------------- INLINE / TEMPLATE IMPLEMENTATIONS ---------------------
+		template <typename T>
+		constexpr inline T Abs(const T A) { return (A < T(0)) ? -A : A; }
 
-		inline void SinCos(float rad, float& sinOut, float& cosOut)
-		{
-			sinOut = sinf(rad);
-			cosOut = cosf(rad);
-		}
+		// ------------------------- INLINE / TEMPLATE IMPLEMENTATIONS ---------------------
 
-		inline bool FloatEqual(float x, float y, float tolerance)
+		constexpr inline bool FloatEqual(float x, float y, float tolerance)
 		{
-			return fabs(x - y) < tolerance;
+			return Abs(x - y) < tolerance;
 		}
 
 		inline float InvSqrt(float num)
@@ -158,4 +229,6 @@ namespace SNova
 		}
 
 	}
-}
\ No newline at end of file
+}
+
+#include "FastTrig.h"
\ No newline at end of file
@@ -0,0 +1,138 @@
+/******************************************************************************/
+/*!
+\file		Instrumentation.cpp
+\author		Justin Leow
+\brief
+	Registry of the per-thread counters. See Instrumentation.h.
+
+	Threads add their counters to a list the first time they record, and
+	fold them into a running total when they exit, so TakeTotalSnapshot
+	also covers worker threads that are gone. Both take a mutex; recording
+	never does.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "SNova.h"
+#include "Instrumentation.h"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace SNova
+{
+namespace Instrumentation
+{
+
+namespace
+{
+	struct Registry
+	{
+		std::mutex mutex;
+		std::vector<const ThreadCounters*> live;
+		Snapshot exited;
+	};
+
+	// Never destroyed, so threads exiting during shutdown can still unregister
+	Registry& GetRegistry()
+	{
+		static Registry* registry = new Registry;
+		return *registry;
+	}
+
+	void AddTo(Snapshot& total, const ThreadCounters& counters)
+	{
+		for (unsigned i = 0; i < COUNTER_COUNT; ++i)
+		{
+			total.calls[i] += counters.calls[i].load(std::memory_order_relaxed);
+			total.nanoseconds[i] += counters.nanoseconds[i].load(std::memory_order_relaxed);
+		}
+	}
+}
+
+const char* GetName(Counter counter)
+{
+	static const char* const NAMES[COUNTER_COUNT] = {
+		"Quat::GetRotator",
+		"Rotator::Quaternion",
+		"Rotator::Matrix",
+		"Transform::UpdateMtx",
+		"Transform::Notify",
+		"DiagnosticCheckNaN hit"
+	};
+	return (counter < COUNTER_COUNT) ? NAMES[counter] : "";
+}
+
+Snapshot operator-(const Snapshot& lhs, const Snapshot& rhs)
+{
+	Snapshot result;
+	for (unsigned i = 0; i < COUNTER_COUNT; ++i)
+	{
+		result.calls[i] = lhs.calls[i] - rhs.calls[i];
+		result.nanoseconds[i] = lhs.nanoseconds[i] - rhs.nanoseconds[i];
+	}
+	return result;
+}
+
+ThreadCounters::ThreadCounters()
+{
+	for (unsigned i = 0; i < COUNTER_COUNT; ++i)
+	{
+		calls[i].store(0, std::memory_order_relaxed);
+		nanoseconds[i].store(0, std::memory_order_relaxed);
+	}
+
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock{ registry.mutex };
+	registry.live.push_back(this);
+}
+
+ThreadCounters::~ThreadCounters()
+{
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock{ registry.mutex };
+	AddTo(registry.exited, *this);
+	registry.live.erase(std::remove(registry.live.begin(), registry.live.end(), this), registry.live.end());
+}
+
+Snapshot TakeThreadSnapshot()
+{
+	Snapshot result;
+#if SNOVA_INSTRUMENTATION
+	AddTo(result, LocalCounters());
+#endif
+	return result;
+}
+
+Snapshot TakeTotalSnapshot()
+{
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock{ registry.mutex };
+
+	Snapshot result = registry.exited;
+	for (const ThreadCounters* counters : registry.live)
+		AddTo(result, *counters);
+	return result;
+}
+
+void ResetThread()
+{
+#if SNOVA_INSTRUMENTATION
+	// The total keeps what was recorded up to now
+	ThreadCounters& counters = LocalCounters();
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock{ registry.mutex };
+	AddTo(registry.exited, counters);
+	for (unsigned i = 0; i < COUNTER_COUNT; ++i)
+	{
+		counters.calls[i].store(0, std::memory_order_relaxed);
+		counters.nanoseconds[i].store(0, std::memory_order_relaxed);
+	}
+#endif
+}
+
+} // namespace Instrumentation
+} // namespace SNova
\ No newline at end of file
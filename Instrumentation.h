@@ -0,0 +1,154 @@
+/******************************************************************************/
+/*!
+\file		Instrumentation.h
+\author		Justin Leow
+\brief
+	Opt-in counters (and timers) for the library's expensive calls, to find
+	accidental Euler round trips and matrix rebuilds in a running game.
+
+	Compiled out unless SNOVA_INSTRUMENTATION is set (see GenMath.h):
+		0 - nothing is recorded, the macros below are empty (default)
+		1 - calls are counted
+		2 - calls are counted and timed (steady_clock, two reads per call)
+
+	Each thread records into its own counters without locks or atomic
+	read-modify-writes. The snapshot functions below can be called from
+	any thread (e.g. the frame profiler's) at any time:
+		Instrumentation::Snapshot before = Instrumentation::TakeTotalSnapshot();
+		... frame ...
+		Instrumentation::Snapshot frame = Instrumentation::TakeTotalSnapshot() - before;
+		graph(frame.calls[Instrumentation::QUAT_GET_ROTATOR]);
+
+	The API stays available when compiled out; snapshots are then all 0.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "GenMath.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace SNova
+{
+namespace Instrumentation
+{
+	enum Counter : unsigned
+	{
+		QUAT_GET_ROTATOR,		// Quat::GetRotator (3 inverse trig calls)
+		ROTATOR_QUATERNION,		// Rotator::Quaternion (6 sin/cos)
+		ROTATOR_MATRIX,			// Rotator::Matrix (6 sin/cos)
+		TRANSFORM_UPDATE_MTX,	// Transform::UpdateMtx
+		TRANSFORM_NOTIFY,		// Subject::Notify from Transform::Flush
+		NAN_CHECK_HIT,			// DiagnosticCheckNaN found a NaN (needs ENABLE_NAN_CHECK)
+
+		COUNTER_COUNT
+	};
+
+	// Display name of a counter, e.g. "Quat::GetRotator"
+	const char* GetName(Counter counter);
+
+	struct Snapshot
+	{
+		uint64_t calls[COUNTER_COUNT] = {};
+
+		// Time spent inside the calls. Only recorded with SNOVA_INSTRUMENTATION 2
+		uint64_t nanoseconds[COUNTER_COUNT] = {};
+	};
+
+	// Element-wise difference, for the counts over a frame
+	Snapshot operator-(const Snapshot& lhs, const Snapshot& rhs);
+
+	// Counters of the calling thread
+	Snapshot TakeThreadSnapshot();
+
+	// Counters of every thread, including ones that have exited
+	Snapshot TakeTotalSnapshot();
+
+	// Zero the calling thread's counters. Other threads keep theirs, so
+	// prefer differencing snapshots when more than one thread records
+	void ResetThread();
+
+	/////////////////////////////////////////////////////
+	// Recording (use the macros below rather than these)
+
+	// One thread's counters. Only that thread writes them; others may read
+	struct ThreadCounters
+	{
+		std::atomic<uint64_t> calls[COUNTER_COUNT];
+		std::atomic<uint64_t> nanoseconds[COUNTER_COUNT];
+
+		ThreadCounters();
+		~ThreadCounters();
+		ThreadCounters(const ThreadCounters&) = delete;
+		ThreadCounters& operator=(const ThreadCounters&) = delete;
+	};
+
+	inline ThreadCounters& LocalCounters()
+	{
+		thread_local ThreadCounters counters;
+		return counters;
+	}
+
+	// Single writer, so a relaxed load and store is enough (no lock prefix)
+	inline void Add(std::atomic<uint64_t>& value, uint64_t amount)
+	{
+		value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	inline void Count(Counter counter)
+	{
+		Add(LocalCounters().calls[counter], 1);
+	}
+
+	// Counts on construction, adds the elapsed time on destruction
+	class ScopedTimer
+	{
+	public:
+		explicit ScopedTimer(Counter counter)
+			: m_Counter{ counter }, m_Start{ std::chrono::steady_clock::now() }
+		{
+			Count(counter);
+		}
+
+		~ScopedTimer()
+		{
+			const auto elapsed = std::chrono::steady_clock::now() - m_Start;
+			Add(LocalCounters().nanoseconds[m_Counter],
+				static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+		}
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	private:
+		Counter m_Counter;
+		std::chrono::steady_clock::time_point m_Start;
+	};
+
+} // namespace Instrumentation
+} // namespace SNova
+
+/**
+ * SNOVA_INSTRUMENT_SCOPE(QUAT_GET_ROTATOR) - at the top of a function: count
+ *     the call, and time the rest of the scope with SNOVA_INSTRUMENTATION 2.
+ * SNOVA_INSTRUMENT_EVENT(NAN_CHECK_HIT) - count only.
+ */
+#define SNOVA_INSTRUMENT_CONCAT_(a, b) a##b
+#define SNOVA_INSTRUMENT_CONCAT(a, b) SNOVA_INSTRUMENT_CONCAT_(a, b)
+
+#if SNOVA_INSTRUMENTATION >= 2
+	#define SNOVA_INSTRUMENT_SCOPE(counter) \
+		const ::SNova::Instrumentation::ScopedTimer SNOVA_INSTRUMENT_CONCAT(snovaInstrumentTimer, __LINE__){ ::SNova::Instrumentation::counter }
+	#define SNOVA_INSTRUMENT_EVENT(counter) ::SNova::Instrumentation::Count(::SNova::Instrumentation::counter)
+#elif SNOVA_INSTRUMENTATION
+	#define SNOVA_INSTRUMENT_SCOPE(counter) ::SNova::Instrumentation::Count(::SNova::Instrumentation::counter)
+	#define SNOVA_INSTRUMENT_EVENT(counter) ::SNova::Instrumentation::Count(::SNova::Instrumentation::counter)
+#else
+	#define SNOVA_INSTRUMENT_SCOPE(counter) ((void)0)
+	#define SNOVA_INSTRUMENT_EVENT(counter) ((void)0)
+#endif
\ No newline at end of file
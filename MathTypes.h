@@ -0,0 +1,400 @@
+/******************************************************************************/
+/*!
+\file		MathTypes.h
+\author		Justin Leow
+\brief
+	Vector, quaternion and rotation matrix templated on the scalar type,
+	for the scalars the float engine types do not cover:
+		Vec3d / QuatD / Mtx33d       - double, e.g. large-world server positions
+		Vec3x / QuatX / Mtx33x       - Fixed (Fixed.h), bit-identical lockstep simulation
+
+	Float stays in Vector3D, Quat, QuatValue, Rotator and Matrix3x3; these
+	templates are not instantiated for float and the float types do not
+	forward to them. The quaternion steps are the same as Quat's (product,
+	RotateVector, Slerp), so a change to one must be made to the other.
+	Any type with + - * /, comparisons, construction from int, float and
+	double, and a ScalarMath specialization works as a scalar.
+
+	Convert with the explicit TVector3(Vector3D) constructor and
+	ToVector3D(), and with Quat(TQuat) and QuatX{ q } for a Quat q. TQuat
+	uses the same conventions as Quat, including the axis remapping of the
+	axis-angle constructor, so conversions round trip.
+
+	Fixed vectors: every sum wraps (Fixed.h), so results only need to end
+	up inside [-32768, 32768). Magnitude, Normalize, RotateVector and
+	matrix * vector work for any vector in that range. Dot products,
+	cross products and MagnitudeSq multiply two vectors and wrap once the
+	product passes 32768, e.g. MagnitudeSq above a magnitude of ~181.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "GenMath.h"
+#include "Fixed.h"
+#include "Vector3D.h"
+#include <cmath>
+
+namespace SNova
+{
+
+/////////////////////////////////////////////////////
+// Scalar functions
+
+// The functions the templates need, per scalar type
+template <typename T>
+struct ScalarMath;
+
+template <>
+struct ScalarMath<double>
+{
+	static constexpr double SmallNumber() { return 1.e-16; }
+	static inline double Sqrt(double x) { return std::sqrt(x); }
+	static inline double InvSqrt(double x) { return 1.0 / std::sqrt(x); }
+#if SNOVA_DETERMINISTIC_MATH
+	static inline void SinCos(double rad, double& s, double& c) { Math::Deterministic::SinCos(rad, s, c); }
+	static inline double Sin(double rad) { return Math::Deterministic::Sin(rad); }
+	static inline double Acos(double x) { return Math::Deterministic::Acos(x); }
+	static inline double Atan2(double y, double x) { return Math::Deterministic::Atan2(y, x); }
+#else
+	static inline void SinCos(double rad, double& s, double& c) { s = std::sin(rad); c = std::cos(rad); }
+	static inline double Sin(double rad) { return std::sin(rad); }
+	static inline double Acos(double x) { return std::acos(Math::Min(Math::Max(x, -1.0), 1.0)); }
+	static inline double Atan2(double y, double x) { return std::atan2(y, x); }
+#endif
+};
+
+template <>
+struct ScalarMath<Fixed>
+{
+	static constexpr Fixed SmallNumber() { return Fixed::FromRaw(1); }
+	static constexpr Fixed Sqrt(Fixed x) { return Fixed::Sqrt(x); }
+	static constexpr Fixed InvSqrt(Fixed x) { return Fixed{ 1 } / Fixed::Sqrt(x); }
+	static constexpr void SinCos(Fixed rad, Fixed& s, Fixed& c) { Fixed::SinCos(rad, s, c); }
+	static constexpr Fixed Sin(Fixed rad) { Fixed s, c; Fixed::SinCos(rad, s, c); return s; }
+	static constexpr Fixed Atan2(Fixed y, Fixed x) { return Fixed::Atan2(y, x); }
+
+	// Input clamped to [-1, 1]
+	static constexpr Fixed Acos(Fixed x)
+	{
+		const Fixed one{ 1 };
+		const Fixed c = (x > one) ? one : ((x < -one) ? -one : x);
+		return Fixed::Atan2(Fixed::Sqrt(one - c * c), c);
+	}
+};
+
+/////////////////////////////////////////////////////
+// Vector length
+
+// sqrt(x^2 + y^2 + z^2)
+template <typename T>
+inline T Length3(T x, T y, T z)
+{
+	return ScalarMath<T>::Sqrt(x * x + y * y + z * z);
+}
+
+// Scale (x, y, z) to unit length. Left unchanged if about zero
+template <typename T>
+inline void Normalize3(T& x, T& y, T& z, T tolerance)
+{
+	const T lengthSq = x * x + y * y + z * z;
+	if (lengthSq > tolerance)
+	{
+		const T scale = ScalarMath<T>::InvSqrt(lengthSq);
+		x *= scale;
+		y *= scale;
+		z *= scale;
+	}
+}
+
+// Fixed squares wrap past ~181, so these take the length from the raw
+// values in 64 bits and divide by it
+inline Fixed Length3(Fixed x, Fixed y, Fixed z)
+{
+	return Fixed::Length(x, y, z);
+}
+
+inline void Normalize3(Fixed& x, Fixed& y, Fixed& z, Fixed tolerance)
+{
+	const Fixed length = Fixed::Length(x, y, z);
+	if (length > tolerance)
+	{
+		x /= length;
+		y /= length;
+		z /= length;
+	}
+}
+
+/////////////////////////////////////////////////////
+// Vector
+
+template <typename T>
+struct TVector3
+{
+	T x, y, z;
+
+	constexpr TVector3() : x{}, y{}, z{} {}
+	constexpr TVector3(T _x, T _y, T _z) : x(_x), y(_y), z(_z) {}
+
+	// From / to the engine's float vector
+	constexpr explicit TVector3(const Vector3D& v) : x(T(v.x)), y(T(v.y)), z(T(v.z)) {}
+	constexpr Vector3D ToVector3D() const { return Vector3D{ static_cast<float>(x), static_cast<float>(y), static_cast<float>(z) }; }
+
+	// From another scalar type
+	template <typename U>
+	constexpr explicit TVector3(const TVector3<U>& v) : x(T(v.x)), y(T(v.y)), z(T(v.z)) {}
+
+	constexpr TVector3 operator-() const { return TVector3{ -x, -y, -z }; }
+	constexpr TVector3 operator+(const TVector3& rhs) const { return TVector3{ x + rhs.x, y + rhs.y, z + rhs.z }; }
+	constexpr TVector3 operator-(const TVector3& rhs) const { return TVector3{ x - rhs.x, y - rhs.y, z - rhs.z }; }
+	constexpr TVector3 operator*(T rhs) const { return TVector3{ x * rhs, y * rhs, z * rhs }; }
+	constexpr TVector3 operator/(T rhs) const { return TVector3{ x / rhs, y / rhs, z / rhs }; }
+	constexpr TVector3& operator+=(const TVector3& rhs) { return *this = *this + rhs; }
+	constexpr TVector3& operator-=(const TVector3& rhs) { return *this = *this - rhs; }
+	constexpr TVector3& operator*=(T rhs) { return *this = *this * rhs; }
+	constexpr TVector3& operator/=(T rhs) { return *this = *this / rhs; }
+	constexpr bool operator==(const TVector3& rhs) const { return x == rhs.x && y == rhs.y && z == rhs.z; }
+	constexpr bool operator!=(const TVector3& rhs) const { return !(*this == rhs); }
+
+	// Dot Product
+	constexpr T operator*(const TVector3& rhs) const { return x * rhs.x + y * rhs.y + z * rhs.z; }
+
+	// Cross Product
+	constexpr TVector3 operator^(const TVector3& rhs) const
+	{
+		return TVector3{ y * rhs.z - z * rhs.y, z * rhs.x - x * rhs.z, x * rhs.y - y * rhs.x };
+	}
+
+	constexpr T MagnitudeSq() const { return *this * *this; }
+	inline T Magnitude() const { return Length3(x, y, z); }
+
+	// Zero vectors stay zero
+	inline void Normalize()
+	{
+		Normalize3(x, y, z, ScalarMath<T>::SmallNumber());
+	}
+
+	inline TVector3 Normalized() const
+	{
+		TVector3 r{ *this };
+		r.Normalize();
+		return r;
+	}
+};
+
+template <typename T>
+constexpr TVector3<T> operator*(T lhs, const TVector3<T>& rhs)
+{
+	return rhs * lhs;
+}
+
+/////////////////////////////////////////////////////
+// Rotation matrix
+
+// Row-major 3x3, applied to column vectors: (M * v)[r] = Dot(row r, v)
+template <typename T>
+struct TMatrix3
+{
+	T m[3][3];
+
+	static constexpr TMatrix3 Identity()
+	{
+		return TMatrix3{ { { T(1), T(0), T(0) }, { T(0), T(1), T(0) }, { T(0), T(0), T(1) } } };
+	}
+
+	constexpr TVector3<T> operator*(const TVector3<T>& v) const
+	{
+		return TVector3<T>{
+			m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+			m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+			m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z };
+	}
+
+	constexpr TMatrix3 operator*(const TMatrix3& rhs) const
+	{
+		TMatrix3 r{};
+		for (int i = 0; i < 3; ++i)
+		{
+			for (int j = 0; j < 3; ++j)
+				r.m[i][j] = m[i][0] * rhs.m[0][j] + m[i][1] * rhs.m[1][j] + m[i][2] * rhs.m[2][j];
+		}
+		return r;
+	}
+
+	// The inverse, for rotation matrices
+	constexpr TMatrix3 Transposed() const
+	{
+		TMatrix3 r{};
+		for (int i = 0; i < 3; ++i)
+		{
+			for (int j = 0; j < 3; ++j)
+				r.m[i][j] = m[j][i];
+		}
+		return r;
+	}
+};
+
+/////////////////////////////////////////////////////
+// Quaternion
+
+template <typename T>
+struct TQuat
+{
+	typedef TVector3<T> Vector;
+
+	T w, x, y, z;
+
+	// Identity
+	constexpr TQuat() : w(T(1)), x(T(0)), y(T(0)), z(T(0)) {}
+	constexpr TQuat(T _w, T _x, T _y, T _z) : w(_w), x(_x), y(_y), z(_z) {}
+
+	// Same as Quat(Axis, AngleRad). Axis must be normalized
+	TQuat(const Vector& axis, T angleRad)
+	{
+		T s, c;
+		ScalarMath<T>::SinCos(T(0.5) * angleRad, s, c);
+		x = s * -axis.z;
+		y = s * -axis.x;
+		z = s * axis.y;
+		w = c;
+	}
+
+	// From another scalar type. From / to Quat: QuatX{ q } and Quat(TQuat)
+	template <typename U>
+	constexpr explicit TQuat(const TQuat<U>& q) : w(T(q.w)), x(T(q.x)), y(T(q.y)), z(T(q.z)) {}
+
+	// Hamilton Product
+	constexpr TQuat operator*(const TQuat& q) const
+	{
+		return TQuat{
+			w * q.w - x * q.x - y * q.y - z * q.z,
+			w * q.x + x * q.w + y * q.z - z * q.y,
+			w * q.y - x * q.z + y * q.w + z * q.x,
+			w * q.z + x * q.y - y * q.x + z * q.w };
+	}
+
+	constexpr TQuat& operator*=(const TQuat& q) { return *this = *this * q; }
+	constexpr bool operator==(const TQuat& q) const { return w == q.w && x == q.x && y == q.y && z == q.z; }
+	constexpr bool operator!=(const TQuat& q) const { return !(*this == q); }
+
+	// Dot Product
+	constexpr T operator|(const TQuat& q) const { return w * q.w + x * q.x + y * q.y + z * q.z; }
+
+	constexpr T SizeSquared() const { return *this | *this; }
+	inline T Size() const { return ScalarMath<T>::Sqrt(SizeSquared()); }
+
+	// Inverse rotation of a normalized quaternion
+	constexpr TQuat Conjugate() const { return TQuat{ w, -x, -y, -z }; }
+
+	// Identity if too small to normalize
+	inline void Normalize(T tolerance = ScalarMath<T>::SmallNumber())
+	{
+		const T squareSum = SizeSquared();
+		if (squareSum >= tolerance)
+		{
+			const T scale = ScalarMath<T>::InvSqrt(squareSum);
+			w *= scale;
+			x *= scale;
+			y *= scale;
+			z *= scale;
+		}
+		else
+		{
+			*this = TQuat{};
+		}
+	}
+
+	inline TQuat GetNormalized(T tolerance = ScalarMath<T>::SmallNumber()) const
+	{
+		TQuat r{ *this };
+		r.Normalize(tolerance);
+		return r;
+	}
+
+	/**
+	 * V' = V + 2w(Q x V) + 2(Q x (Q x V)), see Quat::RotateVector. The
+	 * doubling comes last so no step is larger than |V| (what keeps Fixed
+	 * vectors in range)
+	 */
+	constexpr Vector RotateVector(const Vector& v) const
+	{
+		const Vector q{ x, y, z };
+		const Vector t = q ^ v;
+		return v + (t * w) * T(2) + (q ^ t) * T(2);
+	}
+
+	constexpr Vector UnrotateVector(const Vector& v) const
+	{
+		return Conjugate().RotateVector(v);
+	}
+
+	// M * v == RotateVector(v) for normalized quaternions
+	constexpr TMatrix3<T> ToMatrix() const
+	{
+		const T two = T(2);
+		return TMatrix3<T>{ {
+			{ T(1) - two * (y * y + z * z), two * (x * y - w * z), two * (x * z + w * y) },
+			{ two * (x * y + w * z), T(1) - two * (x * x + z * z), two * (y * z - w * x) },
+			{ two * (x * z - w * y), two * (y * z + w * x), T(1) - two * (x * x + y * y) } } };
+	}
+
+	// Normalized lerp along the shorter arc
+	static inline TQuat Nlerp(const TQuat& a, const TQuat& b, T t)
+	{
+		const T sign = ((a | b) >= T(0)) ? T(1) : T(-1);
+		const T s0 = T(1) - t, s1 = sign * t;
+		return TQuat{ s0 * a.w + s1 * b.w, s0 * a.x + s1 * b.x, s0 * a.y + s1 * b.y, s0 * a.z + s1 * b.z }.GetNormalized();
+	}
+
+	// Same steps as Quat::Slerp_NotNormalized. Inputs must be normalized
+	static inline TQuat Slerp_NotNormalized(const TQuat& a, const TQuat& b, T t)
+	{
+		// Align quats so they take the shorter route
+		const T rawCos = a | b;
+		const T cosSum = (rawCos >= T(0)) ? rawCos : -rawCos;
+
+		T scale0, scale1;
+		if (cosSum < T(0.9999))
+		{
+			const T omega = ScalarMath<T>::Acos(cosSum);
+			const T invSin = T(1) / ScalarMath<T>::Sin(omega);
+			scale0 = ScalarMath<T>::Sin((T(1) - t) * omega) * invSin;
+			scale1 = ScalarMath<T>::Sin(t * omega) * invSin;
+		}
+		else
+		{
+			// Inputs too close; use linear interpolation.
+			scale0 = T(1) - t;
+			scale1 = t;
+		}
+
+		scale1 = (rawCos >= T(0)) ? scale1 : -scale1;
+		return TQuat{
+			scale0 * a.w + scale1 * b.w,
+			scale0 * a.x + scale1 * b.x,
+			scale0 * a.y + scale1 * b.y,
+			scale0 * a.z + scale1 * b.z };
+	}
+
+	// Spherical interpolation. Inputs must be normalized
+	static inline TQuat Slerp(const TQuat& a, const TQuat& b, T t)
+	{
+		return Slerp_NotNormalized(a, b, t).GetNormalized();
+	}
+};
+
+/////////////////////////////////////////////////////
+// Type Aliases
+
+typedef TVector3<double> Vec3d;
+typedef TQuat<double> QuatD;
+typedef TMatrix3<double> Mtx33d;
+
+typedef TVector3<Fixed> Vec3x;
+typedef TQuat<Fixed> QuatX;
+typedef TMatrix3<Fixed> Mtx33x;
+
+} // namespace SNova
\ No newline at end of file
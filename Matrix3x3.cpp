@@ -40,11 +40,15 @@ Matrix3x3 & Matrix3x3::operator=(const Matrix3x3 & rhs)
 
 Matrix3x3 operator*(const Matrix3x3 & lhs, const Matrix3x3 & rhs)
 {
+	// unrolled, each row of the result is lhs's row times rhs
 	Matrix3x3 m{ 0,0,0,0,0,0,0,0,0 };
 	for (int i = 0; i < 3; ++i)
-		for (int j = 0; j < 3; ++j)
-			for (int k = 0; k < 3; ++k)
-				m.m2[i][j] += lhs.m2[i][k] * rhs.m2[k][j];
+	{
+		const float a0 = lhs.m2[i][0], a1 = lhs.m2[i][1], a2 = lhs.m2[i][2];
+		m.m2[i][0] = a0 * rhs.m2[0][0] + a1 * rhs.m2[1][0] + a2 * rhs.m2[2][0];
+		m.m2[i][1] = a0 * rhs.m2[0][1] + a1 * rhs.m2[1][1] + a2 * rhs.m2[2][1];
+		m.m2[i][2] = a0 * rhs.m2[0][2] + a1 * rhs.m2[1][2] + a2 * rhs.m2[2][2];
+	}
 	return m;
 }
 
@@ -60,7 +64,7 @@ Matrix3x3 & Matrix3x3::operator*=(const Matrix3x3 & rhs)
 
 }
 
-Matrix3x3& Matrix3x3::operator+=(const Matrix3x3 rhs)
+Matrix3x3& Matrix3x3::operator+=(const Matrix3x3& rhs)
 {
 	for (int i = 0; i < 3; ++i)
 	{ 
@@ -70,7 +74,7 @@ Matrix3x3& Matrix3x3::operator+=(const Matrix3x3 rhs)
 	return *this;
 }
 
-Matrix3x3& Matrix3x3::operator-=(const Matrix3x3 rhs)
+Matrix3x3& Matrix3x3::operator-=(const Matrix3x3& rhs)
 {
 	for (int i = 0; i < 3; ++i)
 	{
@@ -94,19 +98,19 @@ void Matrix3x3::PrintMatrix3x3()
 	}
 }
 
-inline float Matrix3x3::Determinant() const
+float Matrix3x3::Determinant() const
 {
 	return	  m2[0][0] * (m2[1][1] * m2[2][2] - m2[1][2] * m2[2][1])
 		- m2[0][1] * (m2[1][0] * m2[2][2] - m2[1][2] * m2[2][0])
 		+ m2[0][2] * (m2[1][0] * m2[2][1] - m2[1][1] * m2[2][0]);
 }
 
-Matrix3x3 Matrix3x3::GetInverse()
+Matrix3x3 Matrix3x3::GetInverse() const
 {
 	return Mtx33Inverse(*this);
 }
 
-Matrix3x3 Matrix3x3::GetTranspose()
+Matrix3x3 Matrix3x3::GetTranspose() const
 {
 	Matrix3x3 res;
 	Mtx33Transpose(res, *this);
@@ -204,11 +208,14 @@ void Mtx33RotRad(Matrix3x3 & pResult, float angle)
 	sin  cos 0
 	0    0  1
 	*/
+	float s, c;
+	Math::SinCos<Math::TrigAccuracy::Exact>(angle, s, c);
+
 	Mtx33Identity(pResult);
-	pResult.m2[0][0] = cosf(angle);
-	pResult.m2[0][1] = -(sinf(angle));
-	pResult.m2[1][0] = sinf(angle);
-	pResult.m2[1][1] = cosf(angle);
+	pResult.m2[0][0] = c;
+	pResult.m2[0][1] = -s;
+	pResult.m2[1][0] = s;
+	pResult.m2[1][1] = c;
 
 }
 
@@ -223,11 +230,14 @@ void Mtx33RotDeg(Matrix3x3 & pResult, float angle)
 	//convert to radians
 	angle = static_cast<float>(angle * PI / 180);
 
+	float s, c;
+	Math::SinCos<Math::TrigAccuracy::Exact>(angle, s, c);
+
 	Mtx33Identity(pResult);
-	pResult.m2[0][0] = cosf(angle);
-	pResult.m2[0][1] = -(sinf(angle));
-	pResult.m2[1][0] = sinf(angle);
-	pResult.m2[1][1] = cosf(angle);
+	pResult.m2[0][0] = c;
+	pResult.m2[0][1] = -s;
+	pResult.m2[1][0] = s;
+	pResult.m2[1][1] = c;
 
 
 }
@@ -17,14 +17,14 @@ struct Matrix3x3
 	Matrix3x3& operator=(const Matrix3x3 &rhs);
 
 	Matrix3x3& operator*=(const Matrix3x3 &rhs);
-	Matrix3x3& operator+=(const Matrix3x3 rhs);
-	Matrix3x3& operator-=(const Matrix3x3 rhs);
+	Matrix3x3& operator+=(const Matrix3x3& rhs);
+	Matrix3x3& operator-=(const Matrix3x3& rhs);
 
 	void PrintMatrix3x3();
 
 	float Determinant() const;
-	Matrix3x3 GetInverse();
-	Matrix3x3 GetTranspose();
+	Matrix3x3 GetInverse() const;
+	Matrix3x3 GetTranspose() const;
 
 	std::string ToString() const;
 
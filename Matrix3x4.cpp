@@ -0,0 +1,250 @@
+/******************************************************************************/
+/*!
+\file		Matrix3x4.cpp
+\author		Justin Leow
+\brief
+	Affine transform stored as the top three rows of a 4x4 matrix. See Matrix3x4.h.
+
+	Matrix products, transpose and inverse work a row at a time with
+	SIMD::Quad. Batch kernels are
+	templates over the SIMD lane type, like those in QuatBatch.cpp, with the
+	matrix elements broadcast to every lane.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "SNova.h"
+#include "Matrix3x4.h"
+#include "QuatBatch.h"
+#include "SIMD.h"
+
+namespace SNova
+{
+
+namespace
+{
+	/////////////////////////////////////////////////////
+	// Kernels. Each processes L::Width elements starting at i
+
+	// POINT adds the translation (TransformPoint), otherwise TransformVector
+	template <bool POINT, typename L>
+	inline void TransformKernel(size_t i, const Matrix3x4& m,
+		const float* x, const float* y, const float* z,
+		float* ox, float* oy, float* oz)
+	{
+		const L px = L::Load(x + i), py = L::Load(y + i), pz = L::Load(z + i);
+		float* const out[3] = { ox, oy, oz };
+
+		for (int r = 0; r < 3; ++r)
+		{
+			L result = L::Set(m.m2[r][0]) * px + L::Set(m.m2[r][1]) * py + L::Set(m.m2[r][2]) * pz;
+			if (POINT)
+				result = result + L::Set(m.m2[r][3]);
+			result.Store(out[r] + i);
+		}
+	}
+
+	template <bool POINT>
+	void TransformSoA(const Matrix3x4& m, const float* x, const float* y, const float* z,
+		float* ox, float* oy, float* oz, size_t n)
+	{
+		SIMD::RunBatch(n, [&](size_t i, auto lane)
+		{
+			TransformKernel<POINT, decltype(lane)>(i, m, x, y, z, ox, oy, oz);
+		});
+	}
+
+	template <bool POINT>
+	void TransformStrided(const Matrix3x4& m, const float* in, size_t inStride, float* out, size_t outStride, size_t n)
+	{
+		// Array-of-structs (or interleaved) input, so go through a small SoA
+		// staging buffer that stays in L1. Reads a chunk before writing it, so out may alias in
+		static constexpr size_t CHUNK = 64;
+		alignas(SIMD::ALIGNMENT) float x[CHUNK];
+		alignas(SIMD::ALIGNMENT) float y[CHUNK];
+		alignas(SIMD::ALIGNMENT) float z[CHUNK];
+
+		const char* src = reinterpret_cast<const char*>(in);
+		char* dst = reinterpret_cast<char*>(out);
+
+		for (size_t base = 0; base < n; base += CHUNK)
+		{
+			const size_t count = Math::Min(CHUNK, n - base);
+
+			for (size_t k = 0; k < count; ++k)
+			{
+				const float* v = reinterpret_cast<const float*>(src + (base + k) * inStride);
+				x[k] = v[0]; y[k] = v[1]; z[k] = v[2];
+			}
+
+			TransformSoA<POINT>(m, x, y, z, x, y, z, count);
+
+			for (size_t k = 0; k < count; ++k)
+			{
+				float* v = reinterpret_cast<float*>(dst + (base + k) * outStride);
+				v[0] = x[k]; v[1] = y[k]; v[2] = z[k];
+			}
+		}
+	}
+
+	template <bool POINT>
+	void TransformAoS(const Matrix3x4& m, const Vec3* in, Vec3* out, size_t n)
+	{
+		TransformStrided<POINT>(m, reinterpret_cast<const float*>(in), sizeof(Vec3), reinterpret_cast<float*>(out), sizeof(Vec3), n);
+	}
+}
+
+/////////////////////////////////////////////////////
+// Matrix3x4
+
+Matrix3x4::Matrix3x4()
+	: m2{ { 1.f, 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f, 0.f }, { 0.f, 0.f, 1.f, 0.f } }
+{}
+
+Matrix3x4::Matrix3x4(const Matrix3x3& linear, const Vec3& translation)
+	: m2{
+		{ linear.m2[0][0], linear.m2[0][1], linear.m2[0][2], translation.x },
+		{ linear.m2[1][0], linear.m2[1][1], linear.m2[1][2], translation.y },
+		{ linear.m2[2][0], linear.m2[2][1], linear.m2[2][2], translation.z } }
+{}
+
+Matrix3x4 Matrix3x4::FromTRS(const Vec3& translation, const Quat& rotation, const Vec3& scale)
+{
+	const Matrix3x3 r = rotation.ToMatrix3x3();
+	const float s[3] = { scale.x, scale.y, scale.z };
+
+	Matrix3x4 m{ Matrix3x3{}, translation };
+	for (int i = 0; i < 3; ++i)
+		for (int j = 0; j < 3; ++j)
+			m.m2[i][j] = r.m2[i][j] * s[j];
+	return m;
+}
+
+Matrix3x3 Matrix3x4::GetLinear() const
+{
+	return Matrix3x3{
+		m2[0][0], m2[0][1], m2[0][2],
+		m2[1][0], m2[1][1], m2[1][2],
+		m2[2][0], m2[2][1], m2[2][2] };
+}
+
+Matrix3x4 Matrix3x4::GetTranspose() const
+{
+	// The zero 4th row becomes the zero translation column
+	SIMD::Quad r0 = SIMD::Quad::Load(m2[0]);
+	SIMD::Quad r1 = SIMD::Quad::Load(m2[1]);
+	SIMD::Quad r2 = SIMD::Quad::Load(m2[2]);
+	SIMD::Quad r3 = SIMD::Quad::Set(0.f);
+	SIMD::Transpose4(r0, r1, r2, r3);
+
+	Matrix3x4 result;
+	r0.Store(result.m2[0]);
+	r1.Store(result.m2[1]);
+	r2.Store(result.m2[2]);
+	return result;
+}
+
+Matrix3x4 Matrix3x4::GetInverse() const
+{
+	const SIMD::Quad r0 = SIMD::Quad::Load(m2[0]);
+	const SIMD::Quad r1 = SIMD::Quad::Load(m2[1]);
+	const SIMD::Quad r2 = SIMD::Quad::Load(m2[2]);
+
+	// Columns of L^-1 are the cross products of L's rows over det(L).
+	// Cross3 only reads lanes 0-2, so the translation in lane 3 is ignored
+	SIMD::Quad c0 = SIMD::Cross3(r1, r2);
+	SIMD::Quad c1 = SIMD::Cross3(r2, r0);
+	SIMD::Quad c2 = SIMD::Cross3(r0, r1);
+	const float det = SIMD::Dot3(r0, c0);
+	if (det == 0.f)
+		return *this;
+
+	const SIMD::Quad invDet = SIMD::Quad::Set(1.f / det);
+	c0 = c0 * invDet;
+	c1 = c1 * invDet;
+	c2 = c2 * invDet;
+
+	// (L, t)^-1 = (L^-1, -L^-1 * t). Transposing the columns plus that
+	// translation gives the rows
+	SIMD::Quad t = -(c0 * SIMD::Quad::Set(m2[0][3]) + c1 * SIMD::Quad::Set(m2[1][3]) + c2 * SIMD::Quad::Set(m2[2][3]));
+	SIMD::Transpose4(c0, c1, c2, t);
+
+	Matrix3x4 inverse;
+	c0.Store(inverse.m2[0]);
+	c1.Store(inverse.m2[1]);
+	c2.Store(inverse.m2[2]);
+	return inverse;
+}
+
+Matrix3x4 Matrix3x4::GetInverseRigid() const
+{
+	Matrix3x4 inverse = GetTranspose();
+	inverse.SetTranslation(-inverse.TransformVector(GetTranslation()));
+	return inverse;
+}
+
+Matrix3x4 Matrix3x4::operator*(const Matrix3x4& rhs) const
+{
+	// Row i of the result is a weighted sum of rhs's rows, with the
+	// implied 4th row (0, 0, 0, 1) carrying the translation
+	const SIMD::Quad b0 = SIMD::Quad::Load(rhs.m2[0]);
+	const SIMD::Quad b1 = SIMD::Quad::Load(rhs.m2[1]);
+	const SIMD::Quad b2 = SIMD::Quad::Load(rhs.m2[2]);
+	const SIMD::Quad b3 = SIMD::Quad::Set(0.f, 0.f, 0.f, 1.f);
+
+	Matrix3x4 result;
+	for (int i = 0; i < 3; ++i)
+	{
+		const SIMD::Quad row =
+			  SIMD::Quad::Set(m2[i][0]) * b0
+			+ SIMD::Quad::Set(m2[i][1]) * b1
+			+ SIMD::Quad::Set(m2[i][2]) * b2
+			+ SIMD::Quad::Set(m2[i][3]) * b3;
+		row.Store(result.m2[i]);
+	}
+	return result;
+}
+
+/////////////////////////////////////////////////////
+// Batch versions
+
+void TransformPoints(const Matrix3x4& m, const Vec3* in, Vec3* out, size_t n)
+{
+	TransformAoS<true>(m, in, out, n);
+}
+
+void TransformPoints(const Matrix3x4& m, const Vec3Batch& in, Vec3Batch& out)
+{
+	TransformSoA<true>(m, in.x, in.y, in.z, out.x, out.y, out.z, in.Size());
+}
+
+void TransformVectors(const Matrix3x4& m, const Vec3* in, Vec3* out, size_t n)
+{
+	TransformAoS<false>(m, in, out, n);
+}
+
+void TransformVectors(const Matrix3x4& m, const Vec3Batch& in, Vec3Batch& out)
+{
+	TransformSoA<false>(m, in.x, in.y, in.z, out.x, out.y, out.z, in.Size());
+}
+
+void TransformPoints(const Matrix3x4& m, const float* in, size_t inStride, float* out, size_t outStride, size_t n)
+{
+	TransformStrided<true>(m, in, inStride, out, outStride, n);
+}
+
+void TransformVectors(const Matrix3x4& m, const float* in, size_t inStride, float* out, size_t outStride, size_t n)
+{
+	TransformStrided<false>(m, in, inStride, out, outStride, n);
+}
+
+void Mtx33MultiplyN(const Matrix3x3& m, const Vec3* in, Vec3* out, size_t n)
+{
+	// Matrix3x3's operator*(Vec3) uses the transpose of m2
+	TransformVectors(Matrix3x4{ m.GetTranspose() }, in, out, n);
+}
+
+} // namespace SNova
\ No newline at end of file
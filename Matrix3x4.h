@@ -0,0 +1,145 @@
+/******************************************************************************/
+/*!
+\file		Matrix3x4.h
+\author		Justin Leow
+\brief
+	Affine transform (rotation/scale plus translation) stored as the top
+	three rows of a 4x4 matrix.
+
+	Same layout and convention as Mtx44 and the buffer ComposeTRSN writes:
+	column vectors, p' = L * p + t, translation in column 3. Each row is
+	4 floats and 16-byte aligned, so a row is one SIMD register
+	(SIMD::Quad), and batches of points run over SIMD::Wide lanes.
+
+	Note that Matrix3x3's operator*(Vec3) multiplies by the transpose of
+	m2, so Matrix3x4{ m } * p equals m.GetTranspose() * p, not m * p.
+	Mtx33MultiplyN does what Matrix3x3's operator* does.
+
+	Transpose, inverse and products are SIMD here. Matrix3x3 stays scalar
+	(its products are unrolled): its rows are 3 unpadded floats, so a row
+	load would read into the next row or past the end.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "Vector3D.h"
+#include "Matrix3x3.h"
+#include "Quat.h"
+#include <cstddef>
+
+namespace SNova
+{
+
+struct Vec3Batch;
+
+struct alignas(16) Matrix3x4
+{
+	/////////////////////////////////////////////////////
+	// Data Members
+public:
+	// m2[i][0..2] is row i of the linear part, m2[i][3] is translation i
+	float m2[3][4];
+
+	/////////////////////////////////////////////////////
+	// Constructors
+public:
+	// Identity
+	Matrix3x4();
+
+	explicit Matrix3x4(const Matrix3x3& linear, const Vec3& translation = Vec3{});
+
+	// Translation * Rotation * Scale, same as Mtx44ComposeTRS
+	static Matrix3x4 FromTRS(const Vec3& translation, const Quat& rotation, const Vec3& scale);
+
+	/////////////////////////////////////////////////////
+	// Member Functions
+public:
+	Matrix3x3 GetLinear() const;
+	inline Vec3 GetTranslation() const;
+	inline void SetTranslation(const Vec3& t);
+
+	// L * p + t
+	inline Vec3 TransformPoint(const Vec3& p) const;
+
+	// L * v, no translation (directions)
+	inline Vec3 TransformVector(const Vec3& v) const;
+
+	// Transpose of the linear part. Translation is set to 0, since the
+	// transposed 4x4 would hold it in a bottom row
+	Matrix3x4 GetTranspose() const;
+
+	// Inverse of any affine transform. Returns this unchanged if it isn't invertible (like Mtx33Inverse)
+	Matrix3x4 GetInverse() const;
+
+	// Inverse when the linear part is a pure rotation (no scale), using its transpose
+	Matrix3x4 GetInverseRigid() const;
+
+	// Apply rhs first, then this
+	Matrix3x4 operator*(const Matrix3x4& rhs) const;
+	inline Vec3 operator*(const Vec3& p) const;
+};
+
+typedef Matrix3x4 Affine3;
+
+static_assert(sizeof(Matrix3x4) == 12 * sizeof(float), "Matrix3x4 must match the ComposeTRSN buffer layout");
+
+/////////////////////////////////////////////////////
+// Batch versions. out may alias in.
+
+// out[i] = m.TransformPoint(in[i])
+void TransformPoints(const Matrix3x4& m, const Vec3* in, Vec3* out, size_t n);
+void TransformPoints(const Matrix3x4& m, const Vec3Batch& in, Vec3Batch& out);
+
+// out[i] = m.TransformVector(in[i])
+void TransformVectors(const Matrix3x4& m, const Vec3* in, Vec3* out, size_t n);
+void TransformVectors(const Matrix3x4& m, const Vec3Batch& in, Vec3Batch& out);
+
+// Same over interleaved data (e.g. positions inside a vertex buffer).
+// Element i is the 3 floats at byte offset i * inStride / i * outStride.
+// in == out with the same stride transforms in place.
+void TransformPoints(const Matrix3x4& m, const float* in, size_t inStride, float* out, size_t outStride, size_t n);
+void TransformVectors(const Matrix3x4& m, const float* in, size_t inStride, float* out, size_t outStride, size_t n);
+
+// out[i] = m * in[i], with Matrix3x3's operator*(Vec3)
+void Mtx33MultiplyN(const Matrix3x3& m, const Vec3* in, Vec3* out, size_t n);
+
+// ------------------------- INLINE IMPLEMENTATIONS ---------------------
+
+inline Vec3 Matrix3x4::GetTranslation() const
+{
+	return Vec3{ m2[0][3], m2[1][3], m2[2][3] };
+}
+
+inline void Matrix3x4::SetTranslation(const Vec3& t)
+{
+	m2[0][3] = t.x;
+	m2[1][3] = t.y;
+	m2[2][3] = t.z;
+}
+
+inline Vec3 Matrix3x4::TransformPoint(const Vec3& p) const
+{
+	return Vec3{
+		m2[0][0] * p.x + m2[0][1] * p.y + m2[0][2] * p.z + m2[0][3],
+		m2[1][0] * p.x + m2[1][1] * p.y + m2[1][2] * p.z + m2[1][3],
+		m2[2][0] * p.x + m2[2][1] * p.y + m2[2][2] * p.z + m2[2][3] };
+}
+
+inline Vec3 Matrix3x4::TransformVector(const Vec3& v) const
+{
+	return Vec3{
+		m2[0][0] * v.x + m2[0][1] * v.y + m2[0][2] * v.z,
+		m2[1][0] * v.x + m2[1][1] * v.y + m2[1][2] * v.z,
+		m2[2][0] * v.x + m2[2][1] * v.y + m2[2][2] * v.z };
+}
+
+inline Vec3 Matrix3x4::operator*(const Vec3& p) const
+{
+	return TransformPoint(p);
+}
+
+} // namespace SNova
\ No newline at end of file
@@ -0,0 +1,175 @@
+/******************************************************************************/
+/*!
+\file		MatrixCompose.cpp
+\author		Justin Leow
+\brief
+	Builds Translation * Rotation * Scale matrices in one pass. See MatrixCompose.h.
+
+	The batch kernel is Quat::ToMatrix3x3 written over SIMD lanes, with the
+	gimbal lock branch turned into a Select so every lane runs the same code.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "SNova.h"
+#include "MatrixCompose.h"
+#include "SIMD.h"
+
+namespace SNova
+{
+
+namespace
+{
+	// Lane version of SinCosOfAtan2 in Quat.cpp
+	template <typename L>
+	inline void SinCosOfAtan2(L y, L x, L& sinOut, L& cosOut)
+	{
+		const L lengthSq = x * x + y * y;
+		const L invLength = L::Set(1.f) / SIMD::Sqrt(lengthSq);
+
+		// atan2f(0, 0) == 0
+		const L zero = SIMD::CmpLE(lengthSq, L::Set(0.f));
+		sinOut = SIMD::Select(zero, L::Set(0.f), y * invLength);
+		cosOut = SIMD::Select(zero, L::Set(1.f), x * invLength);
+	}
+
+	/**
+	 * Compose L::Width matrices starting at i.
+	 * in: tx ty tz, qw qx qy qz, sx sy sz.  out: 12 arrays, row-major 3x4
+	 */
+	template <typename L>
+	inline void ComposeKernel(size_t i, float* const* in, float* const* out)
+	{
+		const L w = L::Load(in[3] + i), x = L::Load(in[4] + i), y = L::Load(in[5] + i), z = L::Load(in[6] + i);
+		const L one = L::Set(1.f), two = L::Set(2.f);
+
+		// Same steps as Quat::ToMatrix3x3
+		const L yawY = two * (w * z + x * y);
+		const L yawX = one - two * (y * y + z * z);
+		const L singularityTest = z * x - w * y;
+
+		L SY, CY;
+		SinCosOfAtan2(yawY, yawX, SY, CY);
+
+		// Gimbal lock: pitch = +-90, roll = +-yaw - 2 * atan2f(x, w)
+		const L positive = SIMD::CmpGT(singularityTest, L::Set(0.f));
+		const L sign = SIMD::Select(positive, one, L::Set(-1.f));
+		L S2A, C2A;
+		SinCosOfAtan2(two * w * x, w * w - x * x, S2A, C2A);
+		const L SYSigned = sign * SY;
+		const L lockedSR = SYSigned * C2A - CY * S2A;
+		const L lockedCR = CY * C2A + SYSigned * S2A;
+
+		// Regular case
+		const L freeSP = two * singularityTest;
+		const L freeCP = SIMD::Sqrt(SIMD::Max(one - freeSP * freeSP, L::Set(0.f)));
+		L freeSR, freeCR;
+		SinCosOfAtan2(-two * (w * x + y * z), one - two * (x * x + y * y), freeSR, freeCR);
+
+		const L locked = SIMD::CmpGT(SIMD::Abs(singularityTest), L::Set(0.4999995f));
+		const L SP = SIMD::Select(locked, sign, freeSP);
+		const L CP = SIMD::Select(locked, L::Set(0.f), freeCP);
+		const L SR = SIMD::Select(locked, lockedSR, freeSR);
+		const L CR = SIMD::Select(locked, lockedCR, freeCR);
+
+		// Same axis remapping as Rotator::Matrix()
+		const L MSP = SY, MCP = CY;
+		const L MSY = -SR, MCY = CR;
+		const L MSR = SP, MCR = CP;
+
+		const L sx = L::Load(in[7] + i), sy = L::Load(in[8] + i), sz = L::Load(in[9] + i);
+
+		(MCP * MCY * sx).Store(out[0] + i);
+		(MCP * MSY * sy).Store(out[1] + i);
+		(MSP * sz).Store(out[2] + i);
+		L::Load(in[0] + i).Store(out[3] + i);
+
+		((MSR * MSP * MCY - MCR * MSY) * sx).Store(out[4] + i);
+		((MSR * MSP * MSY + MCR * MCY) * sy).Store(out[5] + i);
+		(-MSR * MCP * sz).Store(out[6] + i);
+		L::Load(in[1] + i).Store(out[7] + i);
+
+		(-(MCR * MSP * MCY + MSR * MSY) * sx).Store(out[8] + i);
+		((MCY * MSR - MCR * MSP * MSY) * sy).Store(out[9] + i);
+		(MCR * MCP * sz).Store(out[10] + i);
+		L::Load(in[2] + i).Store(out[11] + i);
+	}
+}
+
+void Mtx44ComposeAffine(Mtx44& result, const Matrix3x3& rotation, const Vec3& scale, const Vec3& translation)
+{
+	const float s[3] = { scale.x, scale.y, scale.z };
+	const float t[3] = { translation.x, translation.y, translation.z };
+
+	for (int i = 0; i < 3; ++i)
+	{
+		for (int j = 0; j < 3; ++j)
+			result.m2[i][j] = rotation.m2[i][j] * s[j];
+		result.m2[i][3] = t[i];
+	}
+
+	result.m2[3][0] = 0.f;
+	result.m2[3][1] = 0.f;
+	result.m2[3][2] = 0.f;
+	result.m2[3][3] = 1.f;
+}
+
+void Mtx44ComposeTRS(Mtx44& result, const Vec3& translation, const Quat& rotation, const Vec3& scale)
+{
+	Mtx44ComposeAffine(result, rotation.ToMatrix3x3(), scale, translation);
+}
+
+void ComposeTRSN(const Vec3* translations, const Quat* rotations, const Vec3* scales,
+	float* out, size_t n, size_t stride)
+{
+	// Inputs are array-of-structs, so go through a small SoA staging
+	// buffer that stays in L1 (like the Quat batch functions)
+	static constexpr size_t CHUNK = 64;
+	alignas(SIMD::ALIGNMENT) float inLanes[10][CHUNK];
+	alignas(SIMD::ALIGNMENT) float outLanes[AFFINE_FLOATS][CHUNK];
+
+	float* in[10];
+	float* rows[AFFINE_FLOATS];
+	for (size_t k = 0; k < 10; ++k)
+		in[k] = inLanes[k];
+	for (size_t k = 0; k < AFFINE_FLOATS; ++k)
+		rows[k] = outLanes[k];
+
+	for (size_t base = 0; base < n; base += CHUNK)
+	{
+		const size_t count = Math::Min(CHUNK, n - base);
+
+		for (size_t k = 0; k < count; ++k)
+		{
+			const Vec3& t = translations[base + k];
+			const Quat& q = rotations[base + k];
+			const Vec3& s = scales[base + k];
+			in[0][k] = t.x; in[1][k] = t.y; in[2][k] = t.z;
+			in[3][k] = q.w; in[4][k] = q.x; in[5][k] = q.y; in[6][k] = q.z;
+			in[7][k] = s.x; in[8][k] = s.y; in[9][k] = s.z;
+		}
+
+		SIMD::RunBatch(count, [&](size_t i, auto lane)
+		{
+			ComposeKernel<decltype(lane)>(i, in, rows);
+		});
+
+		for (size_t k = 0; k < count; ++k)
+		{
+			float* dst = out + (base + k) * stride;
+			for (size_t e = 0; e < AFFINE_FLOATS; ++e)
+				dst[e] = rows[e][k];
+		}
+	}
+}
+
+void ComposeTRSN(const Vec3* translations, const Quat* rotations, const Vec3* scales,
+	Matrix3x4* out, size_t n)
+{
+	ComposeTRSN(translations, rotations, scales, reinterpret_cast<float*>(out), n, AFFINE_FLOATS);
+}
+
+} // namespace SNova
\ No newline at end of file
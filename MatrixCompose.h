@@ -0,0 +1,56 @@
+/******************************************************************************/
+/*!
+\file		MatrixCompose.h
+\author		Justin Leow
+\brief
+	Builds Translation * Rotation * Scale matrices in one pass.
+
+	Building T, R and S as three Mtx44s and multiplying them costs 128
+	multiplies, nearly all of them by 0 or 1. The result is always
+
+		| R00*sx  R01*sy  R02*sz  tx |
+		| R10*sx  R11*sy  R12*sz  ty |
+		| R20*sx  R21*sy  R22*sz  tz |
+		|   0       0       0      1 |
+
+	so these functions write it directly. ComposeTRSN does many at once
+	(SIMD, see SIMD.h) into a flat float buffer ready for GPU upload.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "Quat.h"
+#include "Vector3D.h"
+#include "Matrix3x3.h"
+#include "Matrix4x4.h"
+#include "Matrix3x4.h"
+#include <cstddef>
+
+namespace SNova
+{
+	// result = Translate(translation) * rotation * Scale(scale)
+	void Mtx44ComposeAffine(Mtx44& result, const Matrix3x3& rotation, const Vec3& scale, const Vec3& translation);
+
+	// result = Translate(translation) * rotation.ToMatrix3x3() * Scale(scale)
+	void Mtx44ComposeTRS(Mtx44& result, const Vec3& translation, const Quat& rotation, const Vec3& scale);
+
+	// Floats written per matrix by ComposeTRSN: the top 3 rows, row-major
+	static constexpr size_t AFFINE_FLOATS = 12;
+
+	/**
+	 * out[i] = the top 3 rows of Mtx44ComposeTRS(translations[i], rotations[i], scales[i]),
+	 * row-major, AFFINE_FLOATS floats each. Matrix i starts at out + i * stride,
+	 * so stride > AFFINE_FLOATS leaves room for other per-instance data.
+	 */
+	void ComposeTRSN(const Vec3* translations, const Quat* rotations, const Vec3* scales,
+		float* out, size_t n, size_t stride = AFFINE_FLOATS);
+
+	// Same, into an array of Matrix3x4 (which has the same layout)
+	void ComposeTRSN(const Vec3* translations, const Quat* rotations, const Vec3* scales,
+		Matrix3x4* out, size_t n);
+
+} // namespace SNova
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "ParallelFor.h"
+#include <algorithm>
+#include <utility>
+
+namespace SNova
+{
+	namespace
+	{
+		ParallelForBackend& Backend()
+		{
+			static ParallelForBackend backend;
+			return backend;
+		}
+
+		// Set while this thread runs ThreadPool work, so nested Run()s go inline
+		// instead of waiting on runMutex (held by the outer Run) forever
+		thread_local bool insideJob = false;
+
+		struct JobScope
+		{
+			JobScope() { insideJob = true; }
+			~JobScope() { insideJob = false; }
+		};
+	}
+
+	ThreadPool& ThreadPool::Get()
+	{
+		static ThreadPool instance;
+		return instance;
+	}
+
+	ThreadPool::ThreadPool()
+	{
+		const unsigned cores = std::max(std::thread::hardware_concurrency(), 1u);
+
+		// The calling thread also works, so leave one core for it
+		for (unsigned i = 1; i < cores; ++i)
+			workers.emplace_back(&ThreadPool::WorkerLoop, this);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			quit = true;
+		}
+		wake.notify_all();
+
+		for (std::thread& t : workers)
+			t.join();
+	}
+
+	size_t ThreadPool::ThreadCount() const
+	{
+		return workers.size() + 1;
+	}
+
+	void ThreadPool::Run(size_t count, size_t grain, const ParallelRangeFn& fn)
+	{
+		if (count == 0)
+			return;
+
+		if (insideJob)
+		{
+			fn(0, count);
+			return;
+		}
+
+		grain = std::max<size_t>(grain, 1);
+
+		const JobScope scope;
+		std::lock_guard<std::mutex> runLock{ runMutex };
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			job = &fn;
+			jobCount = count;
+			jobGrain = grain;
+			nextChunk = 0;
+			chunksLeft = (count + grain - 1) / grain;
+			++generation;
+		}
+		wake.notify_all();
+
+		Drain(fn, count, grain);
+
+		// Wait for workers still running a chunk (all of them, if one threw)
+		std::unique_lock<std::mutex> lock{ mutex };
+		done.wait(lock, [this] { return (chunksLeft == 0 || error) && activeWorkers == 0; });
+		job = nullptr;
+
+		// No worker can touch fn any more, so it is safe to unwind past it
+		if (error)
+			std::rethrow_exception(std::exchange(error, nullptr));
+	}
+
+	void ThreadPool::Drain(const ParallelRangeFn& fn, size_t count, size_t grain)
+	{
+		const size_t chunkCount = (count + grain - 1) / grain;
+
+		for (size_t chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++)
+		{
+			const size_t begin = chunk * grain;
+			const size_t end = std::min(begin + grain, count);
+			try
+			{
+				fn(begin, end);
+			}
+			catch (...)
+			{
+				// Keep the first error for Run, and start no more chunks
+				std::lock_guard<std::mutex> lock{ mutex };
+				if (!error)
+					error = std::current_exception();
+				nextChunk = chunkCount;
+				return;
+			}
+			--chunksLeft;
+		}
+	}
+
+	void ThreadPool::WorkerLoop()
+	{
+		size_t seenGeneration = 0;
+		insideJob = true;
+
+		for (;;)
+		{
+			const ParallelRangeFn* fn;
+			size_t count, grain;
+			{
+				std::unique_lock<std::mutex> lock{ mutex };
+				wake.wait(lock, [&] { return quit || (generation != seenGeneration && job); });
+
+				if (quit)
+					return;
+
+				seenGeneration = generation;
+				fn = job;
+				count = jobCount;
+				grain = jobGrain;
+				++activeWorkers;
+			}
+
+			Drain(*fn, count, grain);
+
+			{
+				std::lock_guard<std::mutex> lock{ mutex };
+				--activeWorkers;
+			}
+			done.notify_all();
+		}
+	}
+
+	void SetParallelForBackend(const ParallelForBackend& backend)
+	{
+		Backend() = backend;
+	}
+
+	void ParallelFor(size_t count, size_t grain, const ParallelRangeFn& fn)
+	{
+		if (count == 0)
+			return;
+
+		// Not worth waking threads for
+		if (count <= grain)
+		{
+			fn(0, count);
+			return;
+		}
+
+		if (Backend())
+			Backend()(count, grain, fn);
+		else
+			ThreadPool::Get().Run(count, grain, fn);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SNova
+{
+
+// Function run over one chunk [begin, end) of a parallel loop
+typedef std::function<void(size_t begin, size_t end)> ParallelRangeFn;
+
+// Backend signature, so an engine can route ParallelFor into its own job system
+typedef std::function<void(size_t count, size_t grain, const ParallelRangeFn& fn)> ParallelForBackend;
+
+// Persistent worker threads used by the default ParallelFor backend.
+// Chunks are claimed from a shared atomic counter, so threads that finish
+// early keep pulling work (dynamic load balancing).
+class ThreadPool
+{
+public:
+	static ThreadPool& Get();
+
+	~ThreadPool();
+
+	// Split [0, count) into chunks of (at most) grain items and run them on
+	// all workers plus the calling thread. Returns once every chunk is done.
+	// Called from inside a job (a worker or a running Run()), the whole
+	// range runs inline, since the pool is busy with the outer job.
+	// If fn throws, no further chunks start; Run waits for the ones already
+	// running and rethrows the first exception on the calling thread.
+	void Run(size_t count, size_t grain, const ParallelRangeFn& fn);
+
+	// Worker threads + the calling thread
+	size_t ThreadCount() const;
+
+private:
+	ThreadPool();
+	void WorkerLoop();
+
+	// Claim and run chunks of the current job until none are left
+	void Drain(const ParallelRangeFn& fn, size_t count, size_t grain);
+
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+
+	// current job
+	const ParallelRangeFn* job = nullptr;
+	size_t jobCount = 0;
+	size_t jobGrain = 1;
+	std::atomic<size_t> nextChunk{ 0 };
+	std::atomic<size_t> chunksLeft{ 0 };
+	size_t activeWorkers = 0;
+	size_t generation = 0;
+	std::exception_ptr error;	// first exception thrown by the current job
+	bool quit = false;
+
+	// Only one Run() at a time
+	std::mutex runMutex;
+};
+
+// Replace the backend used by ParallelFor. Pass nullptr to restore the ThreadPool
+void SetParallelForBackend(const ParallelForBackend& backend);
+
+// Run fn over [0, count) in chunks of grain items across all cores.
+// Small loops (count <= grain) run inline on the calling thread, and so do
+// nested calls made from inside the default ThreadPool's jobs.
+// An exception from fn reaches the caller (see ThreadPool::Run).
+void ParallelFor(size_t count, size_t grain, const ParallelRangeFn& fn);
+
+}
\ No newline at end of file
@@ -27,16 +27,18 @@ written consent of DigiPen Institute of Technology is prohibited.
 #include "Rotator.h"
 #include "Vector3D.h"
 #include "Matrix3x3.h"
+#include "Matrix4x4.h"
+#include "MatrixCompose.h"
+#include "Matrix3x4.h"
 #include "Transform.h"
 #include <iostream>
 
 namespace SNova
 {
 
-// Allowed error for a normalized quaternion
-#define THRESH_QUAT_NORMALIZED 0.01f
-
-const Quat Quat::Identity = Quat{};
+// Constant rotations fold at compile time
+static_assert(Quat::Identity * Quat::Identity == Quat::Identity, "Quat must stay constexpr");
+static_assert(Quat::MakeFromEulerConstexpr(0.f, 0.f, 0.f) == Quat::Identity, "Quat must stay constexpr");
 
 Quat::Quat(Vec3 Axis, float AngleRad)
 {
@@ -69,6 +71,8 @@ Vec3 Quat::Euler() const
 
 Rotator Quat::GetRotator() const
 {
+	SNOVA_INSTRUMENT_SCOPE(QUAT_GET_ROTATOR);
+
 	/*
 	 * Reference: 
 	 * https://en.wikipedia.org/wiki/Conversion_between_quaternions_and_Euler_angles
@@ -101,20 +105,20 @@ Rotator Quat::GetRotator() const
 	if (singularityTest < -SINGULARITY_THRESHOLD)
 	{
 		result.pitch = -90.f;
-		result.yaw = RAD2DEG(atan2f(yawY, yawX));
-		result.roll = Rotator::NormalizeAxis(-result.yaw - RAD2DEG(2.f * atan2f(x, w)));
+		result.yaw = RAD2DEG(Math::Atan2(yawY, yawX));
+		result.roll = Rotator::NormalizeAxis(-result.yaw - RAD2DEG(2.f * Math::Atan2(x, w)));
 	}
 	else if (singularityTest > SINGULARITY_THRESHOLD)
 	{
 		result.pitch = 90.f;
-		result.yaw = RAD2DEG(atan2f(yawY, yawX));
-		result.roll = Rotator::NormalizeAxis(result.yaw - RAD2DEG(2.f * atan2f(x, w)));
+		result.yaw = RAD2DEG(Math::Atan2(yawY, yawX));
+		result.roll = Rotator::NormalizeAxis(result.yaw - RAD2DEG(2.f * Math::Atan2(x, w)));
 	}
 	else
 	{
-		result.pitch = RAD2DEG(asinf(2.f * singularityTest));
-		result.yaw = RAD2DEG(atan2f(yawY, yawX));
-		result.roll = RAD2DEG(atan2(-2.f * (w * x + y * z), 1.f - 2.f * (x * x + y * y)));
+		result.pitch = RAD2DEG(Math::Asin(2.f * singularityTest));
+		result.yaw = RAD2DEG(Math::Atan2(yawY, yawX));
+		result.roll = RAD2DEG(Math::Atan2(-2.f * (w * x + y * z), 1.f - 2.f * (x * x + y * y)));
 	}
 
 	result.DiagnosticCheckNaN();
@@ -123,12 +127,210 @@ Rotator Quat::GetRotator() const
 
 Matrix3x3 Quat::Matrix() const
 {
-	return GetRotator().Matrix();
+	return ToMatrix3x3();
+}
+
+// Gets the sin/cos of atan2f(y, x) without calling any trig function
+static inline void SinCosOfAtan2(float y, float x, float& sinOut, float& cosOut)
+{
+	const float lengthSq = x * x + y * y;
+	if (lengthSq <= 0.f)
+	{
+		// atan2f(0, 0) == 0
+		sinOut = 0.f;
+		cosOut = 1.f;
+		return;
+	}
+
+	const float invLength = 1.f / sqrtf(lengthSq);
+	sinOut = y * invLength;
+	cosOut = x * invLength;
+}
+
+Matrix3x3 Quat::ToMatrix3x3() const
+{
+	/*
+	 * Rotator::Matrix() only needs the sin and cos of pitch/yaw/roll, and
+	 * GetRotator() obtains those angles from atan2f/asinf of terms that
+	 * are already polynomials in w/x/y/z. So instead of taking the angles
+	 * and then their sin/cos, we take the sin/cos of the atan2f/asinf
+	 * arguments directly. Same singularity handling as GetRotator().
+	 */
+
+	DiagnosticCheckNaN();
+
+	const float yawY = 2.f * (w * z + x * y);
+	const float yawX = (1.f - 2.f * (y * y + z * z));
+	const float singularityTest = z * x - w * y;
+	const float SINGULARITY_THRESHOLD = 0.4999995f;
+
+	float SP, CP, SY, CY, SR, CR;
+	SinCosOfAtan2(yawY, yawX, SY, CY);
+
+	if (fabsf(singularityTest) > SINGULARITY_THRESHOLD)
+	{
+		// pitch = +-90, roll = +-yaw - 2 * atan2f(x, w)
+		const float sign = (singularityTest > 0.f) ? 1.f : -1.f;
+		SP = sign;
+		CP = 0.f;
+
+		float S2A, C2A;
+		SinCosOfAtan2(2.f * w * x, w * w - x * x, S2A, C2A);
+
+		const float SYSigned = sign * SY;
+		SR = SYSigned * C2A - CY * S2A;
+		CR = CY * C2A + SYSigned * S2A;
+	}
+	else
+	{
+		SP = 2.f * singularityTest;
+		CP = sqrtf(Math::Max(1.f - SP * SP, 0.f));
+		SinCosOfAtan2(-2.f * (w * x + y * z), 1.f - 2.f * (x * x + y * y), SR, CR);
+	}
+
+	// Same axis remapping as Rotator::Matrix()
+	// (newPitch = yaw, newYaw = -roll, newRoll = pitch)
+	const float MSP =  SY, MCP = CY;
+	const float MSY = -SR, MCY = CR;
+	const float MSR =  SP, MCR = CP;
+
+	Matrix3x3 m;
+
+	m.m2[0][0] = MCP * MCY;
+	m.m2[0][1] = MCP * MSY;
+	m.m2[0][2] = MSP;
+
+	m.m2[1][0] = MSR * MSP * MCY - MCR * MSY;
+	m.m2[1][1] = MSR * MSP * MSY + MCR * MCY;
+	m.m2[1][2] = -MSR * MCP;
+
+	m.m2[2][0] = -(MCR * MSP * MCY + MSR * MSY);
+	m.m2[2][1] = MCY * MSR - MCR * MSP * MSY;
+	m.m2[2][2] = MCR * MCP;
+
+	return m;
+}
+
+Matrix4x4 Quat::ToMatrix4x4(const Vec3& scale, const Vec3& translation) const
+{
+	Mtx44 result;
+	Mtx44ComposeTRS(result, translation, *this, scale);
+	return result;
 }
 
-bool Quat::IsNormalized() const
+// Normalize at full precision. Quat::Normalize's Math::InvSqrt is good to
+// ~0.2%, which LookRotation would compound over its two steps
+static Quat NormalizedExact(const Quat& q)
 {
-	return fabsf(1.f - SizeSquared()) < THRESH_QUAT_NORMALIZED;
+	const float squareSum = q.SizeSquared();
+	return (squareSum >= SMALL_NUMBER) ? q * (1.f / sqrtf(squareSum)) : Quat::Identity;
+}
+
+Quat Quat::LookRotation(const Vec3& forward, const Vec3& up)
+{
+	// Swing the X axis onto forward, then roll about forward until the
+	// swung Y axis lines up with the part of up perpendicular to forward.
+	// QuatBatch's LookRotationKernel is the same steps over SIMD lanes.
+	const Vec3 F = forward.Normalized();
+	const Quat swing = NormalizedExact(FindBetweenNormals(Vec3{ 1.f, 0.f, 0.f }, F));
+
+	Vec3 Y = up - F * (F * up);
+	if (Y.MagnitudeSq() > EPSILON)
+		Y.Normalize();
+	else
+		Y = Vec3{};
+
+	// Roll around F by the angle from U to Y (both perpendicular to F), with
+	// cos/sin of that angle. (1 + cos, sin * F) and (sin, (1 - cos) * F) are
+	// both the half-angle quaternion scaled; use the one that can't vanish,
+	// so there is no special case for opposite vectors. Y == 0 gives no roll.
+	const Vec3 U = swing.RotateVector(Vec3{ 0.f, 1.f, 0.f });
+	const float cosRoll = U * Y;
+	const float sinRoll = (U ^ Y) * F;
+	const Quat roll = NormalizedExact((cosRoll >= 0.f)
+		? Quat{ 1.f + cosRoll, sinRoll * F.x, sinRoll * F.y, sinRoll * F.z }
+		: Quat{ sinRoll, (1.f - cosRoll) * F.x, (1.f - cosRoll) * F.y, (1.f - cosRoll) * F.z });
+
+	return roll * swing;
+}
+
+Quat Quat::Log() const
+{
+	Quat result{ 0.f, x, y, z };
+
+	// atan2(|v|, w) instead of acos(w) over sqrt(1 - w * w): near w = -1 a
+	// float-normalized quat's |v| is off from sqrt(1 - w * w) by far more
+	// than an ulp, and Exp would then miss the angle by ~0.01 degrees
+	const float sinHalfAngle = sqrtf(x * x + y * y + z * z);
+	if (sinHalfAngle >= SMALL_NUMBER)
+	{
+		const float scale = Math::Atan2<Math::TrigAccuracy::Exact>(sinHalfAngle, w) / sinHalfAngle;
+		result.x *= scale;
+		result.y *= scale;
+		result.z *= scale;
+	}
+
+	return result;
+}
+
+Quat Quat::Exp() const
+{
+	const float halfAngle = sqrtf(x * x + y * y + z * z);
+	float s, c;
+	Math::SinCos<Math::TrigAccuracy::Exact>(halfAngle, s, c);
+
+	// sin(a) / a goes to 1
+	const float scale = (halfAngle >= SMALL_NUMBER) ? s / halfAngle : 1.f;
+	return Quat{ c, x * scale, y * scale, z * scale };
+}
+
+void Quat::IntegrateAngularVelocity(const Vec3& omega, float dt)
+{
+	// Same axis remapping as Quat(Vec3, float)
+	const float halfDt = 0.5f * dt;
+	*this *= Quat{ 0.f, -omega.z * halfDt, -omega.x * halfDt, omega.y * halfDt }.Exp();
+}
+
+void Quat::IntegrateAngularVelocityFirstOrder(const Vec3& omega, float dt, bool normalize)
+{
+	// q * (1, v) = q + q * (0, v)
+	const float halfDt = 0.5f * dt;
+	const Quat stepped = *this * Quat{ 1.f, -omega.z * halfDt, -omega.x * halfDt, omega.y * halfDt };
+	*this = normalize ? NormalizedExact(stepped) : stepped;
+}
+
+// Matrix whose TransformVector is q.RotateVector: its columns are the rotated axes
+static Matrix3x4 RotationMatrixOf(const Quat& q)
+{
+	const Vec3 X = q.RotateVector(Vec3{ 1.f, 0.f, 0.f });
+	const Vec3 Y = q.RotateVector(Vec3{ 0.f, 1.f, 0.f });
+	const Vec3 Z = q.RotateVector(Vec3{ 0.f, 0.f, 1.f });
+
+	return Matrix3x4{ Matrix3x3{
+		X.x, Y.x, Z.x,
+		X.y, Y.y, Z.y,
+		X.z, Y.z, Z.z } };
+}
+
+void Quat::RotateVectors(const Vec3* in, Vec3* out, size_t n) const
+{
+	TransformVectors(RotationMatrixOf(*this), in, out, n);
+}
+
+void Quat::UnrotateVectors(const Vec3* in, Vec3* out, size_t n) const
+{
+	// UnrotateVector is RotateVector of the conjugate
+	TransformVectors(RotationMatrixOf(Conjugate()), in, out, n);
+}
+
+void Quat::RotateVectors(const float* in, size_t inStride, float* out, size_t outStride, size_t n) const
+{
+	TransformVectors(RotationMatrixOf(*this), in, inStride, out, outStride, n);
+}
+
+void Quat::UnrotateVectors(const float* in, size_t inStride, float* out, size_t outStride, size_t n) const
+{
+	TransformVectors(RotationMatrixOf(Conjugate()), in, inStride, out, outStride, n);
 }
 
 Quat Quat::Slerp_NotNormalized(const Quat& q1, const Quat& q2, float t)
@@ -149,10 +351,10 @@ Quat Quat::Slerp_NotNormalized(const Quat& q1, const Quat& q2, float t)
 
 	if (cosSum < DOT_THRESHOLD)
 	{
-		const float omega = acosf(cosSum);
-		const float invSin = 1.f / sinf(omega);
-		scale0 = sinf((1.f - t) * omega) * invSin;
-		scale1 = sinf(t * omega) * invSin;
+		const float omega = Math::Acos(cosSum);
+		const float invSin = 1.f / Math::Sin(omega);
+		scale0 = Math::Sin((1.f - t) * omega) * invSin;
+		scale1 = Math::Sin(t * omega) * invSin;
 	}
 	else
 	{
@@ -176,15 +378,9 @@ Quat Quat::Slerp_NotNormalized(const Quat& q1, const Quat& q2, float t)
 
 void Quat::UpdateBoundTransform()
 {
+	// Syncs the rotator unless the value is unchanged (or the quat is authoritative)
 	if (mp_BoundTransform)
-	{
-		Rotator tmp = GetRotator();
-		mp_BoundTransform->rotator.pitch = tmp.pitch;
-		mp_BoundTransform->rotator.yaw = tmp.yaw;
-		mp_BoundTransform->rotator.roll = tmp.roll;
-		//mp_BoundTransform->mtx = Matrix();
-		mp_BoundTransform->UpdateMtx();
-	}
+		mp_BoundTransform->OnRotationWritten();
 }
 
 } // namespace SNova
\ No newline at end of file
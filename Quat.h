@@ -25,10 +25,37 @@ written consent of DigiPen Institute of Technology is prohibited.
 #pragma once
 #include "Vector3D.h"
 #include "Rotator.h"
+#include "MathTypes.h"
+#include "Instrumentation.h"
+#include <cstdint>
 
 namespace SNova
 {
 
+struct QuatValue;
+
+/**
+ * How Quat::IntegrateAngularVelocityN / QuatBatch::IntegrateAngularVelocity
+ * step many bodies. Keep one per body array and pass it every step.
+ */
+struct AngularIntegration
+{
+	enum class Method
+	{
+		Exact,		// Quat::IntegrateAngularVelocity
+		FirstOrder	// Quat::IntegrateAngularVelocityFirstOrder, trig-free
+	};
+
+	Method method = Method::FirstOrder;
+
+	// Normalize on every Nth step (1 = every step, 0 = never).
+	// Normalization is at full precision and costs about as much as a first-order step
+	uint32_t renormalizeEvery = 1;
+
+	// Steps taken so far, advanced by each call
+	uint32_t step = 0;
+};
+
 struct Quat
 {
 public:
@@ -58,17 +85,24 @@ public:
 	// Constructors
 public:
 	// Default constructor (Generates Identity Quaternion).
-	inline Quat();
+	constexpr Quat();
 
 	// Member-Wise Constructor
-	inline Quat(float InW, float InX, float InY, float InZ);
+	constexpr Quat(float InW, float InX, float InY, float InZ);
 
 	// Copy Constructor
-	inline Quat(const Quat& q);
+	constexpr Quat(const Quat& q);
 
 	// Construct from Rotator
 	explicit inline Quat(const Rotator& r);
 
+	// Construct from an unbound value (defined in QuatValue.h)
+	constexpr Quat(const QuatValue& q);
+
+	// Construct from a double or Fixed quaternion (MathTypes.h)
+	template <typename T>
+	constexpr explicit Quat(const TQuat<T>& q);
+
 	/**
 	 * Creates and initializes a new quaternion from the a rotation around the given axis.
 	 *
@@ -83,6 +117,17 @@ public:
 	// Construct a quaternion from Euler angles (in degrees)
 	inline static Quat MakeFromEuler(float x_pitch, float y_yaw, float z_roll);
 
+	/**
+	 * Compile-time versions of Quat(Axis, AngleRad) and MakeFromEuler, for
+	 * fixed orientations (basis flips, mount offsets) that should be baked
+	 * into constants:
+	 *     static constexpr Quat FlipY = Quat::MakeFromAxisAngleConstexpr(Vec3{ 0.f, 1.f, 0.f }, PI);
+	 * Same results as the runtime versions to float precision, but slower
+	 * when called at runtime (see Math::SinCosConstexpr).
+	 */
+	static constexpr Quat MakeFromAxisAngleConstexpr(const Vec3& Axis, float AngleRad);
+	static constexpr Quat MakeFromEulerConstexpr(float x_pitch, float y_yaw, float z_roll);
+
 	/////////////////////////////////////////////////////
 	// Conversion Functions
 public:
@@ -108,6 +153,22 @@ public:
 	// ONLY USE FOR RENDERING!!!
 	Matrix3x3 Matrix() const;
 
+	/*
+	 * Get the rotation matrix of this quaternion directly from w/x/y/z.
+	 *
+	 * Gives the same matrix as GetRotator().Matrix() (including the
+	 * Forward/Up/Right axis remapping) but without the Euler round trip,
+	 * so no atan2/asin/sin/cos calls are made.
+	 */
+	Matrix3x3 ToMatrix3x3() const;
+
+	// Get the full transformation matrix (Translation * Rotation * Scale)
+	Matrix4x4 ToMatrix4x4(const Vec3& scale, const Vec3& translation) const;
+
+	// Convert to a double or Fixed quaternion, e.g. QuatX{ q } (MathTypes.h)
+	template <typename T>
+	constexpr explicit operator TQuat<T>() const;
+
 	/////////////////////////////////////////////////////
 	// Member Functions
 public:
@@ -119,8 +180,8 @@ public:
 	// WARNING: Combining quaternions should be done by multiplication
 	inline Quat& operator+=(const Quat& q);
 	inline Quat& operator-=(const Quat& q);
-	inline Quat  operator+(const Quat& q) const;
-	inline Quat  operator-(const Quat& q) const;
+	constexpr Quat operator+(const Quat& q) const;
+	constexpr Quat operator-(const Quat& q) const;
 
 	/**
 	 * Gets the result of multiplying this by another quaternion (this * Q). 
@@ -132,30 +193,30 @@ public:
 	 * Note that (A * B) * C is equivalent to A * (B * C)
 	 * [Associative] but not [Commutative]
 	 */
-	inline Quat  operator*(const Quat& q) const;
+	constexpr Quat operator*(const Quat& q) const;
 	inline Quat& operator*=(const Quat& q);
 
 	// Quaternion scaling operations
 	// Do not use unless you know what you're doing
-	inline Quat  operator*(float scale) const;
+	constexpr Quat operator*(float scale) const;
 	inline Quat& operator*=(float scale);
-	inline Quat  operator/(float scale) const;
+	constexpr Quat operator/(float scale) const;
 	inline Quat& operator/=(float scale);
-	inline Quat  operator-() const;
+	constexpr Quat operator-() const;
 
 	// Comparison operations
-	inline bool Equals(const Quat& q, float tolerance = KINDA_SMALL_NUMBER) const;
-	inline bool IsIdentity(float tolerance = SMALL_NUMBER) const;
+	constexpr bool Equals(const Quat& q, float tolerance = KINDA_SMALL_NUMBER) const;
+	constexpr bool IsIdentity(float tolerance = SMALL_NUMBER) const;
 
 	/** 
 	 * Checks if two quaternions are identical. See Equals() for a 
 	 * comparison that allows for an error tolerance
 	 */
-	inline bool operator==(const Quat& q) const;
-	inline bool operator!=(const Quat& q) const;
+	constexpr bool operator==(const Quat& q) const;
+	constexpr bool operator!=(const Quat& q) const;
 
 	// Quaternion Inner Product
-	inline float operator|(const Quat& q) const;
+	constexpr float operator|(const Quat& q) const;
 
 	// Normalize this quaternion if its large enough. Returns Identity if too small.
 	inline void Normalize(float tolerance = SMALL_NUMBER);
@@ -164,25 +225,78 @@ public:
 	inline Quat GetNormalized(float tolerance = SMALL_NUMBER);
 
 	// Returns True if this quaternion is Normalized
-	bool IsNormalized() const;
+	constexpr bool IsNormalized() const;
 
 	// Length of the quaternion
 	inline float Size() const;
-	inline float SizeSquared() const;
+	constexpr float SizeSquared() const;
 
 	// Get Axis and Angle of rotation of this quaternion
 	inline void ToAxisAndAngle(Vec3& axis, float& angle);
 	inline float GetAngle() const;
 	inline Vec3 GetRotationAxis() const;
 
+	/**
+	 * Quaternion logarithm and exponential (as in UE4's FQuat).
+	 * Log of a unit quat is the pure quat (0, x, y, z) * angle / (2 sin(angle / 2)),
+	 * i.e. its vector part scaled to half the rotation angle. Exp ignores w
+	 * and maps such a pure quat back to the unit quat. Exp(Log(q)) == q.
+	 * Both use Exact trig whatever SNOVA_TRIG_ACCURACY is, so that holds
+	 * (to float rounding) at every tier.
+	 * Log only depends on q's direction, so it is the same for q * k, k > 0.
+	 */
+	Quat Log() const;
+	Quat Exp() const;
+
+	/**
+	 * Advance this rotation by angular velocity omega (rad/s) for dt seconds.
+	 * omega is in this rotation's local frame and uses the same axes as
+	 * Quat(Vec3, float), so this is *this *= Quat(omega.Normalized(), |omega| * dt).
+	 *
+	 * IntegrateAngularVelocity           - Exact, through Exp. One sin/cos.
+	 * IntegrateAngularVelocityFirstOrder - *this += *this * (0, omega * dt / 2), no trig.
+	 *     The step angle comes out short by about (|omega| dt)^3 / 12 and the
+	 *     length grows by about (|omega| dt)^2 / 8, so it is normalized
+	 *     (at full precision) unless you pass false and do it every few steps.
+	 *     At 120 Hz and 10 rad/s that is ~5e-5 rad and ~0.09% per step.
+	 */
+	void IntegrateAngularVelocity(const Vec3& omega, float dt);
+	void IntegrateAngularVelocityFirstOrder(const Vec3& omega, float dt, bool normalize = true);
+
+	/**
+	 * Step n rigid bodies at once: q[i].IntegrateAngularVelocity(omega[i], dt)
+	 * (or FirstOrder) a SIMD register at a time, normalizing on the steps
+	 * integration.renormalizeEvery asks for. Advances integration.step.
+	 * The lanes use default-tier sin/cos (FastTrig.h), so at Fast each step
+	 * is within ~0.003 degrees of the scalar one.
+	 * For bodies already in SoA form, use QuatBatch::IntegrateAngularVelocity.
+	 */
+	static void IntegrateAngularVelocityN(Quat* q, const Vec3* omega, float dt, size_t n, AngularIntegration& integration);
+
 	// Returns a vector rotated by this quaternion.
 	inline Vec3 RotateVector(Vec3 v) const;
 
 	// Returns a vector rotated by the inverse of this quaternion
 	inline Vec3 UnrotateVector(Vec3 v) const;
 
+	/*
+	 * out[i] = RotateVector(in[i]) / UnrotateVector(in[i]) for n vectors.
+	 * Builds the rotation matrix once, then streams the vectors through
+	 * SIMD (see TransformVectors in Matrix3x4.h). out may alias in.
+	 */
+	void RotateVectors(const Vec3* in, Vec3* out, size_t n) const;
+	void UnrotateVectors(const Vec3* in, Vec3* out, size_t n) const;
+
+	// Same over interleaved data, e.g. positions in a vertex buffer: vector i
+	// is the 3 floats i * stride bytes in. in == out (same stride) rotates in place
+	void RotateVectors(const float* in, size_t inStride, float* out, size_t outStride, size_t n) const;
+	void UnrotateVectors(const float* in, size_t inStride, float* out, size_t outStride, size_t n) const;
+
 	// Get the inverse of this quaternion (the inverse rotation). This quat must be normalized.
-	inline Quat Inverse() const;
+	constexpr Quat Inverse() const;
+
+	// Inverse rotation without the normalization check (w, -x, -y, -z)
+	constexpr Quat Conjugate() const;
 
 	/*
 	 * Enforce that the delta between this quat and another represents 
@@ -235,8 +349,31 @@ public:
 	/**
 	 * Generates the smallest geodesic rotation between 2 vectors of unit length (This is assumed).
 	 * Use this if you know the vectors are normalized to speed up computation.
+	 * Opposite vectors give a 180 degree turn about an axis perpendicular to v1:
+	 * (-v1.z, 0, v1.x) if |v1.x| > |v1.z|, else (0, -v1.z, v1.y).
 	 */
 	static inline Quat FindBetweenNormals(const Vec3& v1, const Vec3& v2);
+
+	/**
+	 * Rotation that turns the X axis (forward) to face forward, and the Y axis
+	 * (up) as close to up as it can get. Neither needs to be normalized.
+	 * If up is parallel to forward, the roll is whatever FindBetweenNormals gives.
+	 * A zero forward gives no swing.
+	 */
+	static Quat LookRotation(const Vec3& forward, const Vec3& up = Vec3{ 0.f, 1.f, 0.f });
+
+	/**
+	 * Batched orientation building for many entities:
+	 * out[i] = FindBetweenNormals(from[i], to[i]) / LookRotation(forward[i], up[i]).
+	 * The antiparallel cases are handled with selects instead of branches, so
+	 * vectors are processed a SIMD register at a time. Results are
+	 * normalized at full precision (see SlerpN). For arrays already in SoA
+	 * form, use the QuatBatch versions. The second LookRotationN uses the
+	 * same up (e.g. world up) for every element.
+	 */
+	static void FindBetweenNormalsN(const Vec3* from, const Vec3* to, Quat* out, size_t n);
+	static void LookRotationN(const Vec3* forward, const Vec3* up, Quat* out, size_t n);
+	static void LookRotationN(const Vec3* forward, const Vec3& up, Quat* out, size_t n);
 	
 	/*
 	 * Spherical Interpolation. Will correct alignment. 
@@ -244,6 +381,24 @@ public:
 	 */
 	static inline Quat Slerp(const Quat& q1, const Quat& q2, float t);
 
+	/**
+	 * Batched interpolation for animation blending: out[i] = Slerp(a[i], b[i], t[i]).
+	 * Quats are processed a SIMD register at a time (see QuatBatch).
+	 * out may alias a or b. Input must be normalized. Result is normalized.
+	 *
+	 * SlerpN     - Same weights as Slerp. The result is normalized at full
+	 *              precision, so it is closer to exact than Slerp (whose
+	 *              Math::InvSqrt is good to ~0.2%).
+	 * NlerpN     - Normalized lerp along the shorter arc. Cheapest; does not
+	 *              keep a constant angular velocity over t.
+	 * SlerpFastN - Slerp through a polynomial in cos(angle) instead of
+	 *              acos/sin. Max error against an exact slerp is ~1e-5 per
+	 *              component for t in [0, 1], worst for angles near 180 deg.
+	 */
+	static void SlerpN(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n);
+	static void NlerpN(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n);
+	static void SlerpFastN(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n);
+
 	/////////////////////////////////////////////////////
 	// For Debugging
 
@@ -251,8 +406,8 @@ public:
 	std::string ToString() const;
 	
 	// Check that no NaN values in quaternion
-	inline void DiagnosticCheckNaN() const;
-	inline bool ContainsNaN() const;
+	constexpr void DiagnosticCheckNaN() const;
+	constexpr bool ContainsNaN() const;
 
 private:
 	/////////////////////////////////////////////////////
@@ -269,19 +424,32 @@ private:
 // ------------------------- INLINE IMPLEMENTATIONS ---------------------
 
 /** Default constructor (Generates Identity Quaternion). */
-inline Quat::Quat()
+constexpr Quat::Quat()
 	: w(1.0f), x(0), y(0), z(0)
 {}
 
 // Constructor
-inline Quat::Quat(float InW, float InX, float InY, float InZ)
+constexpr Quat::Quat(float InW, float InX, float InY, float InZ)
 	: w(InW), x(InX), y(InY), z(InZ)
 {}
 
-inline Quat::Quat(const Quat& q)
-	: x(q.x), y(q.y), z(q.z), w(q.w)
+constexpr Quat::Quat(const Quat& q)
+	: w(q.w), x(q.x), y(q.y), z(q.z)
+{}
+
+template <typename T>
+constexpr Quat::Quat(const TQuat<T>& q)
+	: w(static_cast<float>(q.w)), x(static_cast<float>(q.x)), y(static_cast<float>(q.y)), z(static_cast<float>(q.z))
 {}
 
+template <typename T>
+constexpr Quat::operator TQuat<T>() const
+{
+	return TQuat<T>{ T(w), T(x), T(y), T(z) };
+}
+
+inline constexpr Quat Quat::Identity{ 1.f, 0.f, 0.f, 0.f };
+
 inline Quat::Quat(const Rotator & r)
 {
 	*this = r.Quaternion();
@@ -292,6 +460,32 @@ inline Quat Quat::MakeFromEuler(float x_pitch, float y_yaw, float z_roll)
 	return Rotator{ x_pitch, y_yaw, z_roll }.Quaternion();
 }
 
+constexpr Quat Quat::MakeFromAxisAngleConstexpr(const Vec3& Axis, float AngleRad)
+{
+	// Same axis remapping as Quat(Vec3, float)
+	float s = 0.f, c = 0.f;
+	Math::SinCosConstexpr(0.5f * AngleRad, s, c);
+	return Quat{ c, s * -Axis.z, s * -Axis.x, s * Axis.y };
+}
+
+constexpr Quat Quat::MakeFromEulerConstexpr(float x_pitch, float y_yaw, float z_roll)
+{
+	// Same formula as Rotator::Quaternion
+	constexpr float DEG_TO_RAD_DIVIDED_BY_2 = (PI / (180.f)) / 2.f;
+	float SP = 0.f, SY = 0.f, SR = 0.f, CP = 0.f, CY = 0.f, CR = 0.f;
+
+	Math::SinCosConstexpr(x_pitch * DEG_TO_RAD_DIVIDED_BY_2, SP, CP);
+	Math::SinCosConstexpr(y_yaw   * DEG_TO_RAD_DIVIDED_BY_2, SY, CY);
+	Math::SinCosConstexpr(z_roll  * DEG_TO_RAD_DIVIDED_BY_2, SR, CR);
+
+	return Quat{
+		 CR * CP * CY + SR * SP * SY,
+		 CR * SP * SY - SR * CP * CY,
+		-CR * SP * CY - SR * CP * SY,
+		 CR * CP * SY - SR * SP * CY
+	};
+}
+
 inline Quat& Quat::operator=(const Quat& q)
 {
 	x = q.x;
@@ -325,21 +519,21 @@ inline Quat& Quat::operator-=(const Quat& q)
 	return *this;
 }
 
-inline Quat Quat::operator+(const Quat& q) const
+constexpr Quat Quat::operator+(const Quat& q) const
 {
 	Quat r { w + q.w, x + q.x, y + q.y, z + q.z };
 	r.DiagnosticCheckNaN();
 	return r;
 }
 
-inline Quat Quat::operator-(const Quat& q) const
+constexpr Quat Quat::operator-(const Quat& q) const
 {
 	Quat r { w - q.w, x - q.x, y - q.y, z - q.z };
 	r.DiagnosticCheckNaN();
 	return r;
 }
 
-inline Quat Quat::operator*(const Quat& q) const
+constexpr Quat Quat::operator*(const Quat& q) const
 {
 	// Hamilton Product
 	Quat r{
@@ -360,7 +554,7 @@ inline Quat& Quat::operator*=(const Quat& q)
 	return *this;
 }
 
-inline Quat Quat::operator*(float scale) const
+constexpr Quat Quat::operator*(float scale) const
 {
 	return Quat(w * scale, x * scale, y * scale, z * scale);
 }
@@ -377,7 +571,7 @@ inline Quat& Quat::operator*=(float scale)
 	return *this;
 }
 
-inline Quat Quat::operator/(float scale) const
+constexpr Quat Quat::operator/(float scale) const
 {
 	return Quat(w / scale, x / scale, y / scale, z / scale);
 }
@@ -393,12 +587,12 @@ inline Quat& Quat::operator/=(float scale)
 	return *this;
 }
 
-inline Quat Quat::operator-() const
+constexpr Quat Quat::operator-() const
 {
 	return Quat{ -w,-x,-y,-z };
 }
 
-inline bool Quat::Equals(const Quat& q, float tolerance) const
+constexpr bool Quat::Equals(const Quat& q, float tolerance) const
 {
 	return (
 		Math::FloatEqual(w, q.w, tolerance) &&
@@ -408,12 +602,12 @@ inline bool Quat::Equals(const Quat& q, float tolerance) const
 		);
 }
 
-inline bool Quat::IsIdentity(float tolerance) const
+constexpr bool Quat::IsIdentity(float tolerance) const
 {
 	return Equals(Quat::Identity, tolerance);
 }
 
-inline bool Quat::operator==(const Quat& q) const
+constexpr bool Quat::operator==(const Quat& q) const
 {
 	return (
 		x == q.x &&
@@ -423,13 +617,13 @@ inline bool Quat::operator==(const Quat& q) const
 	);
 }
 
-inline bool Quat::operator!=(const Quat& q) const
+constexpr bool Quat::operator!=(const Quat& q) const
 {
 	return !operator==(q);
 }
 
 // Dot Product
-inline float Quat::operator|(const Quat& q) const
+constexpr float Quat::operator|(const Quat& q) const
 {
 	return w * q.w + x * q.x + y * q.y + z * q.z;
 }
@@ -464,11 +658,17 @@ inline float Quat::Size() const
 	return sqrtf(w * w + x * x + y * y + z * z);
 }
 
-inline float Quat::SizeSquared() const
+constexpr float Quat::SizeSquared() const
 {
 	return w * w + x * x + y * y + z * z;
 }
 
+constexpr bool Quat::IsNormalized() const
+{
+	// Allowed error for a normalized quaternion (THRESH_QUAT_NORMALIZED)
+	return Math::Abs(1.f - SizeSquared()) < 0.01f;
+}
+
 inline void Quat::ToAxisAndAngle(Vec3& axis, float& angle)
 {
 	axis = GetRotationAxis();
@@ -477,7 +677,7 @@ inline void Quat::ToAxisAndAngle(Vec3& axis, float& angle)
 
 inline float Quat::GetAngle() const
 {
-	return 2.f * acosf(w);
+	return 2.f * Math::Acos<Math::TrigAccuracy::Exact>(w);
 }
 
 inline Vec3 Quat::GetRotationAxis() const
@@ -514,14 +714,19 @@ inline Vec3 Quat::UnrotateVector(Vec3 V) const
 	return V + (w * T) + (Q ^ T);
 }
 
-inline Quat Quat::Inverse() const
+constexpr Quat Quat::Inverse() const
 {
 	if (IsNormalized())
-		return Quat{ w, -x, -y, -z };
+		return Conjugate();
 	else
 		return Quat::Identity; // Non-normalized quats not supported.
 }
 
+constexpr Quat Quat::Conjugate() const
+{
+	return Quat{ w, -x, -y, -z };
+}
+
 inline void Quat::EnforceShortestArcWith(const Quat& q)
 {
 	const float dotResult = *this | q;
@@ -570,7 +775,7 @@ inline Vec3 Quat::Vector() const
 inline float Quat::AngularDistance(const Quat& q) const
 {
 	float innerProduct = *this | q;
-	return acosf((2 * innerProduct * innerProduct) - 1.f);
+	return Math::Acos<Math::TrigAccuracy::Exact>((2 * innerProduct * innerProduct) - 1.f);
 }
 
 inline Quat Quat::FindBetween(const Vec3& v1, const Vec3& v2)
@@ -612,8 +817,8 @@ inline Quat Quat::FindBetween_Helper(const Vec3& A, const Vec3& B, float normAB)
 	else
 	{
 		// A and B are exactly opposite; So we generate a rotation that is
-		// 180 degrees around an arbitrary axis.
-		result = (fabsf(A.x) > fabsf(B.x))
+		// 180 degrees around an axis perpendicular to A.
+		result = (fabsf(A.x) > fabsf(A.z))
 			? Quat{ 0.f, -A.z, 0.f, A.x }
 			: Quat{ 0.f, 0.f, -A.z, A.y };
 	}
@@ -635,19 +840,20 @@ inline std::string Quat::ToString() const
 }
 
 #if ENABLE_NAN_CHECK
-inline void Quat::DiagnosticCheckNaN() const
+constexpr void Quat::DiagnosticCheckNaN() const
 {
 	if (ContainsNaN())
 	{
+		SNOVA_INSTRUMENT_EVENT(NAN_CHECK_HIT);
 		std::cout << "Quat contains NaN: " << ToString() << std::endl;
 		*const_cast<Quat*>(this) = Quat::Identity;
 	}
 }
 #else
-inline void Quat::DiagnosticCheckNaN() const {}
+constexpr void Quat::DiagnosticCheckNaN() const {}
 #endif
 
-inline bool Quat::ContainsNaN() const
+constexpr bool Quat::ContainsNaN() const
 {
 	return (!Math::IsFinite(x) ||
 		!Math::IsFinite(y) ||
@@ -0,0 +1,818 @@
+/******************************************************************************/
+/*!
+\file		QuatBatch.cpp
+\author		Justin Leow
+\brief
+	Structure-of-arrays containers for many quaternions / vectors at once.
+
+	Kernels are templates over the SIMD lane type. They run with SIMD::Wide
+	over whole registers and with SIMD::Scalar over the remaining tail.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "QuatBatch.h"
+#include "SIMD.h"
+#include <algorithm>
+#include <utility>
+
+namespace SNova
+{
+
+// Allowed error for a normalized quaternion (same as Quat::IsNormalized)
+#define THRESH_QUAT_NORMALIZED 0.01f
+
+namespace
+{
+	/////////////////////////////////////////////////////
+	// Kernels. Each processes L::Width elements starting at i
+
+	template <typename L>
+	inline void MultiplyKernel(size_t i,
+		const float* aw, const float* ax, const float* ay, const float* az,
+		const float* bw, const float* bx, const float* by, const float* bz,
+		float* ow, float* ox, float* oy, float* oz)
+	{
+		const L w1 = L::Load(aw + i), x1 = L::Load(ax + i), y1 = L::Load(ay + i), z1 = L::Load(az + i);
+		const L w2 = L::Load(bw + i), x2 = L::Load(bx + i), y2 = L::Load(by + i), z2 = L::Load(bz + i);
+
+		// Hamilton Product
+		(w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2).Store(ow + i);
+		(w1 * x2 + x1 * w2 + y1 * z2 - z1 * y2).Store(ox + i);
+		(w1 * y2 - x1 * z2 + y1 * w2 + z1 * x2).Store(oy + i);
+		(w1 * z2 + x1 * y2 - y1 * x2 + z1 * w2).Store(oz + i);
+	}
+
+	template <typename L>
+	inline void NormalizeLanes(float tolerance, L& qw, L& qx, L& qy, L& qz)
+	{
+		const L squareSum = qw * qw + qx * qx + qy * qy + qz * qz;
+		const L bigEnough = CmpGE(squareSum, L::Set(tolerance));
+
+		// Lanes that fail the tolerance become Identity
+		const L scale = Select(bigEnough, InvSqrt(squareSum), L::Set(0.f));
+		qw = Select(bigEnough, qw * scale, L::Set(1.f));
+		qx = qx * scale;
+		qy = qy * scale;
+		qz = qz * scale;
+	}
+
+	template <typename L>
+	inline void StoreNormalized(size_t i, float tolerance, L qw, L qx, L qy, L qz,
+		float* w, float* x, float* y, float* z)
+	{
+		NormalizeLanes(tolerance, qw, qx, qy, qz);
+		qw.Store(w + i);
+		qx.Store(x + i);
+		qy.Store(y + i);
+		qz.Store(z + i);
+	}
+
+	template <typename L>
+	inline void NormalizeKernel(size_t i, float tolerance, float* w, float* x, float* y, float* z)
+	{
+		const L qw = L::Load(w + i), qx = L::Load(x + i), qy = L::Load(y + i), qz = L::Load(z + i);
+		StoreNormalized(i, tolerance, qw, qx, qy, qz, w, x, y, z);
+	}
+
+	template <typename L>
+	inline void InverseKernel(size_t i,
+		const float* w, const float* x, const float* y, const float* z,
+		float* ow, float* ox, float* oy, float* oz)
+	{
+		const L qw = L::Load(w + i), qx = L::Load(x + i), qy = L::Load(y + i), qz = L::Load(z + i);
+		const L sizeSq = qw * qw + qx * qx + qy * qy + qz * qz;
+		const L normalized = CmpLT(Abs(L::Set(1.f) - sizeSq), L::Set(THRESH_QUAT_NORMALIZED));
+
+		// Non-normalized quats give Identity
+		const L zero = L::Set(0.f);
+		Select(normalized, qw, L::Set(1.f)).Store(ow + i);
+		Select(normalized, -qx, zero).Store(ox + i);
+		Select(normalized, -qy, zero).Store(oy + i);
+		Select(normalized, -qz, zero).Store(oz + i);
+	}
+
+	template <typename L>
+	inline void DotKernel(size_t i,
+		const float* aw, const float* ax, const float* ay, const float* az,
+		const float* bw, const float* bx, const float* by, const float* bz,
+		float* out)
+	{
+		(L::Load(aw + i) * L::Load(bw + i)
+			+ L::Load(ax + i) * L::Load(bx + i)
+			+ L::Load(ay + i) * L::Load(by + i)
+			+ L::Load(az + i) * L::Load(bz + i)).Store(out + i);
+	}
+
+	template <typename L>
+	inline void RotateKernel(size_t i, float sign,
+		const float* w, const float* x, const float* y, const float* z,
+		const float* vx, const float* vy, const float* vz,
+		float* ox, float* oy, float* oz)
+	{
+		// Same formula as Quat::RotateVector
+		// T = 2(Q x V); V' = V + w*(T) + (Q x T)
+		// sign = -1 negates Q to unrotate
+		const L s = L::Set(sign);
+		const L qw = L::Load(w + i);
+		const L qx = L::Load(x + i) * s, qy = L::Load(y + i) * s, qz = L::Load(z + i) * s;
+		const L Vx = L::Load(vx + i), Vy = L::Load(vy + i), Vz = L::Load(vz + i);
+
+		const L two = L::Set(2.f);
+		const L tx = two * (qy * Vz - Vy * qz);
+		const L ty = two * (qz * Vx - Vz * qx);
+		const L tz = two * (qx * Vy - Vx * qy);
+
+		(Vx + qw * tx + (qy * tz - ty * qz)).Store(ox + i);
+		(Vy + qw * ty + (qz * tx - tz * qx)).Store(oy + i);
+		(Vz + qw * tz + (qx * ty - tx * qy)).Store(oz + i);
+	}
+
+	/**
+	 * Quat::FindBetween_Helper with normAB = 1, before the Normalize.
+	 * The antiparallel fallback is picked with selects, not a branch.
+	 */
+	template <typename L>
+	inline void FindBetweenLanes(L ax, L ay, L az, L bx, L by, L bz, L& w, L& x, L& y, L& z)
+	{
+		const L zero = L::Set(0.f);
+		const L resultW = L::Set(1.f) + ax * bx + ay * by + az * bz;
+		const L regular = CmpGE(resultW, L::Set(KINDA_SMALL_NUMBER));
+
+		// Opposite: (0, -A.z, 0, A.x) or (0, 0, -A.z, A.y)
+		const L pickX = CmpGT(Abs(ax), Abs(az));
+		w = Select(regular, resultW, zero);
+		x = Select(regular, ay * bz - az * by, Select(pickX, -az, zero));
+		y = Select(regular, az * bx - ax * bz, Select(pickX, zero, -az));
+		z = Select(regular, ax * by - ay * bx, Select(pickX, ax, ay));
+	}
+
+	// NormalizeVector3D, except lanes too small to normalize are multiplied by tooSmallScale
+	template <typename L>
+	inline void NormalizeVectorLanes(float tooSmallScale, L& x, L& y, L& z)
+	{
+		const L magnitudeSq = x * x + y * y + z * z;
+		const L ok = CmpGT(magnitudeSq, L::Set(EPSILON));
+		const L scale = Select(ok, L::Set(1.f) / Sqrt(magnitudeSq), L::Set(tooSmallScale));
+		x = x * scale;
+		y = y * scale;
+		z = z * scale;
+	}
+
+	template <typename L>
+	inline void FindBetweenKernel(size_t i,
+		const float* ax, const float* ay, const float* az,
+		const float* bx, const float* by, const float* bz,
+		float* ow, float* ox, float* oy, float* oz)
+	{
+		L w, x, y, z;
+		FindBetweenLanes(L::Load(ax + i), L::Load(ay + i), L::Load(az + i),
+			L::Load(bx + i), L::Load(by + i), L::Load(bz + i), w, x, y, z);
+		StoreNormalized(i, SMALL_NUMBER, w, x, y, z, ow, ox, oy, oz);
+	}
+
+	// Same steps as Quat::LookRotation
+	template <typename L>
+	inline void LookRotationKernel(size_t i,
+		const float* fx, const float* fy, const float* fz, L upX, L upY, L upZ,
+		float* ow, float* ox, float* oy, float* oz)
+	{
+		const L zero = L::Set(0.f), one = L::Set(1.f), two = L::Set(2.f);
+
+		L Fx = L::Load(fx + i), Fy = L::Load(fy + i), Fz = L::Load(fz + i);
+		NormalizeVectorLanes(1.f, Fx, Fy, Fz);
+
+		// Swing the X axis onto F
+		L sw, sx, sy, sz;
+		FindBetweenLanes(one, zero, zero, Fx, Fy, Fz, sw, sx, sy, sz);
+		NormalizeLanes(SMALL_NUMBER, sw, sx, sy, sz);
+
+		// Part of up perpendicular to F, or 0
+		const L FdotUp = Fx * upX + Fy * upY + Fz * upZ;
+		L Yx = upX - Fx * FdotUp, Yy = upY - Fy * FdotUp, Yz = upZ - Fz * FdotUp;
+		NormalizeVectorLanes(0.f, Yx, Yy, Yz);
+
+		// U = swing.RotateVector(0, 1, 0): T = 2(Q x V); U = V + w*T + (Q x T)
+		const L tx = -two * sz, ty = zero, tz = two * sx;
+		const L Ux = sw * tx + (sy * tz - ty * sz);
+		const L Uy = one + sw * ty + (sz * tx - tz * sx);
+		const L Uz = sw * tz + (sx * ty - tx * sy);
+
+		// Roll U onto Y around F, from the cos/sin of the angle between them
+		const L cosRoll = Ux * Yx + Uy * Yy + Uz * Yz;
+		const L sinRoll = (Uy * Yz - Yy * Uz) * Fx + (Uz * Yx - Yz * Ux) * Fy + (Ux * Yy - Yx * Uy) * Fz;
+		const L useCos = CmpGE(cosRoll, zero);
+		L rw = Select(useCos, one + cosRoll, sinRoll);
+		const L axisScale = Select(useCos, sinRoll, one - cosRoll);
+		L rx = axisScale * Fx, ry = axisScale * Fy, rz = axisScale * Fz;
+		NormalizeLanes(SMALL_NUMBER, rw, rx, ry, rz);
+
+		// roll * swing (Hamilton Product)
+		(rw * sw - rx * sx - ry * sy - rz * sz).Store(ow + i);
+		(rw * sx + rx * sw + ry * sz - rz * sy).Store(ox + i);
+		(rw * sy - rx * sz + ry * sw + rz * sx).Store(oy + i);
+		(rw * sz + rx * sy - ry * sx + rz * sw).Store(oz + i);
+	}
+
+	/**
+	 * Quat::IntegrateAngularVelocity / IntegrateAngularVelocityFirstOrder in
+	 * place: q = q * delta, delta = Exp(0, v) or (1, v) with v = omega * dt / 2
+	 */
+	template <AngularIntegration::Method METHOD, typename L>
+	inline void IntegrateKernel(size_t i, float halfDt, bool normalize,
+		const float* omegaX, const float* omegaY, const float* omegaZ,
+		float* w, float* x, float* y, float* z)
+	{
+		const L one = L::Set(1.f), h = L::Set(halfDt);
+
+		// Same axis remapping as Quat(Vec3, float)
+		const L vx = -L::Load(omegaZ + i) * h, vy = -L::Load(omegaX + i) * h, vz = L::Load(omegaY + i) * h;
+
+		L dw = one, dx = vx, dy = vy, dz = vz;
+		if (METHOD == AngularIntegration::Method::Exact)
+		{
+			const L halfAngle = Sqrt(vx * vx + vy * vy + vz * vz);
+			L s, c;
+			SIMD::SinCos<Math::DEFAULT_TRIG_ACCURACY>(halfAngle, s, c);
+
+			// sin(a) / a goes to 1
+			const L bigEnough = CmpGE(halfAngle, L::Set(SMALL_NUMBER));
+			const L scale = Select(bigEnough, s / Select(bigEnough, halfAngle, one), one);
+			dw = c;
+			dx = vx * scale;
+			dy = vy * scale;
+			dz = vz * scale;
+		}
+
+		const L qw = L::Load(w + i), qx = L::Load(x + i), qy = L::Load(y + i), qz = L::Load(z + i);
+
+		// q * delta (Hamilton Product)
+		L rw = qw * dw - qx * dx - qy * dy - qz * dz;
+		L rx = qw * dx + qx * dw + qy * dz - qz * dy;
+		L ry = qw * dy - qx * dz + qy * dw + qz * dx;
+		L rz = qw * dz + qx * dy - qy * dx + qz * dw;
+		if (normalize)
+			NormalizeLanes(SMALL_NUMBER, rw, rx, ry, rz);
+
+		rw.Store(w + i);
+		rx.Store(x + i);
+		ry.Store(y + i);
+		rz.Store(z + i);
+	}
+
+	// Counts the step, and returns whether it should normalize
+	inline bool NextStepNormalizes(AngularIntegration& integration)
+	{
+		++integration.step;
+		const uint32_t every = integration.renormalizeEvery;
+		return (every != 0) && (integration.step % every == 0);
+	}
+
+	template <AngularIntegration::Method METHOD>
+	void IntegrateArrays(size_t count, float dt, bool normalize,
+		const float* omegaX, const float* omegaY, const float* omegaZ,
+		float* w, float* x, float* y, float* z)
+	{
+		const float halfDt = 0.5f * dt;
+		SIMD::RunBatch(count, [&](size_t i, auto lane)
+		{
+			IntegrateKernel<METHOD, decltype(lane)>(i, halfDt, normalize, omegaX, omegaY, omegaZ, w, x, y, z);
+		});
+	}
+
+	inline void IntegrateArrays(AngularIntegration::Method method, size_t count, float dt, bool normalize,
+		const float* omegaX, const float* omegaY, const float* omegaZ,
+		float* w, float* x, float* y, float* z)
+	{
+		if (method == AngularIntegration::Method::Exact)
+			IntegrateArrays<AngularIntegration::Method::Exact>(count, dt, normalize, omegaX, omegaY, omegaZ, w, x, y, z);
+		else
+			IntegrateArrays<AngularIntegration::Method::FirstOrder>(count, dt, normalize, omegaX, omegaY, omegaZ, w, x, y, z);
+	}
+
+	enum class BlendMode { Slerp, Nlerp, SlerpFast };
+
+	/**
+	 * Coefficients of the acos/sin-free slerp from
+	 * D. Eberly, "A Fast and Accurate Algorithm for Computing SLERP" (2011).
+	 * u[i] = 1 / (i * (2i + 1)), v[i] = i / (2i + 1) for i = 1..8, with the
+	 * last pair scaled by (1 + mu) to fold in the truncated tail.
+	 */
+	static constexpr float SLERP_ONE_PLUS_MU = 1.90110745351730037f;
+	static constexpr float SLERP_U[8] = {
+		1.f / (1 * 3), 1.f / (2 * 5), 1.f / (3 * 7), 1.f / (4 * 9),
+		1.f / (5 * 11), 1.f / (6 * 13), 1.f / (7 * 15), SLERP_ONE_PLUS_MU / (8 * 17) };
+	static constexpr float SLERP_V[8] = {
+		1.f / 3, 2.f / 5, 3.f / 7, 4.f / 9,
+		5.f / 11, 6.f / 13, 7.f / 15, SLERP_ONE_PLUS_MU * 8 / 17 };
+
+	template <BlendMode MODE, typename L>
+	inline void BlendKernel(size_t i, const float* t,
+		const float* aw, const float* ax, const float* ay, const float* az,
+		const float* bw, const float* bx, const float* by, const float* bz,
+		float* ow, float* ox, float* oy, float* oz)
+	{
+		const L w1 = L::Load(aw + i), x1 = L::Load(ax + i), y1 = L::Load(ay + i), z1 = L::Load(az + i);
+		const L w2 = L::Load(bw + i), x2 = L::Load(bx + i), y2 = L::Load(by + i), z2 = L::Load(bz + i);
+		const L T = L::Load(t + i);
+		const L one = L::Set(1.f);
+
+		// Align quats so they take the shorter route (flip b if needed)
+		const L rawCosSum = w1 * w2 + x1 * x2 + y1 * y2 + z1 * z2;
+		const L cosSum = Abs(rawCosSum);
+		const L sign = Select(CmpGE(rawCosSum, L::Set(0.f)), one, -one);
+
+		L scale0, scale1;
+		if (MODE == BlendMode::Nlerp)
+		{
+			scale0 = one - T;
+			scale1 = T;
+		}
+		else if (MODE == BlendMode::SlerpFast)
+		{
+			// scale(t) = t * (1 + b0(t) * (1 + b1(t) * ( ... (1 + b7(t)))))
+			// with bi(t) = (u[i] * t^2 - v[i]) * (cos - 1)
+			const L d = one - T;
+			const L sqrT = T * T, sqrD = d * d;
+			const L xm1 = cosSum - one;
+
+			L cT = one, cD = one;
+			for (int k = 7; k >= 0; --k)
+			{
+				const L u = L::Set(SLERP_U[k]), v = L::Set(SLERP_V[k]);
+				cT = one + (u * sqrT - v) * xm1 * cT;
+				cD = one + (u * sqrD - v) * xm1 * cD;
+			}
+			scale0 = d * cD;
+			scale1 = T * cT;
+		}
+		else
+		{
+			// Same weights as Slerp_NotNormalized
+			const L omega = SIMD::Acos<Math::DEFAULT_TRIG_ACCURACY>(cosSum);
+			const L sinOmega = SIMD::Sin<Math::DEFAULT_TRIG_ACCURACY>(omega);
+			const L sin0 = SIMD::Sin<Math::DEFAULT_TRIG_ACCURACY>((one - T) * omega);
+			const L sin1 = SIMD::Sin<Math::DEFAULT_TRIG_ACCURACY>(T * omega);
+
+			// Inputs too close; use linear interpolation.
+			const L farEnough = CmpLT(cosSum, L::Set(0.9999f));
+			const L invSin = one / Select(farEnough, sinOmega, one);
+			scale0 = Select(farEnough, sin0 * invSin, one - T);
+			scale1 = Select(farEnough, sin1 * invSin, T);
+		}
+		scale1 = scale1 * sign;
+
+		StoreNormalized(i, SMALL_NUMBER,
+			scale0 * w1 + scale1 * w2, scale0 * x1 + scale1 * x2,
+			scale0 * y1 + scale1 * y2, scale0 * z1 + scale1 * z2,
+			ow, ox, oy, oz);
+	}
+
+	using SIMD::RunBatch;
+
+	template <BlendMode MODE>
+	void BlendBatch(const QuatBatch& a, const QuatBatch& b, const float* t, QuatBatch& out)
+	{
+		const size_t count = Math::Min(a.Size(), b.Size());
+		if (out.Size() < count)
+			out.Resize(count);
+
+		RunBatch(count, [&](size_t i, auto lane)
+		{
+			BlendKernel<MODE, decltype(lane)>(i, t, a.w, a.x, a.y, a.z, b.w, b.x, b.y, b.z, out.w, out.x, out.y, out.z);
+		});
+	}
+
+	template <BlendMode MODE>
+	void BlendQuats(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n)
+	{
+		// Quat is array-of-structs (and may be bound), so go through a small
+		// SoA staging buffer that stays in L1
+		static constexpr size_t CHUNK = 64;
+		alignas(SIMD::ALIGNMENT) float lanes[12][CHUNK];
+		float* const aw = lanes[0]; float* const ax = lanes[1]; float* const ay = lanes[2]; float* const az = lanes[3];
+		float* const bw = lanes[4]; float* const bx = lanes[5]; float* const by = lanes[6]; float* const bz = lanes[7];
+		float* const ow = lanes[8]; float* const ox = lanes[9]; float* const oy = lanes[10]; float* const oz = lanes[11];
+
+		for (size_t base = 0; base < n; base += CHUNK)
+		{
+			const size_t count = Math::Min(CHUNK, n - base);
+
+			for (size_t k = 0; k < count; ++k)
+			{
+				const Quat& q1 = a[base + k];
+				const Quat& q2 = b[base + k];
+				aw[k] = q1.w; ax[k] = q1.x; ay[k] = q1.y; az[k] = q1.z;
+				bw[k] = q2.w; bx[k] = q2.x; by[k] = q2.y; bz[k] = q2.z;
+			}
+
+			RunBatch(count, [&](size_t i, auto lane)
+			{
+				BlendKernel<MODE, decltype(lane)>(i, t + base, aw, ax, ay, az, bw, bx, by, bz, ow, ox, oy, oz);
+			});
+
+			// Assign through Quat so bound Transforms are updated
+			for (size_t k = 0; k < count; ++k)
+				out[base + k] = Quat{ ow[k], ox[k], oy[k], oz[k] };
+		}
+	}
+
+	/**
+	 * Vec3 arrays a[] and b[] in, Quat array out, through SoA staging like
+	 * BlendQuats. fn(i, lane, lanes) runs a kernel on lanes[0..2] (a),
+	 * lanes[3..5] (b) and lanes[6..9] (out w, x, y, z). b may be null.
+	 */
+	template <typename Fn>
+	void Vec3PairsToQuats(const Vec3* a, const Vec3* b, Quat* out, size_t n, Fn&& fn)
+	{
+		static constexpr size_t CHUNK = 64;
+		alignas(SIMD::ALIGNMENT) float buffer[10][CHUNK];
+		float* lanes[10];
+		for (size_t k = 0; k < 10; ++k)
+			lanes[k] = buffer[k];
+
+		for (size_t base = 0; base < n; base += CHUNK)
+		{
+			const size_t count = Math::Min(CHUNK, n - base);
+
+			for (size_t k = 0; k < count; ++k)
+			{
+				const Vec3& v = a[base + k];
+				lanes[0][k] = v.x; lanes[1][k] = v.y; lanes[2][k] = v.z;
+			}
+			if (b)
+			{
+				for (size_t k = 0; k < count; ++k)
+				{
+					const Vec3& v = b[base + k];
+					lanes[3][k] = v.x; lanes[4][k] = v.y; lanes[5][k] = v.z;
+				}
+			}
+
+			RunBatch(count, [&](size_t i, auto lane)
+			{
+				fn(i, lane, lanes);
+			});
+
+			// Assign through Quat so bound Transforms are updated
+			for (size_t k = 0; k < count; ++k)
+				out[base + k] = Quat{ lanes[6][k], lanes[7][k], lanes[8][k], lanes[9][k] };
+		}
+	}
+}
+
+/////////////////////////////////////////////////////
+// Vec3Batch
+
+Vec3Batch::Vec3Batch(size_t count)
+{
+	Resize(count);
+}
+
+Vec3Batch::Vec3Batch(const Vec3Batch& rhs)
+{
+	*this = rhs;
+}
+
+Vec3Batch::Vec3Batch(Vec3Batch&& rhs) noexcept
+{
+	*this = std::move(rhs);
+}
+
+Vec3Batch& Vec3Batch::operator=(const Vec3Batch& rhs)
+{
+	if (this != &rhs)
+	{
+		Resize(rhs.m_Size);
+		std::copy(rhs.x, rhs.x + m_Size, x);
+		std::copy(rhs.y, rhs.y + m_Size, y);
+		std::copy(rhs.z, rhs.z + m_Size, z);
+	}
+	return *this;
+}
+
+Vec3Batch& Vec3Batch::operator=(Vec3Batch&& rhs) noexcept
+{
+	std::swap(x, rhs.x);
+	std::swap(y, rhs.y);
+	std::swap(z, rhs.z);
+	std::swap(mp_Buffer, rhs.mp_Buffer);
+	std::swap(m_Size, rhs.m_Size);
+	return *this;
+}
+
+Vec3Batch::~Vec3Batch()
+{
+	if (mp_Buffer)
+		SIMD::FreeFloats(mp_Buffer);
+}
+
+void Vec3Batch::Resize(size_t count)
+{
+	if (count == m_Size)
+		return;
+
+	// One allocation; each component array starts on an aligned boundary
+	const size_t stride = SIMD::PadCount(count);
+	float* buffer = SIMD::AllocateFloats(stride * 3);
+	std::fill(buffer, buffer + stride * 3, 0.f);
+
+	const size_t keep = Math::Min(count, m_Size);
+	if (mp_Buffer)
+	{
+		std::copy(x, x + keep, buffer);
+		std::copy(y, y + keep, buffer + stride);
+		std::copy(z, z + keep, buffer + stride * 2);
+		SIMD::FreeFloats(mp_Buffer);
+	}
+
+	mp_Buffer = buffer;
+	x = buffer;
+	y = buffer + stride;
+	z = buffer + stride * 2;
+	m_Size = count;
+}
+
+/////////////////////////////////////////////////////
+// QuatBatch
+
+QuatBatch::QuatBatch(size_t count)
+{
+	Resize(count);
+}
+
+QuatBatch::QuatBatch(const QuatBatch& rhs)
+{
+	*this = rhs;
+}
+
+QuatBatch::QuatBatch(QuatBatch&& rhs) noexcept
+{
+	*this = std::move(rhs);
+}
+
+QuatBatch& QuatBatch::operator=(const QuatBatch& rhs)
+{
+	if (this != &rhs)
+	{
+		Resize(rhs.m_Size);
+		std::copy(rhs.w, rhs.w + m_Size, w);
+		std::copy(rhs.x, rhs.x + m_Size, x);
+		std::copy(rhs.y, rhs.y + m_Size, y);
+		std::copy(rhs.z, rhs.z + m_Size, z);
+	}
+	return *this;
+}
+
+QuatBatch& QuatBatch::operator=(QuatBatch&& rhs) noexcept
+{
+	std::swap(w, rhs.w);
+	std::swap(x, rhs.x);
+	std::swap(y, rhs.y);
+	std::swap(z, rhs.z);
+	std::swap(mp_Buffer, rhs.mp_Buffer);
+	std::swap(m_Size, rhs.m_Size);
+	return *this;
+}
+
+QuatBatch::~QuatBatch()
+{
+	if (mp_Buffer)
+		SIMD::FreeFloats(mp_Buffer);
+}
+
+void QuatBatch::Resize(size_t count)
+{
+	if (count == m_Size)
+		return;
+
+	// One allocation; each component array starts on an aligned boundary
+	const size_t stride = SIMD::PadCount(count);
+	float* buffer = SIMD::AllocateFloats(stride * 4);
+	std::fill(buffer, buffer + stride, 1.f);
+	std::fill(buffer + stride, buffer + stride * 4, 0.f);
+
+	const size_t keep = Math::Min(count, m_Size);
+	if (mp_Buffer)
+	{
+		std::copy(w, w + keep, buffer);
+		std::copy(x, x + keep, buffer + stride);
+		std::copy(y, y + keep, buffer + stride * 2);
+		std::copy(z, z + keep, buffer + stride * 3);
+		SIMD::FreeFloats(mp_Buffer);
+	}
+
+	mp_Buffer = buffer;
+	w = buffer;
+	x = buffer + stride;
+	y = buffer + stride * 2;
+	z = buffer + stride * 3;
+	m_Size = count;
+}
+
+void QuatBatch::Multiply(const QuatBatch& a, const QuatBatch& b, QuatBatch& out)
+{
+	const size_t count = Math::Min(a.m_Size, b.m_Size);
+	if (out.m_Size < count)
+		out.Resize(count);
+
+	RunBatch(count, [&](size_t i, auto lane)
+	{
+		MultiplyKernel<decltype(lane)>(i, a.w, a.x, a.y, a.z, b.w, b.x, b.y, b.z, out.w, out.x, out.y, out.z);
+	});
+}
+
+void QuatBatch::Normalize(float tolerance)
+{
+	RunBatch(m_Size, [&](size_t i, auto lane)
+	{
+		NormalizeKernel<decltype(lane)>(i, tolerance, w, x, y, z);
+	});
+}
+
+void QuatBatch::Inverse(QuatBatch& out) const
+{
+	if (out.m_Size < m_Size)
+		out.Resize(m_Size);
+
+	RunBatch(m_Size, [&](size_t i, auto lane)
+	{
+		InverseKernel<decltype(lane)>(i, w, x, y, z, out.w, out.x, out.y, out.z);
+	});
+}
+
+void QuatBatch::Dot(const QuatBatch& q, float* out) const
+{
+	const size_t count = Math::Min(m_Size, q.m_Size);
+	RunBatch(count, [&](size_t i, auto lane)
+	{
+		DotKernel<decltype(lane)>(i, w, x, y, z, q.w, q.x, q.y, q.z, out);
+	});
+}
+
+void QuatBatch::RotateVectors(const Vec3Batch& in, Vec3Batch& out) const
+{
+	const size_t count = Math::Min(m_Size, in.Size());
+	if (out.Size() < count)
+		out.Resize(count);
+
+	RunBatch(count, [&](size_t i, auto lane)
+	{
+		RotateKernel<decltype(lane)>(i, 1.f, w, x, y, z, in.x, in.y, in.z, out.x, out.y, out.z);
+	});
+}
+
+void QuatBatch::UnrotateVectors(const Vec3Batch& in, Vec3Batch& out) const
+{
+	const size_t count = Math::Min(m_Size, in.Size());
+	if (out.Size() < count)
+		out.Resize(count);
+
+	RunBatch(count, [&](size_t i, auto lane)
+	{
+		RotateKernel<decltype(lane)>(i, -1.f, w, x, y, z, in.x, in.y, in.z, out.x, out.y, out.z);
+	});
+}
+
+void QuatBatch::Slerp(const QuatBatch& a, const QuatBatch& b, const float* t, QuatBatch& out)
+{
+	BlendBatch<BlendMode::Slerp>(a, b, t, out);
+}
+
+void QuatBatch::Nlerp(const QuatBatch& a, const QuatBatch& b, const float* t, QuatBatch& out)
+{
+	BlendBatch<BlendMode::Nlerp>(a, b, t, out);
+}
+
+void QuatBatch::SlerpFast(const QuatBatch& a, const QuatBatch& b, const float* t, QuatBatch& out)
+{
+	BlendBatch<BlendMode::SlerpFast>(a, b, t, out);
+}
+
+void QuatBatch::IntegrateAngularVelocity(const Vec3Batch& omega, float dt, AngularIntegration& integration)
+{
+	const bool normalize = NextStepNormalizes(integration);
+	IntegrateArrays(integration.method, Math::Min(m_Size, omega.Size()), dt, normalize,
+		omega.x, omega.y, omega.z, w, x, y, z);
+}
+
+void QuatBatch::FindBetweenNormals(const Vec3Batch& from, const Vec3Batch& to, QuatBatch& out)
+{
+	const size_t count = Math::Min(from.Size(), to.Size());
+	if (out.Size() < count)
+		out.Resize(count);
+
+	RunBatch(count, [&](size_t i, auto lane)
+	{
+		FindBetweenKernel<decltype(lane)>(i, from.x, from.y, from.z, to.x, to.y, to.z, out.w, out.x, out.y, out.z);
+	});
+}
+
+void QuatBatch::LookRotation(const Vec3Batch& forward, const Vec3Batch& up, QuatBatch& out)
+{
+	const size_t count = Math::Min(forward.Size(), up.Size());
+	if (out.Size() < count)
+		out.Resize(count);
+
+	RunBatch(count, [&](size_t i, auto lane)
+	{
+		using L = decltype(lane);
+		LookRotationKernel<L>(i, forward.x, forward.y, forward.z,
+			L::Load(up.x + i), L::Load(up.y + i), L::Load(up.z + i), out.w, out.x, out.y, out.z);
+	});
+}
+
+void QuatBatch::LookRotation(const Vec3Batch& forward, const Vec3& up, QuatBatch& out)
+{
+	const size_t count = forward.Size();
+	if (out.Size() < count)
+		out.Resize(count);
+
+	RunBatch(count, [&](size_t i, auto lane)
+	{
+		using L = decltype(lane);
+		LookRotationKernel<L>(i, forward.x, forward.y, forward.z,
+			L::Set(up.x), L::Set(up.y), L::Set(up.z), out.w, out.x, out.y, out.z);
+	});
+}
+
+/////////////////////////////////////////////////////
+// Quat batch entry points (declared in Quat.h)
+
+void Quat::FindBetweenNormalsN(const Vec3* from, const Vec3* to, Quat* out, size_t n)
+{
+	Vec3PairsToQuats(from, to, out, n, [](size_t i, auto lane, float* const* l)
+	{
+		FindBetweenKernel<decltype(lane)>(i, l[0], l[1], l[2], l[3], l[4], l[5], l[6], l[7], l[8], l[9]);
+	});
+}
+
+void Quat::LookRotationN(const Vec3* forward, const Vec3* up, Quat* out, size_t n)
+{
+	Vec3PairsToQuats(forward, up, out, n, [](size_t i, auto lane, float* const* l)
+	{
+		using L = decltype(lane);
+		LookRotationKernel<L>(i, l[0], l[1], l[2],
+			L::Load(l[3] + i), L::Load(l[4] + i), L::Load(l[5] + i), l[6], l[7], l[8], l[9]);
+	});
+}
+
+void Quat::LookRotationN(const Vec3* forward, const Vec3& up, Quat* out, size_t n)
+{
+	Vec3PairsToQuats(forward, static_cast<const Vec3*>(nullptr), out, n, [&up](size_t i, auto lane, float* const* l)
+	{
+		using L = decltype(lane);
+		LookRotationKernel<L>(i, l[0], l[1], l[2],
+			L::Set(up.x), L::Set(up.y), L::Set(up.z), l[6], l[7], l[8], l[9]);
+	});
+}
+
+void Quat::IntegrateAngularVelocityN(Quat* q, const Vec3* omega, float dt, size_t n, AngularIntegration& integration)
+{
+	const bool normalize = NextStepNormalizes(integration);
+
+	// SoA staging like BlendQuats
+	static constexpr size_t CHUNK = 64;
+	alignas(SIMD::ALIGNMENT) float lanes[7][CHUNK];
+	float* const qw = lanes[0]; float* const qx = lanes[1]; float* const qy = lanes[2]; float* const qz = lanes[3];
+	float* const ox = lanes[4]; float* const oy = lanes[5]; float* const oz = lanes[6];
+
+	for (size_t base = 0; base < n; base += CHUNK)
+	{
+		const size_t count = Math::Min(CHUNK, n - base);
+
+		for (size_t k = 0; k < count; ++k)
+		{
+			const Quat& r = q[base + k];
+			const Vec3& v = omega[base + k];
+			qw[k] = r.w; qx[k] = r.x; qy[k] = r.y; qz[k] = r.z;
+			ox[k] = v.x; oy[k] = v.y; oz[k] = v.z;
+		}
+
+		IntegrateArrays(integration.method, count, dt, normalize, ox, oy, oz, qw, qx, qy, qz);
+
+		// Assign through Quat so bound Transforms are updated
+		for (size_t k = 0; k < count; ++k)
+			q[base + k] = Quat{ qw[k], qx[k], qy[k], qz[k] };
+	}
+}
+
+void Quat::SlerpN(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n)
+{
+	BlendQuats<BlendMode::Slerp>(a, b, t, out, n);
+}
+
+void Quat::NlerpN(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n)
+{
+	BlendQuats<BlendMode::Nlerp>(a, b, t, out, n);
+}
+
+void Quat::SlerpFastN(const Quat* a, const Quat* b, const float* t, Quat* out, size_t n)
+{
+	BlendQuats<BlendMode::SlerpFast>(a, b, t, out, n);
+}
+
+} // namespace SNova
\ No newline at end of file
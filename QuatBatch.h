@@ -0,0 +1,165 @@
+/******************************************************************************/
+/*!
+\file		QuatBatch.h
+\author		Justin Leow
+\brief
+	Structure-of-arrays containers for many quaternions / vectors at once.
+
+	Each component lives in its own aligned float array, so the batch
+	operations below process a full SIMD register of quaternions per
+	instruction (8 with AVX2, 4 with SSE/NEON, see SIMD.h). There is no
+	Transform binding here; these are plain values.
+
+	Every batch operation has the same meaning as its single Quat
+	counterpart, applied element-wise (out[i] = a[i] * b[i], etc).
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "Quat.h"
+#include "Vector3D.h"
+
+namespace SNova
+{
+
+struct Vec3Batch
+{
+	/////////////////////////////////////////////////////
+	// Data Members
+public:
+	float* x = nullptr;
+	float* y = nullptr;
+	float* z = nullptr;
+
+private:
+	float* mp_Buffer = nullptr;
+	size_t m_Size = 0;
+
+	/////////////////////////////////////////////////////
+	// Constructors
+public:
+	Vec3Batch() = default;
+
+	// New elements are zero vectors
+	explicit Vec3Batch(size_t count);
+
+	Vec3Batch(const Vec3Batch& rhs);
+	Vec3Batch(Vec3Batch&& rhs) noexcept;
+	Vec3Batch& operator=(const Vec3Batch& rhs);
+	Vec3Batch& operator=(Vec3Batch&& rhs) noexcept;
+	~Vec3Batch();
+
+	/////////////////////////////////////////////////////
+	// Member Functions
+public:
+	// Resize the batch. Existing elements are kept, new ones are zero.
+	void Resize(size_t count);
+	inline size_t Size() const { return m_Size; }
+
+	inline void Set(size_t i, const Vec3& v) { x[i] = v.x; y[i] = v.y; z[i] = v.z; }
+	inline Vec3 Get(size_t i) const { return Vec3{ x[i], y[i], z[i] }; }
+};
+
+struct QuatBatch
+{
+	/////////////////////////////////////////////////////
+	// Data Members
+public:
+	float* w = nullptr;
+	float* x = nullptr;
+	float* y = nullptr;
+	float* z = nullptr;
+
+private:
+	float* mp_Buffer = nullptr;
+	size_t m_Size = 0;
+
+	/////////////////////////////////////////////////////
+	// Constructors
+public:
+	QuatBatch() = default;
+
+	// New elements are Identity
+	explicit QuatBatch(size_t count);
+
+	QuatBatch(const QuatBatch& rhs);
+	QuatBatch(QuatBatch&& rhs) noexcept;
+	QuatBatch& operator=(const QuatBatch& rhs);
+	QuatBatch& operator=(QuatBatch&& rhs) noexcept;
+	~QuatBatch();
+
+	/////////////////////////////////////////////////////
+	// Member Functions
+public:
+	// Resize the batch. Existing elements are kept, new ones are Identity.
+	void Resize(size_t count);
+	inline size_t Size() const { return m_Size; }
+
+	inline void Set(size_t i, const Quat& q) { w[i] = q.w; x[i] = q.x; y[i] = q.y; z[i] = q.z; }
+	inline Quat Get(size_t i) const { return Quat{ w[i], x[i], y[i], z[i] }; }
+
+	/**
+	 * out[i] = a[i] * b[i] (Hamilton product, see Quat::operator*)
+	 * All batches must have the same size. out may alias a or b.
+	 */
+	static void Multiply(const QuatBatch& a, const QuatBatch& b, QuatBatch& out);
+	inline QuatBatch operator*(const QuatBatch& q) const;
+
+	// Normalize every quaternion. Ones too small become Identity (see Quat::Normalize)
+	void Normalize(float tolerance = SMALL_NUMBER);
+
+	// out[i] = this[i].Inverse(). Non-normalized quats give Identity, like Quat::Inverse
+	void Inverse(QuatBatch& out) const;
+
+	// out[i] = this[i] | q[i] (inner product). out must hold Size() floats
+	void Dot(const QuatBatch& q, float* out) const;
+
+	// out[i] = this[i].RotateVector(in[i]). out may alias in.
+	void RotateVectors(const Vec3Batch& in, Vec3Batch& out) const;
+
+	// out[i] = this[i].UnrotateVector(in[i]). out may alias in.
+	void UnrotateVectors(const Vec3Batch& in, Vec3Batch& out) const;
+
+	/**
+	 * this[i].IntegrateAngularVelocity(omega[i], dt), or the FirstOrder
+	 * version, per integration.method. Normalizes on the steps
+	 * integration.renormalizeEvery asks for and advances integration.step.
+	 */
+	void IntegrateAngularVelocity(const Vec3Batch& omega, float dt, AngularIntegration& integration);
+
+	/**
+	 * out[i] = Slerp(a[i], b[i], t[i]). t must hold Size() floats.
+	 * See Quat::SlerpN / NlerpN / SlerpFastN for how the three differ.
+	 * out may alias a or b.
+	 */
+	static void Slerp(const QuatBatch& a, const QuatBatch& b, const float* t, QuatBatch& out);
+	static void Nlerp(const QuatBatch& a, const QuatBatch& b, const float* t, QuatBatch& out);
+	static void SlerpFast(const QuatBatch& a, const QuatBatch& b, const float* t, QuatBatch& out);
+
+	/**
+	 * out[i] = Quat::FindBetweenNormals(from[i], to[i]) / Quat::LookRotation(forward[i], up[i]).
+	 * Branchless, see Quat::FindBetweenNormalsN. The second LookRotation
+	 * uses the same up for every element.
+	 */
+	static void FindBetweenNormals(const Vec3Batch& from, const Vec3Batch& to, QuatBatch& out);
+	static void LookRotation(const Vec3Batch& forward, const Vec3Batch& up, QuatBatch& out);
+	static void LookRotation(const Vec3Batch& forward, const Vec3& up, QuatBatch& out);
+};
+
+typedef QuatBatch QuatSoA;
+typedef Vec3Batch Vec3SoA;
+
+// ------------------------- INLINE IMPLEMENTATIONS ---------------------
+
+inline QuatBatch QuatBatch::operator*(const QuatBatch& q) const
+{
+	QuatBatch r{ m_Size };
+	Multiply(*this, q, r);
+	return r;
+}
+
+} // namespace SNova
\ No newline at end of file
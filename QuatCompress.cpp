@@ -0,0 +1,403 @@
+/******************************************************************************/
+/*!
+\file		QuatCompress.cpp
+\author		Justin Leow
+\brief
+	Compact rotation and Transform encodings. See QuatCompress.h.
+
+	Each codec is a pair of lane kernels (quat components <-> codes held as
+	floats) plus scalar bit packing. Batches go through a small SoA staging
+	buffer like QuatBatch.cpp; single quaternions run the same code with a
+	batch of one, so both give identical bits.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "SNova.h"
+#include "QuatCompress.h"
+#include "Transform.h"
+#include "SIMD.h"
+
+namespace SNova
+{
+
+namespace
+{
+	using namespace SIMD;
+
+	// Components other than the largest lie in [-RANGE, RANGE]
+	static constexpr float RANGE = 0.707106781f;
+
+	/**
+	 * Smallest-three with BITS per stored component.
+	 * Codes run 0 .. MAX_CODE. MAX_CODE is even, so 0 is exactly MAX_CODE / 2.
+	 */
+	template <int BITS>
+	struct Smallest3
+	{
+		static constexpr uint32_t MAX_CODE = (1u << BITS) - 2u;
+		static constexpr float HALF_CODE = MAX_CODE / 2;
+
+		// codes[0] = index of the dropped component (w x y z = 0 1 2 3), codes[1..3] = the rest
+		template <typename L>
+		static inline void Encode(size_t i, const float* const* q, float* const* codes)
+		{
+			const L w = L::Load(q[0] + i), x = L::Load(q[1] + i), y = L::Load(q[2] + i), z = L::Load(q[3] + i);
+
+			// Largest magnitude, first one wins ties
+			L best = Abs(w), index = L::Set(0.f);
+			auto consider = [&](L c, float k)
+			{
+				const L bigger = CmpGT(Abs(c), best);
+				best = Select(bigger, Abs(c), best);
+				index = Select(bigger, L::Set(k), index);
+			};
+			consider(x, 1.f);
+			consider(y, 2.f);
+			consider(z, 3.f);
+
+			const L is0 = CmpLT(index, L::Set(0.5f)), upTo1 = CmpLT(index, L::Set(1.5f)), upTo2 = CmpLT(index, L::Set(2.5f));
+
+			// Flip the whole quat so the dropped component is positive
+			const L dropped = Select(is0, w, Select(upTo1, x, Select(upTo2, y, z)));
+			const L sign = Select(CmpLT(dropped, L::Set(0.f)), L::Set(-1.f), L::Set(1.f));
+
+			// The other three, in w x y z order
+			const L a = Select(is0, x, w);
+			const L b = Select(upTo1, y, x);
+			const L c = Select(upTo2, z, y);
+
+			const L scale = sign * L::Set(HALF_CODE / RANGE);
+			auto code = [&](L v)
+			{
+				return Min(Max(Round(v * scale + L::Set(HALF_CODE)), L::Set(0.f)), L::Set(float(MAX_CODE)));
+			};
+
+			index.Store(codes[0] + i);
+			code(a).Store(codes[1] + i);
+			code(b).Store(codes[2] + i);
+			code(c).Store(codes[3] + i);
+		}
+
+		template <typename L>
+		static inline void Decode(size_t i, const float* const* codes, float* const* q)
+		{
+			const L index = L::Load(codes[0] + i);
+			const L toValue = L::Set(RANGE / HALF_CODE);
+			const L a = (L::Load(codes[1] + i) - L::Set(HALF_CODE)) * toValue;
+			const L b = (L::Load(codes[2] + i) - L::Set(HALF_CODE)) * toValue;
+			const L c = (L::Load(codes[3] + i) - L::Set(HALF_CODE)) * toValue;
+
+			// Unit length, so the dropped component is what's left
+			const L d = Sqrt(Max(L::Set(1.f) - a * a - b * b - c * c, L::Set(0.f)));
+
+			const L is0 = CmpLT(index, L::Set(0.5f)), upTo1 = CmpLT(index, L::Set(1.5f)), upTo2 = CmpLT(index, L::Set(2.5f));
+			Select(is0, d, a).Store(q[0] + i);
+			Select(is0, a, Select(upTo1, d, b)).Store(q[1] + i);
+			Select(upTo1, b, Select(upTo2, d, c)).Store(q[2] + i);
+			Select(upTo2, c, d).Store(q[3] + i);
+		}
+
+		// index in the top 2 of 3 * BITS + 2 bits
+		static inline uint64_t Pack(const float* const* codes, size_t k)
+		{
+			return (uint64_t(codes[0][k]) << (3 * BITS))
+				| (uint64_t(codes[1][k]) << (2 * BITS))
+				| (uint64_t(codes[2][k]) << BITS)
+				| uint64_t(codes[3][k]);
+		}
+
+		static inline void Unpack(uint64_t bits, float* const* codes, size_t k)
+		{
+			static constexpr uint64_t MASK = (1u << BITS) - 1u;
+			codes[0][k] = float((bits >> (3 * BITS)) & 3u);
+			codes[1][k] = float((bits >> (2 * BITS)) & MASK);
+			codes[2][k] = float((bits >> BITS) & MASK);
+			codes[3][k] = float(bits & MASK);
+		}
+
+		static inline void Store(uint64_t bits, uint32_t& out) { out = uint32_t(bits); }
+		static inline uint64_t Load(uint32_t in) { return in; }
+
+		static inline void Store(uint64_t bits, CompressedQuat48& out)
+		{
+			out.bits[0] = uint16_t(bits);
+			out.bits[1] = uint16_t(bits >> 16);
+			out.bits[2] = uint16_t(bits >> 32);
+		}
+
+		static inline uint64_t Load(const CompressedQuat48& in)
+		{
+			return uint64_t(in.bits[0]) | (uint64_t(in.bits[1]) << 16) | (uint64_t(in.bits[2]) << 32);
+		}
+
+		template <typename Packed>
+		static inline void Write(const float* const* codes, size_t k, Packed& out) { Store(Pack(codes, k), out); }
+
+		template <typename Packed>
+		static inline void Read(const Packed& in, float* const* codes, size_t k) { Unpack(Load(in), codes, k); }
+	};
+
+	// All four components as int16 in [-1, 1]
+	struct Quantize16
+	{
+		static constexpr float MAX_CODE = 32767.f;
+
+		template <typename L>
+		static inline void Encode(size_t i, const float* const* q, float* const* codes)
+		{
+			for (int c = 0; c < 4; ++c)
+			{
+				const L v = Min(Max(L::Load(q[c] + i), L::Set(-1.f)), L::Set(1.f));
+				Round(v * L::Set(MAX_CODE)).Store(codes[c] + i);
+			}
+		}
+
+		template <typename L>
+		static inline void Decode(size_t i, const float* const* codes, float* const* q)
+		{
+			const L toValue = L::Set(1.f / MAX_CODE);
+			const L w = L::Load(codes[0] + i) * toValue, x = L::Load(codes[1] + i) * toValue;
+			const L y = L::Load(codes[2] + i) * toValue, z = L::Load(codes[3] + i) * toValue;
+
+			// Renormalize at full precision; all zero becomes Identity
+			const L squareSum = w * w + x * x + y * y + z * z;
+			const L bigEnough = CmpGE(squareSum, L::Set(SMALL_NUMBER));
+			const L scale = Select(bigEnough, L::Set(1.f) / Sqrt(squareSum), L::Set(0.f));
+			Select(bigEnough, w * scale, L::Set(1.f)).Store(q[0] + i);
+			(x * scale).Store(q[1] + i);
+			(y * scale).Store(q[2] + i);
+			(z * scale).Store(q[3] + i);
+		}
+
+		static inline void Write(const float* const* codes, size_t k, QuantizedQuat16& out)
+		{
+			out.w = int16_t(codes[0][k]);
+			out.x = int16_t(codes[1][k]);
+			out.y = int16_t(codes[2][k]);
+			out.z = int16_t(codes[3][k]);
+		}
+
+		static inline void Read(const QuantizedQuat16& in, float* const* codes, size_t k)
+		{
+			codes[0][k] = in.w;
+			codes[1][k] = in.x;
+			codes[2][k] = in.y;
+			codes[3][k] = in.z;
+		}
+	};
+
+	static constexpr size_t CHUNK = 64;
+
+	// Quat components and codes, SoA: lanes[0..3] = w x y z, lanes[4..7] = codes
+	struct Staging
+	{
+		alignas(ALIGNMENT) float buffer[8][CHUNK];
+		float* q[4];
+		float* codes[4];
+
+		Staging()
+		{
+			for (int c = 0; c < 4; ++c)
+			{
+				q[c] = buffer[c];
+				codes[c] = buffer[4 + c];
+			}
+		}
+	};
+
+	template <typename Codec, typename Packed>
+	void EncodeN(const Quat* in, Packed* out, size_t n)
+	{
+		Staging s;
+		for (size_t base = 0; base < n; base += CHUNK)
+		{
+			const size_t count = Math::Min(CHUNK, n - base);
+
+			for (size_t k = 0; k < count; ++k)
+			{
+				const Quat& q = in[base + k];
+				s.q[0][k] = q.w; s.q[1][k] = q.x; s.q[2][k] = q.y; s.q[3][k] = q.z;
+			}
+
+			RunBatch(count, [&](size_t i, auto lane)
+			{
+				Codec::template Encode<decltype(lane)>(i, s.q, s.codes);
+			});
+
+			for (size_t k = 0; k < count; ++k)
+				Codec::Write(s.codes, k, out[base + k]);
+		}
+	}
+
+	template <typename Codec, typename Packed>
+	void DecodeN(const Packed* in, Quat* out, size_t n)
+	{
+		Staging s;
+		for (size_t base = 0; base < n; base += CHUNK)
+		{
+			const size_t count = Math::Min(CHUNK, n - base);
+
+			for (size_t k = 0; k < count; ++k)
+				Codec::Read(in[base + k], s.codes, k);
+
+			RunBatch(count, [&](size_t i, auto lane)
+			{
+				Codec::template Decode<decltype(lane)>(i, s.codes, s.q);
+			});
+
+			// Assign through Quat so bound Transforms are updated
+			for (size_t k = 0; k < count; ++k)
+				out[base + k] = Quat{ s.q[0][k], s.q[1][k], s.q[2][k], s.q[3][k] };
+		}
+	}
+
+	template <typename Codec, typename Packed>
+	inline Packed EncodeOne(const Quat& q)
+	{
+		Packed out;
+		EncodeN<Codec>(&q, &out, 1);
+		return out;
+	}
+
+	template <typename Codec, typename Packed>
+	inline Quat DecodeOne(const Packed& in)
+	{
+		Quat out;
+		DecodeN<Codec>(&in, &out, 1);
+		return out;
+	}
+
+	typedef Smallest3<9> Smallest3_29;
+	typedef Smallest3<10> Smallest3_32;
+	typedef Smallest3<15> Smallest3_48;
+
+	/////////////////////////////////////////////////////
+	// Range packing for Transforms
+
+	static constexpr float MAX_U16 = 65535.f;
+
+	inline uint16_t PackRange(float value, float min, float max)
+	{
+		const float extent = max - min;
+		const float t = (extent > 0.f) ? Math::Min(Math::Max((value - min) / extent, 0.f), 1.f) : 0.f;
+		return uint16_t(nearbyintf(t * MAX_U16));
+	}
+
+	inline float UnpackRange(uint16_t code, float min, float max)
+	{
+		return min + (max - min) * (code / MAX_U16);
+	}
+
+	inline QuantizedTransform QuantizeUnrotated(const Transform& transform, const TransformQuantizeRange& range)
+	{
+		const Vec3 p = transform.GetPosition();
+
+		QuantizedTransform q;
+		q.position[0] = PackRange(p.x, range.positionMin.x, range.positionMax.x);
+		q.position[1] = PackRange(p.y, range.positionMin.y, range.positionMax.y);
+		q.position[2] = PackRange(p.z, range.positionMin.z, range.positionMax.z);
+		q.scale = PackRange(transform.GetScaleX(), range.scaleMin, range.scaleMax);
+		q.rotation = 0;
+		return q;
+	}
+
+	inline void DequantizeUnrotated(const QuantizedTransform& q, Transform& transform, const TransformQuantizeRange& range)
+	{
+		transform.SetPosition(Vec3{
+			UnpackRange(q.position[0], range.positionMin.x, range.positionMax.x),
+			UnpackRange(q.position[1], range.positionMin.y, range.positionMax.y),
+			UnpackRange(q.position[2], range.positionMin.z, range.positionMax.z) });
+		transform.SetScale(UnpackRange(q.scale, range.scaleMin, range.scaleMax));
+	}
+}
+
+/////////////////////////////////////////////////////
+// Single quaternion
+
+uint32_t CompressQuat29(const Quat& q) { return EncodeOne<Smallest3_29, uint32_t>(q); }
+uint32_t CompressQuat32(const Quat& q) { return EncodeOne<Smallest3_32, uint32_t>(q); }
+CompressedQuat48 CompressQuat48(const Quat& q) { return EncodeOne<Smallest3_48, CompressedQuat48>(q); }
+QuantizedQuat16 QuantizeQuat16(const Quat& q) { return EncodeOne<Quantize16, QuantizedQuat16>(q); }
+
+Quat DecompressQuat29(uint32_t bits) { return DecodeOne<Smallest3_29>(bits); }
+Quat DecompressQuat32(uint32_t bits) { return DecodeOne<Smallest3_32>(bits); }
+Quat DecompressQuat48(const CompressedQuat48& bits) { return DecodeOne<Smallest3_48>(bits); }
+Quat DequantizeQuat16(const QuantizedQuat16& q) { return DecodeOne<Quantize16>(q); }
+
+/////////////////////////////////////////////////////
+// Batch versions
+
+void CompressQuats29(const Quat* in, uint32_t* out, size_t n) { EncodeN<Smallest3_29>(in, out, n); }
+void CompressQuats32(const Quat* in, uint32_t* out, size_t n) { EncodeN<Smallest3_32>(in, out, n); }
+void CompressQuats48(const Quat* in, CompressedQuat48* out, size_t n) { EncodeN<Smallest3_48>(in, out, n); }
+void QuantizeQuats16(const Quat* in, QuantizedQuat16* out, size_t n) { EncodeN<Quantize16>(in, out, n); }
+
+void DecompressQuats29(const uint32_t* in, Quat* out, size_t n) { DecodeN<Smallest3_29>(in, out, n); }
+void DecompressQuats32(const uint32_t* in, Quat* out, size_t n) { DecodeN<Smallest3_32>(in, out, n); }
+void DecompressQuats48(const CompressedQuat48* in, Quat* out, size_t n) { DecodeN<Smallest3_48>(in, out, n); }
+void DequantizeQuats16(const QuantizedQuat16* in, Quat* out, size_t n) { DecodeN<Quantize16>(in, out, n); }
+
+/////////////////////////////////////////////////////
+// Transforms
+
+QuantizedTransform QuantizeTransform(const Transform& transform, const TransformQuantizeRange& range)
+{
+	QuantizedTransform q = QuantizeUnrotated(transform, range);
+	q.rotation = CompressQuat32(transform.GetRotation());
+	return q;
+}
+
+void DequantizeTransform(const QuantizedTransform& q, Transform& transform, const TransformQuantizeRange& range)
+{
+	DequantizeUnrotated(q, transform, range);
+	transform.SetRotation(DecompressQuat32(q.rotation));
+}
+
+void QuantizeTransforms(const Transform* const* transforms, QuantizedTransform* out, size_t count,
+	const TransformQuantizeRange& range)
+{
+	// Rotations go through the batch encoder a chunk at a time
+	Quat rotations[CHUNK];
+	uint32_t codes[CHUNK];
+
+	for (size_t base = 0; base < count; base += CHUNK)
+	{
+		const size_t n = Math::Min(CHUNK, count - base);
+		for (size_t k = 0; k < n; ++k)
+		{
+			out[base + k] = QuantizeUnrotated(*transforms[base + k], range);
+			rotations[k] = transforms[base + k]->GetRotation();
+		}
+
+		CompressQuats32(rotations, codes, n);
+		for (size_t k = 0; k < n; ++k)
+			out[base + k].rotation = codes[k];
+	}
+}
+
+void DequantizeTransforms(const QuantizedTransform* in, Transform* const* transforms, size_t count,
+	const TransformQuantizeRange& range)
+{
+	Quat rotations[CHUNK];
+	uint32_t codes[CHUNK];
+
+	for (size_t base = 0; base < count; base += CHUNK)
+	{
+		const size_t n = Math::Min(CHUNK, count - base);
+		for (size_t k = 0; k < n; ++k)
+			codes[k] = in[base + k].rotation;
+
+		DecompressQuats32(codes, rotations, n);
+		for (size_t k = 0; k < n; ++k)
+		{
+			DequantizeUnrotated(in[base + k], *transforms[base + k], range);
+			transforms[base + k]->SetRotation(rotations[k]);
+		}
+	}
+}
+
+} // namespace SNova
\ No newline at end of file
@@ -0,0 +1,267 @@
+/******************************************************************************/
+/*!
+\file		QuatSpline.cpp
+\author		Justin Leow
+\brief
+	Cumulative Bezier rotation curves. See QuatSpline.h.
+
+	Sampling is one lane kernel, run with SIMD::Scalar for single samples
+	and a register at a time for arrays of times, so both agree exactly.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "SNova.h"
+#include "QuatSpline.h"
+#include "SIMD.h"
+#include <algorithm>
+
+namespace SNova
+{
+
+namespace
+{
+	using namespace SIMD;
+
+	// Fast sin/cos leaves samples ~1e-4 off unit length and ~0.01 degrees
+	// off the keys, so the curve never goes below the High polynomials
+	static constexpr Math::TrigAccuracy SPLINE_TRIG_ACCURACY =
+		(Math::DEFAULT_TRIG_ACCURACY == Math::TrigAccuracy::Fast) ? Math::TrigAccuracy::High : Math::DEFAULT_TRIG_ACCURACY;
+
+	// Log(q) as a rotation vector (half angle, this library's Log scale)
+	inline Vec3 LogVector(const Quat& q)
+	{
+		const Quat l = q.Log();
+		return Vec3{ l.x, l.y, l.z };
+	}
+
+	inline Quat ExpVector(const Vec3& v)
+	{
+		return Quat{ 0.f, v.x, v.y, v.z }.Exp();
+	}
+
+	/**
+	 * q0 * Exp(w1 * b1(t)) * Exp(w2 * b2(t)) * Exp(w3 * b3(t)) for L::Width samples.
+	 * axis[k] / halfAngle[k] hold wk, start holds q0 (w x y z)
+	 */
+	template <typename L>
+	inline void EvaluateLanes(L t, const L* start, const L (*axis)[3], const L* halfAngle,
+		L& w, L& x, L& y, L& z)
+	{
+		const L one = L::Set(1.f);
+		const L d = one - t;
+		const L basis[3] = { one - d * d * d, t * t * (L::Set(3.f) - L::Set(2.f) * t), t * t * t };
+
+		w = start[0]; x = start[1]; y = start[2]; z = start[3];
+		for (int k = 0; k < 3; ++k)
+		{
+			L s, c;
+			SIMD::SinCos<SPLINE_TRIG_ACCURACY>(basis[k] * halfAngle[k], s, c);
+			const L ex = s * axis[k][0], ey = s * axis[k][1], ez = s * axis[k][2];
+
+			// (w, x, y, z) * (c, ex, ey, ez) (Hamilton Product)
+			const L rw = w * c - x * ex - y * ey - z * ez;
+			const L rx = w * ex + x * c + y * ez - z * ey;
+			const L ry = w * ey - x * ez + y * c + z * ex;
+			const L rz = w * ez + x * ey - y * ex + z * c;
+			w = rw; x = rx; y = ry; z = rz;
+		}
+	}
+
+	// Floats per staged sample: t, start (4), axis (9), halfAngle (3)
+	static constexpr size_t SAMPLE_LANES = 17;
+}
+
+QuatSpline::QuatSpline(const float* times, const Quat* rotations, size_t count)
+{
+	SetKeys(times, rotations, count);
+}
+
+void QuatSpline::SetKeys(const float* times, const Quat* rotations, size_t count)
+{
+	m_Times.assign(times, times + count);
+	m_Keys.assign(rotations, rotations + count);
+	m_Segments.clear();
+
+	if (count < 2)
+		return;
+
+	// Shortest arc between neighbours
+	std::vector<Quat> keys(rotations, rotations + count);
+	for (size_t i = 1; i < count; ++i)
+	{
+		keys[i].EnforceShortestArcWith(keys[i - 1]);
+		m_Keys[i] = keys[i];
+	}
+
+	// Rotation per second over each segment, then at each key
+	const size_t numSegments = count - 1;
+	std::vector<Vec3> segmentVelocity(numSegments);
+	for (size_t i = 0; i < numSegments; ++i)
+		segmentVelocity[i] = LogVector(keys[i].Conjugate() * keys[i + 1]) / (times[i + 1] - times[i]);
+
+	std::vector<Vec3> keyVelocity(count);
+	keyVelocity[0] = segmentVelocity[0];
+	keyVelocity[count - 1] = segmentVelocity[numSegments - 1];
+	for (size_t i = 1; i < numSegments; ++i)
+		keyVelocity[i] = 0.5f * (segmentVelocity[i - 1] + segmentVelocity[i]);
+
+	m_Segments.resize(numSegments);
+	for (size_t i = 0; i < numSegments; ++i)
+	{
+		const float duration = times[i + 1] - times[i];
+
+		// Control points: leave q0 and arrive at q3 with the key velocities
+		const Vec3 w1 = keyVelocity[i] * (duration / 3.f);
+		const Vec3 w3 = keyVelocity[i + 1] * (duration / 3.f);
+		const Quat q1 = keys[i] * ExpVector(w1);
+		const Quat q2 = keys[i + 1] * ExpVector(-w3);
+		const Vec3 w[3] = { w1, LogVector(q1.Conjugate() * q2), w3 };
+
+		Segment& segment = m_Segments[i];
+		segment.startTime = times[i];
+		segment.invDuration = 1.f / duration;
+		segment.start = keys[i];
+		for (int k = 0; k < 3; ++k)
+		{
+			const float length = w[k].Magnitude();
+			segment.halfAngle[k] = length;
+			segment.axis[k] = (length > 0.f) ? w[k] / length : Vec3{};
+		}
+	}
+}
+
+size_t QuatSpline::Seek(float time, size_t segment) const
+{
+	const size_t last = m_Segments.size() - 1;
+	segment = Math::Min(segment, last);
+
+	while (segment < last && time >= m_Segments[segment + 1].startTime)
+		++segment;
+	while (segment > 0 && time < m_Segments[segment].startTime)
+		--segment;
+
+	return segment;
+}
+
+Quat QuatSpline::Sample(float time) const
+{
+	if (m_Segments.empty())
+		return m_Keys.empty() ? Quat::Identity : Quat{ m_Keys.front() };
+
+	// First key time greater than time, among the segment starts after the first
+	const auto next = std::upper_bound(m_Times.begin() + 1, m_Times.end() - 1, time);
+	Cursor cursor{ static_cast<size_t>(next - (m_Times.begin() + 1)) };
+	return Sample(time, cursor);
+}
+
+Quat QuatSpline::Sample(float time, Cursor& cursor) const
+{
+	if (m_Segments.empty())
+		return m_Keys.empty() ? Quat::Identity : Quat{ m_Keys.front() };
+
+	cursor.segment = Seek(time, cursor.segment);
+	const Segment& s = m_Segments[cursor.segment];
+
+	using L = SIMD::Scalar;
+	const float t = Math::Min(Math::Max((time - s.startTime) * s.invDuration, 0.f), 1.f);
+
+	// End of a segment (and past the last key) is the next key exactly
+	if (t == 1.f)
+		return Quat{ m_Keys[cursor.segment + 1] };
+
+	const L start[4] = { L::Set(s.start.w), L::Set(s.start.x), L::Set(s.start.y), L::Set(s.start.z) };
+	L axis[3][3], halfAngle[3];
+	for (int k = 0; k < 3; ++k)
+	{
+		axis[k][0] = L::Set(s.axis[k].x);
+		axis[k][1] = L::Set(s.axis[k].y);
+		axis[k][2] = L::Set(s.axis[k].z);
+		halfAngle[k] = L::Set(s.halfAngle[k]);
+	}
+
+	L w, x, y, z;
+	EvaluateLanes(L::Set(t), start, axis, halfAngle, w, x, y, z);
+	return Quat{ w.v, x.v, y.v, z.v };
+}
+
+void QuatSpline::Sample(const float* times, Quat* out, size_t n, Cursor& cursor) const
+{
+	if (m_Segments.empty())
+	{
+		for (size_t i = 0; i < n; ++i)
+			out[i] = Sample(times[i], cursor);
+		return;
+	}
+
+	// Look up each segment in scalar, then evaluate in SoA like QuatBatch
+	static constexpr size_t CHUNK = 64;
+	alignas(SIMD::ALIGNMENT) float lanes[SAMPLE_LANES][CHUNK];
+	alignas(SIMD::ALIGNMENT) float result[4][CHUNK];
+	size_t segments[CHUNK];
+
+	for (size_t base = 0; base < n; base += CHUNK)
+	{
+		const size_t count = Math::Min(CHUNK, n - base);
+
+		for (size_t k = 0; k < count; ++k)
+		{
+			const float time = times[base + k];
+			cursor.segment = Seek(time, cursor.segment);
+			const Segment& s = m_Segments[cursor.segment];
+			segments[k] = cursor.segment;
+
+			lanes[0][k] = Math::Min(Math::Max((time - s.startTime) * s.invDuration, 0.f), 1.f);
+			lanes[1][k] = s.start.w; lanes[2][k] = s.start.x; lanes[3][k] = s.start.y; lanes[4][k] = s.start.z;
+			for (int j = 0; j < 3; ++j)
+			{
+				lanes[5 + 3 * j][k] = s.axis[j].x;
+				lanes[6 + 3 * j][k] = s.axis[j].y;
+				lanes[7 + 3 * j][k] = s.axis[j].z;
+				lanes[14 + j][k] = s.halfAngle[j];
+			}
+		}
+
+		RunBatch(count, [&](size_t i, auto lane)
+		{
+			using L = decltype(lane);
+			const L start[4] = { L::Load(lanes[1] + i), L::Load(lanes[2] + i), L::Load(lanes[3] + i), L::Load(lanes[4] + i) };
+			L axis[3][3], halfAngle[3];
+			for (int j = 0; j < 3; ++j)
+			{
+				axis[j][0] = L::Load(lanes[5 + 3 * j] + i);
+				axis[j][1] = L::Load(lanes[6 + 3 * j] + i);
+				axis[j][2] = L::Load(lanes[7 + 3 * j] + i);
+				halfAngle[j] = L::Load(lanes[14 + j] + i);
+			}
+
+			L w, x, y, z;
+			EvaluateLanes(L::Load(lanes[0] + i), start, axis, halfAngle, w, x, y, z);
+			w.Store(result[0] + i);
+			x.Store(result[1] + i);
+			y.Store(result[2] + i);
+			z.Store(result[3] + i);
+		});
+
+		// Assign through Quat so bound Transforms are updated. Segment ends
+		// snap to the next key, as in the single version
+		for (size_t k = 0; k < count; ++k)
+		{
+			if (lanes[0][k] == 1.f)
+				out[base + k] = Quat{ m_Keys[segments[k] + 1] };
+			else
+				out[base + k] = Quat{ result[0][k], result[1][k], result[2][k], result[3][k] };
+		}
+	}
+}
+
+void QuatSpline::Sample(const float* times, Quat* out, size_t n) const
+{
+	Cursor cursor;
+	Sample(times, out, n, cursor);
+}
+
+} // namespace SNova
\ No newline at end of file
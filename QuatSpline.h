@@ -0,0 +1,126 @@
+/******************************************************************************/
+/*!
+\file		QuatSpline.h
+\author		Justin Leow
+\brief
+	Smooth rotation curves through keyframes, for camera and cutscene paths.
+
+	Chaining Quat::Slerp between keys gives kinks at every key and redoes
+	the acos/sin setup of the pair on every sample. QuatSpline does all the
+	per-segment work once in SetKeys, so a sample is a segment lookup plus
+	three sin/cos of cached angles and three quat multiplies.
+
+	Each segment is a cumulative cubic Bezier curve (Kim, Kim & Shin,
+	"A General Construction Scheme for Unit Quaternion Curves with Simple
+	High Order Derivatives", 1995):
+		q(t) = q0 * Exp(w1 * b1(t)) * Exp(w2 * b2(t)) * Exp(w3 * b3(t))
+		b1 = 1 - (1 - t)^3, b2 = 3t^2 - 2t^3, b3 = t^3
+	where wk = Log(q(k-1)^-1 * qk) for control points q0..q3. q0 and q3 are
+	the keys; q1 and q2 come from Catmull-Rom style angular velocities at the
+	keys (the same tangents Squad uses, scaled for uneven key spacing). The
+	curve goes through every key with continuous angular velocity.
+
+	Keys take the shortest arc to the next one (see EnforceShortestArcWith).
+
+	Samples use the High trig tier when SNOVA_TRIG_ACCURACY asks for Fast,
+	so at every tier they are unit length to ~1e-5, pass within 1e-3
+	degrees of the keys, and a sample at or past a segment end returns
+	the key itself.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "Quat.h"
+#include "QuatValue.h"
+#include "Vector3D.h"
+#include <cstddef>
+#include <vector>
+
+namespace SNova
+{
+
+class QuatSpline
+{
+	/////////////////////////////////////////////////////
+	// Types
+public:
+	// The segment the last lookup ended in. One per playing track
+	struct Cursor
+	{
+		size_t segment = 0;
+	};
+
+private:
+	// Everything a sample needs, filled in by SetKeys
+	struct Segment
+	{
+		float startTime;
+		float invDuration;
+		QuatValue start;
+
+		// wk = axis[k] * halfAngle[k]
+		Vec3 axis[3];
+		float halfAngle[3];
+	};
+
+	/////////////////////////////////////////////////////
+	// Data Members
+private:
+	std::vector<float> m_Times;
+	std::vector<QuatValue> m_Keys;
+	std::vector<Segment> m_Segments;
+
+	/////////////////////////////////////////////////////
+	// Constructors
+public:
+	QuatSpline() = default;
+
+	// See SetKeys
+	QuatSpline(const float* times, const Quat* rotations, size_t count);
+
+	/////////////////////////////////////////////////////
+	// Member Functions
+public:
+	/**
+	 * Replace the keys and precompute the segments.
+	 * times must be strictly increasing. rotations must be normalized.
+	 */
+	void SetKeys(const float* times, const Quat* rotations, size_t count);
+
+	inline size_t NumKeys() const { return m_Keys.size(); }
+	inline float StartTime() const { return m_Times.empty() ? 0.f : m_Times.front(); }
+	inline float EndTime() const { return m_Times.empty() ? 0.f : m_Times.back(); }
+
+	/**
+	 * Rotation at time, clamped to [StartTime(), EndTime()].
+	 * No keys gives Identity; one key gives that key.
+	 *
+	 * The first version binary searches for the segment. The cursor
+	 * versions walk from cursor's segment instead and leave it where the
+	 * last time was, so playback that moves forward (or backward) less
+	 * than a segment per call never searches.
+	 */
+	Quat Sample(float time) const;
+	Quat Sample(float time, Cursor& cursor) const;
+
+	/**
+	 * out[i] = Sample(times[i], cursor), a SIMD register of times at a time.
+	 * Fastest when times are sorted (e.g. baking a track at fixed steps).
+	 * Matches the single version to within ~1e-6 per component.
+	 */
+	void Sample(const float* times, Quat* out, size_t n, Cursor& cursor) const;
+	void Sample(const float* times, Quat* out, size_t n) const;
+
+private:
+	/////////////////////////////////////////////////////
+	// Helper Functions
+
+	// Segment containing time, walking from segment
+	size_t Seek(float time, size_t segment) const;
+};
+
+} // namespace SNova
\ No newline at end of file
@@ -0,0 +1,233 @@
+/******************************************************************************/
+/*!
+\file		QuatValue.h
+\author		Justin Leow
+\brief
+	Plain 16-byte quaternion value with the same API as Quat, minus the
+	Transform binding.
+
+	Quat carries a pointer to the Transform that owns it, so every write
+	through a Quat checks (and possibly updates) that Transform. QuatValue
+	has no such pointer: it is trivially copyable, can be memcpy'd or
+	stored in a std::vector, and its arithmetic is constexpr. Use it for
+	math in inner loops and convert to/from Quat at the edges. Only a
+	Transform's own rotation member ever synchronizes with the Transform.
+
+	Same conventions as Quat: C = A * B first applies B then A, and the
+	game's X/Y/Z axes correspond to an object's Forward/Up/Right vectors.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "Quat.h"
+#include "Matrix3x3.h"
+#include "Matrix4x4.h"
+#include <type_traits>
+
+namespace SNova
+{
+
+struct QuatValue
+{
+	/////////////////////////////////////////////////////
+	// Data Members
+public:
+	float w;
+	float x;
+	float y;
+	float z;
+
+	/////////////////////////////////////////////////////
+	// Constants
+public:
+	static const QuatValue Identity;
+
+	/////////////////////////////////////////////////////
+	// Constructors
+public:
+	// Default constructor (Generates Identity Quaternion).
+	constexpr QuatValue() : w(1.f), x(0.f), y(0.f), z(0.f) {}
+
+	// Member-Wise Constructor
+	constexpr QuatValue(float InW, float InX, float InY, float InZ)
+		: w(InW), x(InX), y(InY), z(InZ)
+	{}
+
+	// Copy the value of a (possibly bound) Quat
+	constexpr QuatValue(const Quat& q) : w(q.w), x(q.x), y(q.y), z(q.z) {}
+
+	// Construct from Rotator
+	explicit inline QuatValue(const Rotator& r) : QuatValue(r.Quaternion()) {}
+
+	// Rotation around the given (normalized) axis, in radians. See Quat(Vec3, float)
+	inline QuatValue(const Vec3& Axis, float AngleRad) : QuatValue(Quat{ Axis, AngleRad }) {}
+
+	// Construct a quaternion from Euler angles (in degrees)
+	static inline QuatValue MakeFromEuler(const Vec3& eulers) { return Quat::MakeFromEuler(eulers); }
+	static inline QuatValue MakeFromEuler(float x_pitch, float y_yaw, float z_roll) { return Quat::MakeFromEuler(x_pitch, y_yaw, z_roll); }
+
+	// Unbound Quat with the same value
+	inline Quat ToQuat() const { return Quat{ w, x, y, z }; }
+
+	/////////////////////////////////////////////////////
+	// Conversion Functions
+public:
+	inline Vec3 Euler() const { return ToQuat().Euler(); }
+	inline Vec3 Vector() const { return GetAxisX(); }
+	inline Rotator GetRotator() const { return ToQuat().GetRotator(); }
+	inline Matrix3x3 ToMatrix3x3() const { return ToQuat().ToMatrix3x3(); }
+	inline Matrix4x4 ToMatrix4x4(const Vec3& scale, const Vec3& translation) const { return ToQuat().ToMatrix4x4(scale, translation); }
+
+	/////////////////////////////////////////////////////
+	// Member Functions
+public:
+
+	// Component-wise Operations.
+	// WARNING: Combining quaternions should be done by multiplication
+	constexpr QuatValue& operator+=(const QuatValue& q) { w += q.w; x += q.x; y += q.y; z += q.z; return *this; }
+	constexpr QuatValue& operator-=(const QuatValue& q) { w -= q.w; x -= q.x; y -= q.y; z -= q.z; return *this; }
+	constexpr QuatValue  operator+(const QuatValue& q) const { return QuatValue{ w + q.w, x + q.x, y + q.y, z + q.z }; }
+	constexpr QuatValue  operator-(const QuatValue& q) const { return QuatValue{ w - q.w, x - q.x, y - q.y, z - q.z }; }
+
+	// Hamilton product. Same order rules as Quat::operator*
+	constexpr QuatValue operator*(const QuatValue& q) const
+	{
+		return QuatValue{
+			w * q.w - x * q.x - y * q.y - z * q.z,
+			w * q.x + x * q.w + y * q.z - z * q.y,
+			w * q.y - x * q.z + y * q.w + z * q.x,
+			w * q.z + x * q.y - y * q.x + z * q.w
+		};
+	}
+	constexpr QuatValue& operator*=(const QuatValue& q) { return *this = *this * q; }
+
+	// Quaternion scaling operations
+	// Do not use unless you know what you're doing
+	constexpr QuatValue  operator*(float scale) const { return QuatValue{ w * scale, x * scale, y * scale, z * scale }; }
+	constexpr QuatValue& operator*=(float scale) { return *this = *this * scale; }
+	constexpr QuatValue  operator/(float scale) const { return QuatValue{ w / scale, x / scale, y / scale, z / scale }; }
+	constexpr QuatValue& operator/=(float scale) { return *this = *this / scale; }
+	constexpr QuatValue  operator-() const { return QuatValue{ -w, -x, -y, -z }; }
+
+	// Comparison operations
+	inline bool Equals(const QuatValue& q, float tolerance = KINDA_SMALL_NUMBER) const
+	{
+		return Math::FloatEqual(w, q.w, tolerance)
+			&& Math::FloatEqual(x, q.x, tolerance)
+			&& Math::FloatEqual(y, q.y, tolerance)
+			&& Math::FloatEqual(z, q.z, tolerance);
+	}
+	inline bool IsIdentity(float tolerance = SMALL_NUMBER) const { return Equals(Identity, tolerance); }
+
+	constexpr bool operator==(const QuatValue& q) const { return w == q.w && x == q.x && y == q.y && z == q.z; }
+	constexpr bool operator!=(const QuatValue& q) const { return !operator==(q); }
+
+	// Quaternion Inner Product
+	constexpr float operator|(const QuatValue& q) const { return w * q.w + x * q.x + y * q.y + z * q.z; }
+
+	// Normalize this quaternion if its large enough. Returns Identity if too small.
+	inline void Normalize(float tolerance = SMALL_NUMBER)
+	{
+		const float squareSum = SizeSquared();
+		if (squareSum >= tolerance)
+			*this *= Math::InvSqrt(squareSum);
+		else
+			*this = Identity;
+	}
+	inline QuatValue GetNormalized(float tolerance = SMALL_NUMBER) const { QuatValue r{ *this }; r.Normalize(tolerance); return r; }
+	inline bool IsNormalized() const { return ToQuat().IsNormalized(); }
+
+	// Length of the quaternion
+	inline float Size() const { return sqrtf(SizeSquared()); }
+	constexpr float SizeSquared() const { return w * w + x * x + y * y + z * z; }
+
+	// Get Axis and Angle of rotation of this quaternion
+	inline void ToAxisAndAngle(Vec3& axis, float& angle) const { axis = GetRotationAxis(); angle = GetAngle(); }
+	inline float GetAngle() const { return 2.f * Math::Acos<Math::TrigAccuracy::Exact>(w); }
+	inline Vec3 GetRotationAxis() const { return ToQuat().GetRotationAxis(); }
+
+	// Returns a vector rotated by this quaternion.
+	inline Vec3 RotateVector(const Vec3& v) const;
+
+	// Returns a vector rotated by the inverse of this quaternion
+	inline Vec3 UnrotateVector(const Vec3& v) const;
+
+	// Inverse rotation. Must be normalized; non-normalized quats give Identity (see Quat::Inverse)
+	inline QuatValue Inverse() const { return IsNormalized() ? Conjugate() : Identity; }
+
+	// Inverse rotation without the normalization check
+	constexpr QuatValue Conjugate() const { return QuatValue{ w, -x, -y, -z }; }
+
+	// Enforce that the delta between this quat and another represents the shortest possible rotation angle.
+	constexpr void EnforceShortestArcWith(const QuatValue& q)
+	{
+		if ((*this | q) < 0.f)
+			*this = -*this;
+	}
+
+	// Direction vectors after rotation by this quaternion (see Quat)
+	inline Vec3 GetAxisX() const { return RotateVector(Vec3{ 1.f, 0.f, 0.f }); }
+	inline Vec3 GetForwardVector() const { return GetAxisX(); }
+	inline Vec3 GetAxisY() const { return RotateVector(Vec3{ 0.f, 1.f, 0.f }); }
+	inline Vec3 GetUpVector() const { return GetAxisY(); }
+	inline Vec3 GetAxisZ() const { return RotateVector(Vec3{ 0.f, 0.f, 1.f }); }
+	inline Vec3 GetRightVector() const { return GetAxisZ(); }
+
+	// Get the angular distance between this and another quat (in radians)
+	inline float AngularDistance(const QuatValue& q) const
+	{
+		const float innerProduct = *this | q;
+		return Math::Acos<Math::TrigAccuracy::Exact>((2 * innerProduct * innerProduct) - 1.f);
+	}
+
+	// See Quat::FindBetween / FindBetweenVectors / FindBetweenNormals
+	static inline QuatValue FindBetween(const Vec3& v1, const Vec3& v2) { return Quat::FindBetween(v1, v2); }
+	static inline QuatValue FindBetweenVectors(const Vec3& v1, const Vec3& v2) { return Quat::FindBetweenVectors(v1, v2); }
+	static inline QuatValue FindBetweenNormals(const Vec3& v1, const Vec3& v2) { return Quat::FindBetweenNormals(v1, v2); }
+
+	// Spherical Interpolation. Input must be normalized. Result is normalized.
+	static inline QuatValue Slerp(const QuatValue& q1, const QuatValue& q2, float t) { return Quat::Slerp(q1.ToQuat(), q2.ToQuat(), t); }
+
+	/////////////////////////////////////////////////////
+	// For Debugging
+
+	inline std::string ToString() const { return ToQuat().ToString(); }
+	inline bool ContainsNaN() const { return ToQuat().ContainsNaN(); }
+};
+
+static_assert(sizeof(QuatValue) == 16, "QuatValue must stay 4 packed floats");
+static_assert(std::is_trivially_copyable<QuatValue>::value, "QuatValue must be memcpy-able");
+
+// ------------------------- INLINE IMPLEMENTATIONS ---------------------
+
+inline constexpr QuatValue QuatValue::Identity{ 1.f, 0.f, 0.f, 0.f };
+
+constexpr Quat::Quat(const QuatValue& q)
+	: w(q.w), x(q.x), y(q.y), z(q.z)
+{}
+
+inline Vec3 QuatValue::RotateVector(const Vec3& V) const
+{
+	// Same as Quat::RotateVector, written out so it inlines fully
+	// T = 2(Q x V); V' = V + w*(T) + (Q x T)
+	const float tx = 2.f * (y * V.z - V.y * z);
+	const float ty = 2.f * (z * V.x - V.z * x);
+	const float tz = 2.f * (x * V.y - V.x * y);
+
+	return Vec3{
+		V.x + w * tx + (y * tz - ty * z),
+		V.y + w * ty + (z * tx - tz * x),
+		V.z + w * tz + (x * ty - tx * y)
+	};
+}
+
+inline Vec3 QuatValue::UnrotateVector(const Vec3& V) const
+{
+	return Conjugate().RotateVector(V);
+}
+
+} // namespace SNova
\ No newline at end of file
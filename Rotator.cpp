@@ -2,13 +2,12 @@
 #include "Rotator.h"
 #include "Quat.h"
 #include "Matrix3x3.h"
+#include "Matrix3x4.h"
 #include "Transform.h"
 
 namespace SNova
 {
 
-const Rotator Rotator::ZeroRotator = Rotator{};
-
 Rotator::Rotator(const Quat& q)
 {
 	*this = q.GetRotator();
@@ -31,6 +30,8 @@ Vec3 Rotator::Vector() const
 
 Quat Rotator::Quaternion() const
 {
+	SNOVA_INSTRUMENT_SCOPE(ROTATOR_QUATERNION);
+
 	/*
 	 * Adapted from:
 	 * https://en.wikipedia.org/wiki/Conversion_between_quaternions_and_Euler_angles
@@ -62,6 +63,8 @@ Vec3 Rotator::Euler() const
 
 Matrix3x3 Rotator::Matrix() const
 {
+	SNOVA_INSTRUMENT_SCOPE(ROTATOR_MATRIX);
+
 	Matrix3x3 m;
 	float SP, SY, SR, CP, CY, CR;
 
@@ -99,6 +102,29 @@ Vec3 Rotator::UnrotateVector(const Vec3& v) const
 	return Matrix().GetTranspose() * v;
 }
 
+// Matrix3x3's operator*(Vec3) multiplies by the transpose of m2, and
+// Matrix3x4 doesn't, so RotateVector (Matrix() * v) is Matrix3x4{ Matrix().GetTranspose() }
+
+void Rotator::RotateVectors(const Vec3* in, Vec3* out, size_t n) const
+{
+	TransformVectors(Matrix3x4{ Matrix().GetTranspose() }, in, out, n);
+}
+
+void Rotator::UnrotateVectors(const Vec3* in, Vec3* out, size_t n) const
+{
+	TransformVectors(Matrix3x4{ Matrix() }, in, out, n);
+}
+
+void Rotator::RotateVectors(const float* in, size_t inStride, float* out, size_t outStride, size_t n) const
+{
+	TransformVectors(Matrix3x4{ Matrix().GetTranspose() }, in, inStride, out, outStride, n);
+}
+
+void Rotator::UnrotateVectors(const float* in, size_t inStride, float* out, size_t outStride, size_t n) const
+{
+	TransformVectors(Matrix3x4{ Matrix() }, in, inStride, out, outStride, n);
+}
+
 Rotator Rotator::Combine(const Rotator& A, const Rotator& B)
 {
 	return (A.Quaternion() * B.Quaternion()).GetRotator();
@@ -106,16 +132,15 @@ Rotator Rotator::Combine(const Rotator& A, const Rotator& B)
 
 void Rotator::UpdateBoundTransform()
 {
+	// Converts to the quat unless the value is unchanged
 	if (mp_BoundTransform)
-	{
-		Quat tmp = Quaternion();
-		mp_BoundTransform->rotation.w = tmp.w;
-		mp_BoundTransform->rotation.x = tmp.x;
-		mp_BoundTransform->rotation.y = tmp.y;
-		mp_BoundTransform->rotation.z = tmp.z;
-		//mp_BoundTransform->mtx = Matrix();
-		mp_BoundTransform->UpdateMtx();
-	}
+		mp_BoundTransform->OnRotatorWritten();
+}
+
+void Rotator::PullBoundTransform()
+{
+	if (mp_BoundTransform)
+		mp_BoundTransform->SyncRotator();
 }
 
 #pragma warning( push )
@@ -277,7 +302,33 @@ void Rotator::PerformTest()
 		std::cout << Vector3DAngle(q.Vector(), Vec3{ 1.f, 0.f, 0.f }) << std::endl;
 		break;
 
-	/*case 14:
+	case 14:
+	{
+		std::cout << "\nTest Quat Matrix (should all be true)" << std::endl;
+
+		// Closed-form quat matrix must agree with the Euler round trip
+		const Rotator tests[] = {
+			*this, Rotator{}, Rotator{ 10.f, 20.f, 30.f }, Rotator{ -45.f, 170.f, -120.f },
+			Rotator{ 90.f, 30.f, 0.f }, Rotator{ -90.f, -60.f, 45.f }, Rotator{ 89.9f, 10.f, 10.f }
+		};
+
+		for (const Rotator& r : tests)
+		{
+			const Quat rq = r.Quaternion();
+			const Matrix3x3 expected = rq.GetRotator().Matrix();
+			const Matrix3x3 actual = rq.ToMatrix3x3();
+
+			bool same = true;
+			for (int i = 0; i < 3; ++i)
+				for (int j = 0; j < 3; ++j)
+					same = same && Math::FloatEqual(expected.m2[i][j], actual.m2[i][j]);
+
+			std::cout << std::boolalpha << r.ToString() << ": " << same << std::endl;
+		}
+		break;
+	}
+
+	/*case 15:
 		std::cout << "\nTest Find Between Vectors" << std::endl;
 		
 		Vec3 v1{ 1.f, 3.6f,0.f };
@@ -288,7 +339,7 @@ void Rotator::PerformTest()
 		std::cout << a.RotateVector(v1).ToString() << std::endl;
 		std::cout << std::boolalpha << a.RotateVector(v1).Equals(v2) << std::endl;*/
 
-	/*case 15:
+	/*case 16:
 		std::cout << "Test Slerp" << std::endl;
 
 		Quat q1 = Quat::MakeFromEuler(10.f, 0.f, 0.f);
@@ -19,6 +19,7 @@ written consent of DigiPen Institute of Technology is prohibited.
 #pragma once
 #include "GenMath.h"
 #include "Vector3D.h"
+#include "Instrumentation.h"
 
 namespace SNova
 {
@@ -56,10 +57,10 @@ public:
 	// Constructors
 public:
 	// Default Constructor (Generates ZeroRotator)
-	inline Rotator() : pitch{ 0.f }, yaw{ 0.f }, roll{ 0.f } {}
+	constexpr Rotator() : pitch{ 0.f }, yaw{ 0.f }, roll{ 0.f } {}
 
 	// Construct from Euler Angles (X,Y,Z)
-	inline Rotator(float inPitch, float inYaw, float inRoll)
+	constexpr Rotator(float inPitch, float inYaw, float inRoll)
 		: pitch{ inPitch }, yaw{ inYaw }, roll{ inRoll }
 	{}
 
@@ -70,9 +71,9 @@ public:
 	 * Convert a vector of Euler angles (in degrees) into a Rotator.
 	 * In this engine, this is equivalent to the Pitch-Yaw-Roll constructor.
 	 */
-	static inline Rotator MakeFromEuler(const Vec3& eulers);
+	static constexpr Rotator MakeFromEuler(const Vec3& eulers);
 	
-	static inline Rotator MakeFromEuler(float x_pitch, float y_yaw, float z_roll);
+	static constexpr Rotator MakeFromEuler(float x_pitch, float y_yaw, float z_roll);
 
 	/////////////////////////////////////////////////////
 	// Conversion Functions
@@ -98,18 +99,18 @@ public:
 
 	// Component-wise Addition
 	// NOTE: Addition does not "combine" rotations as you expect. Use Rotator::Combine
-	inline Rotator operator+(const Rotator& r) const;
-	inline Rotator operator-(const Rotator& r) const;
+	constexpr Rotator operator+(const Rotator& r) const;
+	constexpr Rotator operator-(const Rotator& r) const;
 	inline Rotator& operator+=(const Rotator& r);
 	inline Rotator& operator-=(const Rotator& r);
 
 	// Component-wise Scaling
-	inline Rotator operator*(float scale) const;
+	constexpr Rotator operator*(float scale) const;
 	inline Rotator& operator*=(float scale);
 
 	// Comparison Operators. Checks for exact equality.
-	inline bool operator== (const Rotator& r) const;
-	inline bool operator!= (const Rotator& r) const;
+	constexpr bool operator== (const Rotator& r) const;
+	constexpr bool operator!= (const Rotator& r) const;
 
 	/////////////////////////////////////////////////////
 	// Member Functions
@@ -151,6 +152,13 @@ public:
 	// Returns the vector rotated by the inverse of this vector
 	Vec3 UnrotateVector(const Vec3& v) const;
 
+	// Batch versions. Build Matrix() once instead of per vector, then
+	// stream with SIMD. Same rules as Quat::RotateVectors
+	void RotateVectors(const Vec3* in, Vec3* out, size_t n) const;
+	void UnrotateVectors(const Vec3* in, Vec3* out, size_t n) const;
+	void RotateVectors(const float* in, size_t inStride, float* out, size_t outStride, size_t n) const;
+	void UnrotateVectors(const float* in, size_t inStride, float* out, size_t outStride, size_t n) const;
+
 	// Clamps rotation values so they fall within the range [0,360].
 	inline Rotator& Clamp();
 
@@ -194,16 +202,24 @@ private:
 	// Preserve correctness of game object's transform
 	void UpdateBoundTransform();
 
+	// Before modifying this in place: bring it up to date with the bound
+	// transform's quat (only stale when the quat is authoritative, see
+	// Transform::SetQuatAuthoritative)
+	inline void SyncBoundTransform();
+	void PullBoundTransform();
+
 }; // struct Rotator
 
 // ------------------------- INLINE IMPLEMENTATIONS ---------------------
 
-inline Rotator Rotator::MakeFromEuler(const Vec3& eulers)
+inline constexpr Rotator Rotator::ZeroRotator{};
+
+constexpr Rotator Rotator::MakeFromEuler(const Vec3& eulers)
 {
 	return Rotator{ eulers.x, eulers.y, eulers.z };
 }
 
-inline Rotator Rotator::MakeFromEuler(float x_pitch, float y_yaw, float z_roll)
+constexpr Rotator Rotator::MakeFromEuler(float x_pitch, float y_yaw, float z_roll)
 {
 	return Rotator(x_pitch, y_yaw, z_roll);
 }
@@ -218,18 +234,19 @@ inline Rotator& Rotator::operator=(const Rotator& r)
 	return *this;
 }
 
-inline Rotator Rotator::operator+(const Rotator& r) const
+constexpr Rotator Rotator::operator+(const Rotator& r) const
 {
 	return Rotator(pitch + r.pitch, yaw + r.yaw, roll + r.roll);
 }
 
-inline Rotator Rotator::operator-(const Rotator& r) const
+constexpr Rotator Rotator::operator-(const Rotator& r) const
 {
 	return Rotator(pitch - r.pitch, yaw - r.yaw, roll - r.roll);
 }
 
 inline Rotator& Rotator::operator+=(const Rotator& r)
 {
+	SyncBoundTransform();
 	pitch += r.pitch;
 	yaw += r.yaw;
 	roll += r.roll;
@@ -240,6 +257,7 @@ inline Rotator& Rotator::operator+=(const Rotator& r)
 
 inline Rotator& Rotator::operator-=(const Rotator& r)
 {
+	SyncBoundTransform();
 	pitch -= r.pitch;
 	yaw -= r.yaw;
 	roll -= r.roll;
@@ -248,13 +266,14 @@ inline Rotator& Rotator::operator-=(const Rotator& r)
 	return *this;
 }
 
-inline Rotator Rotator::operator*(float scale) const
+constexpr Rotator Rotator::operator*(float scale) const
 {
 	return Rotator(pitch * scale, yaw * scale, roll * scale);
 }
 
 inline Rotator& Rotator::operator*=(float scale)
 {
+	SyncBoundTransform();
 	pitch *= scale;
 	yaw *= scale;
 	roll *= scale;
@@ -263,12 +282,12 @@ inline Rotator& Rotator::operator*=(float scale)
 	return *this;
 }
 
-inline bool Rotator::operator==(const Rotator& r) const
+constexpr bool Rotator::operator==(const Rotator& r) const
 {
 	return pitch == r.pitch && yaw == r.yaw && roll == r.roll;
 }
 
-inline bool Rotator::operator!=(const Rotator& r) const
+constexpr bool Rotator::operator!=(const Rotator& r) const
 {
 	return pitch != r.pitch || yaw != r.yaw || roll != r.roll;
 }
@@ -296,6 +315,7 @@ inline bool Rotator::Equals(const Rotator& r, float tolerance) const
 
 inline Rotator& Rotator::Add(float deltaPitch, float deltaYaw, float deltaRoll)
 {
+	SyncBoundTransform();
 	pitch += deltaPitch;
 	yaw += deltaYaw;
 	roll += deltaRoll;
@@ -303,6 +323,12 @@ inline Rotator& Rotator::Add(float deltaPitch, float deltaYaw, float deltaRoll)
 	return *this;
 }
 
+inline void Rotator::SyncBoundTransform()
+{
+	if (mp_BoundTransform)
+		PullBoundTransform();
+}
+
 inline Rotator& Rotator::Clamp()
 {
 	pitch = ClampAxis(pitch);
@@ -348,6 +374,7 @@ inline void Rotator::DiagnosticCheckNaN() const
 {
 	if (ContainsNaN())
 	{
+		SNOVA_INSTRUMENT_EVENT(NAN_CHECK_HIT);
 		std::cout << "Rotator contains NaN: " << ToString() << std::endl;
 		*const_cast<Rotator*>(this) = Rotator::ZeroRotator;
 	}
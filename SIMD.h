@@ -0,0 +1,469 @@
+/******************************************************************************/
+/*!
+\file		SIMD.h
+\author		Justin Leow
+\brief
+	Thin wrappers over the SSE/AVX2/NEON float registers used by the batch
+	(structure-of-arrays) kernels, plus a one-float Scalar type with the exact
+	same interface.
+
+	Kernels are written once as templates over the lane type and run with
+	SIMD::Wide for the bulk of an array and SIMD::Scalar for the leftover
+	tail (or everything, when no SIMD backend is available).
+
+	Comparisons return a lane-sized mask that is only meant to be passed to
+	Select(), And(), Or() or MaskBits().
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "GenMath.h"
+#include <cstddef>
+#include <new>
+
+#if SNOVA_SIMD_AVX2
+#include <immintrin.h>
+#elif SNOVA_SIMD_SSE
+#include <emmintrin.h>
+#elif SNOVA_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace SNova
+{
+namespace SIMD
+{
+	// Alignment of batch arrays. Enough for the widest backend
+	static constexpr size_t ALIGNMENT = 32;
+
+	/////////////////////////////////////////////////////
+	// Scalar (fallback and tails)
+
+	struct Scalar
+	{
+		static constexpr size_t Width = 1;
+		float v;
+
+		static inline Scalar Load(const float* p) { return Scalar{ *p }; }
+		static inline Scalar Set(float f) { return Scalar{ f }; }
+		inline void Store(float* p) const { *p = v; }
+	};
+
+	inline Scalar operator+(Scalar a, Scalar b) { return Scalar{ a.v + b.v }; }
+	inline Scalar operator-(Scalar a, Scalar b) { return Scalar{ a.v - b.v }; }
+	inline Scalar operator*(Scalar a, Scalar b) { return Scalar{ a.v * b.v }; }
+	inline Scalar operator/(Scalar a, Scalar b) { return Scalar{ a.v / b.v }; }
+	inline Scalar operator-(Scalar a) { return Scalar{ -a.v }; }
+
+	inline Scalar Sqrt(Scalar a) { return Scalar{ sqrtf(a.v) }; }
+	inline Scalar InvSqrt(Scalar a) { return Scalar{ 1.f / sqrtf(a.v) }; }
+	inline Scalar Abs(Scalar a) { return Scalar{ fabsf(a.v) }; }
+	inline Scalar Min(Scalar a, Scalar b) { return Scalar{ Math::Min(a.v, b.v) }; }
+	inline Scalar Max(Scalar a, Scalar b) { return Scalar{ Math::Max(a.v, b.v) }; }
+
+	// Round to the nearest integer (ties to even), result stays a float
+	inline Scalar Round(Scalar a) { return Scalar{ nearbyintf(a.v) }; }
+
+	// Masks are 1 (true) or 0 (false)
+	inline Scalar CmpLT(Scalar a, Scalar b) { return Scalar{ a.v <  b.v ? 1.f : 0.f }; }
+	inline Scalar CmpLE(Scalar a, Scalar b) { return Scalar{ a.v <= b.v ? 1.f : 0.f }; }
+	inline Scalar CmpGT(Scalar a, Scalar b) { return Scalar{ a.v >  b.v ? 1.f : 0.f }; }
+	inline Scalar CmpGE(Scalar a, Scalar b) { return Scalar{ a.v >= b.v ? 1.f : 0.f }; }
+	inline Scalar And(Scalar a, Scalar b) { return Scalar{ (a.v != 0.f && b.v != 0.f) ? 1.f : 0.f }; }
+	inline Scalar Or(Scalar a, Scalar b) { return Scalar{ (a.v != 0.f || b.v != 0.f) ? 1.f : 0.f }; }
+
+	// mask ? a : b
+	inline Scalar Select(Scalar mask, Scalar a, Scalar b) { return (mask.v != 0.f) ? a : b; }
+
+	// Bit k set if lane k of mask is true
+	inline unsigned MaskBits(Scalar mask) { return (mask.v != 0.f) ? 1u : 0u; }
+
+	/////////////////////////////////////////////////////
+	// Widest available backend
+
+#if SNOVA_SIMD_AVX2
+
+	struct Wide
+	{
+		static constexpr size_t Width = 8;
+		__m256 v;
+
+		static inline Wide Load(const float* p) { return Wide{ _mm256_loadu_ps(p) }; }
+		static inline Wide Set(float f) { return Wide{ _mm256_set1_ps(f) }; }
+		inline void Store(float* p) const { _mm256_storeu_ps(p, v); }
+	};
+
+	inline Wide operator+(Wide a, Wide b) { return Wide{ _mm256_add_ps(a.v, b.v) }; }
+	inline Wide operator-(Wide a, Wide b) { return Wide{ _mm256_sub_ps(a.v, b.v) }; }
+	inline Wide operator*(Wide a, Wide b) { return Wide{ _mm256_mul_ps(a.v, b.v) }; }
+	inline Wide operator/(Wide a, Wide b) { return Wide{ _mm256_div_ps(a.v, b.v) }; }
+	inline Wide operator-(Wide a) { return Wide{ _mm256_xor_ps(a.v, _mm256_set1_ps(-0.f)) }; }
+
+	inline Wide Sqrt(Wide a) { return Wide{ _mm256_sqrt_ps(a.v) }; }
+	inline Wide Abs(Wide a) { return Wide{ _mm256_andnot_ps(_mm256_set1_ps(-0.f), a.v) }; }
+	inline Wide Min(Wide a, Wide b) { return Wide{ _mm256_min_ps(a.v, b.v) }; }
+	inline Wide Max(Wide a, Wide b) { return Wide{ _mm256_max_ps(a.v, b.v) }; }
+	inline Wide Round(Wide a) { return Wide{ _mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) }; }
+
+	inline Wide InvSqrt(Wide a)
+	{
+#if SNOVA_DETERMINISTIC_MATH
+		// rsqrt differs between Intel and AMD
+		return Wide{ _mm256_div_ps(_mm256_set1_ps(1.f), _mm256_sqrt_ps(a.v)) };
+#else
+		// Estimate + one Newton-Raphson step (~23 bits)
+		const __m256 est = _mm256_rsqrt_ps(a.v);
+		const __m256 halfA = _mm256_mul_ps(a.v, _mm256_set1_ps(0.5f));
+		const __m256 estSq = _mm256_mul_ps(est, est);
+		return Wide{ _mm256_mul_ps(est, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(halfA, estSq))) };
+#endif
+	}
+
+	inline Wide CmpLT(Wide a, Wide b) { return Wide{ _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+	inline Wide CmpLE(Wide a, Wide b) { return Wide{ _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+	inline Wide CmpGT(Wide a, Wide b) { return Wide{ _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+	inline Wide CmpGE(Wide a, Wide b) { return Wide{ _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+	inline Wide And(Wide a, Wide b) { return Wide{ _mm256_and_ps(a.v, b.v) }; }
+	inline Wide Or(Wide a, Wide b) { return Wide{ _mm256_or_ps(a.v, b.v) }; }
+
+	inline Wide Select(Wide mask, Wide a, Wide b) { return Wide{ _mm256_blendv_ps(b.v, a.v, mask.v) }; }
+	inline unsigned MaskBits(Wide mask) { return static_cast<unsigned>(_mm256_movemask_ps(mask.v)); }
+
+#elif SNOVA_SIMD_SSE
+
+	struct Wide
+	{
+		static constexpr size_t Width = 4;
+		__m128 v;
+
+		static inline Wide Load(const float* p) { return Wide{ _mm_loadu_ps(p) }; }
+		static inline Wide Set(float f) { return Wide{ _mm_set1_ps(f) }; }
+		inline void Store(float* p) const { _mm_storeu_ps(p, v); }
+	};
+
+	inline Wide operator+(Wide a, Wide b) { return Wide{ _mm_add_ps(a.v, b.v) }; }
+	inline Wide operator-(Wide a, Wide b) { return Wide{ _mm_sub_ps(a.v, b.v) }; }
+	inline Wide operator*(Wide a, Wide b) { return Wide{ _mm_mul_ps(a.v, b.v) }; }
+	inline Wide operator/(Wide a, Wide b) { return Wide{ _mm_div_ps(a.v, b.v) }; }
+	inline Wide operator-(Wide a) { return Wide{ _mm_xor_ps(a.v, _mm_set1_ps(-0.f)) }; }
+
+	inline Wide Sqrt(Wide a) { return Wide{ _mm_sqrt_ps(a.v) }; }
+	inline Wide Abs(Wide a) { return Wide{ _mm_andnot_ps(_mm_set1_ps(-0.f), a.v) }; }
+	inline Wide Min(Wide a, Wide b) { return Wide{ _mm_min_ps(a.v, b.v) }; }
+	inline Wide Max(Wide a, Wide b) { return Wide{ _mm_max_ps(a.v, b.v) }; }
+
+	// SSE2 has no round; go through int32 (fine for |a| < 2^31)
+	inline Wide Round(Wide a) { return Wide{ _mm_cvtepi32_ps(_mm_cvtps_epi32(a.v)) }; }
+
+	inline Wide InvSqrt(Wide a)
+	{
+#if SNOVA_DETERMINISTIC_MATH
+		// rsqrt differs between Intel and AMD
+		return Wide{ _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(a.v)) };
+#else
+		// Estimate + one Newton-Raphson step (~23 bits)
+		const __m128 est = _mm_rsqrt_ps(a.v);
+		const __m128 halfA = _mm_mul_ps(a.v, _mm_set1_ps(0.5f));
+		const __m128 estSq = _mm_mul_ps(est, est);
+		return Wide{ _mm_mul_ps(est, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfA, estSq))) };
+#endif
+	}
+
+	inline Wide CmpLT(Wide a, Wide b) { return Wide{ _mm_cmplt_ps(a.v, b.v) }; }
+	inline Wide CmpLE(Wide a, Wide b) { return Wide{ _mm_cmple_ps(a.v, b.v) }; }
+	inline Wide CmpGT(Wide a, Wide b) { return Wide{ _mm_cmpgt_ps(a.v, b.v) }; }
+	inline Wide CmpGE(Wide a, Wide b) { return Wide{ _mm_cmpge_ps(a.v, b.v) }; }
+	inline Wide And(Wide a, Wide b) { return Wide{ _mm_and_ps(a.v, b.v) }; }
+	inline Wide Or(Wide a, Wide b) { return Wide{ _mm_or_ps(a.v, b.v) }; }
+
+	// SSE2 has no blendv
+	inline Wide Select(Wide mask, Wide a, Wide b)
+	{
+		return Wide{ _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) };
+	}
+
+	inline unsigned MaskBits(Wide mask) { return static_cast<unsigned>(_mm_movemask_ps(mask.v)); }
+
+#elif SNOVA_SIMD_NEON
+
+	struct Wide
+	{
+		static constexpr size_t Width = 4;
+		float32x4_t v;
+
+		static inline Wide Load(const float* p) { return Wide{ vld1q_f32(p) }; }
+		static inline Wide Set(float f) { return Wide{ vdupq_n_f32(f) }; }
+		inline void Store(float* p) const { vst1q_f32(p, v); }
+	};
+
+	inline Wide operator+(Wide a, Wide b) { return Wide{ vaddq_f32(a.v, b.v) }; }
+	inline Wide operator-(Wide a, Wide b) { return Wide{ vsubq_f32(a.v, b.v) }; }
+	inline Wide operator*(Wide a, Wide b) { return Wide{ vmulq_f32(a.v, b.v) }; }
+	inline Wide operator-(Wide a) { return Wide{ vnegq_f32(a.v) }; }
+
+#if SNOVA_DETERMINISTIC_MATH
+	// The estimate instructions are not specified bit for bit; use the
+	// exact AArch64 ones (GenMath.h only picks NEON there in this mode)
+	inline Wide operator/(Wide a, Wide b) { return Wide{ vdivq_f32(a.v, b.v) }; }
+	inline Wide Sqrt(Wide a) { return Wide{ vsqrtq_f32(a.v) }; }
+	inline Wide InvSqrt(Wide a) { return Wide{ vdivq_f32(vdupq_n_f32(1.f), vsqrtq_f32(a.v)) }; }
+#else
+	inline Wide operator/(Wide a, Wide b)
+	{
+		// Reciprocal estimate + two Newton-Raphson steps
+		float32x4_t r = vrecpeq_f32(b.v);
+		r = vmulq_f32(r, vrecpsq_f32(b.v, r));
+		r = vmulq_f32(r, vrecpsq_f32(b.v, r));
+		return Wide{ vmulq_f32(a.v, r) };
+	}
+
+	inline Wide InvSqrt(Wide a)
+	{
+		// Estimate + two Newton-Raphson steps
+		float32x4_t r = vrsqrteq_f32(a.v);
+		r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(a.v, r), r));
+		r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(a.v, r), r));
+		return Wide{ r };
+	}
+
+	inline Wide Sqrt(Wide a)
+	{
+		// sqrt(a) = a * (1 / sqrt(a)), with sqrt(0) kept at 0
+		const uint32x4_t isZero = vceqq_f32(a.v, vdupq_n_f32(0.f));
+		const float32x4_t r = vmulq_f32(a.v, InvSqrt(a).v);
+		return Wide{ vbslq_f32(isZero, vdupq_n_f32(0.f), r) };
+	}
+#endif
+
+	inline Wide Abs(Wide a) { return Wide{ vabsq_f32(a.v) }; }
+	inline Wide Min(Wide a, Wide b) { return Wide{ vminq_f32(a.v, b.v) }; }
+	inline Wide Max(Wide a, Wide b) { return Wide{ vmaxq_f32(a.v, b.v) }; }
+	inline Wide Round(Wide a) { return Wide{ vrndnq_f32(a.v) }; }
+
+	inline Wide CmpLT(Wide a, Wide b) { return Wide{ vreinterpretq_f32_u32(vcltq_f32(a.v, b.v)) }; }
+	inline Wide CmpLE(Wide a, Wide b) { return Wide{ vreinterpretq_f32_u32(vcleq_f32(a.v, b.v)) }; }
+	inline Wide CmpGT(Wide a, Wide b) { return Wide{ vreinterpretq_f32_u32(vcgtq_f32(a.v, b.v)) }; }
+	inline Wide CmpGE(Wide a, Wide b) { return Wide{ vreinterpretq_f32_u32(vcgeq_f32(a.v, b.v)) }; }
+
+	inline Wide And(Wide a, Wide b)
+	{
+		return Wide{ vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))) };
+	}
+
+	inline Wide Or(Wide a, Wide b)
+	{
+		return Wide{ vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(a.v), vreinterpretq_u32_f32(b.v))) };
+	}
+
+	inline Wide Select(Wide mask, Wide a, Wide b)
+	{
+		return Wide{ vbslq_f32(vreinterpretq_u32_f32(mask.v), a.v, b.v) };
+	}
+
+	inline unsigned MaskBits(Wide mask)
+	{
+		// Each lane is all ones or all zeros; keep one bit per lane and add them up
+		static const uint32_t LANE_BITS[4] = { 1, 2, 4, 8 };
+		const uint32x4_t bits = vandq_u32(vreinterpretq_u32_f32(mask.v), vld1q_u32(LANE_BITS));
+		return vaddvq_u32(bits);
+	}
+
+#else
+
+	// No SIMD backend; batch kernels run one float at a time
+	typedef Scalar Wide;
+
+#endif
+
+	/////////////////////////////////////////////////////
+	// Quad: always 4 floats in one register, whatever Wide is. For the
+	// padded rows of small fixed-size types (see Matrix3x4, Vector3DPacked).
+	// Load/Store need 16-byte aligned pointers. Dot3/Cross3 use lanes 0-2
+	// only; Cross3 leaves lane 3 at 0. Transpose4 transposes the 4x4 matrix
+	// whose rows are r0..r3, in place.
+
+#if SNOVA_SIMD_AVX2 || SNOVA_SIMD_SSE
+
+	struct Quad
+	{
+		__m128 v;
+
+		static inline Quad Load(const float* p) { return Quad{ _mm_load_ps(p) }; }
+		static inline Quad Set(float f) { return Quad{ _mm_set1_ps(f) }; }
+		static inline Quad Set(float x, float y, float z, float w) { return Quad{ _mm_setr_ps(x, y, z, w) }; }
+		inline void Store(float* p) const { _mm_store_ps(p, v); }
+	};
+
+	inline Quad operator+(Quad a, Quad b) { return Quad{ _mm_add_ps(a.v, b.v) }; }
+	inline Quad operator-(Quad a, Quad b) { return Quad{ _mm_sub_ps(a.v, b.v) }; }
+	inline Quad operator*(Quad a, Quad b) { return Quad{ _mm_mul_ps(a.v, b.v) }; }
+	inline Quad operator/(Quad a, Quad b) { return Quad{ _mm_div_ps(a.v, b.v) }; }
+	inline Quad operator-(Quad a) { return Quad{ _mm_xor_ps(a.v, _mm_set1_ps(-0.f)) }; }
+
+	inline float Dot3(Quad a, Quad b)
+	{
+		const __m128 m = _mm_mul_ps(a.v, b.v);
+		const __m128 y = _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1));
+		const __m128 z = _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 2, 2, 2));
+		return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(m, y), z));
+	}
+
+	inline Quad Cross3(Quad a, Quad b)
+	{
+		// a * b.yzx - a.yzx * b gives the cross product in zxy order
+		const __m128 aYZX = _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 bYZX = _mm_shuffle_ps(b.v, b.v, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 c = _mm_sub_ps(_mm_mul_ps(a.v, bYZX), _mm_mul_ps(aYZX, b.v));
+		return Quad{ _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1)) };
+	}
+
+	inline void Transpose4(Quad& r0, Quad& r1, Quad& r2, Quad& r3)
+	{
+		_MM_TRANSPOSE4_PS(r0.v, r1.v, r2.v, r3.v);
+	}
+
+#elif SNOVA_SIMD_NEON
+
+	struct Quad
+	{
+		float32x4_t v;
+
+		static inline Quad Load(const float* p) { return Quad{ vld1q_f32(p) }; }
+		static inline Quad Set(float f) { return Quad{ vdupq_n_f32(f) }; }
+		static inline Quad Set(float x, float y, float z, float w)
+		{
+			const float lanes[4] = { x, y, z, w };
+			return Quad{ vld1q_f32(lanes) };
+		}
+		inline void Store(float* p) const { vst1q_f32(p, v); }
+	};
+
+	inline Quad operator+(Quad a, Quad b) { return Quad{ vaddq_f32(a.v, b.v) }; }
+	inline Quad operator-(Quad a, Quad b) { return Quad{ vsubq_f32(a.v, b.v) }; }
+	inline Quad operator*(Quad a, Quad b) { return Quad{ vmulq_f32(a.v, b.v) }; }
+	inline Quad operator-(Quad a) { return Quad{ vnegq_f32(a.v) }; }
+
+	inline Quad operator/(Quad a, Quad b)
+	{
+#if SNOVA_DETERMINISTIC_MATH
+		return Quad{ vdivq_f32(a.v, b.v) };
+#else
+		// Same as Wide: reciprocal estimate + two Newton-Raphson steps
+		float32x4_t r = vrecpeq_f32(b.v);
+		r = vmulq_f32(r, vrecpsq_f32(b.v, r));
+		r = vmulq_f32(r, vrecpsq_f32(b.v, r));
+		return Quad{ vmulq_f32(a.v, r) };
+#endif
+	}
+
+	inline float Dot3(Quad a, Quad b)
+	{
+		const float32x4_t m = vmulq_f32(a.v, b.v);
+		return vgetq_lane_f32(m, 0) + vgetq_lane_f32(m, 1) + vgetq_lane_f32(m, 2);
+	}
+
+	inline Quad Cross3(Quad a, Quad b)
+	{
+		// (x, y, z, w) -> (y, z, x, w)
+		auto YZX = [](float32x4_t v)
+		{
+			const float32x4_t t = vextq_f32(v, v, 1);
+			return vsetq_lane_f32(vgetq_lane_f32(v, 3), vsetq_lane_f32(vgetq_lane_f32(v, 0), t, 2), 3);
+		};
+
+		// a * b.yzx - a.yzx * b gives the cross product in zxy order
+		const float32x4_t c = vsubq_f32(vmulq_f32(a.v, YZX(b.v)), vmulq_f32(YZX(a.v), b.v));
+		return Quad{ YZX(c) };
+	}
+
+	inline void Transpose4(Quad& r0, Quad& r1, Quad& r2, Quad& r3)
+	{
+		// Transpose the 2x2 blocks, then swap the off-diagonal blocks
+		const float32x4x2_t t01 = vtrnq_f32(r0.v, r1.v);
+		const float32x4x2_t t23 = vtrnq_f32(r2.v, r3.v);
+		r0.v = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+		r1.v = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+		r2.v = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+		r3.v = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+	}
+
+#else
+
+	struct Quad
+	{
+		float v[4];
+
+		static inline Quad Load(const float* p) { return Quad{ { p[0], p[1], p[2], p[3] } }; }
+		static inline Quad Set(float f) { return Quad{ { f, f, f, f } }; }
+		static inline Quad Set(float x, float y, float z, float w) { return Quad{ { x, y, z, w } }; }
+		inline void Store(float* p) const { p[0] = v[0]; p[1] = v[1]; p[2] = v[2]; p[3] = v[3]; }
+	};
+
+	inline Quad operator+(Quad a, Quad b) { return Quad{ { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+	inline Quad operator-(Quad a, Quad b) { return Quad{ { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } }; }
+	inline Quad operator*(Quad a, Quad b) { return Quad{ { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+	inline Quad operator/(Quad a, Quad b) { return Quad{ { a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] } }; }
+	inline Quad operator-(Quad a) { return Quad{ { -a.v[0], -a.v[1], -a.v[2], -a.v[3] } }; }
+
+	inline float Dot3(Quad a, Quad b) { return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2]; }
+
+	inline Quad Cross3(Quad a, Quad b)
+	{
+		return Quad{ {
+			a.v[1] * b.v[2] - b.v[1] * a.v[2],
+			a.v[2] * b.v[0] - b.v[2] * a.v[0],
+			a.v[0] * b.v[1] - b.v[0] * a.v[1],
+			0.f } };
+	}
+
+	inline void Transpose4(Quad& r0, Quad& r1, Quad& r2, Quad& r3)
+	{
+		const Quad a = r0, b = r1, c = r2, d = r3;
+		r0 = Quad{ { a.v[0], b.v[0], c.v[0], d.v[0] } };
+		r1 = Quad{ { a.v[1], b.v[1], c.v[1], d.v[1] } };
+		r2 = Quad{ { a.v[2], b.v[2], c.v[2], d.v[2] } };
+		r3 = Quad{ { a.v[3], b.v[3], c.v[3], d.v[3] } };
+	}
+
+#endif
+
+	/////////////////////////////////////////////////////
+	// Aligned storage for SoA arrays
+
+	inline float* AllocateFloats(size_t count)
+	{
+		return static_cast<float*>(::operator new(count * sizeof(float), std::align_val_t{ ALIGNMENT }));
+	}
+
+	inline void FreeFloats(float* p)
+	{
+		::operator delete(p, std::align_val_t{ ALIGNMENT });
+	}
+
+	// Round a float count up so the next array starts on an ALIGNMENT boundary
+	constexpr inline size_t PadCount(size_t count)
+	{
+		constexpr size_t perLine = ALIGNMENT / sizeof(float);
+		return (count + perLine - 1) / perLine * perLine;
+	}
+
+	/////////////////////////////////////////////////////
+	// Kernel driver
+
+	// Runs fn(i, lane) over [0, count): whole registers first, then the tail
+	template <typename Fn>
+	inline void RunBatch(size_t count, Fn&& fn)
+	{
+		size_t i = 0;
+		for (; i + Wide::Width <= count; i += Wide::Width)
+			fn(i, Wide{});
+		for (; i < count; ++i)
+			fn(i, Scalar{});
+	}
+
+} // namespace SIMD
+} // namespace SNova
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "SNova.h"
+#include "TagTable.h"
+#include <iostream>
+
+namespace SNova
+{
+
+	TagTable& TagTable::Get()
+	{
+		// Never destroyed, so Transforms destroyed at exit can still unregister
+		static TagTable* instance = new TagTable{};
+		return *instance;
+	}
+
+	TagID TagTable::Intern(const std::string& name)
+	{
+		const TagID tag = Acquire(name);
+		if (tag != INVALID_TAG)
+			interned.set(tag);
+		return tag;
+	}
+
+	TagID TagTable::Acquire(const std::string& name)
+	{
+		if (name.empty())
+			return INVALID_TAG;
+
+		auto it = ids.find(name);
+		if (it != ids.end())
+			return it->second;
+
+		TagID tag;
+		if (!freeIds.empty())
+		{
+			tag = freeIds.back();
+			freeIds.pop_back();
+			names[tag] = name;
+		}
+		else if (names.size() < MAX_TAGS)
+		{
+			tag = static_cast<TagID>(names.size());
+			names.push_back(name);
+			members.emplace_back();
+		}
+		else
+		{
+			std::cout << "TagTable is full (" << MAX_TAGS << " tags in use), not interning tag: " << name << std::endl;
+			return INVALID_TAG;
+		}
+
+		ids.emplace(name, tag);
+		return tag;
+	}
+
+	TagID TagTable::Find(const std::string& name) const
+	{
+		auto it = ids.find(name);
+		return it != ids.end() ? it->second : INVALID_TAG;
+	}
+
+	const std::string& TagTable::GetName(TagID tag) const
+	{
+		static const std::string none;
+		return tag < names.size() ? names[tag] : none;
+	}
+
+	size_t TagTable::Size() const
+	{
+		return names.size();
+	}
+
+	const std::vector<Transform*>& TagTable::FindAllWithTag(TagID tag) const
+	{
+		static const std::vector<Transform*> none;
+		return tag < members.size() ? members[tag] : none;
+	}
+
+	uint32_t TagTable::AddMember(TagID tag, Transform* transform)
+	{
+		members[tag].push_back(transform);
+		return static_cast<uint32_t>(members[tag].size() - 1);
+	}
+
+	Transform* TagTable::RemoveMember(TagID tag, uint32_t index)
+	{
+		// swap with back, order doesn't matter
+		std::vector<Transform*>& list = members[tag];
+		Transform* moved = nullptr;
+		if (index + 1 < list.size())
+		{
+			moved = list.back();
+			list[index] = moved;
+		}
+		list.pop_back();
+
+		// Last carrier gone: free the name for reuse
+		if (list.empty() && !interned.test(tag))
+		{
+			ids.erase(names[tag]);
+			names[tag].clear();
+			freeIds.push_back(tag);
+		}
+		return moved;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SNova
+{
+class Transform;
+
+typedef uint16_t TagID;
+constexpr TagID INVALID_TAG = UINT16_MAX;
+
+// Global table of interned tag names.
+// Each distinct tag name gets a small TagID, and Transforms store
+// their tags as a bitset of IDs, so tag checks are one bit test.
+// The table also keeps, per tag, every Transform that has it (see FindAllWithTag).
+// A name set through Transform is counted by those lists: once no Transform
+// carries it, its ID goes back to the table for the next new name. Names
+// from Intern keep their ID for the rest of the run, so it can be cached.
+// At most MAX_TAGS names are in use at once.
+// Not thread safe: intern and change tags from one thread.
+class TagTable
+{
+public:
+	static constexpr size_t MAX_TAGS = 128;
+	typedef std::bitset<MAX_TAGS> TagSet;
+
+	static TagTable& Get();
+
+	// ID for a tag name, adding it if new. The ID is never reused for another name.
+	// Returns INVALID_TAG for an empty name or when MAX_TAGS names are in use
+	TagID Intern(const std::string& name);
+
+	// ID of a tag name. Returns INVALID_TAG if it is not in use. Does not allocate.
+	// Unless the name was interned, the ID is only good while a Transform carries it
+	TagID Find(const std::string& name) const;
+
+	// Empty for an ID that is not in use
+	const std::string& GetName(TagID tag) const;
+
+	// One past the highest ID handed out so far, free ones included
+	size_t Size() const;
+
+	// Every Transform whose tags include tag, in no particular order.
+	// Invalidated by any tag change.
+	const std::vector<Transform*>& FindAllWithTag(TagID tag) const;
+
+private:
+	friend class Transform;
+
+	// Where a Transform sits in the member list of one of its tags
+	struct Slot
+	{
+		TagID tag;
+		uint32_t index;
+	};
+
+	TagTable() = default;
+
+	// ID for a tag name, adding it if new. Unlike Intern, the ID is freed
+	// when its last member leaves. Logs and returns INVALID_TAG when full
+	TagID Acquire(const std::string& name);
+
+	// Called by Transform when tag is added to / removed from it.
+	// AddMember returns the transform's index in the tag's list. RemoveMember
+	// moves the last member into index and returns it (nullptr if none moved)
+	uint32_t AddMember(TagID tag, Transform* transform);
+	Transform* RemoveMember(TagID tag, uint32_t index);
+
+	std::unordered_map<std::string, TagID> ids;
+	std::vector<std::string> names;
+	std::vector<std::vector<Transform*>> members;
+	std::vector<TagID> freeIds;
+	TagSet interned;
+};
+
+}
\ No newline at end of file
@@ -4,27 +4,93 @@
 //#include "OpenGLSystem.h"
 #include "ReflectionDrawFns.h"
 #include "Rotator.h"
+#include "MatrixCompose.h"
+#include "TransformNotifyQueue.h"
+#include "TransformPool.h"
+#include "Instrumentation.h"
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <fstream>
 
 namespace SNova
 {
 
-	void Transform::UpdateMtx()
+	// Conversion counters are bumped from const getters, possibly on several threads
+#if SNOVA_INSTRUMENTATION
+	#define SNOVA_COUNT_CONVERSION(counter) conversionStats.counter.fetch_add(1, std::memory_order_relaxed)
+#else
+	#define SNOVA_COUNT_CONVERSION(counter) ((void)0)
+#endif
+
+	void Transform::UpdateMtx() const
+	{
+		SNOVA_INSTRUMENT_SCOPE(TRANSFORM_UPDATE_MTX);
+
+		// build matrix straight from quat (no euler round trip),
+		// written in place instead of multiplying T, R and S
+		Mtx44ComposeTRS(mtx, position, rotation, scale);
+		isDirty = false;
+		SNOVA_COUNT_CONVERSION(mtxMisses);
+	}
+
+	void Transform::MarkDirty(unsigned changes)
 	{
-		// create rotation matrix
-		Mtx44 rotMtx{ rotator.Matrix() };
-		// create scaling matrix
-		Mtx44 scaleMtx;
-		Mtx44Scale(scaleMtx, scale.x, scale.y, scale.z);
-		// create translation matrix
-		Mtx44 transMtx;
-		Mtx44Translate(transMtx, position.x, position.y, position.z);
+		// mtx is rebuilt on the next Flush() / GetTransform()
+		if (changes & CHANGE_MTX)
+		{
+			isDirty = true;
+			++mtxVersion;
+			if (pool)
+				pool->QueueHotUpdate(poolSlot);
+		}
 
-		// concatenate the matrices
-		mtx = transMtx * (rotMtx * scaleMtx);
+		changeMask |= changes;
+		TransformNotifyQueue::Get().Enqueue(this);
+	}
 
-		// notify observers regarding change of mtx
-		Notify();
+	void Transform::Flush()
+	{
+		if (isDirty)
+			UpdateMtx();
+
+		if (changeMask != CHANGE_NONE)
+		{
+			// notify observers regarding change of mtx
+			{
+				SNOVA_INSTRUMENT_SCOPE(TRANSFORM_NOTIFY);
+				Notify();
+			}
+			changeMask = CHANGE_NONE;
+		}
+	}
+
+	bool Transform::IsDirty() const
+	{
+		return isDirty;
+	}
+
+	unsigned Transform::GetChangeMask() const
+	{
+		return changeMask;
+	}
+
+	unsigned Transform::GetMtxVersion() const
+	{
+		return mtxVersion;
+	}
+
+	Mtx44 Transform::GetTransform() const
+	{
+		// Lazily rebuild. mtx is a cache of position/rotation/scale.
+		// Observers are still only notified by Flush()
+		if (isDirty)
+			UpdateMtx();
+		else
+			SNOVA_COUNT_CONVERSION(mtxHits);
+		return mtx;
 	}
 
 	Transform::Transform()
@@ -36,41 +102,86 @@ namespace SNova
 		rotator.mp_BoundTransform = this;
 		rotation.mp_BoundTransform = this;
 
-		UpdateMtx();
+		MarkDirty(CHANGE_ALL);
 	}
 
 	Transform::Transform(const Transform& rhs)
 	: position{ rhs.position }
 	, scale{ rhs.scale }
-	, rotation{ rhs.rotation }
-	, rotator{ rhs.rotation }
+	, quatAuthoritative{ rhs.quatAuthoritative }
 	{
 		// Bind Quat and Rotator together
 		rotator.mp_BoundTransform = this;
 		rotation.mp_BoundTransform = this;
-		UpdateMtx();
+		CopyRotationFrom(rhs);
+		MarkDirty(CHANGE_ALL);
+
+		// Same inputs, so rhs's matrix is ours too if it is current
+		if (!rhs.isDirty)
+		{
+			mtx = rhs.mtx;
+			isDirty = false;
+			SNOVA_COUNT_CONVERSION(mtxHits);
+		}
 	}
 
-	Transform& Transform::operator=(const Transform& rhs)
+	Transform::Transform(Transform&& rhs)
+	: Component(std::move(rhs))
+	, position{ rhs.position }
+	, scale{ rhs.scale }
+	, quatAuthoritative{ rhs.quatAuthoritative }
 	{
-		Component::operator=(rhs);
-		SetPosition(rhs.position);
-		SetScale(rhs.scale);
-		rotation = rhs.rotation;
-		rotator = rhs.rotator;
-
 		// Bind Quat and Rotator together
 		rotator.mp_BoundTransform = this;
 		rotation.mp_BoundTransform = this;
+		MarkDirty(CHANGE_ALL);
+		CopyValuesFrom(rhs);
+		TakeTagsFrom(rhs);
+	}
+
+	Transform::~Transform()
+	{
+		TransformNotifyQueue::Get().Remove(this);
+		UpdateTagSet(TagTable::TagSet{});
+	}
+
+	Transform& Transform::operator=(const Transform& rhs)
+	{
+		Component::operator=(rhs);
+		CopyValuesFrom(rhs);
+		return *this;
+	}
+
+	Transform& Transform::operator=(Transform&& rhs)
+	{
+		if (this == &rhs)
+			return *this;
 
-		UpdateMtx();
+		Component::operator=(std::move(rhs));
+		CopyValuesFrom(rhs);
+		TakeTagsFrom(rhs);
 		return *this;
 	}
 
+	void Transform::CopyStateFrom(const Transform& rhs)
+	{
+		if (this == &rhs)
+			return;
+
+		CopyValuesFrom(rhs);
+
+		if (tagSet != rhs.tagSet || Tag != rhs.Tag)
+		{
+			UpdateTagSet(rhs.tagSet);
+			Tag = rhs.Tag;
+			MarkDirty(CHANGE_TAG);
+		}
+	}
+
 	void Transform::SetPosition(const Vec3& pos)
 	{
 		position = pos;
-		UpdateMtx();
+		MarkDirty(CHANGE_POSITION);
 	}
 
 	void Transform::SetPosition(const float& x, const float& y, const float& z)
@@ -78,25 +189,25 @@ namespace SNova
 		position.x = x;
 		position.y = y;
 		position.z = z;
-		UpdateMtx();
+		MarkDirty(CHANGE_POSITION);
 	}
 
 	void Transform::SetPosX(const float& x)
 	{
 		position.x = x;
-		UpdateMtx();
+		MarkDirty(CHANGE_POSITION);
 	}
 
 	void Transform::SetPosY(const float& y)
 	{
 		position.y = y;
-		UpdateMtx();
+		MarkDirty(CHANGE_POSITION);
 	}
 
 	void Transform::SetPosZ(const float& z)
 	{
 		position.z = z;
-		UpdateMtx();
+		MarkDirty(CHANGE_POSITION);
 	}
 
 	Vec3 Transform::GetPosition() const
@@ -119,59 +230,269 @@ namespace SNova
 	
 	const SNova::Matrix3x3& Transform::GetRotationMatrixInDegrees() const
 	{
-		float roX = rotator.pitch * 0.01745328888f;
-		float roY = rotator.yaw * 0.01745328888f;
-		float roZ = rotator.roll * 0.01745328888f;
+		const Rotator& euler = GetRotator();
+		float roX = euler.pitch * 0.01745328888f;
+		float roY = euler.yaw * 0.01745328888f;
+		float roZ = euler.roll * 0.01745328888f;
+
+		float sX, cX, sY, cY, sZ, cZ;
+		Math::SinCos<Math::TrigAccuracy::Exact>(roX, sX, cX);
+		Math::SinCos<Math::TrigAccuracy::Exact>(roY, sY, cY);
+		Math::SinCos<Math::TrigAccuracy::Exact>(roZ, sZ, cZ);
 
 		Matrix3x3 rotX{ 1.0f, 0, 0,
-						0, cosf(roX), -sinf(roX),
-						0, sinf(roX), cosf(roX) };
+						0, cX, -sX,
+						0, sX, cX };
 
-		Matrix3x3 rotY{ cosf(roY), 0, sinf(roY),
+		Matrix3x3 rotY{ cY, 0, sY,
 						0, 1.0f, 0
-						-sinf(roY), 0, cosf(roY) };
+						-sY, 0, cY };
 
-		Matrix3x3 rotZ{ cosf(roZ), -sinf(roZ), 0,
-						sinf(roZ), cosf(roZ), 0,
+		Matrix3x3 rotZ{ cZ, -sZ, 0,
+						sZ, cZ, 0,
 						0, 0, 1.0f };
 
 		return rotZ * rotY * rotX;
 	}
 
+	void Transform::SetRotation(const QuatValue& q)
+	{
+		rotation = Quat{ q };
+	}
+
+	QuatValue Transform::GetRotation() const
+	{
+		return QuatValue{ rotation };
+	}
+
+	void Transform::SetQuatAuthoritative(bool enable)
+	{
+		// Leave the rotator valid for code that reads it directly
+		SyncRotator();
+		quatAuthoritative = enable;
+	}
+
+	bool Transform::IsQuatAuthoritative() const
+	{
+		return quatAuthoritative;
+	}
+
+	const Rotator& Transform::GetRotator() const
+	{
+		// rotator is a cache of rotation, like mtx
+		SyncRotator();
+		return rotator;
+	}
+
+	Transform::ConversionStats Transform::GetConversionStats() const
+	{
+		ConversionStats stats;
+#if SNOVA_INSTRUMENTATION
+		stats.rotatorHits = conversionStats.rotatorHits.load(std::memory_order_relaxed);
+		stats.rotatorMisses = conversionStats.rotatorMisses.load(std::memory_order_relaxed);
+		stats.rotationHits = conversionStats.rotationHits.load(std::memory_order_relaxed);
+		stats.rotationMisses = conversionStats.rotationMisses.load(std::memory_order_relaxed);
+		stats.mtxHits = conversionStats.mtxHits.load(std::memory_order_relaxed);
+		stats.mtxMisses = conversionStats.mtxMisses.load(std::memory_order_relaxed);
+#endif
+		return stats;
+	}
+
+	void Transform::ResetConversionStats()
+	{
+#if SNOVA_INSTRUMENTATION
+		conversionStats.rotatorHits.store(0, std::memory_order_relaxed);
+		conversionStats.rotatorMisses.store(0, std::memory_order_relaxed);
+		conversionStats.rotationHits.store(0, std::memory_order_relaxed);
+		conversionStats.rotationMisses.store(0, std::memory_order_relaxed);
+		conversionStats.mtxHits.store(0, std::memory_order_relaxed);
+		conversionStats.mtxMisses.store(0, std::memory_order_relaxed);
+#endif
+	}
+
+	unsigned Transform::GetRotationVersion() const
+	{
+		return rotationVersion;
+	}
+
+	void Transform::SyncRotator() const
+	{
+		if (rotatorVersion == rotationVersion)
+		{
+			SNOVA_COUNT_CONVERSION(rotatorHits);
+			return;
+		}
+
+		const Rotator euler = rotation.GetRotator();
+		rotator.pitch = euler.pitch;
+		rotator.yaw = euler.yaw;
+		rotator.roll = euler.roll;
+		cachedEuler = Vec3{ euler.pitch, euler.yaw, euler.roll };
+		rotatorVersion = rotationVersion;
+		SNOVA_COUNT_CONVERSION(rotatorMisses);
+	}
+
+	// Exact compares: a write is only skipped if it changes nothing
+	static bool SameRotation(const QuatValue& a, const QuatValue& b)
+	{
+		return a.w == b.w && a.x == b.x && a.y == b.y && a.z == b.z;
+	}
+
+	static bool SameEuler(const Rotator& r, const Vec3& euler)
+	{
+		return r.pitch == euler.x && r.yaw == euler.y && r.roll == euler.z;
+	}
+
+	static bool SameVector(const Vec3& a, const Vec3& b)
+	{
+		return a.x == b.x && a.y == b.y && a.z == b.z;
+	}
+
+	void Transform::OnRotationWritten()
+	{
+		if (SameRotation(rotation, cachedRotation))
+		{
+			SNOVA_COUNT_CONVERSION(rotatorHits);
+			return;
+		}
+
+		cachedRotation = rotation;
+		++rotationVersion;
+
+		// Authoritative quat: rotator is rebuilt only when read (GetRotator)
+		if (!quatAuthoritative)
+			SyncRotator();
+		MarkDirty(CHANGE_ROTATION);
+	}
+
+	void Transform::OnRotatorWritten()
+	{
+		// Only skip if rotator was up to date before the write
+		if (rotatorVersion == rotationVersion && SameEuler(rotator, cachedEuler))
+		{
+			SNOVA_COUNT_CONVERSION(rotationHits);
+			return;
+		}
+
+		const Quat q = rotator.Quaternion();
+		rotation.w = q.w;
+		rotation.x = q.x;
+		rotation.y = q.y;
+		rotation.z = q.z;
+
+		// Just written, so the rotator is up to date even if the quat is authoritative
+		cachedRotation = q;
+		cachedEuler = Vec3{ rotator.pitch, rotator.yaw, rotator.roll };
+		rotatorVersion = ++rotationVersion;
+		SNOVA_COUNT_CONVERSION(rotationMisses);
+		MarkDirty(CHANGE_ROTATION);
+	}
+
+	void Transform::CopyRotationFrom(const Transform& rhs)
+	{
+		if (!SameRotation(rotation, rhs.rotation))
+		{
+			rotation.w = rhs.rotation.w;
+			rotation.x = rhs.rotation.x;
+			rotation.y = rhs.rotation.y;
+			rotation.z = rhs.rotation.z;
+			cachedRotation = rotation;
+			++rotationVersion;
+			MarkDirty(CHANGE_ROTATION);
+		}
+
+		if (rhs.rotatorVersion == rhs.rotationVersion)
+		{
+			// rhs's rotator matches this rotation, take it as it is
+			rotator.pitch = rhs.rotator.pitch;
+			rotator.yaw = rhs.rotator.yaw;
+			rotator.roll = rhs.rotator.roll;
+			cachedEuler = rhs.cachedEuler;
+			rotatorVersion = rotationVersion;
+			SNOVA_COUNT_CONVERSION(rotatorHits);
+		}
+		else if (!quatAuthoritative)
+		{
+			SyncRotator();
+		}
+	}
+
+	void Transform::CopyValuesFrom(const Transform& rhs)
+	{
+		unsigned changes = CHANGE_NONE;
+		if (!SameVector(position, rhs.position))
+		{
+			position = rhs.position;
+			changes |= CHANGE_POSITION;
+		}
+		if (!SameVector(scale, rhs.scale))
+		{
+			scale = rhs.scale;
+			changes |= CHANGE_SCALE;
+		}
+		if (changes != CHANGE_NONE)
+			MarkDirty(changes);
+
+		CopyRotationFrom(rhs);
+
+		// Same inputs, so rhs's matrix is ours too if it is current
+		if (isDirty && !rhs.isDirty)
+		{
+			mtx = rhs.mtx;
+			isDirty = false;
+			SNOVA_COUNT_CONVERSION(mtxHits);
+		}
+	}
+
+	void Transform::TakeTagsFrom(Transform& rhs)
+	{
+		if (tagSet.none() && rhs.tagSet.none() && Tag.empty() && rhs.Tag.empty())
+			return;
+
+		// Join rhs's tags before it leaves them, so none is freed in between
+		UpdateTagSet(rhs.tagSet);
+		rhs.UpdateTagSet(TagTable::TagSet{});
+
+		Tag = std::move(rhs.Tag);
+		rhs.Tag.clear();
+		MarkDirty(CHANGE_TAG);
+		rhs.MarkDirty(CHANGE_TAG);
+	}
+
 	void Transform::SetScale(const Vec3& s)
 	{
 		scale = s;
-		UpdateMtx();
+		MarkDirty(CHANGE_SCALE);
 	}
 
 	void Transform::SetScaleX(const float& x)
 	{
 		scale.x = x;
-		UpdateMtx();
+		MarkDirty(CHANGE_SCALE);
 	}
 
 	void Transform::SetScaleY(const float& y)
 	{
 		scale.y = y;
-		UpdateMtx();
+		MarkDirty(CHANGE_SCALE);
 	}
 
 	void Transform::SetScaleZ(const float& z)
 	{
 		scale.z = z;
-		UpdateMtx();
+		MarkDirty(CHANGE_SCALE);
 	}
 
 	void Transform::SetScale(float x, float y, float z)
 	{
 		scale = Vec3{ x, y, z };
-		UpdateMtx();
+		MarkDirty(CHANGE_SCALE);
 	}
 
 	void Transform::SetScale(float uniform)
 	{
 		scale = Vec3{ uniform, uniform, uniform };
-		UpdateMtx();
+		MarkDirty(CHANGE_SCALE);
 	}
 
 	Vec3 Transform::GetScale() const
@@ -199,11 +520,6 @@ namespace SNova
 		return Tag;
 	}
 
-	void Transform::SetTag(const std::string& input)
-	{
-		Tag = input;
-	}
-
 	// Helper function for tag system
 	std::vector<std::string> SplitTags(const std::string& tags)
 	{
@@ -223,32 +539,153 @@ namespace SNova
 		return tmp;
 	}
 
-	bool Transform::HasTag(const std::string& target)
+	// Names the table has no room for (it logs them) stay in the text, so
+	// they are not lost on the next save
+	void Transform::ParseTags(const std::string& input, TagTable::TagSet& set, std::string& text)
 	{
-		return Tag.find(target) != std::string::npos;
+		TagTable& table = TagTable::Get();
+		std::vector<std::string> unindexed;
+
+		for (const std::string& name : SplitTags(input))
+		{
+			if (std::find(unindexed.begin(), unindexed.end(), name) != unindexed.end())
+				continue;
+
+			const TagID tag = table.Acquire(name);
+			if (tag == INVALID_TAG)
+				unindexed.push_back(name);
+			else if (set.test(tag))
+				continue;
+			else
+				set.set(tag);
+
+			if (!text.empty())
+				text += ' ';
+			text += name;
+		}
 	}
 
-	void Transform::AddTag(const std::string& newTag)
+	void Transform::SetTag(const std::string& input)
+	{
+		TagTable::TagSet newSet;
+		std::string text;
+		ParseTags(input, newSet, text);
+
+		UpdateTagSet(newSet);
+		Tag = text;
+		MarkDirty(CHANGE_TAG);
+	}
+
+	void Transform::UpdateTagSet(const TagTable::TagSet& newSet)
+	{
+		const TagTable::TagSet changed = tagSet ^ newSet;
+		if (changed.none())
+			return;
+
+		TagTable& table = TagTable::Get();
+		for (size_t i = 0; i < table.Size(); ++i)
+		{
+			if (!changed.test(i))
+				continue;
+
+			const TagID tag = static_cast<TagID>(i);
+			if (newSet.test(i))
+			{
+				tagSlots.push_back(TagTable::Slot{ tag, table.AddMember(tag, this) });
+				continue;
+			}
+
+			// O(1) removal: the last member moves into our place in the list
+			TagTable::Slot& slot = FindTagSlot(tag);
+			if (Transform* moved = table.RemoveMember(tag, slot.index))
+				moved->FindTagSlot(tag).index = slot.index;
+			slot = tagSlots.back();
+			tagSlots.pop_back();
+		}
+		tagSet = newSet;
+	}
+
+	TagTable::Slot& Transform::FindTagSlot(TagID tag)
+	{
+		auto it = std::find_if(tagSlots.begin(), tagSlots.end(), [tag](const TagTable::Slot& slot) { return slot.tag == tag; });
+		return *it;
+	}
+
+	bool Transform::HasTag(const std::string& target) const
 	{
-		if (Tag == "")
-			SetTag(newTag);
+		return HasTag(TagTable::Get().Find(target));
+	}
 
-		if (!HasTag(newTag))
-			SetTag(Tag + ' ' + newTag);
+	void Transform::AddTag(const std::string& newTag)
+	{
+		AddTag(TagTable::Get().Acquire(newTag));
 	}
 
 	void Transform::RemoveTag(const std::string& target)
 	{
-		auto pos = Tag.find(target);
-		auto len = target.length();
+		RemoveTag(TagTable::Get().Find(target));
+	}
+
+	bool Transform::HasTag(TagID tag) const
+	{
+		return tag < TagTable::MAX_TAGS && tagSet.test(tag);
+	}
 
-		if (pos == std::string::npos)
+	void Transform::AddTag(TagID tag)
+	{
+		if (tag == INVALID_TAG || HasTag(tag))
 			return;
 
-		Tag.replace(pos, len+1, "");
+		TagTable::TagSet newSet = tagSet;
+		newSet.set(tag);
+		UpdateTagSet(newSet);
 
-		if (!Tag.empty() && Tag.back() == ' ')
-			Tag.pop_back();
+		if (!Tag.empty())
+			Tag += ' ';
+		Tag += TagTable::Get().GetName(tag);
+		MarkDirty(CHANGE_TAG);
+	}
+
+	void Transform::RemoveTag(TagID tag)
+	{
+		if (!HasTag(tag))
+			return;
+
+		// Copy the name first: if this is the tag's last carrier,
+		// UpdateTagSet frees the ID and its name
+		const std::string target = TagTable::Get().GetName(tag);
+
+		TagTable::TagSet newSet = tagSet;
+		newSet.reset(tag);
+		UpdateTagSet(newSet);
+
+		// Rebuild the string without that name
+		std::string text;
+		for (const std::string& name : SplitTags(Tag))
+		{
+			if (name == target)
+				continue;
+			if (!text.empty())
+				text += ' ';
+			text += name;
+		}
+		Tag = text;
+		MarkDirty(CHANGE_TAG);
+	}
+
+	const TagTable::TagSet& Transform::GetTagSet() const
+	{
+		return tagSet;
+	}
+
+	const std::vector<Transform*>& Transform::FindAllWithTag(TagID tag)
+	{
+		return TagTable::Get().FindAllWithTag(tag);
+	}
+
+	const std::vector<Transform*>& Transform::FindAllWithTag(const std::string& tag)
+	{
+		return FindAllWithTag(TagTable::Get().Find(tag));
 	}
 
 	void Transform::ListProperties()
@@ -342,7 +779,8 @@ namespace SNova
 		file << "\n";
 		file << "SCALE:" << scale.x << "," << scale.y << "," << scale.z;
 		file << "\n";
-		file << "ROTATION: " << rotator.pitch << " " << rotator.yaw << " " << rotator.roll;
+		const Rotator& euler = GetRotator();
+		file << "ROTATION: " << euler.pitch << " " << euler.yaw << " " << euler.roll;
 		file << "\n";
 		Component::Serialize(file);
 	}
@@ -350,7 +788,7 @@ namespace SNova
 	{
 		std::getline(file, input); // Tag
 		std::string _str = input.substr(input.find(":") + 1);
-		Tag = _str;
+		SetTag(_str);
 
 		std::getline(file, input); // position
 		input = input.substr(input.find(":") + 1);
@@ -374,6 +812,7 @@ namespace SNova
 		scale.y = std::stof(input);
 		std::getline(is, input, ',');
 		scale.z = std::stof(input);
+		MarkDirty(CHANGE_ALL);
 
 		// rotation
 		// With safety check for old savefiles
@@ -394,11 +833,195 @@ namespace SNova
 		}
 		is >> rotator.pitch >> rotator.yaw >> rotator.roll;
 		rotator.UpdateBoundTransform();
-		UpdateMtx();
 
 		Component::Deserialize(file, input);
 	}
 
+	// Helper functions for binary format
+
+	// The format is little-endian and made of 4-byte fields only, so a
+	// big-endian host swaps every 4 bytes of a header or record
+	static void SwapFileWords(void* data, size_t bytes)
+	{
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		unsigned char* p = static_cast<unsigned char*>(data);
+		for (size_t i = 0; i + 4 <= bytes; i += 4)
+		{
+			std::swap(p[i], p[i + 3]);
+			std::swap(p[i + 1], p[i + 2]);
+		}
+#else
+		(void)data;
+		(void)bytes;
+#endif
+	}
+
+	// Read size bytes, growing out only as data arrives, so a corrupt
+	// size in a header fails at the end of the stream instead of
+	// allocating it up front
+	static bool ReadBytes(std::istream& file, std::vector<char>& out, uint64_t size)
+	{
+		static constexpr uint64_t CHUNK = 1 << 16;
+
+		out.clear();
+		if (size > static_cast<uint64_t>(SIZE_MAX))
+			return false;
+
+		while (out.size() < size)
+		{
+			const size_t begin = out.size();
+			const size_t n = static_cast<size_t>(std::min<uint64_t>(CHUNK, size - begin));
+			out.resize(begin + n);
+			file.read(out.data() + begin, n);
+			if (static_cast<size_t>(file.gcount()) != n)
+				return false;
+		}
+		return true;
+	}
+
+	// Reads and checks a block header
+	static bool ReadBatchHeader(std::istream& file, TransformFileHeader& header)
+	{
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		SwapFileWords(&header, sizeof(header));
+
+		// A newer version with only appended fields still reads (recordSize
+		// grows), anything else bumps VERSION and is rejected here
+		return file.gcount() == sizeof(header)
+			&& header.magic == TransformFileHeader::MAGIC
+			&& header.version >= 1 && header.version <= TransformFileHeader::VERSION
+			&& header.recordSize >= sizeof(TransformRecord);
+	}
+
+	bool Transform::SerializeBatch(std::ostream& file, const Transform* const* transforms, size_t count)
+	{
+		if (count > UINT32_MAX)
+			return false;
+
+		std::vector<TransformRecord> records(count);
+		std::string tags;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Transform& t = *transforms[i];
+			TransformRecord& r = records[i];
+
+			r.position[0] = t.position.x;
+			r.position[1] = t.position.y;
+			r.position[2] = t.position.z;
+			r.scale[0] = t.scale.x;
+			r.scale[1] = t.scale.y;
+			r.scale[2] = t.scale.z;
+
+			// Save the quat, not the rotator, so a load gives back exactly this rotation
+			r.rotation[0] = t.rotation.w;
+			r.rotation[1] = t.rotation.x;
+			r.rotation[2] = t.rotation.y;
+			r.rotation[3] = t.rotation.z;
+
+			if (t.Tag.size() > UINT32_MAX - tags.size())
+				return false;
+
+			r.tagOffset = static_cast<uint32_t>(tags.size());
+			r.tagLength = static_cast<uint32_t>(t.Tag.size());
+			tags += t.Tag;
+			SwapFileWords(&r, sizeof(r));
+		}
+
+		TransformFileHeader header;
+		header.recordSize = sizeof(TransformRecord);
+		header.count = static_cast<uint32_t>(count);
+		header.tagTableSize = static_cast<uint32_t>(tags.size());
+		SwapFileWords(&header, sizeof(header));
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(TransformRecord));
+		file.write(tags.data(), tags.size());
+		return true;
+	}
+
+	size_t Transform::PeekBatchCount(std::istream& file)
+	{
+		const std::istream::pos_type start = file.tellg();
+
+		TransformFileHeader header;
+		const bool valid = ReadBatchHeader(file, header);
+
+		file.clear();
+		file.seekg(start);
+		return valid ? header.count : 0;
+	}
+
+	bool Transform::DeserializeBatch(std::istream& file, Transform* const* transforms, size_t count)
+	{
+		TransformFileHeader header;
+		if (!ReadBatchHeader(file, header) || header.count != count)
+			return false;
+
+		// The records, then the tag text, each read in 64 KB chunks. Both
+		// sizes come from the file, so they are only allocated as the bytes arrive
+		std::vector<char> records, tagBytes;
+		if (!ReadBytes(file, records, static_cast<uint64_t>(header.recordSize) * count)
+			|| !ReadBytes(file, tagBytes, header.tagTableSize))
+			return false;
+
+		// Check every record first so a bad file changes nothing
+		for (size_t i = 0; i < count; ++i)
+		{
+			TransformRecord r;
+			std::memcpy(&r, records.data() + i * header.recordSize, sizeof(r));
+			SwapFileWords(&r, sizeof(r));
+			if (static_cast<uint64_t>(r.tagOffset) + r.tagLength > header.tagTableSize)
+				return false;
+		}
+
+		// Records repeat the same few tag strings, so each distinct one is
+		// split and looked up once. An entry is reused while the transform
+		// that took it still has all its tags, i.e. none of its IDs was freed
+		struct ParsedTags
+		{
+			TagTable::TagSet set;
+			std::string text;
+			const Transform* owner = nullptr;
+		};
+		std::unordered_map<std::string_view, ParsedTags> parsedTags;
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			TransformRecord r;
+			std::memcpy(&r, records.data() + i * header.recordSize, sizeof(r));
+			SwapFileWords(&r, sizeof(r));
+			Transform& t = *transforms[i];
+
+			t.position = Vec3{ r.position[0], r.position[1], r.position[2] };
+			t.scale = Vec3{ r.scale[0], r.scale[1], r.scale[2] };
+
+			// Write the fields directly so the bound rotator is synced once,
+			// from the saved quat (assigning the rotator would round trip it).
+			// An authoritative quat defers that to the next GetRotator()
+			t.rotation.w = r.rotation[0];
+			t.rotation.x = r.rotation[1];
+			t.rotation.y = r.rotation[2];
+			t.rotation.z = r.rotation[3];
+			t.OnRotationWritten();
+
+			const std::string_view tagText{ tagBytes.data() + r.tagOffset, r.tagLength };
+			ParsedTags& parsed = parsedTags[tagText];
+			if (!parsed.owner || parsed.owner->tagSet != parsed.set)
+			{
+				parsed.set.reset();
+				parsed.text.clear();
+				ParseTags(std::string{ tagText }, parsed.set, parsed.text);
+				parsed.owner = &t;
+			}
+			t.UpdateTagSet(parsed.set);
+			t.Tag = parsed.text;
+			t.MarkDirty(CHANGE_ALL);
+		}
+
+		return true;
+	}
+
 	/*Mtx44 Transform::GetRotationMtx()
 	{
 		Mtx44 xRot;
@@ -408,5 +1031,4 @@ namespace SNova
 		void Mtx44RotYDeg(yRot, float angle);
 		void Mtx44RotZDeg(zRot, float angle);
 	}*/
-}
-
+}
\ No newline at end of file
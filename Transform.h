@@ -4,22 +4,87 @@
 #include "ImGuiPropertyInspector.h"
 #include "Subject.h"
 #include "Quat.h"
+#include "QuatValue.h"
 #include "Matrix3x3.h"
 #include "Matrix4x4.h"
+#include "TagTable.h"
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 
 namespace SNova
 {
+// Binary transform format, see Transform::SerializeBatch.
+// A block is one TransformFileHeader, header.count TransformRecords,
+// then header.tagTableSize bytes of tag text. Little-endian (swapped on
+// big-endian hosts), no padding; every field is 4 bytes.
+struct TransformFileHeader
+{
+	static constexpr uint32_t MAGIC = 0x46544E53;	// "SNTF"
+	static constexpr uint32_t VERSION = 1;
+
+	uint32_t magic = MAGIC;
+	uint32_t version = VERSION;
+	uint32_t recordSize = 0;	// bytes per record. Newer versions may append fields
+	uint32_t count = 0;			// number of records
+	uint32_t tagTableSize = 0;	// bytes of tag text after the records
+	uint32_t reserved[3] = {};
+};
+
+struct TransformRecord
+{
+	float position[3];
+	float scale[3];
+	float rotation[4];	// w, x, y, z
+	uint32_t tagOffset;	// into the tag table
+	uint32_t tagLength;
+};
+
+static_assert(sizeof(TransformFileHeader) == 32, "TransformFileHeader layout is part of the file format");
+static_assert(sizeof(TransformRecord) == 48, "TransformRecord layout is part of the file format");
+
+class TransformPool;
+
 class Transform : public Component, public Subject
 {
 	friend struct Rotator;
 	friend struct Quat;
+	friend class TransformNotifyQueue;
+	friend class TransformPool;
 
 public:
+	// What changed since observers were last notified. See GetChangeMask()
+	enum ChangeFlags : unsigned
+	{
+		CHANGE_NONE		= 0,
+		CHANGE_POSITION	= 1 << 0,
+		CHANGE_ROTATION	= 1 << 1,
+		CHANGE_SCALE	= 1 << 2,
+		CHANGE_TAG		= 1 << 3,
+		CHANGE_MTX		= CHANGE_POSITION | CHANGE_ROTATION | CHANGE_SCALE,
+		CHANGE_ALL		= CHANGE_MTX | CHANGE_TAG
+	};
+
 	Transform();
 	Transform(const Transform& rhs);
 	Transform& operator= (const Transform& rhs);
 
+	// Also take rhs's tags (no string copy) and its Component data (both
+	// move the base from rhs). rhs keeps its other values but is left
+	// without tags. Not noexcept: queueing the change notification and
+	// updating the TagTable can allocate
+	Transform(Transform&& rhs);
+	Transform& operator= (Transform&& rhs);
+
+	// Make this a copy of rhs's position, rotation, scale and tags, e.g.
+	// when instantiating a prefab or restoring an undo snapshot. Takes
+	// rhs's matrix and rotator if they are current instead of rebuilding
+	// them, reuses the tag string's memory, and only marks (and notifies)
+	// what actually differs. Observers and the component data are not copied.
+	// To notify many of these at once, see TransformNotifyQueue::ScopedSuspend
+	void CopyStateFrom(const Transform& rhs);
+	~Transform();
+
 	// position
 	void SetPosition(const SNova::Vec3& pos);
 	void SetPosition(const float& x, const float& y, const float& z);
@@ -33,6 +98,47 @@ public:
 
 	// rotation
 	const SNova::Matrix3x3& GetRotationMatrixInDegrees() const;
+	// Write/read the rotation as a plain value. The write syncs rotator once
+	void SetRotation(const SNova::QuatValue& q);
+	SNova::QuatValue GetRotation() const;
+
+	// Make rotation the only source of truth. Off by default.
+	// Normally every quat write also converts it to the rotator
+	// (GetRotator(), three inverse trig calls). With this on, quat writes
+	// only mark the rotator stale and it is rebuilt when read through
+	// GetRotator(), which the inspector and serializer use. Code reading
+	// the rotator member directly must use GetRotator() instead.
+	void SetQuatAuthoritative(bool enable);
+	bool IsQuatAuthoritative() const;
+
+	// Editor-facing Euler angles, up to date in either mode.
+	// Rebuilds the cached rotator if stale, so, like GetTransform(), this
+	// is not safe to call from several threads on the same transform
+	const SNova::Rotator& GetRotator() const;
+
+	// Counters for the rotation <-> rotator conversions and the mtx rebuild.
+	// A hit is a conversion/rebuild skipped because its source was unchanged:
+	// a read of an up to date cache, a write of the value already there
+	// (inspector refreshes, replicated state that didn't move), or a copy
+	// that took the other transform's results.
+	// Only recorded with SNOVA_INSTRUMENTATION (see Instrumentation.h);
+	// otherwise the counters are compiled out and the stats are all 0.
+	// They are relaxed atomics, since the const getters count too and may
+	// run on several threads at once (ParallelFor readers)
+	struct ConversionStats
+	{
+		uint32_t rotatorHits = 0;		// rotation -> rotator
+		uint32_t rotatorMisses = 0;
+		uint32_t rotationHits = 0;		// rotator -> rotation
+		uint32_t rotationMisses = 0;
+		uint32_t mtxHits = 0;			// position/rotation/scale -> mtx
+		uint32_t mtxMisses = 0;
+	};
+	ConversionStats GetConversionStats() const;
+	void ResetConversionStats();
+
+	// Bumped by every write that changes the rotation (from either side)
+	unsigned GetRotationVersion() const;
   
   //scale
 	void SetScale(const SNova::Vec3& s);
@@ -47,7 +153,29 @@ public:
 	float GetScaleZ() const;
 
 	//Mtx
-	Mtx44 GetTransform() const { return mtx; };
+	// Rebuilds mtx first if any setter has been called since the last rebuild.
+	// That rebuild writes the cache, so reading a dirty transform from several
+	// threads at once is a race; Flush() it first. Clean reads are safe
+	Mtx44 GetTransform() const;
+
+	// Rebuild mtx and notify observers once if anything changed.
+	// Setters only mark the transform dirty and queue it on the
+	// TransformNotifyQueue, which calls this for every changed transform
+	// when the engine dispatches it (e.g. once per frame).
+	// That queue is process-wide and not synchronised, so every write to
+	// any Transform must happen on the thread that dispatches it, even for
+	// different transforms. Jobs on worker threads write through a
+	// TransformFrameBuffer instead.
+	void Flush();
+	bool IsDirty() const;
+
+	// ChangeFlags of everything modified since the last notification.
+	// Observers can read this inside their notification to skip work.
+	unsigned GetChangeMask() const;
+
+	// Bumped every time position/rotation/scale change. Lets caches of
+	// this transform's matrix (e.g. TransformHierarchy) detect changes.
+	unsigned GetMtxVersion() const;
 
 	//Properties
 	void ListProperties() override;
@@ -61,22 +189,51 @@ public:
 	// ****************** TAG SYSTEM ******************
 	// For simplicity, we delimit multiple tags with whitespace
 	// e.g. "NoSave Plant" contains tags "NoSave" and "Plant"
+	// Tags are interned in the TagTable and kept as a bitset of TagIDs,
+	// the string is only for display and save files. A name the full
+	// table cannot take stays in the string but is not in the bitset
 
 	// Naive Getters/Setters. Use next 3 functions for gameplay
 	std::string GetTag() const;
 	void SetTag(const std::string& tags);
 
-	// Returns true if tag is present
-	bool HasTag(const std::string& tag);
+	// Returns true if tag is present (whole names only, "Plant" does not match "PlantPot")
+	bool HasTag(const std::string& tag) const;
 	void AddTag(const std::string& tag);
 	void RemoveTag(const std::string& tag);
 
+	// Same with interned IDs from TagTable::Intern. O(1) and no allocation
+	bool HasTag(TagID tag) const;
+	void AddTag(TagID tag);
+	void RemoveTag(TagID tag);
+	const TagTable::TagSet& GetTagSet() const;
+
+	// Every transform carrying tag (see TagTable::FindAllWithTag)
+	static const std::vector<Transform*>& FindAllWithTag(TagID tag);
+	static const std::vector<Transform*>& FindAllWithTag(const std::string& tag);
+
 	void Serialize(std::ofstream& file) override;
 	void Deserialize(std::ifstream& file, std::string input) override;
 
+	// Binary format for bulk save/load (the text format above is kept for
+	// diffs and old files). Streams must be opened with std::ios::binary.
+	// Writes all transforms as one block: header, records, tag table.
+	// Returns false and writes nothing if count or the total tag text does
+	// not fit the format's 32-bit sizes
+	static bool SerializeBatch(std::ostream& file, const Transform* const* transforms, size_t count);
+
+	// Number of transforms in the binary block at the read position.
+	// Returns 0 if there is none (e.g. a text file). The stream is not moved
+	static size_t PeekBatchCount(std::istream& file);
+
+	// Read a block written by SerializeBatch into transforms[0..count).
+	// count must match the block (see PeekBatchCount). On a bad or
+	// mismatched block returns false and leaves every transform untouched
+	static bool DeserializeBatch(std::istream& file, Transform* const* transforms, size_t count);
+
 	property_vtable();
 	Quat rotation;		// internal only
-	Rotator rotator;	// exposed to editor
+	mutable Rotator rotator;	// exposed to editor, also a cache of rotation (see GetRotator)
 
 	//Mtx44 GetRotationMtx();
 
@@ -84,11 +241,79 @@ private:
 	SNova::Vec3 position;
 	SNova::Vec3 scale;
 	std::string Tag = std::string{};
+	TagTable::TagSet tagSet;
+
+	// Where this transform sits in the TagTable's list of each of its tags
+	std::vector<TagTable::Slot> tagSlots;
+
+	//Transform matrix, a cache of position/rotation/scale (see GetTransform)
+	mutable Mtx44 mtx;
+
+	// True if mtx is out of date with position/rotation/scale
+	mutable bool isDirty = true;
+
+	// See SetQuatAuthoritative
+	bool quatAuthoritative = false;
 
-	//Transform matrix 
-	Mtx44 mtx;
+	// rotator is up to date when rotatorVersion == rotationVersion.
+	// cachedRotation is rotation at rotationVersion and cachedEuler is
+	// rotator at rotatorVersion, so unchanged writes can be skipped
+	unsigned rotationVersion = 0;
+	mutable unsigned rotatorVersion = 0;
+	SNova::QuatValue cachedRotation;
+	mutable SNova::Vec3 cachedEuler;
+#if SNOVA_INSTRUMENTATION
+	struct ConversionCounters
+	{
+		std::atomic<uint32_t> rotatorHits{ 0 };
+		std::atomic<uint32_t> rotatorMisses{ 0 };
+		std::atomic<uint32_t> rotationHits{ 0 };
+		std::atomic<uint32_t> rotationMisses{ 0 };
+		std::atomic<uint32_t> mtxHits{ 0 };
+		std::atomic<uint32_t> mtxMisses{ 0 };
+	};
+	mutable ConversionCounters conversionStats;
+#endif
+
+	// ChangeFlags not yet sent to observers
+	unsigned changeMask = CHANGE_NONE;
+	unsigned mtxVersion = 0;
+
+	// Slot in the TransformNotifyQueue
+	static constexpr size_t NOT_QUEUED = static_cast<size_t>(-1);
+	size_t queueIndex = NOT_QUEUED;
+
+	// Pool slot whose hot data MarkDirty() marks stale (null if not pooled)
+	TransformPool* pool = nullptr;
+	uint32_t poolSlot = 0;
+
+	void UpdateMtx() const;
+	void MarkDirty(unsigned changes);
+
+	// Rebuild rotator from rotation if stale
+	void SyncRotator() const;
+
+	// Called by the bound rotation / rotator after every write
+	void OnRotationWritten();
+	void OnRotatorWritten();
+
+	// Take rhs's rotation and, if it is up to date, its rotator, without converting
+	void CopyRotationFrom(const Transform& rhs);
 
-	void UpdateMtx();
+	// Take rhs's position, scale and rotation, and its matrix if current.
+	// Only marks what changed
+	void CopyValuesFrom(const Transform& rhs);
+
+	// Move rhs's tags to this transform, re-registering them in the TagTable
+	void TakeTagsFrom(Transform& rhs);
+
+	// Replace tagSet, keeping the TagTable's per-tag lists up to date
+	void UpdateTagSet(const TagTable::TagSet& newSet);
+	TagTable::Slot& FindTagSlot(TagID tag);
+
+	// IDs of the names in input (added to the table if new), and input
+	// without duplicate names
+	static void ParseTags(const std::string& input, TagTable::TagSet& set, std::string& text);
 };
 
 }
@@ -96,7 +321,18 @@ private:
 property_begin_name(SNova::Transform, "Transform")
 {
 	property_parent(Component)
-	, property_var(Tag)
+	, property_var_fnbegin("Tag", std::string)
+	{
+		if (isRead)
+		{
+			InOut = Self.Tag;
+		}
+		else
+		{
+			Self.SetTag(InOut);
+		}
+
+	}property_var_fnend()
 	, property_var_fnbegin("position", SNova::Vec3)
 	{
 		if (isRead)
@@ -127,7 +363,18 @@ property_begin_name(SNova::Transform, "Transform")
 	, property_var(rotation.y).Flags(property::flags::SHOW_READONLY)
 	, property_var(rotation.z).Flags(property::flags::SHOW_READONLY)
 	, property_var(rotation.w).Flags(property::flags::SHOW_READONLY)
-	, property_var(rotator)
+	, property_var_fnbegin("rotator", SNova::Rotator)
+	{
+		if (isRead)
+		{
+			InOut = Self.GetRotator();
+		}
+		else
+		{
+			Self.rotator = InOut;
+		}
+
+	}property_var_fnend()
 	// no longer neeeded due to quat being bound to rotator
 	//, property_var_fnbegin("rotation", SNova::Rotator)
 	//		{
@@ -143,5 +390,4 @@ property_begin_name(SNova::Transform, "Transform")
 	//			}
 	//		}property_var_fnend()
 }
-property_vend_h(SNova::Transform)
-
+property_vend_h(SNova::Transform)
\ No newline at end of file
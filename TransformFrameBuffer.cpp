@@ -0,0 +1,203 @@
+#include "SNova.h"
+#include "TransformFrameBuffer.h"
+#include "ParallelFor.h"
+
+namespace SNova
+{
+	struct TransformFrameBuffer::FramePool
+	{
+		std::mutex mutex;
+		std::vector<std::unique_ptr<Frame>> frames;
+	};
+
+	size_t TransformFrameBuffer::Frame::Size() const
+	{
+		return position.size();
+	}
+
+	TransformFrameBuffer::TransformFrameBuffer()
+		: published{ std::make_shared<const Frame>() }, framePool{ std::make_shared<FramePool>() }
+	{
+	}
+
+	TransformFrameBuffer::SlotID TransformFrameBuffer::Add(Transform* transform)
+	{
+		SlotID id;
+		if (!freeSlots.empty())
+		{
+			id = freeSlots.back();
+			freeSlots.pop_back();
+		}
+		else
+		{
+			id = static_cast<SlotID>(transforms.size());
+			transforms.emplace_back();
+			pending.emplace_back();
+		}
+
+		transforms[id] = transform;
+		pending[id] = PendingWrite{};
+		++liveCount;
+		++layout;
+		return id;
+	}
+
+	void TransformFrameBuffer::Remove(SlotID slot)
+	{
+		if (slot >= transforms.size() || !transforms[slot])
+			return;
+
+		transforms[slot] = nullptr;
+		pending[slot] = PendingWrite{};
+		freeSlots.push_back(slot);
+		--liveCount;
+		++layout;
+	}
+
+	Transform* TransformFrameBuffer::GetTransform(SlotID slot) const
+	{
+		return transforms[slot];
+	}
+
+	size_t TransformFrameBuffer::Size() const
+	{
+		return liveCount;
+	}
+
+	void TransformFrameBuffer::WritePosition(SlotID slot, const Vec3& position)
+	{
+		PendingWrite& write = pending[slot];
+		write.position = position;
+		write.changes |= Transform::CHANGE_POSITION;
+	}
+
+	void TransformFrameBuffer::WriteRotation(SlotID slot, const QuatValue& rotation)
+	{
+		PendingWrite& write = pending[slot];
+		write.rotation = rotation;
+		write.changes |= Transform::CHANGE_ROTATION;
+	}
+
+	void TransformFrameBuffer::WriteScale(SlotID slot, const Vec3& scale)
+	{
+		PendingWrite& write = pending[slot];
+		write.scale = scale;
+		write.changes |= Transform::CHANGE_SCALE;
+	}
+
+	void TransformFrameBuffer::Write(SlotID slot, const Vec3& position, const QuatValue& rotation, const Vec3& scale)
+	{
+		PendingWrite& write = pending[slot];
+		write.position = position;
+		write.rotation = rotation;
+		write.scale = scale;
+		write.changes |= Transform::CHANGE_MTX;
+	}
+
+	void TransformFrameBuffer::Publish()
+	{
+		ApplyPending();
+
+		std::shared_ptr<Frame> frame = TakeFreeFrame();
+		frame->number = ++frameNumber;
+		Capture(*frame);
+
+		std::shared_ptr<const Frame> previous = std::move(frame);
+		{
+			std::lock_guard<std::mutex> lock{ publishMutex };
+			published.swap(previous);
+		}
+
+		// The old Frame returns to the pool here, or when its last reader lets go
+	}
+
+	std::shared_ptr<const TransformFrameBuffer::Frame> TransformFrameBuffer::Acquire() const
+	{
+		std::lock_guard<std::mutex> lock{ publishMutex };
+		return published;
+	}
+
+	void TransformFrameBuffer::ApplyPending()
+	{
+		// Through the setters, on this thread, so the bound rotation/rotator,
+		// the notify queue and the change masks see an ordinary write
+		for (size_t i = 0; i < pending.size(); ++i)
+		{
+			PendingWrite& write = pending[i];
+			if (write.changes == Transform::CHANGE_NONE)
+				continue;
+
+			Transform* transform = transforms[i];
+			if (write.changes & Transform::CHANGE_POSITION)
+				transform->SetPosition(write.position);
+			if (write.changes & Transform::CHANGE_ROTATION)
+				transform->SetRotation(write.rotation);
+			if (write.changes & Transform::CHANGE_SCALE)
+				transform->SetScale(write.scale);
+
+			write.changes = Transform::CHANGE_NONE;
+		}
+	}
+
+	std::shared_ptr<TransformFrameBuffer::Frame> TransformFrameBuffer::TakeFreeFrame()
+	{
+		std::unique_ptr<Frame> frame;
+		{
+			std::lock_guard<std::mutex> lock{ framePool->mutex };
+			if (!framePool->frames.empty())
+			{
+				frame = std::move(framePool->frames.back());
+				framePool->frames.pop_back();
+			}
+		}
+		if (!frame)
+			frame.reset(new Frame);
+
+		// The deleter runs on whichever thread drops the last reference.
+		// Taking the pool's mutex there orders that reader's reads before
+		// the next Publish() that rewrites the Frame
+		std::shared_ptr<FramePool> pool = framePool;
+		return std::shared_ptr<Frame>(frame.release(), [pool](Frame* released)
+		{
+			std::lock_guard<std::mutex> lock{ pool->mutex };
+			pool->frames.emplace_back(released);
+		});
+	}
+
+	void TransformFrameBuffer::Capture(Frame& frame) const
+	{
+		const size_t count = transforms.size();
+		const bool sameLayout = (frame.layout == layout) && (frame.Size() == count);
+
+		frame.position.resize(count);
+		frame.rotation.resize(count);
+		frame.scale.resize(count);
+		frame.mtx.resize(count);
+		frame.version.resize(count);
+
+		// Each chunk only touches its own slots and their Transforms
+		ParallelFor(count, grainSize, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				const Transform* transform = transforms[i];
+				if (!transform)
+					continue;
+
+				// Unchanged since this Frame last captured it
+				const unsigned version = transform->GetMtxVersion();
+				if (sameLayout && frame.version[i] == version)
+					continue;
+
+				frame.position[i] = transform->GetPosition();
+				frame.rotation[i] = transform->GetRotation();
+				frame.scale[i] = transform->GetScale();
+				frame.mtx[i] = transform->GetTransform();
+				frame.version[i] = version;
+			}
+		});
+
+		frame.layout = layout;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+#include "Transform.h"
+#include "Matrix4x4.h"
+#include "QuatValue.h"
+#include "Vector3D.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace SNova
+{
+
+// Double-buffered Transform state, so gameplay jobs can run on worker
+// threads while other threads read transforms.
+//
+// Writing a Transform directly also writes its bound rotation/rotator,
+// the notify queue and its observers, none of which are thread-safe.
+// Instead, register Transforms here once and, during a frame, write the
+// new values into the buffer with Write*(). Every slot has its own
+// pending entry, so jobs writing different slots never touch the same
+// data and need no locks. Nothing reaches the Transforms yet.
+//
+// Publish() is the sync point. Call it on the thread that owns the
+// Transforms (e.g. the main thread) once the frame's jobs are done: it
+// applies the pending writes through the normal setters, then publishes
+// a Frame with the position, rotation, scale and matrix of every slot.
+// A Frame is never modified after it is published. Acquire() it from any
+// thread and read it for as long as it is held, including while the next
+// frame is written and published.
+//
+// Each slot must be written by at most one job between two Publish()
+// calls. Transform pointers must stay valid while they are registered.
+class TransformFrameBuffer
+{
+public:
+	typedef uint32_t SlotID;
+	static constexpr SlotID INVALID_SLOT = UINT32_MAX;
+
+	// Published state, indexed by SlotID. Free slots keep their last values
+	struct Frame
+	{
+		uint64_t number = 0;	// 1 for the first Publish(), then counts up
+		std::vector<Vec3> position;
+		std::vector<QuatValue> rotation;
+		std::vector<Vec3> scale;
+		std::vector<Mtx44> mtx;
+
+		size_t Size() const;
+
+	private:
+		friend class TransformFrameBuffer;
+
+		// Transform::GetMtxVersion() each slot was captured at, and the
+		// slot layout it was captured with, so a recycled Frame only
+		// refreshes the slots that changed
+		std::vector<unsigned> version;
+		uint64_t layout = 0;
+	};
+
+	TransformFrameBuffer();
+	TransformFrameBuffer(const TransformFrameBuffer&) = delete;
+	TransformFrameBuffer& operator=(const TransformFrameBuffer&) = delete;
+
+	// Register a transform. Returns a slot that stays valid until removed.
+	// It appears in frames from the next Publish()
+	SlotID Add(Transform* transform);
+
+	// Unregister a slot, dropping any pending write to it
+	void Remove(SlotID slot);
+
+	Transform* GetTransform(SlotID slot) const;
+	size_t Size() const;
+
+	// Queue new values for a slot, applied by the next Publish().
+	// Safe from any thread as long as no other thread writes the same slot.
+	// A later write to the same slot in a frame replaces the earlier one
+	void WritePosition(SlotID slot, const Vec3& position);
+	void WriteRotation(SlotID slot, const QuatValue& rotation);
+	void WriteScale(SlotID slot, const Vec3& scale);
+	void Write(SlotID slot, const Vec3& position, const QuatValue& rotation, const Vec3& scale);
+
+	// Apply every pending write to its Transform and publish a new Frame.
+	// Must not run concurrently with Write*(), Add() or Remove().
+	// Changes made to the Transforms directly (e.g. by the editor) since the
+	// last Publish() are picked up too
+	void Publish();
+
+	// The last published Frame (empty before the first Publish()). Safe from any thread
+	std::shared_ptr<const Frame> Acquire() const;
+
+	// Slots per ParallelFor chunk while capturing a Frame
+	size_t grainSize = 256;
+
+private:
+	// A job's write to one slot, applied by Publish()
+	struct PendingWrite
+	{
+		Vec3 position;
+		QuatValue rotation;
+		Vec3 scale;
+		unsigned changes = Transform::CHANGE_NONE;
+	};
+
+	std::vector<Transform*> transforms;		// nullptr for free slots
+	std::vector<PendingWrite> pending;
+	std::vector<SlotID> freeSlots;
+	size_t liveCount = 0;
+
+	// Bumped by Add/Remove. See Frame::layout
+	uint64_t layout = 1;
+	uint64_t frameNumber = 0;
+
+	// published is what Acquire() returns. A Frame goes back to the pool
+	// when its last holder lets go, and Publish() reuses it. The pool
+	// outlives the buffer if readers still hold Frames
+	struct FramePool;
+	mutable std::mutex publishMutex;
+	std::shared_ptr<const Frame> published;
+	std::shared_ptr<FramePool> framePool;
+
+	void ApplyPending();
+	std::shared_ptr<Frame> TakeFreeFrame();
+	void Capture(Frame& frame) const;
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include "SNova.h"
+#include "TransformHierarchy.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <atomic>
+
+namespace SNova
+{
+	static constexpr uint32_t NO_PARENT = UINT32_MAX;
+
+	TransformHierarchy::NodeID TransformHierarchy::AddNode(Transform* transform, NodeID parent)
+	{
+		// Check the parent before reusing a slot: a removed parent's slot is on
+		// freeSlots, and reusing it would make the new node its own parent
+		if (parent != INVALID_NODE && (parent >= slots.size() || !slots[parent].alive))
+			parent = INVALID_NODE;
+
+		NodeID id;
+		if (!freeSlots.empty())
+		{
+			id = freeSlots.back();
+			freeSlots.pop_back();
+		}
+		else
+		{
+			id = static_cast<NodeID>(slots.size());
+			slots.emplace_back();
+		}
+
+		Slot& slot = slots[id];
+		slot.transform = transform;
+		slot.parent = INVALID_NODE;
+		slot.children.clear();
+		slot.alive = true;
+		slot.sorted = false;
+		++liveCount;
+
+		if (parent != INVALID_NODE && parent != id)
+		{
+			slot.parent = parent;
+			slots[parent].children.push_back(id);
+		}
+
+		structureChanged = true;
+		return id;
+	}
+
+	void TransformHierarchy::RemoveNode(NodeID node)
+	{
+		if (node >= slots.size() || !slots[node].alive)
+			return;
+
+		Detach(node);
+
+		// Free the whole subtree
+		std::vector<NodeID> stack{ node };
+		while (!stack.empty())
+		{
+			const NodeID id = stack.back();
+			stack.pop_back();
+
+			Slot& slot = slots[id];
+			stack.insert(stack.end(), slot.children.begin(), slot.children.end());
+
+			slot = Slot{};
+			freeSlots.push_back(id);
+			--liveCount;
+		}
+
+		structureChanged = true;
+	}
+
+	void TransformHierarchy::SetParent(NodeID node, NodeID parent)
+	{
+		if (node >= slots.size() || !slots[node].alive)
+			return;
+
+		if (parent != INVALID_NODE && (parent >= slots.size() || !slots[parent].alive || parent == node || IsAncestor(node, parent)))
+			return;
+
+		Detach(node);
+
+		if (parent != INVALID_NODE)
+		{
+			slots[node].parent = parent;
+			slots[parent].children.push_back(node);
+		}
+
+		structureChanged = true;
+	}
+
+	TransformHierarchy::NodeID TransformHierarchy::GetParent(NodeID node) const
+	{
+		return (node < slots.size()) ? slots[node].parent : INVALID_NODE;
+	}
+
+	Transform* TransformHierarchy::GetTransform(NodeID node) const
+	{
+		return (node < slots.size()) ? slots[node].transform : nullptr;
+	}
+
+	size_t TransformHierarchy::Size() const
+	{
+		return liveCount;
+	}
+
+	Mtx44 TransformHierarchy::GetWorldMatrix(NodeID node) const
+	{
+		if (node >= slots.size() || !slots[node].alive)
+		{
+			Mtx44 identity;
+			Mtx44Identity(identity);
+			return identity;
+		}
+
+		// sortedIndex is only assigned by the next Update()
+		const Slot& slot = slots[node];
+		return slot.sorted ? worldMtx[slot.sortedIndex] : slot.transform->GetTransform();
+	}
+
+	size_t TransformHierarchy::LastUpdateCount() const
+	{
+		return lastUpdateCount;
+	}
+
+	bool TransformHierarchy::IsAncestor(NodeID ancestor, NodeID node) const
+	{
+		for (NodeID id = slots[node].parent; id != INVALID_NODE; id = slots[id].parent)
+		{
+			if (id == ancestor)
+				return true;
+		}
+		return false;
+	}
+
+	void TransformHierarchy::Detach(NodeID node)
+	{
+		const NodeID parent = slots[node].parent;
+		if (parent == INVALID_NODE)
+			return;
+
+		std::vector<NodeID>& siblings = slots[parent].children;
+		siblings.erase(std::remove(siblings.begin(), siblings.end(), node), siblings.end());
+		slots[node].parent = INVALID_NODE;
+	}
+
+	void TransformHierarchy::Rebuild()
+	{
+		sortedSlot.clear();
+		sortedSlot.reserve(liveCount);
+		levelStart.clear();
+
+		// Roots form level 0
+		for (NodeID id = 0; id < slots.size(); ++id)
+		{
+			if (slots[id].alive && slots[id].parent == INVALID_NODE)
+				sortedSlot.push_back(id);
+		}
+
+		// Breadth-first; each pass over the previous level appends the next one
+		size_t begin = 0;
+		while (begin < sortedSlot.size())
+		{
+			const size_t end = sortedSlot.size();
+			levelStart.push_back(begin);
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				const Slot& slot = slots[sortedSlot[i]];
+				sortedSlot.insert(sortedSlot.end(), slot.children.begin(), slot.children.end());
+			}
+			begin = end;
+		}
+		levelStart.push_back(sortedSlot.size());
+
+		const size_t count = sortedSlot.size();
+		sortedParent.resize(count);
+		sortedTransform.resize(count);
+		sortedVersion.resize(count);
+		worldMtx.resize(count);
+		worldChanged.resize(count);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			slots[sortedSlot[i]].sortedIndex = static_cast<uint32_t>(i);
+			slots[sortedSlot[i]].sorted = true;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Slot& slot = slots[sortedSlot[i]];
+			sortedParent[i] = (slot.parent == INVALID_NODE) ? NO_PARENT : slots[slot.parent].sortedIndex;
+			sortedTransform[i] = slot.transform;
+
+			// Force a recompute of everything
+			sortedVersion[i] = slot.transform->GetMtxVersion() - 1;
+		}
+
+		structureChanged = false;
+	}
+
+	void TransformHierarchy::Update()
+	{
+		if (structureChanged)
+			Rebuild();
+
+		std::atomic<size_t> updated{ 0 };
+
+		for (size_t level = 0; level + 1 < levelStart.size(); ++level)
+		{
+			const size_t first = levelStart[level];
+			const size_t count = levelStart[level + 1] - first;
+
+			// The previous level is complete, so parents are final here
+			ParallelFor(count, grainSize, [&](size_t begin, size_t end)
+			{
+				size_t chunkUpdated = 0;
+
+				for (size_t i = first + begin; i < first + end; ++i)
+				{
+					Transform* transform = sortedTransform[i];
+					const unsigned version = transform->GetMtxVersion();
+					const uint32_t parent = sortedParent[i];
+					const bool parentChanged = (parent != NO_PARENT) && worldChanged[parent];
+
+					if (version == sortedVersion[i] && !parentChanged)
+					{
+						worldChanged[i] = 0;
+						continue;
+					}
+
+					const Mtx44 local = transform->GetTransform();
+					worldMtx[i] = (parent == NO_PARENT) ? local : worldMtx[parent] * local;
+					sortedVersion[i] = version;
+					worldChanged[i] = 1;
+					++chunkUpdated;
+				}
+
+				updated += chunkUpdated;
+			});
+		}
+
+		lastUpdateCount = updated;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+#include "Transform.h"
+#include "Matrix4x4.h"
+#include <cstdint>
+#include <vector>
+
+namespace SNova
+{
+
+// Parent/child composition of Transforms into world matrices.
+//
+// Each node wraps a Transform, whose matrix is the node's local matrix
+// (world = parentWorld * local). Nodes are kept in breadth-first order,
+// sorted by depth, so every level is one contiguous range and a level only
+// depends on the one above it. Update() walks the levels top-down and
+// computes each level with ParallelFor. A node is recomputed only if its
+// own Transform changed or an ancestor's world matrix did.
+//
+// Transform pointers must stay valid while they are in the hierarchy.
+// Structure changes (add/remove/reparent) are cheap to request but cause
+// the next Update() to re-sort and recompute everything.
+class TransformHierarchy
+{
+public:
+	typedef uint32_t NodeID;
+	static constexpr NodeID INVALID_NODE = UINT32_MAX;
+
+	// Add a node under parent (or as a root). Returns a handle that stays
+	// valid until the node is removed. An invalid or removed parent adds a root.
+	NodeID AddNode(Transform* transform, NodeID parent = INVALID_NODE);
+
+	// Remove a node and its whole subtree
+	void RemoveNode(NodeID node);
+
+	// Move a node (and its subtree) under another parent. Pass INVALID_NODE to make it a root.
+	// Making a node a child of its own descendant is ignored.
+	void SetParent(NodeID node, NodeID parent);
+
+	// INVALID_NODE / nullptr for invalid handles
+	NodeID GetParent(NodeID node) const;
+	Transform* GetTransform(NodeID node) const;
+	size_t Size() const;
+
+	// Bring world matrices up to date with all Transforms
+	void Update();
+
+	// World matrix as of the last Update(). A node added since then has
+	// none yet and returns its local matrix until the next Update().
+	// Identity for invalid handles
+	Mtx44 GetWorldMatrix(NodeID node) const;
+
+	// Nodes recomputed by the last Update()
+	size_t LastUpdateCount() const;
+
+	// Nodes per ParallelFor chunk
+	size_t grainSize = 256;
+
+private:
+	// Stable per-node data, indexed by NodeID
+	struct Slot
+	{
+		Transform* transform = nullptr;
+		NodeID parent = INVALID_NODE;
+		std::vector<NodeID> children;
+		uint32_t sortedIndex = 0;
+		bool alive = false;
+		bool sorted = false;	// placed in the sorted arrays by an Update()
+	};
+
+	std::vector<Slot> slots;
+	std::vector<NodeID> freeSlots;
+	size_t liveCount = 0;
+
+	// Breadth-first arrays, indexed by sorted index
+	std::vector<NodeID> sortedSlot;
+	std::vector<uint32_t> sortedParent;		// sorted index of parent, or UINT32_MAX
+	std::vector<Transform*> sortedTransform;
+	std::vector<unsigned> sortedVersion;	// Transform::GetMtxVersion() at last update
+	std::vector<Mtx44> worldMtx;
+	std::vector<uint8_t> worldChanged;		// set during Update() if worldMtx[i] was recomputed
+
+	// [levelStart[d], levelStart[d + 1]) are the nodes at depth d
+	std::vector<size_t> levelStart;
+
+	bool structureChanged = false;
+	size_t lastUpdateCount = 0;
+
+	void Rebuild();
+	bool IsAncestor(NodeID ancestor, NodeID node) const;
+	void Detach(NodeID node);
+};
+
+}
\ No newline at end of file
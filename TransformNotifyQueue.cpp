@@ -0,0 +1,102 @@
+#include "SNova.h"
+#include "TransformNotifyQueue.h"
+#include "Transform.h"
+
+namespace SNova
+{
+
+	TransformNotifyQueue& TransformNotifyQueue::Get()
+	{
+		static TransformNotifyQueue instance;
+		return instance;
+	}
+
+	void TransformNotifyQueue::Enqueue(Transform* transform)
+	{
+		if (transform->queueIndex != Transform::NOT_QUEUED)
+			return;
+
+		transform->queueIndex = pending.size();
+		pending.push_back(transform);
+	}
+
+	void TransformNotifyQueue::Remove(Transform* transform)
+	{
+		if (transform->queueIndex != Transform::NOT_QUEUED)
+		{
+			// swap with back so removal is O(1)
+			Transform* last = pending.back();
+			pending[transform->queueIndex] = last;
+			last->queueIndex = transform->queueIndex;
+			pending.pop_back();
+			transform->queueIndex = Transform::NOT_QUEUED;
+		}
+
+		// Destroyed by an observer in the middle of Dispatch()
+		for (Transform*& t : dispatching)
+		{
+			if (t == transform)
+				t = nullptr;
+		}
+	}
+
+	void TransformNotifyQueue::Dispatch()
+	{
+		if (suspendCount > 0)
+		{
+			dispatchRequested = true;
+			return;
+		}
+
+		// Swap out so observers that write to transforms queue them for next time
+		dispatching.swap(pending);
+		for (Transform* t : dispatching)
+			t->queueIndex = Transform::NOT_QUEUED;
+
+		for (size_t i = 0; i < dispatching.size(); ++i)
+		{
+			if (dispatching[i])
+				dispatching[i]->Flush();
+		}
+
+		dispatching.clear();
+	}
+
+	size_t TransformNotifyQueue::Size() const
+	{
+		return pending.size();
+	}
+
+	void TransformNotifyQueue::Suspend()
+	{
+		++suspendCount;
+	}
+
+	void TransformNotifyQueue::Resume()
+	{
+		if (suspendCount == 0 || --suspendCount > 0)
+			return;
+
+		if (dispatchRequested)
+		{
+			dispatchRequested = false;
+			Dispatch();
+		}
+	}
+
+	bool TransformNotifyQueue::IsSuspended() const
+	{
+		return suspendCount > 0;
+	}
+
+	TransformNotifyQueue::ScopedSuspend::ScopedSuspend()
+	{
+		TransformNotifyQueue::Get().Suspend();
+	}
+
+	TransformNotifyQueue::ScopedSuspend::~ScopedSuspend()
+	{
+		TransformNotifyQueue::Get().Resume();
+	}
+
+}
\ No newline at end of file
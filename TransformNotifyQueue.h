@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+
+namespace SNova
+{
+class Transform;
+
+// Collects changed transforms during a frame and notifies their observers
+// in one pass, so a transform written many times only notifies once.
+// Each transform is queued at most once until the next Dispatch().
+// Not thread-safe: every Transform setter calls Enqueue(), so all
+// Transform writes and Dispatch() must run on one thread (writes from
+// jobs go through TransformFrameBuffer).
+class TransformNotifyQueue
+{
+public:
+	static TransformNotifyQueue& Get();
+
+	// Queue a transform for notification. Does nothing if already queued.
+	void Enqueue(Transform* transform);
+
+	// Drop a transform from the queue (e.g. when it is destroyed)
+	void Remove(Transform* transform);
+
+	// Rebuild and notify every queued transform, then clear the queue.
+	// Call once per frame at the point observers should see changes.
+	// Transforms changed by observers during dispatch are queued for the next one.
+	void Dispatch();
+
+	size_t Size() const;
+
+	// Hold back Dispatch() during bulk work, e.g. spawning thousands of
+	// prefab instances. Calls nest. A Dispatch() while suspended only
+	// records that one was asked for, and the last Resume() runs it, so
+	// every transform changed in between is notified once, after all of
+	// them are set up
+	void Suspend();
+	void Resume();
+	bool IsSuspended() const;
+
+	// Suspend() for the lifetime of the object
+	class ScopedSuspend
+	{
+	public:
+		ScopedSuspend();
+		~ScopedSuspend();
+		ScopedSuspend(const ScopedSuspend&) = delete;
+		ScopedSuspend& operator=(const ScopedSuspend&) = delete;
+	};
+
+private:
+	TransformNotifyQueue() = default;
+
+	unsigned suspendCount = 0;
+	bool dispatchRequested = false;
+
+	std::vector<Transform*> pending;
+	std::vector<Transform*> dispatching;
+};
+
+}
\ No newline at end of file
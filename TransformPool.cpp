@@ -0,0 +1,196 @@
+#include "SNova.h"
+#include "TransformPool.h"
+#include "ParallelFor.h"
+#include <new>
+
+namespace SNova
+{
+	TransformPool::~TransformPool()
+	{
+		Release();
+	}
+
+	Transform* TransformPool::Slot(uint32_t index) const
+	{
+		return reinterpret_cast<Transform*>(chunks[index / CHUNK_SIZE] + (index % CHUNK_SIZE) * SLOT_STRIDE);
+	}
+
+	uint32_t TransformPool::AllocateSlot()
+	{
+		if (!freeSlots.empty())
+		{
+			const uint32_t index = freeSlots.back();
+			freeSlots.pop_back();
+			return index;
+		}
+
+		const uint32_t index = static_cast<uint32_t>(generations.size());
+		if (index % CHUNK_SIZE == 0)
+			chunks.push_back(static_cast<unsigned char*>(::operator new(CHUNK_SIZE * SLOT_STRIDE, std::align_val_t{ CACHE_LINE })));
+
+		generations.push_back(0);
+		hotPosition.emplace_back();
+		hotRotation.emplace_back();
+		hotScale.emplace_back();
+		hotMtx.emplace_back();
+		alive.push_back(0);
+		stale.push_back(0);
+		return index;
+	}
+
+	void TransformPool::QueueHotUpdate(uint32_t index)
+	{
+		if (stale[index])
+			return;
+
+		stale[index] = 1;
+		staleSlots.push_back(index);
+	}
+
+	TransformPool::Handle TransformPool::Construct(uint32_t index, const Transform* source)
+	{
+		Transform* transform = source ? new (Slot(index)) Transform{ *source } : new (Slot(index)) Transform{};
+		if (source)
+			transform->SetTag(source->GetTag());
+
+		transform->pool = this;
+		transform->poolSlot = index;
+		alive[index] = 1;
+		QueueHotUpdate(index);
+		++liveCount;
+
+		return Handle{ index, generations[index] };
+	}
+
+	TransformPool::Handle TransformPool::Create()
+	{
+		return Construct(AllocateSlot(), nullptr);
+	}
+
+	TransformPool::Handle TransformPool::Clone(const Transform& source)
+	{
+		return Construct(AllocateSlot(), &source);
+	}
+
+	void TransformPool::Destroy(Handle handle)
+	{
+		if (!IsAlive(handle))
+			return;
+
+		Slot(handle.index)->~Transform();
+		alive[handle.index] = 0;
+		++generations[handle.index];
+		freeSlots.push_back(handle.index);
+		--liveCount;
+	}
+
+	Transform* TransformPool::Get(Handle handle) const
+	{
+		return IsAlive(handle) ? Slot(handle.index) : nullptr;
+	}
+
+	bool TransformPool::IsAlive(Handle handle) const
+	{
+		return handle.index < generations.size() && alive[handle.index] && generations[handle.index] == handle.generation;
+	}
+
+	size_t TransformPool::Size() const
+	{
+		return liveCount;
+	}
+
+	size_t TransformPool::SlotCount() const
+	{
+		return generations.size();
+	}
+
+	void TransformPool::Reset()
+	{
+		for (uint32_t i = 0; i < generations.size(); ++i)
+		{
+			if (alive[i])
+			{
+				Slot(i)->~Transform();
+				alive[i] = 0;
+				++generations[i];
+			}
+		}
+
+		// Hand slots out from the front again, so the next level is contiguous
+		freeSlots.clear();
+		for (size_t i = generations.size(); i > 0; --i)
+			freeSlots.push_back(static_cast<uint32_t>(i - 1));
+		liveCount = 0;
+
+		for (uint32_t index : staleSlots)
+			stale[index] = 0;
+		staleSlots.clear();
+	}
+
+	void TransformPool::Release()
+	{
+		Reset();
+
+		for (unsigned char* chunk : chunks)
+			::operator delete(chunk, std::align_val_t{ CACHE_LINE });
+
+		chunks.clear();
+		generations.clear();
+		freeSlots.clear();
+		hotPosition.clear();
+		hotRotation.clear();
+		hotScale.clear();
+		hotMtx.clear();
+		alive.clear();
+		stale.clear();
+	}
+
+	void TransformPool::UpdateHotData()
+	{
+		// A slot is listed once, so each chunk only touches its own slots
+		// and their Transforms. Slots destroyed since they were queued are skipped
+		ParallelFor(staleSlots.size(), grainSize, [&](size_t begin, size_t end)
+		{
+			for (size_t k = begin; k < end; ++k)
+			{
+				const uint32_t i = staleSlots[k];
+				stale[i] = 0;
+				if (!alive[i])
+					continue;
+
+				const Transform* transform = Slot(i);
+				hotPosition[i] = transform->GetPosition();
+				hotRotation[i] = transform->GetRotation();
+				hotScale[i] = transform->GetScale();
+				hotMtx[i] = transform->GetTransform();
+			}
+		});
+		staleSlots.clear();
+	}
+
+	const Vec3* TransformPool::Positions() const
+	{
+		return hotPosition.data();
+	}
+
+	const QuatValue* TransformPool::Rotations() const
+	{
+		return hotRotation.data();
+	}
+
+	const Vec3* TransformPool::Scales() const
+	{
+		return hotScale.data();
+	}
+
+	const Mtx44* TransformPool::Matrices() const
+	{
+		return hotMtx.data();
+	}
+
+	const uint8_t* TransformPool::SlotAlive() const
+	{
+		return alive.data();
+	}
+
+}
\ No newline at end of file
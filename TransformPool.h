@@ -0,0 +1,130 @@
+#pragma once
+#include "Transform.h"
+#include "Matrix4x4.h"
+#include "QuatValue.h"
+#include "Vector3D.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SNova
+{
+
+// Scene-wide storage for Transforms.
+//
+// Transforms live in chunks of CHUNK_SIZE slots, each slot starting on its
+// own cache line, so a scene's transforms are a few large blocks instead
+// of one heap allocation each. Chunks are never moved or freed until
+// Release(), so Transform pointers stay valid while the slot is alive.
+// Freed slots are reused, and Reset() destroys every transform at once
+// (e.g. at level unload) while keeping the memory for the next level.
+//
+// Handles carry a generation, so a handle to a destroyed (or reset)
+// transform is detected by Get()/IsAlive() instead of reaching whatever
+// took its slot.
+//
+// For loops over every transform (culling, bounds, rendering), the pool
+// also keeps the hot data in separate arrays indexed by slot: position,
+// rotation, scale and matrix. These are a second copy on purpose: the
+// Transforms stay the storage, and writes go through them as usual, so
+// every setter, observer and the rotator binding keep working unchanged.
+// The copy is a read-only snapshot taken by UpdateHotData(). A slot is
+// current right after that call and stale from its next setter until the
+// following UpdateHotData(), so call it once after the frame's writes and
+// before the loops that read the arrays.
+// Transform::MarkDirty() queues its slot, and UpdateHotData() copies only
+// the queued slots, so a frame costs the transforms that changed rather
+// than the whole pool.
+class TransformPool
+{
+	friend class Transform;
+
+public:
+	static constexpr size_t CHUNK_SIZE = 256;
+	static constexpr size_t CACHE_LINE = 64;
+	static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+	struct Handle
+	{
+		uint32_t index = INVALID_INDEX;
+		uint32_t generation = 0;
+
+		bool operator==(const Handle& rhs) const { return index == rhs.index && generation == rhs.generation; }
+		bool operator!=(const Handle& rhs) const { return !(*this == rhs); }
+	};
+
+	TransformPool() = default;
+	TransformPool(const TransformPool&) = delete;
+	TransformPool& operator=(const TransformPool&) = delete;
+	~TransformPool();
+
+	// New default Transform
+	Handle Create();
+
+	// New copy of source (position, rotation, scale, tag; not its observers)
+	Handle Clone(const Transform& source);
+
+	// Destroy a transform. Stale handles are ignored
+	void Destroy(Handle handle);
+
+	// nullptr if the handle is stale
+	Transform* Get(Handle handle) const;
+	bool IsAlive(Handle handle) const;
+
+	// Live transforms
+	size_t Size() const;
+
+	// Slots allocated so far, live or free. The length of the hot arrays
+	size_t SlotCount() const;
+
+	// Destroy every transform. Memory is kept and all handles become stale
+	void Reset();
+
+	// Reset() and free the chunks. Unlike after Reset(), old handles
+	// must not be used afterwards: generations start over
+	void Release();
+
+	// Bring the hot arrays up to date with the live transforms.
+	// Only slots written since the last call are copied
+	void UpdateHotData();
+
+	// Hot arrays as of the last UpdateHotData(), SlotCount() long. Writes
+	// since then are not in them yet.
+	// Free slots have SlotAlive()[slot] == 0 and stale values.
+	// Invalidated when SlotCount() grows
+	const Vec3* Positions() const;
+	const QuatValue* Rotations() const;
+	const Vec3* Scales() const;
+	const Mtx44* Matrices() const;
+	const uint8_t* SlotAlive() const;
+
+	// Slots per ParallelFor chunk in UpdateHotData()
+	size_t grainSize = 1024;
+
+private:
+	// Bytes per slot: sizeof(Transform) rounded up to a cache line
+	static constexpr size_t SLOT_STRIDE = (sizeof(Transform) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+
+	std::vector<unsigned char*> chunks;
+	std::vector<uint32_t> generations;
+	std::vector<uint32_t> freeSlots;
+	size_t liveCount = 0;
+
+	// Hot arrays, indexed by slot
+	std::vector<Vec3> hotPosition;
+	std::vector<QuatValue> hotRotation;
+	std::vector<Vec3> hotScale;
+	std::vector<Mtx44> hotMtx;
+	std::vector<uint8_t> alive;
+
+	// Slots to copy on the next UpdateHotData(), each listed once
+	std::vector<uint32_t> staleSlots;
+	std::vector<uint8_t> stale;
+
+	Transform* Slot(uint32_t index) const;
+	void QueueHotUpdate(uint32_t index);
+	uint32_t AllocateSlot();
+	Handle Construct(uint32_t index, const Transform* source);
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,314 @@
+#include "SNova.h"
+#include "TransformSnapshot.h"
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SNova
+{
+	// Helper function for snapshot layout
+	static uint64_t AlignOffset(uint64_t offset)
+	{
+		constexpr uint64_t align = TransformSnapshotHeader::FILE_ALIGNMENT;
+		return (offset + align - 1) / align * align;
+	}
+
+	// Helper function for snapshot layout. Zero bytes up to the next section
+	static void WritePadding(std::ofstream& file, uint64_t from, uint64_t to)
+	{
+		static const char zeros[TransformSnapshotHeader::FILE_ALIGNMENT] = {};
+		file.write(zeros, static_cast<std::streamsize>(to - from));
+	}
+
+	// Helper function for snapshot validation. [offset, offset + size) lies
+	// inside [0, limit), written so that no sum can wrap
+	static bool SectionFits(uint64_t offset, uint64_t size, uint64_t limit)
+	{
+		return size <= limit && offset <= limit - size;
+	}
+
+	bool TransformSnapshot::Write(const std::string& path, const Transform* const* transforms, size_t count)
+	{
+		constexpr size_t floatsPerLine = TransformSnapshotHeader::FILE_ALIGNMENT / sizeof(float);
+
+		TransformSnapshotHeader header;
+		header.count = static_cast<uint32_t>(count);
+		header.stride = static_cast<uint32_t>((count + floatsPerLine - 1) / floatsPerLine * floatsPerLine);
+
+		// Tags first, their size is needed for the header
+		std::vector<uint32_t> tagEntries(count * 2);
+		std::string tagText;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const std::string tag = transforms[i]->GetTag();
+			tagEntries[i * 2] = static_cast<uint32_t>(tagText.size());
+			tagEntries[i * 2 + 1] = static_cast<uint32_t>(tag.size());
+			tagText += tag;
+		}
+
+		const uint64_t arraysBytes = uint64_t{ ARRAY_COUNT } * header.stride * sizeof(float);
+		header.arraysOffset = sizeof(TransformSnapshotHeader);
+		header.tagsOffset = AlignOffset(header.arraysOffset + arraysBytes);
+		header.tagTextOffset = AlignOffset(header.tagsOffset + tagEntries.size() * sizeof(uint32_t));
+		header.tagTextSize = tagText.size();
+		header.fileSize = header.tagTextOffset + header.tagTextSize;
+
+		std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+		if (!file)
+			return false;
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+		// One array at a time, so only stride floats are staged
+		std::vector<float> column(header.stride, 0.f);
+		for (int array = 0; array < ARRAY_COUNT; ++array)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const Transform& t = *transforms[i];
+				switch (array)
+				{
+				case POS_X:		column[i] = t.GetPosX(); break;
+				case POS_Y:		column[i] = t.GetPosY(); break;
+				case POS_Z:		column[i] = t.GetPosZ(); break;
+				case SCALE_X:	column[i] = t.GetScaleX(); break;
+				case SCALE_Y:	column[i] = t.GetScaleY(); break;
+				case SCALE_Z:	column[i] = t.GetScaleZ(); break;
+				case ROT_W:		column[i] = t.rotation.w; break;
+				case ROT_X:		column[i] = t.rotation.x; break;
+				case ROT_Y:		column[i] = t.rotation.y; break;
+				case ROT_Z:		column[i] = t.rotation.z; break;
+				}
+			}
+			file.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(float));
+		}
+
+		WritePadding(file, header.arraysOffset + arraysBytes, header.tagsOffset);
+		file.write(reinterpret_cast<const char*>(tagEntries.data()), tagEntries.size() * sizeof(uint32_t));
+		WritePadding(file, header.tagsOffset + tagEntries.size() * sizeof(uint32_t), header.tagTextOffset);
+		file.write(tagText.data(), tagText.size());
+
+		return static_cast<bool>(file);
+	}
+
+	TransformSnapshot::~TransformSnapshot()
+	{
+		Close();
+	}
+
+	bool TransformSnapshot::Open(const std::string& path)
+	{
+		Close();
+
+#ifdef _WIN32
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		HANDLE mapping = nullptr;
+		if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+			mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		// The view keeps the mapping alive, the handles aren't needed after this
+		if (mapping)
+		{
+			mp_Data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+			m_MappedSize = mp_Data ? static_cast<size_t>(size.QuadPart) : 0;
+			CloseHandle(mapping);
+		}
+		CloseHandle(file);
+#else
+		const int file = open(path.c_str(), O_RDONLY);
+		if (file < 0)
+			return false;
+
+		struct stat info;
+		if (fstat(file, &info) == 0 && info.st_size > 0)
+		{
+			void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, file, 0);
+			if (view != MAP_FAILED)
+			{
+				mp_Data = static_cast<const unsigned char*>(view);
+				m_MappedSize = static_cast<size_t>(info.st_size);
+			}
+		}
+		close(file);
+#endif
+
+		if (!mp_Data)
+			return false;
+
+		if (m_MappedSize >= sizeof(m_Header))
+			std::memcpy(&m_Header, mp_Data, sizeof(m_Header));
+
+		if (m_MappedSize < sizeof(m_Header) || !Validate())
+		{
+			Unmap();
+			return false;
+		}
+		return true;
+	}
+
+	bool TransformSnapshot::Validate() const
+	{
+		const TransformSnapshotHeader& h = m_Header;
+		if (h.magic != TransformSnapshotHeader::MAGIC || h.version != TransformSnapshotHeader::VERSION)
+			return false;
+
+		// Sections must be aligned, inside the file and in order. Each size is
+		// checked against the file first, so the ends below cannot wrap
+		const uint64_t arraysBytes = uint64_t{ ARRAY_COUNT } * h.stride * sizeof(float);
+		const uint64_t tagsBytes = uint64_t{ h.count } * 2 * sizeof(uint32_t);
+		if (h.stride < h.count
+			|| h.fileSize > m_MappedSize
+			|| h.arraysOffset < sizeof(TransformSnapshotHeader)
+			|| h.arraysOffset != AlignOffset(h.arraysOffset)
+			|| h.tagsOffset != AlignOffset(h.tagsOffset)
+			|| !SectionFits(h.arraysOffset, arraysBytes, h.fileSize)
+			|| !SectionFits(h.tagsOffset, tagsBytes, h.fileSize)
+			|| !SectionFits(h.tagTextOffset, h.tagTextSize, h.fileSize)
+			|| h.tagsOffset < h.arraysOffset + arraysBytes
+			|| h.tagTextOffset < h.tagsOffset + tagsBytes)
+			return false;
+
+		// Every tag must point inside the tag text
+		const uint32_t* tags = reinterpret_cast<const uint32_t*>(mp_Data + h.tagsOffset);
+		for (size_t i = 0; i < h.count; ++i)
+		{
+			if (uint64_t{ tags[i * 2] } + tags[i * 2 + 1] > h.tagTextSize)
+				return false;
+		}
+		return true;
+	}
+
+	void TransformSnapshot::Close()
+	{
+		m_Live.clear();
+		m_PromotedCount = 0;
+		Unmap();
+	}
+
+	void TransformSnapshot::Unmap()
+	{
+		if (mp_Data)
+		{
+#ifdef _WIN32
+			UnmapViewOfFile(mp_Data);
+#else
+			munmap(const_cast<unsigned char*>(mp_Data), m_MappedSize);
+#endif
+		}
+
+		mp_Data = nullptr;
+		m_MappedSize = 0;
+		m_Header = TransformSnapshotHeader{};
+	}
+
+	bool TransformSnapshot::IsOpen() const
+	{
+		return mp_Data != nullptr;
+	}
+
+	size_t TransformSnapshot::Size() const
+	{
+		return m_Header.count;
+	}
+
+	const float* TransformSnapshot::GetArray(Array array) const
+	{
+		if (!mp_Data)
+			return nullptr;
+		return reinterpret_cast<const float*>(mp_Data + m_Header.arraysOffset) + size_t{ m_Header.stride } * array;
+	}
+
+	size_t TransformSnapshot::Stride() const
+	{
+		return m_Header.stride;
+	}
+
+	float TransformSnapshot::Value(Array array, size_t i) const
+	{
+		return GetArray(array)[i];
+	}
+
+	Vec3 TransformSnapshot::GetPosition(size_t i) const
+	{
+		if (const Transform* live = GetLive(i))
+			return live->GetPosition();
+		return Vec3{ Value(POS_X, i), Value(POS_Y, i), Value(POS_Z, i) };
+	}
+
+	Vec3 TransformSnapshot::GetScale(size_t i) const
+	{
+		if (const Transform* live = GetLive(i))
+			return live->GetScale();
+		return Vec3{ Value(SCALE_X, i), Value(SCALE_Y, i), Value(SCALE_Z, i) };
+	}
+
+	QuatValue TransformSnapshot::GetRotation(size_t i) const
+	{
+		if (const Transform* live = GetLive(i))
+			return live->GetRotation();
+		return QuatValue{ Value(ROT_W, i), Value(ROT_X, i), Value(ROT_Y, i), Value(ROT_Z, i) };
+	}
+
+	std::string TransformSnapshot::GetTag(size_t i) const
+	{
+		if (const Transform* live = GetLive(i))
+			return live->GetTag();
+
+		const uint32_t* tags = reinterpret_cast<const uint32_t*>(mp_Data + m_Header.tagsOffset);
+		const char* text = reinterpret_cast<const char*>(mp_Data + m_Header.tagTextOffset);
+		return std::string{ text + tags[i * 2], tags[i * 2 + 1] };
+	}
+
+	Transform& TransformSnapshot::Promote(size_t i)
+	{
+		if (m_Live.empty())
+			m_Live.resize(m_Header.count);
+
+		if (!m_Live[i])
+		{
+			std::unique_ptr<Transform> live{ new Transform{} };
+			live->SetPosition(GetPosition(i));
+			live->SetScale(GetScale(i));
+			live->SetRotation(GetRotation(i));
+			live->SetTag(GetTag(i));
+
+			m_Live[i] = std::move(live);
+			++m_PromotedCount;
+		}
+		return *m_Live[i];
+	}
+
+	Transform* TransformSnapshot::GetLive(size_t i) const
+	{
+		return m_Live.empty() ? nullptr : m_Live[i].get();
+	}
+
+	bool TransformSnapshot::IsPromoted(size_t i) const
+	{
+		return GetLive(i) != nullptr;
+	}
+
+	size_t TransformSnapshot::PromotedCount() const
+	{
+		return m_PromotedCount;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+#include "Transform.h"
+#include "QuatValue.h"
+#include "Vector3D.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SNova
+{
+
+// Snapshot file layout, see TransformSnapshot. Little-endian.
+// Every section starts on a FILE_ALIGNMENT boundary of the file, so once
+// mapped (page aligned) the float arrays can be loaded with aligned SIMD loads.
+struct TransformSnapshotHeader
+{
+	static constexpr uint32_t MAGIC = 0x53544E53;	// "SNTS"
+	static constexpr uint32_t VERSION = 1;
+	static constexpr size_t FILE_ALIGNMENT = 64;
+
+	uint32_t magic = MAGIC;
+	uint32_t version = VERSION;
+	uint32_t count = 0;			// number of transforms
+	uint32_t stride = 0;		// floats per array: count rounded up to a multiple of 16 (FILE_ALIGNMENT bytes), padding is 0
+	uint64_t arraysOffset = 0;	// TransformSnapshot::ARRAY_COUNT float arrays of stride floats each
+	uint64_t tagsOffset = 0;	// count pairs of uint32 {offset, length} into the tag text
+	uint64_t tagTextOffset = 0;
+	uint64_t tagTextSize = 0;
+	uint64_t fileSize = 0;
+	uint64_t reserved = 0;
+};
+
+static_assert(sizeof(TransformSnapshotHeader) == TransformSnapshotHeader::FILE_ALIGNMENT, "TransformSnapshotHeader layout is part of the file format");
+
+// Read-only, memory-mapped view of a saved set of transforms.
+//
+// Open() maps the file and uses it in place: no parsing, and no
+// allocation per transform. Processes that open the same file share its
+// pages. Reads go straight to the mapped arrays. To change a transform,
+// Promote() it: that copies its values into a live Transform owned by the
+// snapshot, and from then on reads of that index see the live Transform.
+// The file itself is never written.
+class TransformSnapshot
+{
+public:
+	// The float arrays, in file order
+	enum Array
+	{
+		POS_X, POS_Y, POS_Z,
+		SCALE_X, SCALE_Y, SCALE_Z,
+		ROT_W, ROT_X, ROT_Y, ROT_Z,
+		ARRAY_COUNT
+	};
+
+	TransformSnapshot() = default;
+	TransformSnapshot(const TransformSnapshot&) = delete;
+	TransformSnapshot& operator=(const TransformSnapshot&) = delete;
+	~TransformSnapshot();
+
+	// Save transforms in snapshot layout. Returns false if the file can't be written
+	static bool Write(const std::string& path, const Transform* const* transforms, size_t count);
+
+	// Map a file written by Write(). Closes any open snapshot first.
+	// Returns false if the file is missing, can't be mapped or isn't a valid snapshot
+	bool Open(const std::string& path);
+
+	// Unmap the file. Also destroys every promoted Transform
+	void Close();
+
+	bool IsOpen() const;
+	size_t Size() const;
+
+	// Zero-copy array straight from the mapping. FILE_ALIGNMENT aligned and
+	// padded with zeros to Stride() floats. Does not see promoted changes
+	const float* GetArray(Array array) const;
+	size_t Stride() const;
+
+	// Values of transform i: the live Transform's if promoted, else the file's
+	Vec3 GetPosition(size_t i) const;
+	Vec3 GetScale(size_t i) const;
+	QuatValue GetRotation(size_t i) const;
+	std::string GetTag(size_t i) const;
+
+	// Live Transform for i, created from the snapshot values on the first call.
+	// Modify transform i through this. Stays valid until Close()
+	Transform& Promote(size_t i);
+
+	// nullptr if i is not promoted
+	Transform* GetLive(size_t i) const;
+	bool IsPromoted(size_t i) const;
+	size_t PromotedCount() const;
+
+private:
+	const unsigned char* mp_Data = nullptr;
+	size_t m_MappedSize = 0;
+	TransformSnapshotHeader m_Header;
+
+	// Indexed by transform, allocated on the first Promote()
+	std::vector<std::unique_ptr<Transform>> m_Live;
+	size_t m_PromotedCount = 0;
+
+	float Value(Array array, size_t i) const;
+	bool Validate() const;
+	void Unmap();
+};
+
+}
\ No newline at end of file
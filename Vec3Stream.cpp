@@ -0,0 +1,279 @@
+/******************************************************************************/
+/*!
+\file		Vec3Stream.cpp
+\author		Justin Leow
+\brief
+	Array versions of the Vector3D operations. See Vec3Stream.h.
+
+	Kernels are written over SIMD lanes on SoA arrays, like QuatBatch.cpp.
+	Add and Scale don't care about components, so the array-of-structs
+	overloads run the same kernels over the flat floats.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "SNova.h"
+#include "Vec3Stream.h"
+#include "QuatBatch.h"
+#include "SIMD.h"
+
+namespace SNova
+{
+namespace Vec3Stream
+{
+
+static_assert(sizeof(Vec3) == 3 * sizeof(float), "Add/Scale treat Vec3 arrays as flat floats");
+
+namespace
+{
+	// Component arrays of a Vec3Batch
+	struct Arrays
+	{
+		float* x;
+		float* y;
+		float* z;
+	};
+
+	inline Arrays Of(const Vec3Batch& batch) { return Arrays{ batch.x, batch.y, batch.z }; }
+
+	/////////////////////////////////////////////////////
+	// SoA kernels. out may alias the inputs element-wise
+
+	void AddFlat(const float* a, const float* b, float* out, size_t count)
+	{
+		SIMD::RunBatch(count, [&](size_t i, auto lane)
+		{
+			using L = decltype(lane);
+			(L::Load(a + i) + L::Load(b + i)).Store(out + i);
+		});
+	}
+
+	void ScaleFlat(const float* in, float s, float* out, size_t count)
+	{
+		SIMD::RunBatch(count, [&](size_t i, auto lane)
+		{
+			using L = decltype(lane);
+			(L::Load(in + i) * L::Set(s)).Store(out + i);
+		});
+	}
+
+	void DotSoA(Arrays a, Arrays b, float* out, size_t n)
+	{
+		SIMD::RunBatch(n, [&](size_t i, auto lane)
+		{
+			using L = decltype(lane);
+			const L dot = L::Load(a.x + i) * L::Load(b.x + i)
+				+ L::Load(a.y + i) * L::Load(b.y + i)
+				+ L::Load(a.z + i) * L::Load(b.z + i);
+			dot.Store(out + i);
+		});
+	}
+
+	void DistanceSquaredSoA(Arrays a, Arrays b, float* out, size_t n)
+	{
+		SIMD::RunBatch(n, [&](size_t i, auto lane)
+		{
+			using L = decltype(lane);
+			const L dx = L::Load(a.x + i) - L::Load(b.x + i);
+			const L dy = L::Load(a.y + i) - L::Load(b.y + i);
+			const L dz = L::Load(a.z + i) - L::Load(b.z + i);
+			(dx * dx + dy * dy + dz * dz).Store(out + i);
+		});
+	}
+
+	void CrossSoA(Arrays a, Arrays b, Arrays out, size_t n)
+	{
+		SIMD::RunBatch(n, [&](size_t i, auto lane)
+		{
+			using L = decltype(lane);
+			const L ax = L::Load(a.x + i), ay = L::Load(a.y + i), az = L::Load(a.z + i);
+			const L bx = L::Load(b.x + i), by = L::Load(b.y + i), bz = L::Load(b.z + i);
+
+			// Same order as Vector3D's operator^
+			(ay * bz - by * az).Store(out.x + i);
+			(az * bx - bz * ax).Store(out.y + i);
+			(ax * by - bx * ay).Store(out.z + i);
+		});
+	}
+
+	void NormalizeSoA(Arrays in, Arrays out, size_t n)
+	{
+		SIMD::RunBatch(n, [&](size_t i, auto lane)
+		{
+			using L = decltype(lane);
+			const L x = L::Load(in.x + i), y = L::Load(in.y + i), z = L::Load(in.z + i);
+			const L magnitudeSq = x * x + y * y + z * z;
+
+			// Same test and math as NormalizeVector3D. Lanes that fail keep
+			// their input (the division there may be inf, it isn't used)
+			const L ok = SIMD::CmpGT(magnitudeSq, L::Set(EPSILON));
+			const L invLength = L::Set(1.f) / SIMD::Sqrt(magnitudeSq);
+
+			SIMD::Select(ok, x * invLength, x).Store(out.x + i);
+			SIMD::Select(ok, y * invLength, y).Store(out.y + i);
+			SIMD::Select(ok, z * invLength, z).Store(out.z + i);
+		});
+	}
+
+	/////////////////////////////////////////////////////
+	// Array-of-structs. Staging into SoA costs more than these ops save, so
+	// loop over the inline single-vector versions (SIMD::Quad ones for Vec3A)
+
+	template <typename V>
+	void DotAoS(const V* a, const V* b, float* out, size_t n)
+	{
+		for (size_t i = 0; i < n; ++i)
+			out[i] = a[i] * b[i];
+	}
+
+	template <typename V>
+	void DistanceSquaredAoS(const V* a, const V* b, float* out, size_t n)
+	{
+		for (size_t i = 0; i < n; ++i)
+			out[i] = Vector3DDistanceSquared(a[i], b[i]);
+	}
+
+	template <typename V>
+	void CrossAoS(const V* a, const V* b, V* out, size_t n)
+	{
+		for (size_t i = 0; i < n; ++i)
+			out[i] = a[i] ^ b[i];
+	}
+
+	template <typename V>
+	void NormalizeAoS(const V* in, V* out, size_t n)
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			V v = in[i];
+			NormalizeVector3D(v, v);
+			out[i] = v;
+		}
+	}
+
+	inline const float* Flat(const Vec3* v) { return reinterpret_cast<const float*>(v); }
+	inline float* Flat(Vec3* v) { return reinterpret_cast<float*>(v); }
+	inline const float* Flat(const Vec3A* v) { return reinterpret_cast<const float*>(v); }
+	inline float* Flat(Vec3A* v) { return reinterpret_cast<float*>(v); }
+}
+
+/////////////////////////////////////////////////////
+// Add
+
+void Add(const Vec3* a, const Vec3* b, Vec3* out, size_t n)
+{
+	AddFlat(Flat(a), Flat(b), Flat(out), n * 3);
+}
+
+void Add(const Vec3A* a, const Vec3A* b, Vec3A* out, size_t n)
+{
+	// The padding floats go along for the ride
+	AddFlat(Flat(a), Flat(b), Flat(out), n * 4);
+}
+
+void Add(const Vec3Batch& a, const Vec3Batch& b, Vec3Batch& out)
+{
+	const size_t n = a.Size();
+	AddFlat(a.x, b.x, out.x, n);
+	AddFlat(a.y, b.y, out.y, n);
+	AddFlat(a.z, b.z, out.z, n);
+}
+
+/////////////////////////////////////////////////////
+// Scale
+
+void Scale(const Vec3* in, float s, Vec3* out, size_t n)
+{
+	ScaleFlat(Flat(in), s, Flat(out), n * 3);
+}
+
+void Scale(const Vec3A* in, float s, Vec3A* out, size_t n)
+{
+	ScaleFlat(Flat(in), s, Flat(out), n * 4);
+}
+
+void Scale(const Vec3Batch& in, float s, Vec3Batch& out)
+{
+	const size_t n = in.Size();
+	ScaleFlat(in.x, s, out.x, n);
+	ScaleFlat(in.y, s, out.y, n);
+	ScaleFlat(in.z, s, out.z, n);
+}
+
+/////////////////////////////////////////////////////
+// Dot
+
+void Dot(const Vec3* a, const Vec3* b, float* out, size_t n)
+{
+	DotAoS(a, b, out, n);
+}
+
+void Dot(const Vec3A* a, const Vec3A* b, float* out, size_t n)
+{
+	DotAoS(a, b, out, n);
+}
+
+void Dot(const Vec3Batch& a, const Vec3Batch& b, float* out)
+{
+	DotSoA(Of(a), Of(b), out, a.Size());
+}
+
+/////////////////////////////////////////////////////
+// Cross
+
+void Cross(const Vec3* a, const Vec3* b, Vec3* out, size_t n)
+{
+	CrossAoS(a, b, out, n);
+}
+
+void Cross(const Vec3A* a, const Vec3A* b, Vec3A* out, size_t n)
+{
+	CrossAoS(a, b, out, n);
+}
+
+void Cross(const Vec3Batch& a, const Vec3Batch& b, Vec3Batch& out)
+{
+	CrossSoA(Of(a), Of(b), Of(out), a.Size());
+}
+
+/////////////////////////////////////////////////////
+// Normalize
+
+void Normalize(const Vec3* in, Vec3* out, size_t n)
+{
+	NormalizeAoS(in, out, n);
+}
+
+void Normalize(const Vec3A* in, Vec3A* out, size_t n)
+{
+	NormalizeAoS(in, out, n);
+}
+
+void Normalize(const Vec3Batch& in, Vec3Batch& out)
+{
+	NormalizeSoA(Of(in), Of(out), in.Size());
+}
+
+/////////////////////////////////////////////////////
+// DistanceSquared
+
+void DistanceSquared(const Vec3* a, const Vec3* b, float* out, size_t n)
+{
+	DistanceSquaredAoS(a, b, out, n);
+}
+
+void DistanceSquared(const Vec3A* a, const Vec3A* b, float* out, size_t n)
+{
+	DistanceSquaredAoS(a, b, out, n);
+}
+
+void DistanceSquared(const Vec3Batch& a, const Vec3Batch& b, float* out)
+{
+	DistanceSquaredSoA(Of(a), Of(b), out, a.Size());
+}
+
+} // namespace Vec3Stream
+} // namespace SNova
\ No newline at end of file
@@ -0,0 +1,68 @@
+/******************************************************************************/
+/*!
+\file		Vec3Stream.h
+\author		Justin Leow
+\brief
+	The common Vector3D operations over whole arrays at once, for loops like
+	broad-phase pair tests that would otherwise make one call per vector.
+
+	Every function has three overloads: arrays of Vector3D, arrays of
+	Vector3DPacked (Vec3A), and Vec3Batch (structure-of-arrays, fastest).
+	Results match the single-vector functions in Vector3D.h element-wise.
+	Outputs may alias inputs.
+
+	Only Vec3Batch gets a full SIMD register of vectors per instruction.
+	Arrays of Vector3D / Vec3A loop over the inline single-vector math
+	(one SIMD::Quad per vector for Vec3A), except Add and Scale, which run
+	over the flat floats at full width. Prefer Vec3Batch in hot loops.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "Vector3D.h"
+#include "Vector3DPacked.h"
+#include <cstddef>
+
+namespace SNova
+{
+
+struct Vec3Batch;
+
+namespace Vec3Stream
+{
+	// out[i] = a[i] + b[i]
+	void Add(const Vec3* a, const Vec3* b, Vec3* out, size_t n);
+	void Add(const Vec3A* a, const Vec3A* b, Vec3A* out, size_t n);
+	void Add(const Vec3Batch& a, const Vec3Batch& b, Vec3Batch& out);
+
+	// out[i] = in[i] * s
+	void Scale(const Vec3* in, float s, Vec3* out, size_t n);
+	void Scale(const Vec3A* in, float s, Vec3A* out, size_t n);
+	void Scale(const Vec3Batch& in, float s, Vec3Batch& out);
+
+	// out[i] = a[i] * b[i] (dot product). out holds n floats
+	void Dot(const Vec3* a, const Vec3* b, float* out, size_t n);
+	void Dot(const Vec3A* a, const Vec3A* b, float* out, size_t n);
+	void Dot(const Vec3Batch& a, const Vec3Batch& b, float* out);
+
+	// out[i] = a[i] ^ b[i] (cross product)
+	void Cross(const Vec3* a, const Vec3* b, Vec3* out, size_t n);
+	void Cross(const Vec3A* a, const Vec3A* b, Vec3A* out, size_t n);
+	void Cross(const Vec3Batch& a, const Vec3Batch& b, Vec3Batch& out);
+
+	// NormalizeVector3D(out[i], in[i]): vectors too small to normalize are copied unchanged
+	void Normalize(const Vec3* in, Vec3* out, size_t n);
+	void Normalize(const Vec3A* in, Vec3A* out, size_t n);
+	void Normalize(const Vec3Batch& in, Vec3Batch& out);
+
+	// out[i] = Vector3DDistanceSquared(a[i], b[i]). out holds n floats
+	void DistanceSquared(const Vec3* a, const Vec3* b, float* out, size_t n);
+	void DistanceSquared(const Vec3A* a, const Vec3A* b, float* out, size_t n);
+	void DistanceSquared(const Vec3Batch& a, const Vec3Batch& b, float* out);
+
+} // namespace Vec3Stream
+} // namespace SNova
\ No newline at end of file
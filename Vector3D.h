@@ -20,26 +20,26 @@ public:
 	};
 
 	//Constructors
-	Vector3D(float x = 0.0f, float y = 0.0f, float z = 0.0f);
+	constexpr Vector3D(float _x = 0.0f, float _y = 0.0f, float _z = 0.0f) : x(_x), y(_y), z(_z) {}
 	Vector3D(const glm::vec3& vec) : x{ vec.x }, y{ vec.y }, z{ vec.z } {};
 	explicit Vector3D(const Vec4& v4);
 
 	//Assignment operators
-	Vector3D& operator +=(const Vector3D& rhs);
-	Vector3D& operator -=(const Vector3D& rhs);
-	Vector3D& operator *=(float rhs);
-	Vector3D& operator /=(float rhs);
+	constexpr Vector3D& operator +=(const Vector3D& rhs);
+	constexpr Vector3D& operator -=(const Vector3D& rhs);
+	constexpr Vector3D& operator *=(float rhs);
+	constexpr Vector3D& operator /=(float rhs);
 
 	operator glm::vec3() const { return glm::vec3{ x,y,z }; }
 
 	//Unary operator
-	Vector3D operator -() const;
+	constexpr Vector3D operator -() const;
 
 	//Other operations
-	void Normalize();
-	Vector3D Normalized() const;
-	float Magnitude() const;
-	float MagnitudeSq() const;
+	inline void Normalize();
+	inline Vector3D Normalized() const;
+	inline float Magnitude() const;
+	inline float MagnitudeSq() const;
 
 	// Converts value of Vector into human-readable string
 	inline std::string ToString() const;
@@ -59,36 +59,39 @@ typedef Vector3D Point3D;
 typedef Vector3D Pt3;
 
 //Binary operators
-Vector3D operator + (const Vector3D& lhs, const Vector3D& rhs);
-Vector3D operator - (const Vector3D& lhs, const Vector3D& rhs);
-Vector3D operator * (const Vector3D& lhs, float rhs);
-Vector3D operator * (float lhs, const Vector3D& rhs);
-Vector3D operator / (const Vector3D& lhs, float rhs);
+constexpr Vector3D operator + (const Vector3D& lhs, const Vector3D& rhs);
+constexpr Vector3D operator - (const Vector3D& lhs, const Vector3D& rhs);
+constexpr Vector3D operator * (const Vector3D& lhs, float rhs);
+constexpr Vector3D operator * (float lhs, const Vector3D& rhs);
+constexpr Vector3D operator / (const Vector3D& lhs, float rhs);
 bool operator == (const Vector3D& lhs, const Vector3D& rhs);
 bool operator != (const Vector3D& lhs, const Vector3D& rhs);
 
 // Dot Product
-float operator*(const Vec3& lhs, const Vec3& rhs);
+constexpr float operator*(const Vec3& lhs, const Vec3& rhs);
 
 // Cross Product
-Vec3 operator^(const Vec3& lhs, const Vec3& rhs);
+constexpr Vec3 operator^(const Vec3& lhs, const Vec3& rhs);
+
+// The small helpers below are inline, they are called in tight loops
+// (see Vec3Stream.h for whole arrays at once)
 
 //Zeroes out vector passed in
-void ZeroVector(Vector3D& pResult);
+inline void ZeroVector(Vector3D& pResult);
 //Negate the vector passed in
-void NegateVector(Vector3D& pResult);
+inline void NegateVector(Vector3D& pResult);
 //Normalize vector 
-void NormalizeVector3D(Vector3D& pResult, const Vector3D& pVec0);
+inline void NormalizeVector3D(Vector3D& pResult, const Vector3D& pVec0);
 //Get vector length
-float Vector3DLength(const Vector3D& pVec0);
+inline float Vector3DLength(const Vector3D& pVec0);
 //Get vector length squared
-float Vector3DLengthSquared(const Vector3D& pVec0);
+inline float Vector3DLengthSquared(const Vector3D& pVec0);
 //Get distance between two points
-float Vector3DDistance(const Vector3D& pVec0, const Vector3D& pVec1);
+inline float Vector3DDistance(const Vector3D& pVec0, const Vector3D& pVec1);
 //Get squared distance between two points
-float Vector3DDistanceSquared(const Vector3D& pVec0, const Vector3D& pVec1);
+inline float Vector3DDistanceSquared(const Vector3D& pVec0, const Vector3D& pVec1);
 //Dot product
-float Vector3DDotProduct(const Vector3D& pVec0, const Vector3D& pVec1);
+inline float Vector3DDotProduct(const Vector3D& pVec0, const Vector3D& pVec1);
 //Cross product magnitude
 float Vector3DCrossProductMag(const Vector3D& pVec0, const Vector3D& pVec1);
 //Get angle between vectors (in radians)
@@ -98,6 +101,166 @@ bool Vector3DParallel(const Vector3D& pVec0, const Vector3D& pVec1);
 
 // ------------------------- INLINE IMPLEMENTATIONS ---------------------
 
+constexpr Vector3D& Vector3D::operator+=(const Vector3D& rhs)
+{
+	x += rhs.x;
+	y += rhs.y;
+	z += rhs.z;
+
+	return *this;
+}
+
+constexpr Vector3D& Vector3D::operator-=(const Vector3D& rhs)
+{
+	x -= rhs.x;
+	y -= rhs.y;
+	z -= rhs.z;
+
+	return *this;
+}
+
+constexpr Vector3D& Vector3D::operator*=(float rhs)
+{
+	x *= rhs;
+	y *= rhs;
+	z *= rhs;
+
+	return *this;
+}
+
+constexpr Vector3D& Vector3D::operator/=(float rhs)
+{
+	x /= rhs;
+	y /= rhs;
+	z /= rhs;
+
+	return *this;
+}
+
+constexpr Vector3D Vector3D::operator-() const
+{
+	return Vector3D{ -x, -y, -z };
+}
+
+constexpr Vector3D operator+(const Vector3D& lhs, const Vector3D& rhs)
+{
+	return Vector3D{ lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z };
+}
+
+constexpr Vector3D operator-(const Vector3D& lhs, const Vector3D& rhs)
+{
+	return Vector3D{ lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z };
+}
+
+constexpr Vector3D operator*(const Vector3D& lhs, float rhs)
+{
+	return Vector3D{ lhs.x * rhs, lhs.y * rhs, lhs.z * rhs };
+}
+
+constexpr Vector3D operator*(float lhs, const Vector3D& rhs)
+{
+	return operator*(rhs, lhs);
+}
+
+constexpr Vector3D operator/(const Vector3D& lhs, float rhs)
+{
+	return Vector3D{ lhs.x / rhs, lhs.y / rhs, lhs.z / rhs };
+}
+
+constexpr float operator*(const Vec3& lhs, const Vec3& rhs)
+{
+	return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z;
+}
+
+constexpr Vec3 operator^(const Vec3& lhs, const Vec3& rhs)
+{
+	return Vec3{ lhs.y * rhs.z - rhs.y * lhs.z,
+				 lhs.z * rhs.x - rhs.z * lhs.x,
+				 lhs.x * rhs.y - rhs.x * lhs.y };
+}
+
+inline void Vector3D::Normalize()
+{
+	NormalizeVector3D(*this, *this);
+}
+
+inline Vector3D Vector3D::Normalized() const
+{
+	Vector3D normVec = *this;
+	NormalizeVector3D(normVec, *this);
+	return normVec;
+}
+
+inline float Vector3D::Magnitude() const
+{
+	return Vector3DLength(*this);
+}
+
+inline float Vector3D::MagnitudeSq() const
+{
+	return Vector3DLengthSquared(*this);
+}
+
+inline void ZeroVector(Vector3D& pResult)
+{
+	pResult.x = 0.0f;
+	pResult.y = 0.0f;
+	pResult.z = 0.0f;
+}
+
+inline void NegateVector(Vector3D& pResult)
+{
+	pResult.x = -pResult.x;
+	pResult.y = -pResult.y;
+	pResult.z = -pResult.z;
+}
+
+inline void NormalizeVector3D(Vector3D& pResult, const Vector3D& pVec0)
+{
+	// magnitude of pVec0
+	float magnitudeSq = Vector3DLengthSquared(pVec0);
+
+	// prevent division by zero (same test as Approximate(magnitudeSq, 0))
+	if (!(magnitudeSq > EPSILON)) return;
+
+	// same as FastInverseSqrt
+	magnitudeSq = 1.0f / sqrtf(magnitudeSq);
+
+	// divide each coordinate by magnitude
+	pResult.x = pVec0.x * magnitudeSq;
+	pResult.y = pVec0.y * magnitudeSq;
+	pResult.z = pVec0.z * magnitudeSq;
+}
+
+inline float Vector3DLength(const Vector3D& pVec0)
+{
+	return sqrtf(pVec0.x * pVec0.x + pVec0.y * pVec0.y + pVec0.z * pVec0.z);
+}
+
+inline float Vector3DLengthSquared(const Vector3D& pVec0)
+{
+	return (pVec0.x * pVec0.x + pVec0.y * pVec0.y + pVec0.z * pVec0.z);
+}
+
+inline float Vector3DDistance(const Vector3D& pVec0, const Vector3D& pVec1)
+{
+	return sqrtf(Vector3DDistanceSquared(pVec0, pVec1));
+}
+
+inline float Vector3DDistanceSquared(const Vector3D& pVec0, const Vector3D& pVec1)
+{
+	float xDiff = pVec0.x - pVec1.x;
+	float yDiff = pVec0.y - pVec1.y;
+	float zDiff = pVec0.z - pVec1.z;
+
+	return (xDiff * xDiff) + (yDiff * yDiff) + (zDiff * zDiff);
+}
+
+inline float Vector3DDotProduct(const Vector3D& pVec0, const Vector3D& pVec1)
+{
+	return (pVec0.x * pVec1.x) + (pVec0.y * pVec1.y) + (pVec0.z * pVec1.z);
+}
+
 inline std::string Vector3D::ToString() const
 {
 	std::ostringstream oss;
@@ -0,0 +1,266 @@
+/******************************************************************************/
+/*!
+\file		Vector3DPacked.h
+\author		Justin Leow
+\brief
+	Vector3D padded to 16 bytes and 16-byte aligned, so each vector is
+	exactly one SIMD register (SIMD::Quad) and every operator is a couple of
+	inline SSE/NEON instructions.
+
+	Use it for hot arrays of positions/velocities (broad-phase, particles),
+	where Vector3D's 12-byte layout forces unaligned scalar code. The 4th
+	float is padding: it is 0 after construction but the operators don't
+	keep it meaningful, so never read it.
+
+	Conversions to and from Vector3D are explicit, so mixing the two types
+	in one expression doesn't silently pick an overload.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "Vector3D.h"
+#include "SIMD.h"
+
+namespace SNova
+{
+
+#ifdef _MSC_VER
+// Supress warning: nonstandard extension used : nameless struct/union
+#pragma warning( disable : 4201 )
+#endif
+
+struct alignas(16) Vector3DPacked
+{
+	/////////////////////////////////////////////////////
+	// Data Members
+public:
+	union
+	{
+		struct { float x, y, z, pad; };
+		float v[4];
+	};
+
+	/////////////////////////////////////////////////////
+	// Constructors
+public:
+	constexpr Vector3DPacked(float _x = 0.0f, float _y = 0.0f, float _z = 0.0f) : x(_x), y(_y), z(_z), pad(0.0f) {}
+	constexpr explicit Vector3DPacked(const Vector3D& vec) : x(vec.x), y(vec.y), z(vec.z), pad(0.0f) {}
+
+	explicit operator Vector3D() const { return Vector3D{ x, y, z }; }
+
+	// One register holding this vector
+	inline SIMD::Quad Load() const { return SIMD::Quad::Load(v); }
+	static inline Vector3DPacked From(SIMD::Quad q);
+
+	/////////////////////////////////////////////////////
+	// Member Functions
+public:
+	inline Vector3DPacked& operator +=(const Vector3DPacked& rhs);
+	inline Vector3DPacked& operator -=(const Vector3DPacked& rhs);
+	inline Vector3DPacked& operator *=(float rhs);
+	inline Vector3DPacked& operator /=(float rhs);
+
+	inline Vector3DPacked operator -() const;
+
+	// Same rules as Vector3D's (vectors too small to normalize are left as they are)
+	inline void Normalize();
+	inline Vector3DPacked Normalized() const;
+	inline float Magnitude() const;
+	inline float MagnitudeSq() const;
+
+	inline std::string ToString() const;
+	inline bool Equals(const Vector3DPacked& v, float tolerance = KINDA_SMALL_NUMBER) const;
+};
+
+#ifdef _MSC_VER
+// Supress warning: nonstandard extension used : nameless struct/union
+#pragma warning( disable : 4201 )
+#endif
+
+// Type Aliases
+typedef Vector3DPacked Vec3A;
+
+static_assert(sizeof(Vector3DPacked) == 4 * sizeof(float), "Vector3DPacked must be exactly one SIMD::Quad");
+
+//Binary operators, same meaning as Vector3D's
+inline Vec3A operator + (const Vec3A& lhs, const Vec3A& rhs);
+inline Vec3A operator - (const Vec3A& lhs, const Vec3A& rhs);
+inline Vec3A operator * (const Vec3A& lhs, float rhs);
+inline Vec3A operator * (float lhs, const Vec3A& rhs);
+inline Vec3A operator / (const Vec3A& lhs, float rhs);
+inline bool operator == (const Vec3A& lhs, const Vec3A& rhs);
+inline bool operator != (const Vec3A& lhs, const Vec3A& rhs);
+
+// Dot Product
+inline float operator*(const Vec3A& lhs, const Vec3A& rhs);
+
+// Cross Product
+inline Vec3A operator^(const Vec3A& lhs, const Vec3A& rhs);
+
+// Overloads of the Vector3D helpers, so code can switch types without renaming
+inline void NormalizeVector3D(Vec3A& pResult, const Vec3A& pVec0);
+inline float Vector3DLength(const Vec3A& pVec0);
+inline float Vector3DLengthSquared(const Vec3A& pVec0);
+inline float Vector3DDistance(const Vec3A& pVec0, const Vec3A& pVec1);
+inline float Vector3DDistanceSquared(const Vec3A& pVec0, const Vec3A& pVec1);
+inline float Vector3DDotProduct(const Vec3A& pVec0, const Vec3A& pVec1);
+
+// ------------------------- INLINE IMPLEMENTATIONS ---------------------
+
+inline Vector3DPacked Vector3DPacked::From(SIMD::Quad q)
+{
+	Vector3DPacked result;
+	q.Store(result.v);
+	return result;
+}
+
+inline Vector3DPacked& Vector3DPacked::operator+=(const Vector3DPacked& rhs)
+{
+	(Load() + rhs.Load()).Store(v);
+	return *this;
+}
+
+inline Vector3DPacked& Vector3DPacked::operator-=(const Vector3DPacked& rhs)
+{
+	(Load() - rhs.Load()).Store(v);
+	return *this;
+}
+
+inline Vector3DPacked& Vector3DPacked::operator*=(float rhs)
+{
+	(Load() * SIMD::Quad::Set(rhs)).Store(v);
+	return *this;
+}
+
+inline Vector3DPacked& Vector3DPacked::operator/=(float rhs)
+{
+	(Load() / SIMD::Quad::Set(rhs)).Store(v);
+	return *this;
+}
+
+inline Vector3DPacked Vector3DPacked::operator-() const
+{
+	return From(-Load());
+}
+
+inline void Vector3DPacked::Normalize()
+{
+	NormalizeVector3D(*this, *this);
+}
+
+inline Vector3DPacked Vector3DPacked::Normalized() const
+{
+	Vector3DPacked normVec = *this;
+	NormalizeVector3D(normVec, *this);
+	return normVec;
+}
+
+inline float Vector3DPacked::Magnitude() const
+{
+	return sqrtf(MagnitudeSq());
+}
+
+inline float Vector3DPacked::MagnitudeSq() const
+{
+	return SIMD::Dot3(Load(), Load());
+}
+
+inline std::string Vector3DPacked::ToString() const
+{
+	std::ostringstream oss;
+	oss << "x=" << x << " y=" << y << " z=" << z;
+	return oss.str();
+}
+
+inline bool Vector3DPacked::Equals(const Vector3DPacked& r, float tolerance) const
+{
+	return (fabsf(x - r.x) <= tolerance)
+		&& (fabsf(y - r.y) <= tolerance)
+		&& (fabsf(z - r.z) <= tolerance);
+}
+
+inline Vec3A operator+(const Vec3A& lhs, const Vec3A& rhs)
+{
+	return Vec3A::From(lhs.Load() + rhs.Load());
+}
+
+inline Vec3A operator-(const Vec3A& lhs, const Vec3A& rhs)
+{
+	return Vec3A::From(lhs.Load() - rhs.Load());
+}
+
+inline Vec3A operator*(const Vec3A& lhs, float rhs)
+{
+	return Vec3A::From(lhs.Load() * SIMD::Quad::Set(rhs));
+}
+
+inline Vec3A operator*(float lhs, const Vec3A& rhs)
+{
+	return operator*(rhs, lhs);
+}
+
+inline Vec3A operator/(const Vec3A& lhs, float rhs)
+{
+	return Vec3A::From(lhs.Load() / SIMD::Quad::Set(rhs));
+}
+
+inline bool operator==(const Vec3A& lhs, const Vec3A& rhs)
+{
+	return (fabsf(lhs.x - rhs.x) < EPSILON && fabsf(lhs.y - rhs.y) < EPSILON && fabsf(lhs.z - rhs.z) < EPSILON);
+}
+
+inline bool operator!=(const Vec3A& lhs, const Vec3A& rhs)
+{
+	return !operator==(lhs, rhs);
+}
+
+inline float operator*(const Vec3A& lhs, const Vec3A& rhs)
+{
+	return SIMD::Dot3(lhs.Load(), rhs.Load());
+}
+
+inline Vec3A operator^(const Vec3A& lhs, const Vec3A& rhs)
+{
+	return Vec3A::From(SIMD::Cross3(lhs.Load(), rhs.Load()));
+}
+
+inline void NormalizeVector3D(Vec3A& pResult, const Vec3A& pVec0)
+{
+	const float magnitudeSq = Vector3DLengthSquared(pVec0);
+
+	// prevent division by zero (same test as Approximate(magnitudeSq, 0))
+	if (!(magnitudeSq > EPSILON)) return;
+
+	pResult = pVec0 * (1.0f / sqrtf(magnitudeSq));
+}
+
+inline float Vector3DLength(const Vec3A& pVec0)
+{
+	return pVec0.Magnitude();
+}
+
+inline float Vector3DLengthSquared(const Vec3A& pVec0)
+{
+	return pVec0.MagnitudeSq();
+}
+
+inline float Vector3DDistance(const Vec3A& pVec0, const Vec3A& pVec1)
+{
+	return sqrtf(Vector3DDistanceSquared(pVec0, pVec1));
+}
+
+inline float Vector3DDistanceSquared(const Vec3A& pVec0, const Vec3A& pVec1)
+{
+	return Vector3DLengthSquared(pVec0 - pVec1);
+}
+
+inline float Vector3DDotProduct(const Vec3A& pVec0, const Vec3A& pVec1)
+{
+	return pVec0 * pVec1;
+}
+
+} // namespace SNova
\ No newline at end of file
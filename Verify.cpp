@@ -0,0 +1,103 @@
+/******************************************************************************/
+/*!
+\file		Verify.cpp
+\author		Justin Leow
+\brief
+	Check bookkeeping and the case list. See Verify.h.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "SNova.h"
+#include "Verify.h"
+
+namespace SNova
+{
+namespace Verify
+{
+
+namespace
+{
+	// Set by RunAll for the case being run
+	std::ostream* output = &std::cerr;
+	size_t failures = 0;
+}
+
+bool Check(bool passed, const char* expression, const char* file, int line)
+{
+	if (!passed)
+	{
+		++failures;
+		*output << "  " << file << '(' << line << "): check failed: " << expression << '\n';
+	}
+	return passed;
+}
+
+std::vector<Case> DefaultCases()
+{
+	return {
+		{ "ComposeTRS", CheckComposeTRS },
+		{ "Matrices", CheckMatrices },
+		{ "RotateVectors", CheckRotateVectors },
+		{ "RotatorVectors", CheckRotatorVectors },
+		{ "QuatBatch", CheckQuatBatch },
+		{ "QuatValue", CheckQuatValue },
+		{ "BlendN", CheckBlendN },
+		{ "TrigTiers", CheckTrigTiers },
+		{ "DeterministicMath", CheckDeterministicMath },
+		{ "ConstexprRotations", CheckConstexprRotations },
+		{ "MathTypes", CheckMathTypes },
+		{ "Vec3Stream", CheckVec3Stream },
+		{ "FindBetween", CheckFindBetween },
+		{ "QuatCompress", CheckQuatCompress },
+		{ "AngularVelocity", CheckAngularVelocity },
+		{ "QuatSpline", CheckQuatSpline },
+		{ "Culling", CheckCulling },
+		{ "TransformMatrix", CheckTransformMatrix },
+		{ "RotatorModes", CheckRotatorModes },
+		{ "ConversionCache", CheckConversionCache },
+		{ "Instrumentation", CheckInstrumentation },
+		{ "Tags", CheckTags },
+		{ "CopyMove", CheckCopyMove },
+		{ "NotifyQueue", CheckNotifyQueue },
+		{ "TransformPool", CheckTransformPool },
+		{ "BinaryFormat", CheckBinaryFormat },
+		{ "Snapshot", CheckSnapshot },
+		{ "FrameBuffer", CheckFrameBuffer },
+		{ "Hierarchy", CheckHierarchy },
+		{ "ParallelFor", CheckParallelFor },
+	};
+}
+
+size_t RunAll(std::ostream& out)
+{
+	return RunAll(DefaultCases(), out);
+}
+
+size_t RunAll(const std::vector<Case>& cases, std::ostream& out)
+{
+	std::ostream* const previousOutput = output;
+	const size_t previousFailures = failures;
+	output = &out;
+
+	size_t total = 0;
+	for (const Case& c : cases)
+	{
+		failures = 0;
+		out << c.name << '\n';
+		c.run();
+		out << "  " << (failures ? std::to_string(failures) + " failed" : std::string{ "ok" }) << '\n';
+		total += failures;
+	}
+	out << (total ? std::to_string(total) + " checks failed" : std::string{ "all checks passed" }) << '\n';
+
+	output = previousOutput;
+	failures = previousFailures;
+	return total;
+}
+
+} // namespace Verify
+} // namespace SNova
\ No newline at end of file
@@ -0,0 +1,176 @@
+/******************************************************************************/
+/*!
+\file		Verify.h
+\author		Justin Leow
+\brief
+	Behaviour checks for the math kernels and Transform storage, each next
+	to the scalar reference or contract it must keep.
+
+	SNOVA_CHECK(condition) is not assert: it is compiled in every build,
+	NDEBUG included, so the checks also run against the Release code that
+	ships. A failed check prints its file, line and expression and counts
+	towards RunAll()'s result; the case keeps going so one run lists every
+	failure. Call RunAll() from a test build or a debug key, on the main
+	thread (the failure count and output are not synchronised).
+
+	Inputs are random but seeded identically every run, at CHECK_COUNT
+	elements so the SIMD kernels' scalar tails run too.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#pragma once
+#include "GenMath.h"
+#include "Matrix3x3.h"
+#include "Quat.h"
+#include "Rotator.h"
+#include "Vector3D.h"
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Check that condition holds; on failure record it and carry on
+#define SNOVA_CHECK(condition) ::SNova::Verify::Check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+namespace SNova
+{
+namespace Verify
+{
+	// One named group of checks
+	struct Case
+	{
+		std::string name;
+		std::function<void()> run;
+	};
+
+	// Built-in cases, one per feature
+	std::vector<Case> DefaultCases();
+
+	// Run every case, print each one and its result to out, return the number of failed checks
+	size_t RunAll(std::ostream& out = std::cout);
+	size_t RunAll(const std::vector<Case>& cases, std::ostream& out);
+
+	// Backs SNOVA_CHECK. Returns passed, so a case can stop when later checks depend on it
+	bool Check(bool passed, const char* expression, const char* file, int line);
+
+	/////////////////////////////////////////////////////
+	// Shared fixtures
+
+	// Not a multiple of any SIMD width
+	static constexpr size_t CHECK_COUNT = 1003;
+
+	// Seeded so every run checks the same inputs
+	struct Random
+	{
+		std::mt19937 rng{ 12345u };
+		std::uniform_real_distribution<float> unit{ -1.f, 1.f };
+
+		float Unit() { return unit(rng); }
+		float Between(float min, float max) { return min + (max - min) * (unit(rng) * 0.5f + 0.5f); }
+
+		Vec3 Vector() { return Vec3{ Unit(), Unit(), Unit() } * 10.f; }
+		Quat Quaternion() { return Quat{ Unit(), Unit(), Unit(), Unit() }.GetNormalized(); }
+		Rotator Angles() { return Rotator{ Between(-89.f, 89.f), Between(-180.f, 180.f), Between(-180.f, 180.f) }; }
+		Matrix3x3 Matrix()
+		{
+			// Rotation * scale, so it is always invertible
+			Matrix3x3 m = Angles().Matrix();
+			const float s = Between(0.5f, 2.f);
+			for (int i = 0; i < 3; ++i)
+				for (int j = 0; j < 3; ++j)
+					m.m2[i][j] *= s;
+			return m;
+		}
+	};
+
+	// |a - b| within tolerance, relative once |b| is above 1
+	inline bool Near(float a, float b, float tolerance)
+	{
+		return Math::Abs(a - b) <= tolerance * Math::Max(1.f, Math::Abs(b));
+	}
+
+	// Angle error, in degrees, of a rotation built from default-tier sin/cos
+	// (Quat(axis, angle), the SIMD integrators). Measured ~0.0024 at Fast
+	static constexpr double TRIG_DEGREES = (Math::DEFAULT_TRIG_ACCURACY == Math::TrigAccuracy::Fast) ? 5e-3 : 1e-3;
+
+	// Random.Quaternion() normalizes with the fast InvSqrt (~1e-3 off),
+	// which breaks round-trip identities long before the kernels do
+	inline Quat ExactUnit(const Quat& q)
+	{
+		return q * (1.f / std::sqrt(q | q));
+	}
+
+	inline bool NearVec(const Vec3& v, const Vec3& expected, float tolerance)
+	{
+		return Near(v.x, expected.x, tolerance) && Near(v.y, expected.y, tolerance) && Near(v.z, expected.z, tolerance);
+	}
+
+	// Same rotation up to sign and the scalar path's fast normalize
+	inline bool SameRotation(const Quat& a, const Quat& b)
+	{
+		return Math::Abs(ExactUnit(a) | ExactUnit(b)) >= 1.f - 1e-5f;
+	}
+
+	// Angle between the rotations a and b in degrees, in double so that the
+	// float rounding of a dot product near 1 doesn't swamp small errors
+	inline double AngleDegrees(const Quat& a, const Quat& b)
+	{
+		const double la = std::sqrt(double{ a | a }), lb = std::sqrt(double{ b | b });
+		const double aw = a.w / la, ax = a.x / la, ay = a.y / la, az = a.z / la;
+		const double bw = b.w / lb, bx = b.x / lb, by = b.y / lb, bz = b.z / lb;
+
+		// Vector part and w of a^-1 * b
+		const double x = aw * bx - bw * ax - (ay * bz - az * by);
+		const double y = aw * by - bw * ay - (az * bx - ax * bz);
+		const double z = aw * bz - bw * az - (ax * by - ay * bx);
+		const double w = aw * bw + ax * bx + ay * by + az * bz;
+		return 2.0 * std::atan2(std::sqrt(x * x + y * y + z * z), std::fabs(w)) * 57.29577951308232;
+	}
+
+	/////////////////////////////////////////////////////
+	// Cases, in VerifyMath.cpp
+
+	void CheckComposeTRS();
+	void CheckMatrices();
+	void CheckRotateVectors();
+	void CheckRotatorVectors();
+	void CheckQuatBatch();
+	void CheckQuatValue();
+	void CheckBlendN();
+	void CheckTrigTiers();
+	void CheckDeterministicMath();
+	void CheckConstexprRotations();
+	void CheckMathTypes();
+	void CheckVec3Stream();
+	void CheckFindBetween();
+	void CheckQuatCompress();
+	void CheckAngularVelocity();
+	void CheckQuatSpline();
+	void CheckCulling();
+
+	/////////////////////////////////////////////////////
+	// Cases, in VerifyTransform.cpp
+
+	void CheckTransformMatrix();
+	void CheckRotatorModes();
+	void CheckConversionCache();
+	void CheckInstrumentation();
+	void CheckTags();
+	void CheckCopyMove();
+	void CheckNotifyQueue();
+	void CheckTransformPool();
+	void CheckBinaryFormat();
+	void CheckSnapshot();
+	void CheckFrameBuffer();
+	void CheckHierarchy();
+	void CheckParallelFor();
+
+} // namespace Verify
+} // namespace SNova
\ No newline at end of file
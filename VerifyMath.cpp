@@ -0,0 +1,1338 @@
+/******************************************************************************/
+/*!
+\file		VerifyMath.cpp
+\author		Justin Leow
+\brief
+	Behaviour checks of the batched and fused math kernels against their
+	scalar references. See Verify.h.
+
+	Every case runs CHECK_COUNT elements, which is not a multiple of any
+	SIMD width, so the kernels' scalar tails run as well as their full
+	registers.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "SNova.h"
+#include "Verify.h"
+#include "Matrix3x4.h"
+#include "MatrixCompose.h"
+#include "QuatBatch.h"
+#include "QuatCompress.h"
+#include "QuatValue.h"
+#include "QuatSpline.h"
+#include "Vec3Stream.h"
+#include "Vector3DPacked.h"
+#include "Culling.h"
+#include "FastTrig.h"
+#include "SIMD.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace SNova
+{
+namespace Verify
+{
+
+namespace
+{
+	// One codec: the round trip stays within the documented angle error,
+	// the batch versions give the same bits as the single ones, Identity is exact
+	template <typename Code, typename Encode, typename Decode, typename EncodeN, typename DecodeN>
+	void CheckCodec(const std::vector<Quat>& quats, double maxDegrees, Encode encode, Decode decode, EncodeN encodeN, DecodeN decodeN)
+	{
+		const size_t n = quats.size();
+		std::vector<Code> codes(n);
+		std::vector<Quat> decoded(n);
+		encodeN(quats.data(), codes.data(), n);
+		decodeN(codes.data(), decoded.data(), n);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const Code code = encode(quats[i]);
+			const Quat single = decode(code);
+			SNOVA_CHECK(std::memcmp(&codes[i], &code, sizeof(Code)) == 0);
+			SNOVA_CHECK(decoded[i] == single);
+			SNOVA_CHECK(AngleDegrees(quats[i], single) <= maxDegrees);
+		}
+		SNOVA_CHECK(decode(encode(Quat::Identity)) == Quat::Identity);
+	}
+
+	// Dot(normal, p) + distance, the plane test of Culling.h
+	inline float PlaneDistance(const FrustumPlane& plane, const Vec3& p)
+	{
+		return plane.normal * p + plane.distance;
+	}
+
+	inline bool SameBits(const Quat& a, const QuatValue& b)
+	{
+		return std::memcmp(&a.w, &b.w, sizeof(float)) == 0 && std::memcmp(&a.x, &b.x, sizeof(float)) == 0
+			&& std::memcmp(&a.y, &b.y, sizeof(float)) == 0 && std::memcmp(&a.z, &b.z, sizeof(float)) == 0;
+	}
+
+	inline bool SameBits(const Vec3& a, const Vec3& b)
+	{
+		return std::memcmp(&a.x, &b.x, sizeof(float)) == 0 && std::memcmp(&a.y, &b.y, sizeof(float)) == 0
+			&& std::memcmp(&a.z, &b.z, sizeof(float)) == 0;
+	}
+
+	// Slerp (or nlerp) of unit quats along the shorter arc, in double
+	Quat ReferenceBlend(const Quat& a, const Quat& b, float t, bool linear)
+	{
+		const double dot = double{ a.w } * b.w + double{ a.x } * b.x + double{ a.y } * b.y + double{ a.z } * b.z;
+		const double sign = dot < 0.0 ? -1.0 : 1.0;
+		const double omega = std::acos(std::min(std::fabs(dot), 1.0));
+		double s0 = 1.0 - t, s1 = t;
+		if (!linear && omega > 1e-6)
+		{
+			s0 = std::sin((1.0 - t) * omega) / std::sin(omega);
+			s1 = std::sin(t * omega) / std::sin(omega);
+		}
+		s1 *= sign;
+		const double w = s0 * a.w + s1 * b.w, x = s0 * a.x + s1 * b.x, y = s0 * a.y + s1 * b.y, z = s0 * a.z + s1 * b.z;
+		const double length = std::sqrt(w * w + x * x + y * y + z * z);
+		return Quat{ static_cast<float>(w / length), static_cast<float>(x / length), static_cast<float>(y / length), static_cast<float>(z / length) };
+	}
+
+	inline float MaxComponentError(const Quat& q, const Quat& expected)
+	{
+		return Math::Max(Math::Max(Math::Abs(q.w - expected.w), Math::Abs(q.x - expected.x)),
+			Math::Max(Math::Abs(q.y - expected.y), Math::Abs(q.z - expected.z)));
+	}
+
+	// One trig tier, scalar and SIMD::Wide lanes, against double precision.
+	// Angles span the few thousand radians FastTrig.h covers; inverse
+	// inputs go past [-1, 1] to hit the clamp
+	template <Math::TrigAccuracy A>
+	void CheckTrigTier(float maxError)
+	{
+		using Lane = SIMD::Wide;
+		Random random;
+		std::vector<float> angles, cosines, ys, xs;
+		for (size_t i = 0; i < CHECK_COUNT; ++i)
+		{
+			angles.push_back(i % 2 ? random.Between(-3000.f, 3000.f) : random.Between(-7.f, 7.f));
+			cosines.push_back(random.Between(-1.1f, 1.1f));
+			ys.push_back(random.Vector().x);
+			xs.push_back(random.Vector().y);
+		}
+		angles.insert(angles.end(), { 0.f, 1.57079632f, -1.57079632f, 3.14159265f, -3.14159265f });
+		cosines.insert(cosines.end(), { -1.f, -0.f, 0.f, 1.f, 0.5f });
+		ys.insert(ys.end(), { 0.f, 0.f, 1.f, -1.f, 0.f });
+		xs.insert(xs.end(), { 0.f, -1.f, 0.f, 0.f, 2.f });
+		const size_t count = angles.size() / Lane::Width * Lane::Width;
+
+		std::vector<float> laneSin(count), laneCos(count), laneSinOnly(count), laneAcos(count), laneAtan2(count);
+		for (size_t i = 0; i < count; i += Lane::Width)
+		{
+			Lane s, c;
+			SIMD::SinCos<A>(Lane::Load(&angles[i]), s, c);
+			s.Store(&laneSin[i]);
+			c.Store(&laneCos[i]);
+			SIMD::Sin<A>(Lane::Load(&angles[i])).Store(&laneSinOnly[i]);
+			SIMD::Acos<A>(Lane::Load(&cosines[i])).Store(&laneAcos[i]);
+			SIMD::Atan2<A>(Lane::Load(&ys[i]), Lane::Load(&xs[i])).Store(&laneAtan2[i]);
+		}
+
+		for (size_t i = 0; i < angles.size(); ++i)
+		{
+			const double angle = angles[i];
+			const double clamped = std::min(std::max(double{ cosines[i] }, -1.0), 1.0);
+			const double sinD = std::sin(angle), cosD = std::cos(angle);
+			const double acosD = std::acos(clamped), asinD = std::asin(clamped);
+			const double atan2D = (ys[i] == 0.f && xs[i] == 0.f) ? 0.0 : std::atan2(double{ ys[i] }, double{ xs[i] });
+
+			float s, c;
+			Math::SinCos<A>(angles[i], s, c);
+			SNOVA_CHECK(s == Math::Sin<A>(angles[i]) && c == Math::Cos<A>(angles[i]));
+			SNOVA_CHECK(std::fabs(s - sinD) <= maxError && std::fabs(c - cosD) <= maxError);
+			SNOVA_CHECK(std::fabs(Math::Acos<A>(cosines[i]) - acosD) <= maxError);
+			SNOVA_CHECK(std::fabs(Math::Asin<A>(cosines[i]) - asinD) <= maxError);
+			SNOVA_CHECK(std::fabs(Math::Atan2<A>(ys[i], xs[i]) - atan2D) <= maxError);
+			SNOVA_CHECK(std::fabs(Math::Atan<A>(ys[i]) - std::atan(double{ ys[i] })) <= maxError);
+			if (A == Math::TrigAccuracy::Exact)
+				SNOVA_CHECK(s == Math::ExactTrig::Sin(angles[i]) && Math::Acos<A>(cosines[i]) == Math::ExactTrig::Acos(static_cast<float>(clamped)));
+
+			if (i >= count)
+				continue;
+			SNOVA_CHECK(std::fabs(laneSin[i] - sinD) <= maxError && std::fabs(laneCos[i] - cosD) <= maxError);
+			SNOVA_CHECK(laneSinOnly[i] == laneSin[i] || A == Math::TrigAccuracy::Exact);
+			SNOVA_CHECK(std::fabs(laneSinOnly[i] - sinD) <= maxError);
+			SNOVA_CHECK(std::fabs(laneAcos[i] - acosD) <= maxError && std::fabs(laneAtan2[i] - atan2D) <= maxError);
+		}
+	}
+
+	// One tier's lane functions give the same bits on SIMD::Wide as on
+	// SIMD::Scalar, lane by lane
+	template <Math::TrigAccuracy A>
+	void CheckLanesMatch(const std::vector<float>& angles, const std::vector<float>& cosines,
+		const std::vector<float>& ys, const std::vector<float>& xs)
+	{
+		using Lane = SIMD::Wide;
+		const size_t count = angles.size() / Lane::Width * Lane::Width;
+		std::vector<float> wide(4 * count);
+		for (size_t i = 0; i < count; i += Lane::Width)
+		{
+			Lane s, c;
+			SIMD::SinCos<A>(Lane::Load(&angles[i]), s, c);
+			s.Store(&wide[i]);
+			c.Store(&wide[count + i]);
+			SIMD::Acos<A>(Lane::Load(&cosines[i])).Store(&wide[2 * count + i]);
+			SIMD::Atan2<A>(Lane::Load(&ys[i]), Lane::Load(&xs[i])).Store(&wide[3 * count + i]);
+		}
+		for (size_t i = 0; i < count; ++i)
+		{
+			SIMD::Scalar s, c;
+			SIMD::SinCos<A>(SIMD::Scalar::Set(angles[i]), s, c);
+			const float scalar[4] = { s.v, c.v, SIMD::Acos<A>(SIMD::Scalar::Set(cosines[i])).v,
+				SIMD::Atan2<A>(SIMD::Scalar::Set(ys[i]), SIMD::Scalar::Set(xs[i])).v };
+			for (size_t k = 0; k < 4; ++k)
+				SNOVA_CHECK(std::memcmp(&wide[k * count + i], &scalar[k], sizeof(float)) == 0);
+		}
+	}
+
+	inline bool SameBits(const Quat& a, const Quat& b)
+	{
+		return std::memcmp(&a.w, &b.w, sizeof(float)) == 0 && std::memcmp(&a.x, &b.x, sizeof(float)) == 0
+			&& std::memcmp(&a.y, &b.y, sizeof(float)) == 0 && std::memcmp(&a.z, &b.z, sizeof(float)) == 0;
+	}
+
+	// Fixed orientations baked at compile time, the way Quat.h suggests
+	constexpr Quat FLIP_Y = Quat::MakeFromAxisAngleConstexpr(Vec3{ 0.f, 1.f, 0.f }, PI);
+	constexpr Quat MOUNT = Quat::MakeFromEulerConstexpr(10.f, -35.f, 90.f);
+	static_assert(FLIP_Y.IsNormalized() && MOUNT.IsNormalized(), "Constexpr factories must give unit quats");
+	static_assert((FLIP_Y * FLIP_Y).Equals(-Quat::Identity, 1e-6f), "Two half turns must make a full turn");
+	static_assert((MOUNT * MOUNT.Inverse()).Equals(Quat::Identity, 1e-6f), "Inverse must undo the rotation");
+	static_assert(Vec3{ 1.f, 2.f, 3.f } * Vec3{ 4.f, 5.f, 6.f } == 32.f, "Vector3D dot must stay constexpr");
+	static_assert((Vec3{ 1.f, 2.f, 3.f } - Vec3{ 1.f, 2.f, 3.f } * 2.f).y == -2.f, "Vector3D arithmetic must stay constexpr");
+
+	// cos/sin of half the angle about the remapped axis, as Quat(Vec3, float), in double
+	Quat ReferenceAxisAngle(const Vec3& axis, float angle)
+	{
+		const double s = std::sin(0.5 * angle), c = std::cos(0.5 * angle);
+		return Quat{ static_cast<float>(c), static_cast<float>(s * -axis.z), static_cast<float>(s * -axis.x), static_cast<float>(s * axis.y) };
+	}
+
+	// Rotator::Quaternion's formula, in double
+	Quat ReferenceEuler(float pitch, float yaw, float roll)
+	{
+		const double halfRad = 3.14159265358979323846 / 360.0;
+		const double SP = std::sin(pitch * halfRad), CP = std::cos(pitch * halfRad);
+		const double SY = std::sin(yaw * halfRad), CY = std::cos(yaw * halfRad);
+		const double SR = std::sin(roll * halfRad), CR = std::cos(roll * halfRad);
+		return Quat{
+			static_cast<float>(CR * CP * CY + SR * SP * SY),
+			static_cast<float>(CR * SP * SY - SR * CP * CY),
+			static_cast<float>(-CR * SP * CY - SR * CP * SY),
+			static_cast<float>(CR * CP * SY - SR * SP * CY) };
+	}
+
+	// Quat::RotateVector's result for unit q, in double
+	Vec3 ReferenceRotate(const Quat& q, const Vec3& v)
+	{
+		const double w = q.w, x = q.x, y = q.y, z = q.z;
+		const double tx = 2.0 * (y * v.z - z * v.y), ty = 2.0 * (z * v.x - x * v.z), tz = 2.0 * (x * v.y - y * v.x);
+		return Vec3{
+			static_cast<float>(v.x + w * tx + (y * tz - z * ty)),
+			static_cast<float>(v.y + w * ty + (z * tx - x * tz)),
+			static_cast<float>(v.z + w * tz + (x * ty - y * tx)) };
+	}
+
+	// Largest component difference of a double or Fixed quaternion / vector
+	// from a float one, in double
+	template <typename T>
+	double MaxComponentError(const TQuat<T>& q, const Quat& expected)
+	{
+		return std::max(std::max(std::fabs(double(q.w) - expected.w), std::fabs(double(q.x) - expected.x)),
+			std::max(std::fabs(double(q.y) - expected.y), std::fabs(double(q.z) - expected.z)));
+	}
+
+	template <typename T>
+	double MaxComponentError(const TVector3<T>& v, const Vec3& expected)
+	{
+		return std::max(std::max(std::fabs(double(v.x) - expected.x), std::fabs(double(v.y) - expected.y)),
+			std::fabs(double(v.z) - expected.z));
+	}
+
+	// Hamilton product of float quats, in double
+	Quat ReferenceProduct(const Quat& a, const Quat& b)
+	{
+		const double aw = a.w, ax = a.x, ay = a.y, az = a.z;
+		return Quat{
+			static_cast<float>(aw * b.w - ax * b.x - ay * b.y - az * b.z),
+			static_cast<float>(aw * b.x + ax * b.w + ay * b.z - az * b.y),
+			static_cast<float>(aw * b.y - ax * b.z + ay * b.w + az * b.x),
+			static_cast<float>(aw * b.z + ax * b.y - ay * b.x + az * b.w) };
+	}
+
+	// One scalar type's TQuat operations against the float ones done in
+	// double: quaternion components within quatError, rotated vectors (up
+	// to 10 * sqrt(3) long) within vectorError
+	template <typename T>
+	void CheckScalarQuat(double quatError, double vectorError)
+	{
+		typedef TQuat<T> Q;
+		typedef TVector3<T> V;
+		Random random;
+		for (size_t i = 0; i < CHECK_COUNT; ++i)
+		{
+			const Quat a = random.Quaternion(), b = random.Quaternion();
+			const float t = random.Between(0.f, 1.f);
+			const Vec3 v = random.Vector();
+			Vec3 axis = random.Vector();
+			axis = axis * (1.f / std::sqrt(axis * axis));
+			const float angle = random.Between(-PI, PI);
+			const Q qa{ a }, qb{ b };
+
+			SNOVA_CHECK(MaxComponentError(qa * qb, ReferenceProduct(a, b)) <= quatError);
+			SNOVA_CHECK(MaxComponentError(Q::Slerp(qa, qb, T(t)), ReferenceBlend(a, b, t, false)) <= quatError);
+			SNOVA_CHECK(MaxComponentError(Q::Nlerp(qa, qb, T(t)), ReferenceBlend(a, b, t, true)) <= quatError);
+			SNOVA_CHECK(MaxComponentError(Q{ V{ axis }, T(angle) }, ReferenceAxisAngle(axis, angle)) <= quatError);
+			SNOVA_CHECK(MaxComponentError(qa.RotateVector(V{ v }), ReferenceRotate(a, v)) <= vectorError);
+			SNOVA_CHECK(MaxComponentError(qa.ToMatrix() * V{ v }, ReferenceRotate(a, v)) <= vectorError);
+			// Two rotations, each within vectorError
+			const Q unit = qa.GetNormalized();
+			SNOVA_CHECK(MaxComponentError(unit.UnrotateVector(unit.RotateVector(V{ v })), v) <= 2.0 * vectorError);
+		}
+	}
+
+	inline Vec3 TransformPoint(const Mtx44& m, const Vec3& p)
+	{
+		return Vec3{
+			m.m2[0][0] * p.x + m.m2[0][1] * p.y + m.m2[0][2] * p.z + m.m2[0][3],
+			m.m2[1][0] * p.x + m.m2[1][1] * p.y + m.m2[1][2] * p.z + m.m2[1][3],
+			m.m2[2][0] * p.x + m.m2[2][1] * p.y + m.m2[2][2] * p.z + m.m2[2][3] };
+	}
+}
+
+/////////////////////////////////////////////////////
+// Fused TRS composition
+
+// Mtx44ComposeTRS against T * (R * S), and ComposeTRSN against Mtx44ComposeTRS
+void CheckComposeTRS()
+{
+	Random random;
+	std::vector<Vec3> t, s;
+	std::vector<Quat> q;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		t.push_back(random.Vector());
+		q.push_back(random.Quaternion());
+		s.push_back(random.Vector());
+	}
+	// Gimbal lock poles
+	q[0] = Quat{ 0.70710678f, 0.f, 0.70710678f, 0.f };
+	q[1] = Quat{ 0.70710678f, 0.f, -0.70710678f, 0.f };
+
+	std::vector<Matrix3x4> batch(CHECK_COUNT);
+	ComposeTRSN(t.data(), q.data(), s.data(), batch.data(), CHECK_COUNT);
+
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		Mtx44 rotMtx{ q[i].ToMatrix3x3() }, scaleMtx, transMtx;
+		Mtx44Scale(scaleMtx, s[i].x, s[i].y, s[i].z);
+		Mtx44Translate(transMtx, t[i].x, t[i].y, t[i].z);
+		const Mtx44 expected = transMtx * (rotMtx * scaleMtx);
+
+		Mtx44 composed;
+		Mtx44ComposeTRS(composed, t[i], q[i], s[i]);
+		for (int r = 0; r < 4; ++r)
+			for (int c = 0; c < 4; ++c)
+				SNOVA_CHECK(Near(composed.m2[r][c], expected.m2[r][c], 1e-6f));
+
+		// FMA in the batch kernel moves the last bits
+		for (int r = 0; r < 3; ++r)
+			for (int c = 0; c < 4; ++c)
+				SNOVA_CHECK(Near(batch[i].m2[r][c], composed.m2[r][c], 1e-5f));
+	}
+}
+
+/////////////////////////////////////////////////////
+// Matrix3x4 and Matrix3x3
+
+// Matrix3x4 and Matrix3x3 products, transpose and inverse against the
+// element formulas, and the batch transforms against TransformPoint
+void CheckMatrices()
+{
+	Random random;
+	std::vector<Vec3> points, transformed(CHECK_COUNT), rotated(CHECK_COUNT);
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+		points.push_back(random.Vector());
+
+	const Matrix3x4 m = Matrix3x4::FromTRS(random.Vector(), random.Quaternion(), Vec3{ 2.f, 0.5f, 1.5f });
+	const Matrix3x4 other = Matrix3x4::FromTRS(random.Vector(), random.Quaternion(), Vec3{ 1.f, 3.f, 0.25f });
+	TransformPoints(m, points.data(), transformed.data(), CHECK_COUNT);
+	const Matrix3x3 linear = random.Matrix(), rhs = random.Matrix();
+	Mtx33MultiplyN(linear, points.data(), rotated.data(), CHECK_COUNT);
+
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const Vec3 expected = m.TransformPoint(points[i]);
+		SNOVA_CHECK(Near(transformed[i].x, expected.x, 1e-5f) && Near(transformed[i].y, expected.y, 1e-5f) && Near(transformed[i].z, expected.z, 1e-5f));
+
+		const Vec3 product = linear * points[i];
+		SNOVA_CHECK(Near(rotated[i].x, product.x, 1e-5f) && Near(rotated[i].y, product.y, 1e-5f) && Near(rotated[i].z, product.z, 1e-5f));
+
+		// (m * other) p == m (other p)
+		const Vec3 composed = (m * other).TransformPoint(points[i]);
+		const Vec3 chained = m.TransformPoint(other.TransformPoint(points[i]));
+		SNOVA_CHECK(Near(composed.x, chained.x, 1e-4f) && Near(composed.y, chained.y, 1e-4f) && Near(composed.z, chained.z, 1e-4f));
+	}
+
+	const Matrix3x3 product = linear * rhs;
+	const Matrix3x4 identity = m.GetInverse() * m;
+	const Matrix3x4 rigid = Matrix3x4::FromTRS(random.Vector(), random.Quaternion(), Vec3{ 1.f, 1.f, 1.f });
+	const Matrix3x4 rigidIdentity = rigid.GetInverseRigid() * rigid;
+	const Matrix3x4 transpose = m.GetTranspose();
+	for (int r = 0; r < 3; ++r)
+	{
+		for (int c = 0; c < 3; ++c)
+		{
+			const float sum = linear.m2[r][0] * rhs.m2[0][c] + linear.m2[r][1] * rhs.m2[1][c] + linear.m2[r][2] * rhs.m2[2][c];
+			SNOVA_CHECK(Near(product.m2[r][c], sum, 1e-5f));
+			SNOVA_CHECK(transpose.m2[r][c] == m.m2[c][r]);
+		}
+		SNOVA_CHECK(transpose.m2[r][3] == 0.f);
+
+		for (int c = 0; c < 4; ++c)
+		{
+			SNOVA_CHECK(Near(identity.m2[r][c], r == c ? 1.f : 0.f, 1e-5f));
+			SNOVA_CHECK(Near(rigidIdentity.m2[r][c], r == c ? 1.f : 0.f, 1e-5f));
+		}
+	}
+
+	// Singular linear part: unchanged, like Mtx33Inverse
+	const Matrix3x4 singular{ Matrix3x3{ 1.f, 2.f, 3.f, 2.f, 4.f, 6.f, 0.f, 0.f, 1.f }, Vec3{ 1.f, 2.f, 3.f } };
+	const Matrix3x4 notInverted = singular.GetInverse();
+	for (int r = 0; r < 3; ++r)
+		for (int c = 0; c < 4; ++c)
+			SNOVA_CHECK(notInverted.m2[r][c] == singular.m2[r][c]);
+}
+
+/////////////////////////////////////////////////////
+// Bulk vector rotation
+
+// Bulk RotateVectors/UnrotateVectors against RotateVector/UnrotateVector,
+// over arrays, interleaved floats (rotated in place) and Vec3Batch
+void CheckRotateVectors()
+{
+	Random random;
+	const Quat q = ExactUnit(random.Quaternion());
+
+	// 5 floats per element: the vector, then 2 floats that must survive
+	static constexpr size_t STRIDE_FLOATS = 5;
+	std::vector<Vec3> in, rotated(CHECK_COUNT), unrotated(CHECK_COUNT);
+	std::vector<float> interleaved(CHECK_COUNT * STRIDE_FLOATS);
+	QuatBatch quats(CHECK_COUNT);
+	Vec3Batch vectors, batchRotated;
+	vectors.Resize(CHECK_COUNT);
+	batchRotated.Resize(CHECK_COUNT);
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		in.push_back(random.Vector());
+		float* element = &interleaved[i * STRIDE_FLOATS];
+		element[0] = in[i].x; element[1] = in[i].y; element[2] = in[i].z;
+		element[3] = element[4] = static_cast<float>(i);
+		quats.Set(i, random.Quaternion());
+		vectors.Set(i, in[i]);
+	}
+
+	q.RotateVectors(in.data(), rotated.data(), CHECK_COUNT);
+	q.UnrotateVectors(rotated.data(), unrotated.data(), CHECK_COUNT);
+	q.RotateVectors(interleaved.data(), STRIDE_FLOATS * sizeof(float), interleaved.data(), STRIDE_FLOATS * sizeof(float), CHECK_COUNT);
+	quats.RotateVectors(vectors, batchRotated);
+
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const Vec3 expected = q.RotateVector(in[i]);
+		SNOVA_CHECK(Near(rotated[i].x, expected.x, 1e-5f) && Near(rotated[i].y, expected.y, 1e-5f) && Near(rotated[i].z, expected.z, 1e-5f));
+		SNOVA_CHECK(Near(unrotated[i].x, in[i].x, 1e-5f) && Near(unrotated[i].y, in[i].y, 1e-5f) && Near(unrotated[i].z, in[i].z, 1e-5f));
+
+		const float* element = &interleaved[i * STRIDE_FLOATS];
+		SNOVA_CHECK(Near(element[0], expected.x, 1e-5f) && Near(element[1], expected.y, 1e-5f) && Near(element[2], expected.z, 1e-5f));
+		SNOVA_CHECK(element[3] == static_cast<float>(i) && element[4] == static_cast<float>(i));
+
+		const Vec3 each = quats.Get(i).RotateVector(in[i]);
+		const Vec3 batch = batchRotated.Get(i);
+		SNOVA_CHECK(Near(batch.x, each.x, 1e-5f) && Near(batch.y, each.y, 1e-5f) && Near(batch.z, each.z, 1e-5f));
+	}
+}
+
+// Rotator's bulk versions against Matrix() * v and UnrotateVector, for
+// every count up to two SIMD widths (the tails) and CHECK_COUNT. The
+// strided input and output have different strides; the floats between
+// elements and past the last one must be left alone
+void CheckRotatorVectors()
+{
+	Random random;
+	const Rotator r = random.Angles();
+	const Matrix3x3 m = r.Matrix();
+
+	static constexpr size_t IN_FLOATS = 5, OUT_FLOATS = 4;
+	static constexpr float UNTOUCHED = -7.f;
+	const size_t counts[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 15, 16, 17, CHECK_COUNT };
+
+	for (size_t n : counts)
+	{
+		std::vector<Vec3> in, rotated(n), unrotated(n);
+		std::vector<float> strided(n * IN_FLOATS), stridedRotated(n * OUT_FLOATS + 1, UNTOUCHED), stridedUnrotated(n * OUT_FLOATS + 1, UNTOUCHED);
+		for (size_t i = 0; i < n; ++i)
+		{
+			in.push_back(random.Vector());
+			float* element = &strided[i * IN_FLOATS];
+			element[0] = in[i].x; element[1] = in[i].y; element[2] = in[i].z;
+			element[3] = element[4] = static_cast<float>(i);
+		}
+
+		r.RotateVectors(in.data(), rotated.data(), n);
+		r.UnrotateVectors(in.data(), unrotated.data(), n);
+		r.RotateVectors(strided.data(), IN_FLOATS * sizeof(float), stridedRotated.data(), OUT_FLOATS * sizeof(float), n);
+		r.UnrotateVectors(strided.data(), IN_FLOATS * sizeof(float), stridedUnrotated.data(), OUT_FLOATS * sizeof(float), n);
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const Vec3 expected = m * in[i];
+			const Vec3 expectedInverse = r.UnrotateVector(in[i]);
+			SNOVA_CHECK(Near(rotated[i].x, expected.x, 1e-5f) && Near(rotated[i].y, expected.y, 1e-5f) && Near(rotated[i].z, expected.z, 1e-5f));
+			SNOVA_CHECK(Near(unrotated[i].x, expectedInverse.x, 1e-5f) && Near(unrotated[i].y, expectedInverse.y, 1e-5f) && Near(unrotated[i].z, expectedInverse.z, 1e-5f));
+
+			const float* out = &stridedRotated[i * OUT_FLOATS];
+			const float* outInverse = &stridedUnrotated[i * OUT_FLOATS];
+			SNOVA_CHECK(Near(out[0], expected.x, 1e-5f) && Near(out[1], expected.y, 1e-5f) && Near(out[2], expected.z, 1e-5f) && out[3] == UNTOUCHED);
+			SNOVA_CHECK(Near(outInverse[0], expectedInverse.x, 1e-5f) && Near(outInverse[1], expectedInverse.y, 1e-5f) && Near(outInverse[2], expectedInverse.z, 1e-5f) && outInverse[3] == UNTOUCHED);
+		}
+		SNOVA_CHECK(stridedRotated.back() == UNTOUCHED && stridedUnrotated.back() == UNTOUCHED);
+	}
+}
+
+/////////////////////////////////////////////////////
+// Quaternion batches
+
+// QuatBatch's element-wise operations against the single Quat ones,
+// including the aliased outputs, the Identity fallbacks of Normalize and
+// Inverse, and the elements Resize keeps and adds
+void CheckQuatBatch()
+{
+	Random random;
+	QuatBatch a(CHECK_COUNT), b(CHECK_COUNT);
+	Vec3Batch vectors(CHECK_COUNT), unrotated(CHECK_COUNT);
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		a.Set(i, random.Quaternion());
+		b.Set(i, random.Quaternion());
+		vectors.Set(i, random.Vector());
+	}
+	// Too small to normalize, and far from unit (no inverse)
+	a.Set(3, Quat{ 1e-5f, 0.f, 0.f, 0.f });
+	a.Set(4, Quat{ 2.f, 0.f, 1.f, 0.f });
+
+	const QuatBatch product = a * b;
+	std::vector<float> dots(CHECK_COUNT);
+	a.Dot(b, dots.data());
+	QuatBatch inverse(CHECK_COUNT);
+	a.Inverse(inverse);
+	b.UnrotateVectors(vectors, unrotated);
+	QuatBatch normalized = a;
+	normalized.Normalize();
+
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const Quat qa = a.Get(i), qb = b.Get(i);
+		const Quat expected = qa * qb;
+		const Quat got = product.Get(i);
+		SNOVA_CHECK(Near(got.w, expected.w, 1e-6f) && Near(got.x, expected.x, 1e-6f) && Near(got.y, expected.y, 1e-6f) && Near(got.z, expected.z, 1e-6f));
+		SNOVA_CHECK(Near(dots[i], qa | qb, 1e-6f));
+		SNOVA_CHECK(inverse.Get(i) == qa.Inverse());
+		SNOVA_CHECK(NearVec(unrotated.Get(i), qb.UnrotateVector(vectors.Get(i)), 1e-5f));
+
+		const Quat unit = normalized.Get(i);
+		if (i == 3)
+			SNOVA_CHECK(unit == Quat::Identity);
+		else
+			SNOVA_CHECK(Near(unit | unit, 1.f, 1e-5f) && SameRotation(unit, qa));
+	}
+	SNOVA_CHECK(inverse.Get(4) == Quat::Identity);
+
+	// out aliasing an input
+	QuatBatch aliased = a;
+	QuatBatch::Multiply(aliased, b, aliased);
+	SNOVA_CHECK(std::memcmp(aliased.w, product.w, CHECK_COUNT * sizeof(float)) == 0);
+	SNOVA_CHECK(std::memcmp(aliased.z, product.z, CHECK_COUNT * sizeof(float)) == 0);
+	b.UnrotateVectors(vectors, vectors);
+	SNOVA_CHECK(std::memcmp(vectors.x, unrotated.x, CHECK_COUNT * sizeof(float)) == 0);
+
+	// Copies are deep, moves take the buffer, Resize keeps and adds Identity
+	QuatBatch moved = std::move(aliased);
+	SNOVA_CHECK(moved.Size() == CHECK_COUNT && aliased.Size() == 0 && moved.Get(7) == product.Get(7));
+	normalized.Set(0, Quat::Identity);
+	SNOVA_CHECK(a.Get(0) != Quat::Identity);
+	moved.Resize(CHECK_COUNT + 5);
+	SNOVA_CHECK(moved.Get(CHECK_COUNT - 1) == product.Get(CHECK_COUNT - 1));
+	for (size_t i = CHECK_COUNT; i < moved.Size(); ++i)
+		SNOVA_CHECK(moved.Get(i) == Quat::Identity);
+	moved.Resize(2);
+	SNOVA_CHECK(moved.Size() == 2 && moved.Get(1) == product.Get(1));
+}
+
+/////////////////////////////////////////////////////
+// Quaternion values
+
+// QuatValue gives the same bits as Quat for every operation they share,
+// and an array of them copies exactly as plain bytes
+void CheckQuatValue()
+{
+	static_assert((QuatValue::Identity * QuatValue{ 0.f, 1.f, 0.f, 0.f }).x == 1.f, "QuatValue must stay constexpr");
+
+	Random random;
+	std::vector<QuatValue> values;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const Quat qa = random.Quaternion(), qb = random.Quaternion();
+		const QuatValue a{ qa }, b{ qb };
+		const Vec3 v = random.Vector();
+		const float t = random.Between(0.f, 1.f);
+		values.push_back(a);
+
+		SNOVA_CHECK(SameBits(qa * qb, a * b) && SameBits(qa + qb, a + b) && SameBits(qa - qb, a - b));
+		SNOVA_CHECK(SameBits(qa * t, a * t) && SameBits(qa.Conjugate(), a.Conjugate()) && SameBits(qa.Inverse(), a.Inverse()));
+		SNOVA_CHECK((qa | qb) == (a | b) && qa.SizeSquared() == a.SizeSquared());
+		SNOVA_CHECK(SameBits(Quat{ qa }.GetNormalized(), a.GetNormalized()));
+		SNOVA_CHECK(SameBits(qa.RotateVector(v), a.RotateVector(v)) && SameBits(qa.UnrotateVector(v), a.UnrotateVector(v)));
+		SNOVA_CHECK(SameBits(qa.GetAxisX(), a.GetAxisX()) && SameBits(qa.GetAxisY(), a.GetAxisY()) && SameBits(qa.GetAxisZ(), a.GetAxisZ()));
+		SNOVA_CHECK(qa.GetAngle() == a.GetAngle() && qa.AngularDistance(qb) == a.AngularDistance(b));
+		SNOVA_CHECK(qa.GetRotator() == a.GetRotator());
+		SNOVA_CHECK(SameBits(Quat::Slerp(qa, qb, t), QuatValue::Slerp(a, b, t)));
+
+		QuatValue shortest = a;
+		Quat shortestQuat = qa;
+		shortest.EnforceShortestArcWith(b);
+		shortestQuat.EnforceShortestArcWith(qb);
+		SNOVA_CHECK(SameBits(shortestQuat, shortest));
+
+		const Matrix3x3 m = qa.ToMatrix3x3(), mv = a.ToMatrix3x3();
+		SNOVA_CHECK(std::memcmp(&m, &mv, sizeof(Matrix3x3)) == 0);
+	}
+	QuatValue tiny{ 1e-5f, 0.f, 0.f, 0.f };
+	tiny.Normalize();
+	const QuatValue notUnit{ 2.f, 0.f, 0.f, 0.f };
+	SNOVA_CHECK(tiny == QuatValue::Identity && notUnit.Inverse() == QuatValue::Identity);
+
+	// Plain bytes: copies are exact and write back nowhere
+	std::vector<QuatValue> copied(values.size());
+	std::memcpy(copied.data(), values.data(), values.size() * sizeof(QuatValue));
+	SNOVA_CHECK(copied == values);
+}
+
+/////////////////////////////////////////////////////
+// Batched blending
+
+// SlerpN within the trig tier of an exact slerp, SlerpFastN within its
+// documented 1e-5 per component, NlerpN against a normalized lerp; every
+// one along the shorter arc, through its endpoints, and with the same
+// bits from the QuatBatch versions and an aliased output
+void CheckBlendN()
+{
+	Random random;
+	std::vector<Quat> a(CHECK_COUNT), b(CHECK_COUNT);
+	std::vector<float> t(CHECK_COUNT);
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		a[i] = ExactUnit(random.Quaternion());
+		b[i] = ExactUnit(random.Quaternion());
+		t[i] = random.Between(0.f, 1.f);
+	}
+	// Endpoints, nearly equal, equal, and nearly opposite inputs
+	t[0] = 0.f;
+	t[1] = 1.f;
+	b[2] = ExactUnit(a[2] * Quat{ Vec3{ 0.f, 1.f, 0.f }, 1e-3f });
+	b[3] = a[3];
+	b[4] = ExactUnit(-(a[4] * Quat{ Vec3{ 1.f, 0.f, 0.f }, 0.05f }));
+	b[5] = ExactUnit(a[5] * Quat{ Vec3{ 0.f, 0.f, 1.f }, 3.1f });
+
+	std::vector<Quat> slerp(CHECK_COUNT), nlerp(CHECK_COUNT), fast(CHECK_COUNT);
+	Quat::SlerpN(a.data(), b.data(), t.data(), slerp.data(), CHECK_COUNT);
+	Quat::NlerpN(a.data(), b.data(), t.data(), nlerp.data(), CHECK_COUNT);
+	Quat::SlerpFastN(a.data(), b.data(), t.data(), fast.data(), CHECK_COUNT);
+
+	// The weights' acos is the tier's; at Fast (~1e-4 rad) measured 0.0092 degrees
+	const double slerpDegrees = (Math::DEFAULT_TRIG_ACCURACY == Math::TrigAccuracy::Fast) ? 2e-2 : 1e-3;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const Quat exact = ReferenceBlend(a[i], b[i], t[i], false);
+		SNOVA_CHECK(AngleDegrees(slerp[i], exact) <= slerpDegrees);
+		SNOVA_CHECK(AngleDegrees(slerp[i], Quat::Slerp(a[i], b[i], t[i])) <= slerpDegrees);
+		SNOVA_CHECK(AngleDegrees(nlerp[i], ReferenceBlend(a[i], b[i], t[i], true)) <= 1e-4);
+		SNOVA_CHECK(MaxComponentError(fast[i], exact) <= 1e-5f);
+
+		// Unit length, and on the shorter arc: never further than 90 degrees from a
+		for (const Quat* blended : { &slerp[i], &nlerp[i], &fast[i] })
+			SNOVA_CHECK(Near(*blended | *blended, 1.f, 1e-5f) && (*blended | a[i]) >= 0.f);
+	}
+	for (const std::vector<Quat>* blended : { &slerp, &nlerp, &fast })
+	{
+		SNOVA_CHECK(SameRotation((*blended)[0], a[0]) && SameRotation((*blended)[1], b[1]));
+		SNOVA_CHECK(SameRotation((*blended)[3], a[3]));
+	}
+
+	// The QuatBatch versions run the same kernels
+	QuatBatch batchA(CHECK_COUNT), batchB(CHECK_COUNT), batchOut(CHECK_COUNT);
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		batchA.Set(i, a[i]);
+		batchB.Set(i, b[i]);
+	}
+	const auto sameAsBatch = [&](const std::vector<Quat>& quats)
+	{
+		for (size_t i = 0; i < CHECK_COUNT; ++i)
+			if (std::memcmp(&quats[i].w, &batchOut.w[i], sizeof(float)) != 0 || std::memcmp(&quats[i].z, &batchOut.z[i], sizeof(float)) != 0)
+				return false;
+		return true;
+	};
+	QuatBatch::Slerp(batchA, batchB, t.data(), batchOut);
+	SNOVA_CHECK(sameAsBatch(slerp));
+	QuatBatch::Nlerp(batchA, batchB, t.data(), batchOut);
+	SNOVA_CHECK(sameAsBatch(nlerp));
+	QuatBatch::SlerpFast(batchA, batchB, t.data(), batchOut);
+	SNOVA_CHECK(sameAsBatch(fast));
+
+	// out aliasing an input
+	std::vector<Quat> aliased = a;
+	Quat::SlerpN(aliased.data(), b.data(), t.data(), aliased.data(), CHECK_COUNT);
+	SNOVA_CHECK(std::equal(aliased.begin(), aliased.end(), slerp.begin()));
+	QuatBatch::SlerpFast(batchA, batchB, t.data(), batchA);
+	batchOut = batchA;
+	SNOVA_CHECK(sameAsBatch(fast));
+}
+
+/////////////////////////////////////////////////////
+// Trig tiers
+
+// Every tier within the error FastTrig.h documents for it, scalar and
+// lanes alike; SinCos4/8/N agree with the scalar SinCos at the default tier
+void CheckTrigTiers()
+{
+	CheckTrigTier<Math::TrigAccuracy::Exact>(1e-6f);
+	CheckTrigTier<Math::TrigAccuracy::High>(1e-6f);
+	CheckTrigTier<Math::TrigAccuracy::Fast>(1e-4f);
+
+	Random random;
+	std::vector<float> angles(CHECK_COUNT), sines(CHECK_COUNT), cosines(CHECK_COUNT);
+	for (float& angle : angles)
+		angle = random.Between(-100.f, 100.f);
+	Math::SinCosN(angles.data(), sines.data(), cosines.data(), CHECK_COUNT);
+	float sin4[4], cos4[4], sin8[8], cos8[8];
+	Math::SinCos4(angles.data(), sin4, cos4);
+	Math::SinCos8(angles.data(), sin8, cos8);
+	const float tolerance = (Math::DEFAULT_TRIG_ACCURACY == Math::TrigAccuracy::Fast) ? 2e-4f : 2e-6f;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		float s, c;
+		Math::SinCos(angles[i], s, c);
+		SNOVA_CHECK(Math::Abs(sines[i] - s) <= tolerance && Math::Abs(cosines[i] - c) <= tolerance);
+		if (i < 8)
+			SNOVA_CHECK(sin8[i] == sines[i] && cos8[i] == cosines[i]);
+		if (i < 4)
+			SNOVA_CHECK(sin4[i] == sines[i] && cos4[i] == cosines[i]);
+	}
+}
+
+/////////////////////////////////////////////////////
+// Deterministic math
+
+// DeterministicMath.h within float rounding of the C library's double
+// results. With SNOVA_DETERMINISTIC_MATH, the Exact tier runs it, and
+// every lane function and batch kernel gives the same bits on a full
+// SIMD::Wide register as on the SIMD::Scalar tail
+void CheckDeterministicMath()
+{
+	Random random;
+	std::vector<float> angles, cosines, ys, xs;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		angles.push_back(i % 2 ? random.Between(-3000.f, 3000.f) : random.Between(-7.f, 7.f));
+		cosines.push_back(random.Between(-1.f, 1.f));
+		ys.push_back(random.Vector().x);
+		xs.push_back(random.Vector().y);
+	}
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const double angle = angles[i];
+		float s, c;
+		Math::Deterministic::SinCos(angles[i], s, c);
+		SNOVA_CHECK(std::fabs(s - std::sin(angle)) <= 6e-8 && std::fabs(c - std::cos(angle)) <= 6e-8);
+		SNOVA_CHECK(std::fabs(Math::Deterministic::Acos(cosines[i]) - std::acos(double{ cosines[i] })) <= 2.4e-7);
+		SNOVA_CHECK(std::fabs(Math::Deterministic::Atan2(ys[i], xs[i]) - std::atan2(double{ ys[i] }, double{ xs[i] })) <= 2.4e-7);
+		SNOVA_CHECK(std::fabs(Math::Deterministic::Sin(angle) - std::sin(angle)) <= 1e-15);
+	}
+
+#if SNOVA_DETERMINISTIC_MATH
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		SNOVA_CHECK(Math::ExactTrig::Sin(angles[i]) == Math::Deterministic::Sin(angles[i]));
+		SNOVA_CHECK(Math::ExactTrig::Atan2(ys[i], xs[i]) == Math::Deterministic::Atan2(ys[i], xs[i]));
+	}
+	CheckLanesMatch<Math::TrigAccuracy::Exact>(angles, cosines, ys, xs);
+	CheckLanesMatch<Math::TrigAccuracy::High>(angles, cosines, ys, xs);
+	CheckLanesMatch<Math::TrigAccuracy::Fast>(angles, cosines, ys, xs);
+
+	// Each element run in the bulk of a batch, then alone as a batch of
+	// one, which only runs the scalar tail
+	QuatBatch a(CHECK_COUNT), b(CHECK_COUNT);
+	Vec3Batch vectors(CHECK_COUNT), from(CHECK_COUNT), to(CHECK_COUNT);
+	std::vector<float> t(CHECK_COUNT);
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		a.Set(i, random.Quaternion());
+		b.Set(i, random.Quaternion());
+		vectors.Set(i, random.Vector());
+		from.Set(i, random.Vector().Normalized());
+		to.Set(i, random.Vector().Normalized());
+		t[i] = random.Between(0.f, 1.f);
+	}
+	QuatBatch product(CHECK_COUNT), slerp(CHECK_COUNT), nlerp(CHECK_COUNT), slerpFast(CHECK_COUNT), between(CHECK_COUNT);
+	Vec3Batch rotated(CHECK_COUNT);
+	QuatBatch::Multiply(a, b, product);
+	QuatBatch normalized = product;
+	normalized.Normalize();
+	a.RotateVectors(vectors, rotated);
+	QuatBatch::Slerp(a, b, t.data(), slerp);
+	QuatBatch::Nlerp(a, b, t.data(), nlerp);
+	QuatBatch::SlerpFast(a, b, t.data(), slerpFast);
+	QuatBatch::FindBetweenNormals(from, to, between);
+
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		QuatBatch a1(1), b1(1), out(1);
+		Vec3Batch v1(1), from1(1), to1(1);
+		a1.Set(0, a.Get(i));
+		b1.Set(0, b.Get(i));
+		v1.Set(0, vectors.Get(i));
+		from1.Set(0, from.Get(i));
+		to1.Set(0, to.Get(i));
+
+		QuatBatch::Multiply(a1, b1, out);
+		SNOVA_CHECK(SameBits(out.Get(0), product.Get(i)));
+		out.Normalize();
+		SNOVA_CHECK(SameBits(out.Get(0), normalized.Get(i)));
+		a1.RotateVectors(v1, v1);
+		SNOVA_CHECK(SameBits(v1.Get(0), rotated.Get(i)));
+		QuatBatch::Slerp(a1, b1, &t[i], out);
+		SNOVA_CHECK(SameBits(out.Get(0), slerp.Get(i)));
+		QuatBatch::Nlerp(a1, b1, &t[i], out);
+		SNOVA_CHECK(SameBits(out.Get(0), nlerp.Get(i)));
+		QuatBatch::SlerpFast(a1, b1, &t[i], out);
+		SNOVA_CHECK(SameBits(out.Get(0), slerpFast.Get(i)));
+		QuatBatch::FindBetweenNormals(from1, to1, out);
+		SNOVA_CHECK(SameBits(out.Get(0), between.Get(i)));
+	}
+#endif
+}
+
+/////////////////////////////////////////////////////
+// Compile-time rotations
+
+// The constexpr factories and SinCosConstexpr are within float rounding of
+// double precision, give the same bits folded or run, and agree with the
+// runtime factories to the default trig tier's accuracy
+void CheckConstexprRotations()
+{
+	// volatile, so these run instead of being folded
+	volatile float pitch = 10.f, yaw = -35.f, roll = 90.f, half = PI;
+	const Quat mount = Quat::MakeFromEulerConstexpr(pitch, yaw, roll);
+	const Quat flip = Quat::MakeFromAxisAngleConstexpr(Vec3{ 0.f, 1.f, 0.f }, half);
+	SNOVA_CHECK(std::memcmp(&mount.w, &MOUNT.w, 4 * sizeof(float)) == 0);
+	SNOVA_CHECK(std::memcmp(&flip.w, &FLIP_Y.w, 4 * sizeof(float)) == 0);
+
+	const float runtimeTolerance = (Math::DEFAULT_TRIG_ACCURACY == Math::TrigAccuracy::Fast) ? 2e-4f : 2e-6f;
+	Random random;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const float angle = random.Between(-4.f * PI, 4.f * PI);
+		SNOVA_CHECK(std::fabs(Math::SinConstexpr(angle) - std::sin(double{ angle })) <= 1e-7);
+		SNOVA_CHECK(std::fabs(Math::CosConstexpr(angle) - std::cos(double{ angle })) <= 1e-7);
+
+		Vec3 axis = random.Vector();
+		axis = axis * (1.f / std::sqrt(axis * axis));
+		const Quat axisAngle = Quat::MakeFromAxisAngleConstexpr(axis, angle);
+		SNOVA_CHECK(MaxComponentError(axisAngle, ReferenceAxisAngle(axis, angle)) <= 4e-7f);
+		SNOVA_CHECK(MaxComponentError(axisAngle, Quat{ axis, angle }) <= runtimeTolerance);
+
+		const Rotator r = random.Angles();
+		const Quat euler = Quat::MakeFromEulerConstexpr(r.pitch, r.yaw, r.roll);
+		SNOVA_CHECK(MaxComponentError(euler, ReferenceEuler(r.pitch, r.yaw, r.roll)) <= 4e-7f);
+		SNOVA_CHECK(MaxComponentError(euler, Quat::MakeFromEuler(r.pitch, r.yaw, r.roll)) <= runtimeTolerance);
+	}
+}
+
+/////////////////////////////////////////////////////
+// Double and fixed-point types
+
+// TQuat<double> and TQuat<Fixed> within their precision of the float
+// operations done in double, conversions to and from float exact where
+// the scalar can hold the value, and Fixed's documented edge cases
+void CheckMathTypes()
+{
+	CheckScalarQuat<double>(1e-7, 1e-6);
+	CheckScalarQuat<Fixed>(1e-4, 1e-3);
+
+	Random random;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const Quat q = random.Quaternion();
+		const Vec3 v = random.Vector();
+		SNOVA_CHECK(SameBits(Quat(QuatD{ q }), QuatValue{ q }) && SameBits(Vec3d{ v }.ToVector3D(), v));
+	}
+
+	// Wrapping, division by zero, and the integer-only functions give the
+	// same raw values folded at compile time as run
+	SNOVA_CHECK(Fixed{ 32767 } + Fixed{ 1 } == Fixed{ -32768 });
+	SNOVA_CHECK((Fixed{ 1 } / Fixed{}).Raw() == INT32_MAX && (Fixed{ -1 } / Fixed{}).Raw() == INT32_MIN);
+	SNOVA_CHECK(Fixed::Sqrt(Fixed{ -4 }) == Fixed{} && Fixed::Atan2(Fixed{}, Fixed{}) == Fixed{});
+	constexpr Fixed SQRT2 = Fixed::Sqrt(Fixed{ 2 });
+	constexpr Fixed ATAN2 = Fixed::Atan2(Fixed{ -3 }, Fixed{ 5 });
+	constexpr Fixed LENGTH = Fixed::Length(Fixed{ 20000 }, Fixed{ 20000 }, Fixed{ 1 });
+	volatile int32_t two = Fixed{ 2 }.Raw(), three = Fixed{ 3 }.Raw(), five = Fixed{ 5 }.Raw();
+	SNOVA_CHECK(Fixed::Sqrt(Fixed::FromRaw(two)) == SQRT2 && Fixed::Atan2(-Fixed::FromRaw(three), Fixed::FromRaw(five)) == ATAN2);
+	SNOVA_CHECK(Fixed::Length(Fixed::FromRaw(two) * Fixed{ 10000 }, Fixed{ 20000 }, Fixed{ 1 }) == LENGTH);
+	SNOVA_CHECK(std::fabs(SQRT2.ToDouble() - std::sqrt(2.0)) <= 1.0 / Fixed::ONE_RAW);
+	SNOVA_CHECK(std::fabs(ATAN2.ToDouble() - std::atan2(-3.0, 5.0)) <= 1e-4);
+	SNOVA_CHECK(std::fabs(LENGTH.ToDouble() - std::sqrt(8e8 + 1.0)) <= 1.0 / Fixed::ONE_RAW);
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const float angle = random.Between(-4.f * PI, 4.f * PI);
+		Fixed s, c;
+		Fixed::SinCos(Fixed{ angle }, s, c);
+		SNOVA_CHECK(std::fabs(s.ToDouble() - std::sin(Fixed{ angle }.ToDouble())) <= 1e-4);
+		SNOVA_CHECK(std::fabs(c.ToDouble() - std::cos(Fixed{ angle }.ToDouble())) <= 1e-4);
+	}
+
+	// Past the ~181 where squares wrap, Magnitude and Normalize still work
+	Vec3x large{ Fixed{ 20000 }, Fixed{ -20000 }, Fixed{ 1 } };
+	SNOVA_CHECK(large.Magnitude() == LENGTH);
+	large.Normalize();
+	SNOVA_CHECK(MaxComponentError(large, Vec3{ 0.70710678f, -0.70710678f, 0.f }) <= 1e-4);
+}
+
+/////////////////////////////////////////////////////
+// Vec3 streams
+
+// Vec3Stream over the three layouts against the single-vector functions
+// of Vector3D.h. Vectors too small to normalize must come back unchanged
+void CheckVec3Stream()
+{
+	Random random;
+	std::vector<Vec3> a, b;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		a.push_back(random.Vector());
+		b.push_back(random.Vector());
+	}
+	a[0] = Vec3{ 0.f, 0.f, 0.f };
+	a[1] = Vec3{ 1e-20f, 0.f, 0.f };
+
+	std::vector<Vec3A> aA, bA;
+	Vec3Batch aB, bB;
+	aB.Resize(CHECK_COUNT);
+	bB.Resize(CHECK_COUNT);
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		aA.push_back(Vec3A{ a[i] });
+		bA.push_back(Vec3A{ b[i] });
+		aB.Set(i, a[i]);
+		bB.Set(i, b[i]);
+	}
+
+	std::vector<Vec3> sum(CHECK_COUNT), scaled(CHECK_COUNT), cross(CHECK_COUNT), unit(CHECK_COUNT);
+	std::vector<Vec3A> sumA(CHECK_COUNT), crossA(CHECK_COUNT), unitA(CHECK_COUNT);
+	Vec3Batch sumB, scaledB, crossB, unitB;
+	sumB.Resize(CHECK_COUNT);
+	scaledB.Resize(CHECK_COUNT);
+	crossB.Resize(CHECK_COUNT);
+	unitB.Resize(CHECK_COUNT);
+	std::vector<float> dot(CHECK_COUNT), dotA(CHECK_COUNT), dotB(CHECK_COUNT);
+	std::vector<float> distance(CHECK_COUNT), distanceA(CHECK_COUNT), distanceB(CHECK_COUNT);
+
+	Vec3Stream::Add(a.data(), b.data(), sum.data(), CHECK_COUNT);
+	Vec3Stream::Add(aA.data(), bA.data(), sumA.data(), CHECK_COUNT);
+	Vec3Stream::Add(aB, bB, sumB);
+	Vec3Stream::Scale(a.data(), 3.f, scaled.data(), CHECK_COUNT);
+	Vec3Stream::Scale(aB, 3.f, scaledB);
+	Vec3Stream::Dot(a.data(), b.data(), dot.data(), CHECK_COUNT);
+	Vec3Stream::Dot(aA.data(), bA.data(), dotA.data(), CHECK_COUNT);
+	Vec3Stream::Dot(aB, bB, dotB.data());
+	Vec3Stream::Cross(a.data(), b.data(), cross.data(), CHECK_COUNT);
+	Vec3Stream::Cross(aA.data(), bA.data(), crossA.data(), CHECK_COUNT);
+	Vec3Stream::Cross(aB, bB, crossB);
+	Vec3Stream::Normalize(a.data(), unit.data(), CHECK_COUNT);
+	Vec3Stream::Normalize(aA.data(), unitA.data(), CHECK_COUNT);
+	Vec3Stream::Normalize(aB, unitB);
+	Vec3Stream::DistanceSquared(a.data(), b.data(), distance.data(), CHECK_COUNT);
+	Vec3Stream::DistanceSquared(aA.data(), bA.data(), distanceA.data(), CHECK_COUNT);
+	Vec3Stream::DistanceSquared(aB, bB, distanceB.data());
+
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		Vec3 expectedUnit = a[i];
+		NormalizeVector3D(expectedUnit, a[i]);
+		const Vec3 expectedSum = a[i] + b[i], expectedCross = a[i] ^ b[i];
+		const float expectedDot = a[i] * b[i], expectedDistance = Vector3DDistanceSquared(a[i], b[i]);
+
+		SNOVA_CHECK(NearVec(sum[i], expectedSum, 1e-6f) && NearVec(Vec3{ sumA[i] }, expectedSum, 1e-6f) && NearVec(sumB.Get(i), expectedSum, 1e-6f));
+		SNOVA_CHECK(NearVec(scaled[i], a[i] * 3.f, 1e-6f) && NearVec(scaledB.Get(i), a[i] * 3.f, 1e-6f));
+		SNOVA_CHECK(Near(dot[i], expectedDot, 1e-5f) && Near(dotA[i], expectedDot, 1e-5f) && Near(dotB[i], expectedDot, 1e-5f));
+		SNOVA_CHECK(NearVec(cross[i], expectedCross, 1e-5f) && NearVec(Vec3{ crossA[i] }, expectedCross, 1e-5f) && NearVec(crossB.Get(i), expectedCross, 1e-5f));
+		SNOVA_CHECK(NearVec(unit[i], expectedUnit, 1e-6f) && NearVec(Vec3{ unitA[i] }, expectedUnit, 1e-6f) && NearVec(unitB.Get(i), expectedUnit, 1e-6f));
+		SNOVA_CHECK(Near(distance[i], expectedDistance, 1e-5f) && Near(distanceA[i], expectedDistance, 1e-5f) && Near(distanceB[i], expectedDistance, 1e-5f));
+	}
+	SNOVA_CHECK(unitB.Get(1).x == 1e-20f && Vec3{ unitA[1] }.x == 1e-20f);
+}
+
+/////////////////////////////////////////////////////
+// FindBetweenNormals and LookRotation
+
+// FindBetweenNormals turns from onto to, and opposite vectors give a
+// half turn about an axis perpendicular to from. LookRotation faces X
+// along forward with Y towards up. The batch versions match both
+void CheckFindBetween()
+{
+	Random random;
+	std::vector<Vec3> from, to, forward, up;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		from.push_back(random.Vector().Normalized());
+		to.push_back(random.Vector().Normalized());
+		forward.push_back(random.Vector());
+		up.push_back(random.Vector());
+	}
+
+	// Opposite pairs: the axes (which used to give Identity) and a random one
+	static constexpr size_t OPPOSITE = 4;
+	from[0] = Vec3{ 1.f, 0.f, 0.f };
+	from[1] = Vec3{ 0.f, 1.f, 0.f };
+	from[2] = Vec3{ 0.f, 0.f, 1.f };
+	for (size_t i = 0; i < OPPOSITE; ++i)
+		to[i] = -from[i];
+
+	std::vector<Quat> between(CHECK_COUNT), look(CHECK_COUNT), lookSharedUp(CHECK_COUNT);
+	Quat::FindBetweenNormalsN(from.data(), to.data(), between.data(), CHECK_COUNT);
+	Quat::LookRotationN(forward.data(), up.data(), look.data(), CHECK_COUNT);
+	Quat::LookRotationN(forward.data(), up[0], lookSharedUp.data(), CHECK_COUNT);
+
+	Vec3Batch fromB, toB, forwardB, upB;
+	fromB.Resize(CHECK_COUNT);
+	toB.Resize(CHECK_COUNT);
+	forwardB.Resize(CHECK_COUNT);
+	upB.Resize(CHECK_COUNT);
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		fromB.Set(i, from[i]);
+		toB.Set(i, to[i]);
+		forwardB.Set(i, forward[i]);
+		upB.Set(i, up[i]);
+	}
+	QuatBatch betweenB(CHECK_COUNT), lookB(CHECK_COUNT);
+	QuatBatch::FindBetweenNormals(fromB, toB, betweenB);
+	QuatBatch::LookRotation(forwardB, upB, lookB);
+
+	const Vec3 xAxis{ 1.f, 0.f, 0.f }, yAxis{ 0.f, 1.f, 0.f };
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const Quat q = Quat::FindBetweenNormals(from[i], to[i]);
+		SNOVA_CHECK(NearVec(ExactUnit(q).RotateVector(from[i]), to[i], 1e-4f));
+		if (i < OPPOSITE)
+		{
+			SNOVA_CHECK(Math::Abs(q.w) <= 1e-4f);
+			SNOVA_CHECK(Math::Abs(Vec3{ q.x, q.y, q.z } * from[i]) <= 1e-4f);
+		}
+		SNOVA_CHECK(SameRotation(between[i], q) && SameRotation(betweenB.Get(i), q));
+
+		const Quat l = Quat::LookRotation(forward[i], up[i]);
+		const Vec3 lookForward = ExactUnit(l).RotateVector(xAxis), lookUp = ExactUnit(l).RotateVector(yAxis);
+		SNOVA_CHECK(NearVec(lookForward, forward[i].Normalized(), 1e-4f));
+		SNOVA_CHECK(lookUp * up[i] >= -1e-4f);
+		SNOVA_CHECK(SameRotation(look[i], l) && SameRotation(lookB.Get(i), l));
+		SNOVA_CHECK(SameRotation(lookSharedUp[i], Quat::LookRotation(forward[i], up[0])));
+	}
+}
+
+/////////////////////////////////////////////////////
+// Quaternion codecs
+
+// Bounds are QuatCompress.h's measured worst cases, rounded up
+void CheckQuatCompress()
+{
+	Random random;
+	std::vector<Quat> quats;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+		quats.push_back(ExactUnit(random.Quaternion()));
+
+	CheckCodec<uint32_t>(quats, 0.49, CompressQuat29, DecompressQuat29, CompressQuats29, DecompressQuats29);
+	CheckCodec<uint32_t>(quats, 0.25, CompressQuat32, DecompressQuat32, CompressQuats32, DecompressQuats32);
+	CheckCodec<CompressedQuat48>(quats, 0.008, CompressQuat48, DecompressQuat48, CompressQuats48, DecompressQuats48);
+	CheckCodec<QuantizedQuat16>(quats, 0.0036, QuantizeQuat16, DequantizeQuat16, QuantizeQuats16, DequantizeQuats16);
+
+	// Transforms: positions within half a 16-bit step of the default range
+	static constexpr size_t TRANSFORMS = 67;
+	const TransformQuantizeRange range;
+	const float positionError = (range.positionMax.x - range.positionMin.x) / 131070.f + 1e-4f;
+	std::vector<Transform> transforms(TRANSFORMS), decoded(TRANSFORMS);
+	std::vector<const Transform*> in;
+	std::vector<Transform*> out;
+	for (size_t i = 0; i < TRANSFORMS; ++i)
+	{
+		transforms[i].SetPosition(random.Vector() * 50.f);
+		transforms[i].SetRotation(quats[i]);
+		transforms[i].SetScale(random.Between(0.5f, 4.f));
+		in.push_back(&transforms[i]);
+		out.push_back(&decoded[i]);
+	}
+
+	std::vector<QuantizedTransform> packed(TRANSFORMS);
+	QuantizeTransforms(in.data(), packed.data(), TRANSFORMS);
+	DequantizeTransforms(packed.data(), out.data(), TRANSFORMS);
+	for (size_t i = 0; i < TRANSFORMS; ++i)
+	{
+		const QuantizedTransform single = QuantizeTransform(transforms[i]);
+		SNOVA_CHECK(std::memcmp(&packed[i], &single, sizeof(single)) == 0);
+		const Vec3 error = decoded[i].GetPosition() - transforms[i].GetPosition();
+		SNOVA_CHECK(Math::Abs(error.x) <= positionError && Math::Abs(error.y) <= positionError && Math::Abs(error.z) <= positionError);
+		SNOVA_CHECK(AngleDegrees(decoded[i].GetRotation(), transforms[i].GetRotation()) <= 0.25);
+	}
+}
+
+/////////////////////////////////////////////////////
+// Angular velocity
+
+// Exp(Log(q)) == q, IntegrateAngularVelocity == q * Quat(axis, angle),
+// the first-order step within its documented error, and the batch
+// steppers against the single ones
+void CheckAngularVelocity()
+{
+	static constexpr float DT = 1.f / 120.f;
+
+	Random random;
+	std::vector<Quat> quats;
+	std::vector<Vec3> omega;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		quats.push_back(ExactUnit(random.Quaternion()));
+		omega.push_back(random.Vector());
+	}
+	quats[0] = Quat::Identity;
+	omega[0] = Vec3{ 0.f, 0.f, 0.f };
+
+	AngularIntegration exact, firstOrder;
+	exact.method = AngularIntegration::Method::Exact;
+	std::vector<Quat> exactN = quats, firstOrderN = quats;
+	Quat::IntegrateAngularVelocityN(exactN.data(), omega.data(), DT, CHECK_COUNT, exact);
+	Quat::IntegrateAngularVelocityN(firstOrderN.data(), omega.data(), DT, CHECK_COUNT, firstOrder);
+	SNOVA_CHECK(exact.step == 1 && firstOrder.step == 1);
+
+	QuatBatch batch(CHECK_COUNT);
+	Vec3Batch omegaB;
+	omegaB.Resize(CHECK_COUNT);
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		batch.Set(i, quats[i]);
+		omegaB.Set(i, omega[i]);
+	}
+	AngularIntegration batchExact;
+	batchExact.method = AngularIntegration::Method::Exact;
+	batch.IntegrateAngularVelocity(omegaB, DT, batchExact);
+
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const Quat& q = quats[i];
+		SNOVA_CHECK(AngleDegrees(q.Log().Exp(), q) <= 1e-3);
+		SNOVA_CHECK(AngleDegrees((-q).Log().Exp(), q) <= 1e-3);
+
+		Quat stepped = q;
+		stepped.IntegrateAngularVelocity(omega[i], DT);
+		const float speed = omega[i].Magnitude();
+		const Quat expected = (speed > 0.f) ? q * Quat{ omega[i] / speed, speed * DT } : q;
+		SNOVA_CHECK(AngleDegrees(stepped, expected) <= TRIG_DEGREES);
+
+		// Short by about (speed * dt)^3 / 12 radians
+		Quat approximate = q;
+		approximate.IntegrateAngularVelocityFirstOrder(omega[i], DT);
+		const double stepAngle = static_cast<double>(speed) * DT;
+		SNOVA_CHECK(AngleDegrees(approximate, stepped) <= (stepAngle * stepAngle * stepAngle / 12.0) * 57.29577951308232 * 1.1 + 1e-3);
+		SNOVA_CHECK(Near(approximate | approximate, 1.f, 1e-5f));
+
+		SNOVA_CHECK(AngleDegrees(exactN[i], stepped) <= TRIG_DEGREES && AngleDegrees(batch.Get(i), stepped) <= TRIG_DEGREES);
+		SNOVA_CHECK(AngleDegrees(firstOrderN[i], approximate) <= 1e-3);
+	}
+	SNOVA_CHECK(quats[0].Log() == (Quat{ 0.f, 0.f, 0.f, 0.f }) && quats[0].Log().Exp() == Quat::Identity);
+}
+
+/////////////////////////////////////////////////////
+// Splines
+
+// QuatSpline goes through its keys, clamps outside them, stays smooth
+// across them, and the cursor and batch samplers follow Sample(time)
+void CheckQuatSpline()
+{
+	static constexpr size_t KEYS = 16;
+
+	Random random;
+	std::vector<float> keyTimes;
+	std::vector<Quat> keys;
+	float keyTime = 0.f;
+	for (size_t k = 0; k < KEYS; ++k)
+		keyTimes.push_back(keyTime += random.Between(0.5f, 2.f));
+	for (size_t k = 0; k < KEYS; ++k)
+		keys.push_back(ExactUnit(random.Quaternion()));
+	const QuatSpline spline{ keyTimes.data(), keys.data(), KEYS };
+
+	for (size_t k = 0; k < KEYS; ++k)
+	{
+		SNOVA_CHECK(AngleDegrees(spline.Sample(keyTimes[k]), keys[k]) <= 1e-3);
+
+		// No kink: a step of 1e-3 either side of a key turns by about as much
+		const double before = AngleDegrees(spline.Sample(keyTimes[k] - 1e-3f), keys[k]);
+		const double after = AngleDegrees(spline.Sample(keyTimes[k] + 1e-3f), keys[k]);
+		if (k > 0 && k + 1 < KEYS)
+			SNOVA_CHECK(Math::Abs(before - after) <= 0.1 * Math::Max(before, after) + 1e-3);
+	}
+	SNOVA_CHECK(AngleDegrees(spline.Sample(keyTimes.front() - 5.f), keys.front()) <= 1e-3);
+	SNOVA_CHECK(AngleDegrees(spline.Sample(keyTimes.back() + 5.f), keys.back()) <= 1e-3);
+
+	std::vector<float> times;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+		times.push_back(random.Between(spline.StartTime() - 1.f, spline.EndTime() + 1.f));
+	std::sort(times.begin(), times.begin() + CHECK_COUNT / 2);
+
+	std::vector<Quat> batch(CHECK_COUNT);
+	spline.Sample(times.data(), batch.data(), CHECK_COUNT);
+
+	// Sorted then random order, so the cursor walks both ways
+	QuatSpline::Cursor cursor;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const Quat expected = spline.Sample(times[i]);
+		SNOVA_CHECK(Near(expected | expected, 1.f, 1e-5f));
+		SNOVA_CHECK(spline.Sample(times[i], cursor) == expected);
+		SNOVA_CHECK(Math::Abs(batch[i].w - expected.w) <= 2e-6f && Math::Abs(batch[i].x - expected.x) <= 2e-6f
+			&& Math::Abs(batch[i].y - expected.y) <= 2e-6f && Math::Abs(batch[i].z - expected.z) <= 2e-6f);
+	}
+
+	SNOVA_CHECK(QuatSpline{}.Sample(1.f) == Quat::Identity);
+	SNOVA_CHECK(QuatSpline(keyTimes.data(), keys.data(), 1).Sample(keyTimes[0] + 1.f) == keys[0]);
+}
+
+/////////////////////////////////////////////////////
+// Culling
+
+// CullAABBs / CullSpheres against a brute-force plane test of every
+// object's transformed corners (or center). Objects within 1e-3 of a
+// plane may go either way; nothing with a corner inside may be culled
+void CheckCulling()
+{
+	static constexpr float EDGE = 1e-3f;
+
+	// 90 degree frustum down -z, near 0.1, far 100 (as in CullAABBs)
+	const float s = 0.70710678f;
+	const Frustum frustum{ {
+		{ Vec3{ s, 0.f, -s }, 0.f }, { Vec3{ -s, 0.f, -s }, 0.f },
+		{ Vec3{ 0.f, s, -s }, 0.f }, { Vec3{ 0.f, -s, -s }, 0.f },
+		{ Vec3{ 0.f, 0.f, -1.f }, -0.1f }, { Vec3{ 0.f, 0.f, 1.f }, 100.f } } };
+
+	Random random;
+	std::vector<Mtx44> matrices;
+	std::vector<AABB> boxes;
+	std::vector<BoundingSphere> spheres;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		Mtx44 m;
+		Mtx44ComposeTRS(m, 5.f * random.Vector(), random.Quaternion(),
+			Vec3{ random.Between(0.5f, 3.f), random.Between(0.5f, 3.f), random.Between(0.5f, 3.f) });
+		matrices.push_back(m);
+		const Vec3 center = random.Vector() * 0.1f, half{ random.Between(0.1f, 2.f), random.Between(0.1f, 2.f), random.Between(0.1f, 2.f) };
+		boxes.push_back(AABB{ center - half, center + half });
+		spheres.push_back(BoundingSphere{ center, random.Between(0.1f, 2.f) });
+	}
+
+	std::vector<uint32_t> visibleBoxes(VisibilityWords(CHECK_COUNT)), visibleSpheres(VisibilityWords(CHECK_COUNT));
+	std::vector<AABB> worldBoxes(CHECK_COUNT);
+	std::vector<BoundingSphere> worldSpheres(CHECK_COUNT);
+	const size_t boxCount = CullAABBs(frustum, matrices.data(), boxes.data(), CHECK_COUNT, visibleBoxes.data(), worldBoxes.data());
+	const size_t sphereCount = CullSpheres(frustum, matrices.data(), spheres.data(), CHECK_COUNT, visibleSpheres.data(), worldSpheres.data());
+
+	size_t boxesSeen = 0, spheresSeen = 0;
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const Mtx44& m = matrices[i];
+
+		// World AABB of the 8 transformed corners
+		AABB world{ TransformPoint(m, boxes[i].min), TransformPoint(m, boxes[i].min) };
+		bool cornerInside = false;
+		for (int c = 0; c < 8; ++c)
+		{
+			const Vec3 corner = TransformPoint(m, Vec3{
+				(c & 1) ? boxes[i].max.x : boxes[i].min.x,
+				(c & 2) ? boxes[i].max.y : boxes[i].min.y,
+				(c & 4) ? boxes[i].max.z : boxes[i].min.z });
+			world.min = Vec3{ Math::Min(world.min.x, corner.x), Math::Min(world.min.y, corner.y), Math::Min(world.min.z, corner.z) };
+			world.max = Vec3{ Math::Max(world.max.x, corner.x), Math::Max(world.max.y, corner.y), Math::Max(world.max.z, corner.z) };
+
+			bool inside = true;
+			for (const FrustumPlane& plane : frustum.planes)
+				inside = inside && PlaneDistance(plane, corner) > EDGE;
+			cornerInside = cornerInside || inside;
+		}
+		SNOVA_CHECK(NearVec(worldBoxes[i].min, world.min, 1e-4f) && NearVec(worldBoxes[i].max, world.max, 1e-4f));
+
+		// The world box is kept unless one plane has it all outside
+		float boxWorst = 1e30f;
+		for (const FrustumPlane& plane : frustum.planes)
+		{
+			const Vec3 farthest{
+				plane.normal.x > 0.f ? world.max.x : world.min.x,
+				plane.normal.y > 0.f ? world.max.y : world.min.y,
+				plane.normal.z > 0.f ? world.max.z : world.min.z };
+			boxWorst = Math::Min(boxWorst, PlaneDistance(plane, farthest));
+		}
+		const bool boxVisible = IsVisible(visibleBoxes.data(), i);
+		SNOVA_CHECK(Math::Abs(boxWorst) <= EDGE || boxVisible == (boxWorst >= 0.f));
+		SNOVA_CHECK(boxVisible || !cornerInside);
+		boxesSeen += boxVisible;
+
+		// Sphere: center transformed, radius times the largest axis scale
+		const Vec3 center = TransformPoint(m, spheres[i].center);
+		float axisScale = 0.f;
+		for (int c = 0; c < 3; ++c)
+			axisScale = Math::Max(axisScale, Vec3{ m.m2[0][c], m.m2[1][c], m.m2[2][c] }.Magnitude());
+		const float radius = spheres[i].radius * axisScale;
+		SNOVA_CHECK(NearVec(worldSpheres[i].center, center, 1e-4f) && Near(worldSpheres[i].radius, radius, 1e-4f));
+
+		float sphereWorst = 1e30f;
+		for (const FrustumPlane& plane : frustum.planes)
+			sphereWorst = Math::Min(sphereWorst, PlaneDistance(plane, center) + radius);
+		const bool sphereVisible = IsVisible(visibleSpheres.data(), i);
+		SNOVA_CHECK(Math::Abs(sphereWorst) <= EDGE || sphereVisible == (sphereWorst >= 0.f));
+		spheresSeen += sphereVisible;
+	}
+
+	// Counts match the bits, and the bits past count are 0
+	SNOVA_CHECK(boxCount == boxesSeen && sphereCount == spheresSeen);
+	SNOVA_CHECK(boxesSeen > 0 && boxesSeen < CHECK_COUNT);
+	SNOVA_CHECK((visibleBoxes.back() >> (CHECK_COUNT % 32)) == 0 && (visibleSpheres.back() >> (CHECK_COUNT % 32)) == 0);
+
+	// The identity view-projection is the clip cube itself
+	Mtx44 identity;
+	Mtx44Identity(identity);
+	const Frustum cube = Frustum::FromMatrix(identity);
+	for (const FrustumPlane& plane : cube.planes)
+	{
+		SNOVA_CHECK(Near(plane.normal.Magnitude(), 1.f, 1e-5f));
+		SNOVA_CHECK(Near(PlaneDistance(plane, Vec3{ 0.f, 0.f, 0.f }), 1.f, 1e-5f));
+		SNOVA_CHECK(PlaneDistance(plane, -1.5f * plane.normal) < 0.f);
+	}
+}
+
+} // namespace Verify
+} // namespace SNova
\ No newline at end of file
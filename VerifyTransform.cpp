@@ -0,0 +1,1212 @@
+/******************************************************************************/
+/*!
+\file		VerifyTransform.cpp
+\author		Justin Leow
+\brief
+	Behaviour checks of Transform storage (its cached matrix, tags and
+	their TagTable lists, the binary format, mapped snapshots, the pool),
+	change notification and its instrumentation counters, the hierarchy,
+	double-buffered frames, and the parallel loop transforms are updated
+	with. See Verify.h.
+
+All content (C) 2019 DigiPen (SINGAPORE) Corporation, all rights reserved.
+Reproduction or disclosure of this file or its contents without the prior
+written consent of DigiPen Institute of Technology is prohibited.
+*/
+/******************************************************************************/
+
+#include "SNova.h"
+#include "Verify.h"
+#include "Transform.h"
+#include "TransformSnapshot.h"
+#include "TransformNotifyQueue.h"
+#include "TransformPool.h"
+#include "TransformHierarchy.h"
+#include "TransformFrameBuffer.h"
+#include "ParallelFor.h"
+#include "Instrumentation.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace SNova
+{
+namespace Verify
+{
+
+namespace
+{
+	// tag's member list holds exactly the transforms whose bitset has it
+	bool MembersMatch(TagID tag, const std::vector<std::unique_ptr<Transform>>& transforms)
+	{
+		const std::vector<Transform*>& members = Transform::FindAllWithTag(tag);
+		size_t carrying = 0;
+		for (const std::unique_ptr<Transform>& t : transforms)
+		{
+			if (!t || !t->HasTag(tag))
+				continue;
+			++carrying;
+			if (std::find(members.begin(), members.end(), t.get()) == members.end())
+				return false;
+		}
+		return carrying == members.size();
+	}
+
+	uint32_t BitsOf(float f)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &f, sizeof(bits));
+		return bits;
+	}
+
+	// The 4-byte field at offset, as the file stores it (little-endian)
+	uint32_t StoredField(const std::string& bytes, size_t offset)
+	{
+		uint32_t value = 0;
+		for (size_t i = 0; i < 4; ++i)
+			value |= static_cast<uint32_t>(static_cast<unsigned char>(bytes[offset + i])) << (8 * i);
+		return value;
+	}
+
+	std::string Patched(std::string bytes, size_t offset, uint32_t value)
+	{
+		for (size_t i = 0; i < 4; ++i)
+			bytes[offset + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+		return bytes;
+	}
+
+	bool SameRotator(const Rotator& a, const Rotator& b)
+	{
+		return a.pitch == b.pitch && a.yaw == b.yaw && a.roll == b.roll;
+	}
+
+	bool SameVector(const Vec3& a, const Vec3& b)
+	{
+		return a.x == b.x && a.y == b.y && a.z == b.z;
+	}
+
+	// t's matrix built from its current values as T * R * S, without its cache
+	Mtx44 ComposedFrom(const Transform& t)
+	{
+		const Vec3 p = t.GetPosition(), s = t.GetScale();
+		Mtx44 rotMtx{ t.GetRotation().ToQuat().ToMatrix3x3() }, scaleMtx, transMtx;
+		Mtx44Scale(scaleMtx, s.x, s.y, s.z);
+		Mtx44Translate(transMtx, p.x, p.y, p.z);
+		return transMtx * (rotMtx * scaleMtx);
+	}
+
+	bool NearMatrix(const Mtx44& a, const Mtx44& expected)
+	{
+		for (int r = 0; r < 4; ++r)
+			for (int c = 0; c < 4; ++c)
+				if (!Near(a.m2[r][c], expected.m2[r][c], 1e-5f))
+					return false;
+		return true;
+	}
+
+	// frame's slot holds t's current values and matrix, bit for bit
+	bool FrameMatches(const TransformFrameBuffer::Frame& frame, size_t slot, const Transform& t)
+	{
+		const Mtx44 mtx = t.GetTransform();
+		return SameVector(frame.position[slot], t.GetPosition()) && SameVector(frame.scale[slot], t.GetScale())
+			&& frame.rotation[slot] == t.GetRotation()
+			&& std::memcmp(&frame.mtx[slot], &mtx, sizeof(Mtx44)) == 0;
+	}
+
+	// copy holds source's values and took its rotator and matrix as they are
+	bool TookCaches(const Transform& copy, const Transform& source, const Mtx44& sourceMtx)
+	{
+		const Mtx44 mtx = copy.GetTransform();
+		return !copy.IsDirty() && std::memcmp(&mtx, &sourceMtx, sizeof(Mtx44)) == 0
+			&& SameRotator(copy.rotator, source.rotator)
+			&& copy.GetRotation().ToQuat() == source.GetRotation().ToQuat();
+	}
+
+	std::string ReadFile(const std::string& path)
+	{
+		std::ifstream file{ path, std::ios::binary };
+		return std::string{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+	}
+
+	void WriteFile(const std::string& path, const std::string& bytes)
+	{
+		std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+		file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+
+	// bytes with the native field at offset replaced, as the snapshot stores it
+	template <typename T>
+	std::string PatchedNative(std::string bytes, size_t offset, T value)
+	{
+		std::memcpy(&bytes[offset], &value, sizeof(value));
+		return bytes;
+	}
+}
+
+/////////////////////////////////////////////////////
+// Cached matrix
+
+// Every setter marks the matrix stale and bumps its version, and the next
+// GetTransform() rebuilds it to match the new values, in both rotation modes
+void CheckTransformMatrix()
+{
+	using Setter = std::function<void(Transform&, Random&)>;
+	const std::vector<Setter> setters = {
+		[](Transform& t, Random& r) { t.SetPosition(r.Vector()); },
+		[](Transform& t, Random& r) { t.SetPosition(r.Unit(), r.Unit(), r.Unit()); },
+		[](Transform& t, Random& r) { t.SetPosX(r.Unit()); },
+		[](Transform& t, Random& r) { t.SetPosY(r.Unit()); },
+		[](Transform& t, Random& r) { t.SetPosZ(r.Unit()); },
+		[](Transform& t, Random& r) { t.SetScale(r.Vector()); },
+		[](Transform& t, Random& r) { t.SetScale(r.Between(0.5f, 2.f), r.Between(0.5f, 2.f), r.Between(0.5f, 2.f)); },
+		[](Transform& t, Random& r) { t.SetScale(r.Between(0.5f, 2.f)); },
+		[](Transform& t, Random& r) { t.SetScaleX(r.Between(0.5f, 2.f)); },
+		[](Transform& t, Random& r) { t.SetScaleY(r.Between(0.5f, 2.f)); },
+		[](Transform& t, Random& r) { t.SetScaleZ(r.Between(0.5f, 2.f)); },
+		[](Transform& t, Random& r) { t.SetRotation(QuatValue{ r.Quaternion() }); },
+		[](Transform& t, Random& r) { t.rotation = r.Quaternion(); },
+		[](Transform& t, Random& r) { t.rotator = r.Angles(); },
+		[](Transform& t, Random& r) { t.rotator.Add(r.Between(1.f, 10.f), 0.f, 0.f); },
+	};
+
+	Random random;
+	for (const bool authoritative : { false, true })
+	{
+		Transform t;
+		t.SetQuatAuthoritative(authoritative);
+		SNOVA_CHECK(t.IsDirty());
+		SNOVA_CHECK(NearMatrix(t.GetTransform(), ComposedFrom(t)) && !t.IsDirty());
+
+		for (size_t i = 0; i < CHECK_COUNT; ++i)
+		{
+			const unsigned version = t.GetMtxVersion();
+			setters[i % setters.size()](t, random);
+			SNOVA_CHECK(t.IsDirty() && t.GetMtxVersion() != version);
+
+			// Rebuilt once, then read from the cache
+			const Mtx44 rebuilt = t.GetTransform();
+			SNOVA_CHECK(!t.IsDirty() && NearMatrix(rebuilt, ComposedFrom(t)));
+			const Mtx44 cached = t.GetTransform();
+			SNOVA_CHECK(std::memcmp(&cached, &rebuilt, sizeof(Mtx44)) == 0);
+		}
+
+		// Flush() rebuilds it too
+		t.SetPosX(1.f);
+		t.Flush();
+		SNOVA_CHECK(!t.IsDirty() && NearMatrix(t.GetTransform(), ComposedFrom(t)));
+	}
+	TransformNotifyQueue::Get().Dispatch();
+}
+
+/////////////////////////////////////////////////////
+// Rotator modes
+
+// Normally a quat write syncs the rotator member at once. With the quat
+// authoritative the member is left as it was until GetRotator() rebuilds
+// it, and every read path and rotator edit still sees the current rotation
+void CheckRotatorModes()
+{
+	Random random;
+	Transform synced, lazy;
+	lazy.SetQuatAuthoritative(true);
+	SNOVA_CHECK(!synced.IsQuatAuthoritative() && lazy.IsQuatAuthoritative());
+
+	for (size_t i = 0; i < CHECK_COUNT; ++i)
+	{
+		const Quat q = random.Quaternion();
+		const Rotator expected = q.GetRotator();
+		const Rotator before = lazy.rotator;
+		const unsigned version = lazy.GetRotationVersion();
+		synced.rotation = q;
+		lazy.rotation = q;
+
+		SNOVA_CHECK(SameRotator(synced.rotator, expected) && SameRotator(synced.GetRotator(), expected));
+		SNOVA_CHECK(SameRotator(lazy.rotator, before));
+
+		// Rebuilt from the quat on read, without counting as a rotation change
+		SNOVA_CHECK(SameRotator(lazy.GetRotator(), expected) && SameRotator(lazy.rotator, expected));
+		SNOVA_CHECK(lazy.GetRotationVersion() == version + 1);
+		SNOVA_CHECK(SameRotation(lazy.GetRotation().ToQuat(), q));
+	}
+
+	// A relative edit of a stale rotator starts from the current rotation
+	const Quat q = random.Quaternion();
+	lazy.rotation = q;
+	lazy.rotator.Add(0.f, 10.f, 0.f);
+	const Rotator edited = q.GetRotator();
+	SNOVA_CHECK(Near(lazy.rotator.pitch, edited.pitch, 1e-4f) && Near(lazy.rotator.yaw, edited.yaw + 10.f, 1e-4f));
+	SNOVA_CHECK(SameRotation(lazy.GetRotation().ToQuat(), Rotator{ edited.pitch, edited.yaw + 10.f, edited.roll }.Quaternion()));
+
+	// Turning the mode off leaves the member current for direct readers
+	lazy.rotation = random.Quaternion();
+	lazy.SetQuatAuthoritative(false);
+	SNOVA_CHECK(!lazy.IsQuatAuthoritative());
+	SNOVA_CHECK(SameRotator(lazy.rotator, lazy.rotation.GetRotator()));
+	lazy.rotation = q;
+	SNOVA_CHECK(SameRotator(lazy.rotator, q.GetRotator()));
+	TransformNotifyQueue::Get().Dispatch();
+}
+
+/////////////////////////////////////////////////////
+// Conversion cache
+
+// Writing back the rotation or rotator already there converts nothing and
+// changes no version; copies and moves take the other transform's rotator
+// and matrix when current, and a copy of equal values marks nothing
+void CheckConversionCache()
+{
+	Random random;
+	TransformNotifyQueue& queue = TransformNotifyQueue::Get();
+
+	Transform t;
+	t.rotator = random.Angles();
+	t.SetPosition(random.Vector());
+	t.GetTransform();
+	queue.Dispatch();
+	t.ResetConversionStats();
+
+	const unsigned rotationVersion = t.GetRotationVersion(), mtxVersion = t.GetMtxVersion();
+	const Rotator euler = t.rotator;
+	t.rotator = euler;
+	t.rotation = t.GetRotation().ToQuat();
+	t.SetRotation(t.GetRotation());
+	SNOVA_CHECK(t.GetRotationVersion() == rotationVersion && t.GetMtxVersion() == mtxVersion);
+	SNOVA_CHECK(!t.IsDirty() && t.GetChangeMask() == Transform::CHANGE_NONE && queue.Size() == 0);
+	SNOVA_CHECK(SameRotator(t.rotator, euler));
+#if SNOVA_INSTRUMENTATION
+	const Transform::ConversionStats skipped = t.GetConversionStats();
+	SNOVA_CHECK(skipped.rotationHits == 1 && skipped.rotationMisses == 0);
+	SNOVA_CHECK(skipped.rotatorHits == 2 && skipped.rotatorMisses == 0);
+#endif
+
+	// A changed rotator converts once, and the same write again is skipped
+	const Rotator turned{ euler.pitch, euler.yaw + 1.f, euler.roll };
+	t.rotator = turned;
+	SNOVA_CHECK(t.GetRotationVersion() == rotationVersion + 1 && t.GetChangeMask() == Transform::CHANGE_ROTATION);
+	SNOVA_CHECK(SameRotator(t.rotator, turned) && SameRotation(t.GetRotation().ToQuat(), turned.Quaternion()));
+	queue.Dispatch();
+	t.rotator = turned;
+	SNOVA_CHECK(t.GetRotationVersion() == rotationVersion + 1 && t.GetChangeMask() == Transform::CHANGE_NONE);
+#if SNOVA_INSTRUMENTATION
+	SNOVA_CHECK(t.GetConversionStats().rotationMisses == 1 && t.GetConversionStats().rotationHits == 2);
+#endif
+
+	Transform source;
+	source.rotator = random.Angles();
+	source.SetPosition(random.Vector());
+	source.SetScale(random.Between(0.5f, 2.f));
+	const Mtx44 sourceMtx = source.GetTransform();
+
+	const Transform copied{ source };
+	SNOVA_CHECK(TookCaches(copied, source, sourceMtx));
+	Transform assigned;
+	assigned = source;
+	SNOVA_CHECK(TookCaches(assigned, source, sourceMtx));
+	Transform moveFrom{ source };
+	const Transform moved{ std::move(moveFrom) };
+	SNOVA_CHECK(TookCaches(moved, source, sourceMtx));
+	Transform moveAssigned;
+	moveFrom = source;
+	moveAssigned = std::move(moveFrom);
+	SNOVA_CHECK(TookCaches(moveAssigned, source, sourceMtx));
+
+	// CopyStateFrom bumps a version only for what differs
+	Transform target;
+	target.CopyStateFrom(source);
+	SNOVA_CHECK(TookCaches(target, source, sourceMtx));
+	SNOVA_CHECK(target.GetRotationVersion() == 1 && (target.GetChangeMask() & Transform::CHANGE_ROTATION));
+	queue.Dispatch();
+	const unsigned targetMtxVersion = target.GetMtxVersion();
+	target.CopyStateFrom(source);
+	SNOVA_CHECK(target.GetRotationVersion() == 1 && target.GetMtxVersion() == targetMtxVersion);
+	SNOVA_CHECK(target.GetChangeMask() == Transform::CHANGE_NONE && queue.Size() == 0);
+
+	// A stale source matrix or rotator is not taken
+	source.SetPosX(source.GetPosX() + 1.f);
+	target.CopyStateFrom(source);
+	SNOVA_CHECK(target.IsDirty() && target.GetChangeMask() == Transform::CHANGE_POSITION);
+	SNOVA_CHECK(NearMatrix(target.GetTransform(), ComposedFrom(source)));
+	source.SetQuatAuthoritative(true);
+	const Quat q = random.Quaternion();
+	source.rotation = q;
+	target.CopyStateFrom(source);
+	SNOVA_CHECK(SameRotator(target.rotator, q.GetRotator()));
+	queue.Dispatch();
+}
+
+/////////////////////////////////////////////////////
+// Instrumentation
+
+// Each instrumented call counts once on the calling thread, a thread's
+// counts stay in the total after it exits, and with instrumentation
+// compiled out every snapshot stays 0
+void CheckInstrumentation()
+{
+	using namespace Instrumentation;
+	for (unsigned i = 0; i < COUNTER_COUNT; ++i)
+		SNOVA_CHECK(GetName(static_cast<Counter>(i))[0] != '\0');
+	SNOVA_CHECK(GetName(COUNTER_COUNT)[0] == '\0');
+
+	Random random;
+	const Quat q = random.Quaternion();
+	const Rotator r = random.Angles();
+	Transform t;
+	TransformNotifyQueue::Get().Dispatch();
+
+	static constexpr uint64_t CALLS = 1000;
+	ResetThread();
+	const Snapshot totalBefore = TakeTotalSnapshot();
+	for (uint64_t i = 0; i < CALLS; ++i)
+	{
+		q.GetRotator();
+		r.Quaternion();
+		r.Matrix();
+		t.SetPosX(static_cast<float>(i));
+		t.GetTransform();
+		t.Flush();
+	}
+	const Snapshot local = TakeThreadSnapshot();
+
+	// Another thread's calls are not in this one's snapshot, but stay in the total after it exits
+	std::thread other{ [&]()
+	{
+		for (uint64_t i = 0; i < CALLS; ++i)
+			q.GetRotator();
+	} };
+	other.join();
+	const Snapshot total = TakeTotalSnapshot() - totalBefore;
+	const Snapshot localAfter = TakeThreadSnapshot();
+
+#if SNOVA_INSTRUMENTATION
+	SNOVA_CHECK(local.calls[QUAT_GET_ROTATOR] == CALLS && local.calls[ROTATOR_QUATERNION] == CALLS);
+	SNOVA_CHECK(local.calls[ROTATOR_MATRIX] == CALLS && local.calls[TRANSFORM_UPDATE_MTX] == CALLS);
+	SNOVA_CHECK(local.calls[TRANSFORM_NOTIFY] == CALLS && local.calls[NAN_CHECK_HIT] == 0);
+	SNOVA_CHECK(localAfter.calls[QUAT_GET_ROTATOR] == CALLS);
+	SNOVA_CHECK(total.calls[QUAT_GET_ROTATOR] == 2 * CALLS && total.calls[TRANSFORM_UPDATE_MTX] == CALLS);
+#if SNOVA_INSTRUMENTATION >= 2
+	SNOVA_CHECK(local.nanoseconds[TRANSFORM_UPDATE_MTX] > 0 && local.nanoseconds[ROTATOR_MATRIX] > 0);
+#else
+	SNOVA_CHECK(local.nanoseconds[TRANSFORM_UPDATE_MTX] == 0 && total.nanoseconds[QUAT_GET_ROTATOR] == 0);
+#endif
+	ResetThread();
+	SNOVA_CHECK(TakeThreadSnapshot().calls[QUAT_GET_ROTATOR] == 0);
+#else
+	for (unsigned i = 0; i < COUNTER_COUNT; ++i)
+		SNOVA_CHECK(local.calls[i] == 0 && localAfter.calls[i] == 0 && total.calls[i] == 0 && total.nanoseconds[i] == 0);
+#endif
+}
+
+/////////////////////////////////////////////////////
+// Tags
+
+// More distinct names over time than the table holds at once: each keeps
+// its ID while carried, the ID is reused once it is not, and member lists
+// stay in step with the bitsets through swap-removal
+void CheckTags()
+{
+	static constexpr size_t COUNT = TagTable::MAX_TAGS + 12;
+	TagTable& table = TagTable::Get();
+
+	const TagID pinned = table.Intern("VerifyPinned");
+	SNOVA_CHECK(pinned != INVALID_TAG);
+
+	// One shared tag, one unique tag each, destroyed as they go
+	std::vector<std::unique_ptr<Transform>> transforms(COUNT);
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		const std::string name = "VerifyTag" + std::to_string(i);
+		transforms[i] = std::make_unique<Transform>();
+		transforms[i]->SetTag("VerifyShared " + name);
+		SNOVA_CHECK(transforms[i]->GetTag() == "VerifyShared " + name);
+		SNOVA_CHECK(transforms[i]->HasTag(name) && transforms[i]->HasTag("VerifyShared"));
+		if (i >= 8)
+			transforms[i - 8].reset();
+	}
+	const TagID shared = table.Find("VerifyShared");
+	SNOVA_CHECK(shared != INVALID_TAG && Transform::FindAllWithTag(shared).size() == 8);
+	SNOVA_CHECK(table.Find("VerifyTag0") == INVALID_TAG && table.GetName(table.Find("VerifyTag0")).empty());
+
+	// Removing from the middle of a list keeps every index right
+	for (size_t i = COUNT - 8; i < COUNT; i += 2)
+		transforms[i]->RemoveTag("VerifyShared");
+	SNOVA_CHECK(MembersMatch(shared, transforms));
+	for (size_t i = COUNT - 7; i < COUNT; i += 2)
+	{
+		transforms[i]->AddTag(pinned);
+		transforms[i].reset();
+	}
+	SNOVA_CHECK(MembersMatch(shared, transforms) && Transform::FindAllWithTag(shared).empty());
+	SNOVA_CHECK(Transform::FindAllWithTag(pinned).empty() && table.Find("VerifyPinned") == pinned);
+
+	// Removing a tag from its only carrier frees the ID; the string must
+	// lose the name too, or the next save writes it back
+	{
+		Transform only;
+		only.SetTag("VerifyAlpha VerifyBeta");
+		only.RemoveTag("VerifyAlpha");
+		SNOVA_CHECK(only.GetTag() == "VerifyBeta" && !only.HasTag("VerifyAlpha"));
+		SNOVA_CHECK(table.Find("VerifyAlpha") == INVALID_TAG);
+		only.RemoveTag(table.Find("VerifyBeta"));
+		SNOVA_CHECK(only.GetTag().empty() && only.GetTagSet().none());
+	}
+
+	// Past MAX_TAGS live names (the pinned one is still in use): the table
+	// refuses the last ones, their strings keep the name
+	transforms.clear();
+	std::vector<std::unique_ptr<Transform>> full(TagTable::MAX_TAGS);
+	for (size_t i = 0; i < full.size(); ++i)
+	{
+		const std::string name = "VerifyFull" + std::to_string(i);
+		full[i] = std::make_unique<Transform>();
+		full[i]->SetTag(name + " " + name);
+		SNOVA_CHECK(full[i]->GetTag() == name);
+	}
+	SNOVA_CHECK(full.front()->HasTag("VerifyFull0"));
+	SNOVA_CHECK(!full.back()->HasTag(full.back()->GetTag()));
+}
+
+/////////////////////////////////////////////////////
+// Copy and move
+
+// A move hands over the tags and their TagTable membership and leaves rhs
+// without any, moving into itself changes nothing, CopyStateFrom shares
+// them, and copies made under a ScopedSuspend are notified once each with
+// no matrix rebuilt
+void CheckCopyMove()
+{
+	static constexpr size_t INSTANCES = 5000;
+	Random random;
+	TransformNotifyQueue& queue = TransformNotifyQueue::Get();
+	const std::string tags = "VerifyMoveA VerifyMoveB";
+
+	Transform a;
+	a.SetPosition(random.Vector());
+	a.rotator = random.Angles();
+	a.SetTag(tags);
+	const TagID moveA = TagTable::Get().Find("VerifyMoveA");
+	const Mtx44 aMtx = a.GetTransform();
+
+	Transform b{ std::move(a) };
+	SNOVA_CHECK(b.GetTag() == tags && b.HasTag(moveA) && b.HasTag("VerifyMoveB"));
+	SNOVA_CHECK(a.GetTag().empty() && a.GetTagSet().none() && SameVector(a.GetPosition(), b.GetPosition()));
+	SNOVA_CHECK(Transform::FindAllWithTag(moveA).size() == 1 && Transform::FindAllWithTag(moveA)[0] == &b);
+	SNOVA_CHECK(a.GetChangeMask() & Transform::CHANGE_TAG);
+
+	// Moving into itself
+	queue.Dispatch();
+	const unsigned mtxVersion = b.GetMtxVersion(), rotationVersion = b.GetRotationVersion();
+	Transform& self = b;
+	b = std::move(self);
+	SNOVA_CHECK(b.GetTag() == tags && b.HasTag(moveA) && Transform::FindAllWithTag(moveA).size() == 1);
+	SNOVA_CHECK(b.GetMtxVersion() == mtxVersion && b.GetRotationVersion() == rotationVersion);
+	SNOVA_CHECK(b.GetChangeMask() == Transform::CHANGE_NONE && queue.Size() == 0);
+	const Mtx44 bMtx = b.GetTransform();
+	SNOVA_CHECK(std::memcmp(&bMtx, &aMtx, sizeof(Mtx44)) == 0);
+
+	// Move assignment drops the target's own tags
+	Transform c;
+	c.SetTag("VerifyMoveC");
+	const TagID moveC = TagTable::Get().Find("VerifyMoveC");
+	c = std::move(b);
+	SNOVA_CHECK(c.GetTag() == tags && c.HasTag(moveA) && !c.HasTag(moveC) && b.GetTagSet().none());
+	SNOVA_CHECK(Transform::FindAllWithTag(moveA).size() == 1 && Transform::FindAllWithTag(moveA)[0] == &c);
+	SNOVA_CHECK(TagTable::Get().Find("VerifyMoveC") == INVALID_TAG || Transform::FindAllWithTag(moveC).empty());
+
+	// CopyStateFrom leaves the source's tags where they are
+	Transform d;
+	d.CopyStateFrom(c);
+	SNOVA_CHECK(d.GetTag() == tags && d.HasTag(moveA) && c.GetTag() == tags && c.HasTag(moveA));
+	SNOVA_CHECK(Transform::FindAllWithTag(moveA).size() == 2 && (d.GetChangeMask() & Transform::CHANGE_TAG));
+	queue.Dispatch();
+
+	// Prefab instantiation: nothing is notified until the ScopedSuspend ends,
+	// then every instance once
+	Transform prefab;
+	prefab.SetPosition(random.Vector());
+	prefab.rotator = random.Angles();
+	prefab.SetScale(random.Between(0.5f, 2.f));
+	prefab.SetTag("VerifyPrefab");
+	const Mtx44 prefabMtx = prefab.GetTransform();
+	queue.Dispatch();
+	Instrumentation::ResetThread();
+
+	std::vector<std::unique_ptr<Transform>> instances(INSTANCES);
+	{
+		TransformNotifyQueue::ScopedSuspend suspend;
+		for (std::unique_ptr<Transform>& instance : instances)
+		{
+			instance = std::make_unique<Transform>();
+			instance->CopyStateFrom(prefab);
+			queue.Dispatch();
+		}
+		SNOVA_CHECK(queue.Size() == INSTANCES && instances.back()->GetChangeMask() == Transform::CHANGE_ALL);
+	}
+	SNOVA_CHECK(queue.Size() == 0 && Transform::FindAllWithTag("VerifyPrefab").size() == INSTANCES + 1);
+	for (const std::unique_ptr<Transform>& instance : instances)
+	{
+		SNOVA_CHECK(instance->GetChangeMask() == Transform::CHANGE_NONE && !instance->IsDirty());
+		SNOVA_CHECK(TookCaches(*instance, prefab, prefabMtx) && instance->GetTag() == "VerifyPrefab");
+	}
+#if SNOVA_INSTRUMENTATION
+	const Instrumentation::Snapshot counts = Instrumentation::TakeThreadSnapshot();
+	SNOVA_CHECK(counts.calls[Instrumentation::TRANSFORM_NOTIFY] == INSTANCES);
+	SNOVA_CHECK(counts.calls[Instrumentation::TRANSFORM_UPDATE_MTX] == 0);
+#endif
+}
+
+/////////////////////////////////////////////////////
+// Change notification
+
+// Setters queue a transform once and add to its change mask, Dispatch()
+// rebuilds and clears them, a destroyed transform leaves the queue, and
+// nested ScopedSuspends hold every Dispatch() back until the outermost ends
+void CheckNotifyQueue()
+{
+	TransformNotifyQueue& queue = TransformNotifyQueue::Get();
+	queue.Dispatch();
+	SNOVA_CHECK(queue.Size() == 0 && !queue.IsSuspended());
+
+	Transform a, b;
+	SNOVA_CHECK(queue.Size() == 2 && a.GetChangeMask() == Transform::CHANGE_ALL);
+	queue.Dispatch();
+	SNOVA_CHECK(queue.Size() == 0 && a.GetChangeMask() == Transform::CHANGE_NONE && !a.IsDirty());
+
+	a.SetPosition(Vec3{ 1.f, 2.f, 3.f });
+	a.SetScale(2.f);
+	a.SetPosX(4.f);
+	b.SetTag("VerifyQueued");
+	SNOVA_CHECK(queue.Size() == 2);
+	SNOVA_CHECK(a.GetChangeMask() == (Transform::CHANGE_POSITION | Transform::CHANGE_SCALE) && a.IsDirty());
+	SNOVA_CHECK(b.GetChangeMask() == Transform::CHANGE_TAG && !b.IsDirty());
+	queue.Dispatch();
+	SNOVA_CHECK(queue.Size() == 0 && !a.IsDirty());
+	SNOVA_CHECK(a.GetChangeMask() == Transform::CHANGE_NONE && b.GetChangeMask() == Transform::CHANGE_NONE);
+
+	// Destroyed while queued, from the front, middle and back of the queue
+	{
+		std::vector<std::unique_ptr<Transform>> many(6);
+		for (std::unique_ptr<Transform>& t : many)
+			t = std::make_unique<Transform>();
+		many[0].reset();
+		many[3].reset();
+		many[5].reset();
+		SNOVA_CHECK(queue.Size() == 3);
+		queue.Dispatch();
+		SNOVA_CHECK(queue.Size() == 0);
+		for (const std::unique_ptr<Transform>& t : many)
+			SNOVA_CHECK(!t || (t->GetChangeMask() == Transform::CHANGE_NONE && !t->IsDirty()));
+	}
+
+	// Nested suspends: only the outermost Resume() runs the Dispatch() asked for
+	{
+		TransformNotifyQueue::ScopedSuspend outer;
+		a.SetPosY(5.f);
+		{
+			TransformNotifyQueue::ScopedSuspend inner;
+			b.SetPosY(5.f);
+			queue.Dispatch();
+			SNOVA_CHECK(queue.IsSuspended() && queue.Size() == 2);
+		}
+		SNOVA_CHECK(queue.IsSuspended() && queue.Size() == 2 && a.GetChangeMask() == Transform::CHANGE_POSITION);
+	}
+	SNOVA_CHECK(!queue.IsSuspended() && queue.Size() == 0);
+	SNOVA_CHECK(a.GetChangeMask() == Transform::CHANGE_NONE && b.GetChangeMask() == Transform::CHANGE_NONE);
+
+	// No Dispatch() asked for while suspended: Resume() leaves the queue alone
+	{
+		TransformNotifyQueue::ScopedSuspend suspend;
+		a.SetPosZ(6.f);
+	}
+	SNOVA_CHECK(queue.Size() == 1 && a.IsDirty());
+	queue.Dispatch();
+
+	// An unmatched Resume() is ignored
+	queue.Resume();
+	SNOVA_CHECK(!queue.IsSuspended());
+}
+
+/////////////////////////////////////////////////////
+// Pool
+
+// Handles go stale on Destroy/Reset and slots are reused under a new
+// generation; the hot arrays only change in UpdateHotData(), and only for
+// the slots written since the last one
+void CheckTransformPool()
+{
+	static constexpr size_t COUNT = TransformPool::CHUNK_SIZE * 2 + 37;
+	Random random;
+	TransformPool pool;
+	pool.grainSize = 16;
+
+	std::vector<TransformPool::Handle> handles;
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		handles.push_back(pool.Create());
+		Transform* t = pool.Get(handles.back());
+		if (!SNOVA_CHECK(t && handles.back().index == i && handles.back().generation == 0))
+			return;
+		SNOVA_CHECK(reinterpret_cast<uintptr_t>(t) % TransformPool::CACHE_LINE == 0);
+		t->SetPosition(random.Vector());
+		t->rotation = random.Quaternion();
+	}
+	SNOVA_CHECK(pool.Size() == COUNT && pool.SlotCount() == COUNT);
+
+	// Matches after UpdateHotData(), stale between a write and the next one
+	const auto hotMatches = [&](size_t i)
+	{
+		const Transform* t = pool.Get(handles[i]);
+		const Mtx44 mtx = t->GetTransform();
+		return pool.SlotAlive()[i] == 1 && SameVector(pool.Positions()[i], t->GetPosition())
+			&& SameVector(pool.Scales()[i], t->GetScale())
+			&& pool.Rotations()[i].ToQuat() == t->GetRotation().ToQuat()
+			&& std::memcmp(&pool.Matrices()[i], &mtx, sizeof(Mtx44)) == 0;
+	};
+	pool.UpdateHotData();
+	for (size_t i = 0; i < COUNT; ++i)
+		SNOVA_CHECK(hotMatches(i));
+
+	const Vec3 before = pool.Positions()[5];
+	pool.Get(handles[5])->SetPosX(before.x + 1.f);
+	SNOVA_CHECK(SameVector(pool.Positions()[5], before));
+	pool.UpdateHotData();
+	SNOVA_CHECK(pool.Positions()[5].x == before.x + 1.f && hotMatches(5));
+
+#if SNOVA_INSTRUMENTATION
+	// Only the written slots are read: the others' matrices are not touched
+	for (const TransformPool::Handle& handle : handles)
+		pool.Get(handle)->ResetConversionStats();
+	for (size_t i = 0; i < COUNT; i += 7)
+		pool.Get(handles[i])->SetScale(random.Between(0.5f, 2.f));
+	pool.UpdateHotData();
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		const Transform::ConversionStats stats = pool.Get(handles[i])->GetConversionStats();
+		SNOVA_CHECK(stats.mtxMisses == (i % 7 == 0 ? 1u : 0u) && stats.mtxHits == 0);
+	}
+#endif
+
+	// Destroyed: every handle to it is stale, a second Destroy is ignored,
+	// a queued write is skipped, and the slot comes back with a new generation
+	const TransformPool::Handle old = handles[10];
+	pool.Get(old)->SetPosY(3.f);
+	pool.Destroy(old);
+	pool.Destroy(old);
+	SNOVA_CHECK(!pool.IsAlive(old) && !pool.Get(old) && pool.SlotAlive()[10] == 0);
+	SNOVA_CHECK(pool.Size() == COUNT - 1);
+	pool.UpdateHotData();
+
+	Transform source;
+	source.SetPosition(random.Vector());
+	source.SetTag("VerifyPooled");
+	handles[10] = pool.Clone(source);
+	SNOVA_CHECK(handles[10].index == 10 && handles[10].generation == old.generation + 1);
+	SNOVA_CHECK(!pool.IsAlive(old) && pool.IsAlive(handles[10]) && pool.Size() == COUNT);
+	SNOVA_CHECK(pool.Get(handles[10])->HasTag("VerifyPooled") && SameVector(pool.Get(handles[10])->GetPosition(), source.GetPosition()));
+	pool.UpdateHotData();
+	SNOVA_CHECK(hotMatches(10));
+
+	// Reset: all stale, memory and slot count kept, slots handed out from the front
+	pool.Reset();
+	SNOVA_CHECK(pool.Size() == 0 && pool.SlotCount() == COUNT);
+	for (const TransformPool::Handle& handle : handles)
+		SNOVA_CHECK(!pool.IsAlive(handle));
+	const TransformPool::Handle first = pool.Create();
+	SNOVA_CHECK(first.index == 0 && first.generation == 1 && pool.SlotCount() == COUNT);
+	pool.UpdateHotData();
+	SNOVA_CHECK(pool.SlotAlive()[0] == 1 && pool.SlotAlive()[1] == 0);
+
+	// Release: memory freed, generations start over
+	pool.Release();
+	SNOVA_CHECK(pool.Size() == 0 && pool.SlotCount() == 0);
+	const TransformPool::Handle fresh = pool.Create();
+	SNOVA_CHECK(fresh.index == 0 && fresh.generation == 0 && pool.Get(fresh));
+	TransformNotifyQueue::Get().Dispatch();
+}
+
+/////////////////////////////////////////////////////
+// Binary format
+
+// SerializeBatch / DeserializeBatch round trip in both rotation modes, the
+// byte order on disk, and blocks that must be rejected without touching
+// any transform
+void CheckBinaryFormat()
+{
+	static constexpr size_t COUNT = 37;
+	static constexpr size_t RECORDS = sizeof(TransformFileHeader);
+	Random random;
+
+	std::vector<std::unique_ptr<Transform>> saved(COUNT), loaded(COUNT);
+	std::vector<const Transform*> savedList;
+	std::vector<Transform*> loadedList;
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		saved[i] = std::make_unique<Transform>();
+		saved[i]->SetPosition(random.Vector());
+		saved[i]->SetScale(random.Between(0.5f, 2.f));
+		if (i % 2)
+			saved[i]->rotator = random.Angles();
+		else
+			saved[i]->SetRotation(QuatValue{ random.Quaternion() });
+		// Repeated tag strings, as a scene has
+		saved[i]->SetTag((i % 3) ? std::string{ "VerifySaved" } : "VerifySaved VerifyEvery" + std::to_string(i % 5));
+		savedList.push_back(saved[i].get());
+
+		loaded[i] = std::make_unique<Transform>();
+		loaded[i]->SetQuatAuthoritative(i % 4 == 0);
+		loaded[i]->SetTag("VerifyOld");
+		loadedList.push_back(loaded[i].get());
+	}
+
+	std::stringstream file{ std::ios::in | std::ios::out | std::ios::binary };
+	SNOVA_CHECK(Transform::SerializeBatch(file, savedList.data(), COUNT));
+	const std::string bytes = file.str();
+	const uint32_t tagTableSize = StoredField(bytes, 16);
+
+	// Little-endian on every host
+	SNOVA_CHECK(bytes.compare(0, 4, "SNTF") == 0 && StoredField(bytes, 4) == TransformFileHeader::VERSION);
+	SNOVA_CHECK(StoredField(bytes, 8) == sizeof(TransformRecord) && StoredField(bytes, 12) == COUNT);
+	SNOVA_CHECK(StoredField(bytes, RECORDS) == BitsOf(saved[0]->GetPosX()));
+	SNOVA_CHECK(StoredField(bytes, RECORDS + 24) == BitsOf(saved[0]->GetRotation().w));
+	SNOVA_CHECK(bytes.size() == RECORDS + COUNT * sizeof(TransformRecord) + tagTableSize);
+
+	SNOVA_CHECK(Transform::PeekBatchCount(file) == COUNT && file.tellg() == 0);
+
+	// Rejected blocks change nothing
+	const auto rejected = [&](const std::string& block, size_t count)
+	{
+		std::istringstream in{ block, std::ios::binary };
+		if (Transform::DeserializeBatch(in, loadedList.data(), count))
+			return false;
+		for (const Transform* t : loadedList)
+		{
+			if (t->GetTag() != "VerifyOld" || t->GetPosition() != Vec3{ 0.f, 0.f, 0.f })
+				return false;
+		}
+		return true;
+	};
+	SNOVA_CHECK(rejected(bytes, COUNT - 1));
+	SNOVA_CHECK(rejected(bytes.substr(0, bytes.size() - 1), COUNT));
+	SNOVA_CHECK(rejected(bytes.substr(0, RECORDS + 5), COUNT));
+	SNOVA_CHECK(rejected(Patched(bytes, 0, 0), COUNT));
+	SNOVA_CHECK(rejected(Patched(bytes, 4, TransformFileHeader::VERSION + 1), COUNT));
+	SNOVA_CHECK(rejected(Patched(bytes, 8, sizeof(TransformRecord) - 4), COUNT));
+	SNOVA_CHECK(rejected(Patched(bytes, 12, COUNT + 1), COUNT));
+	SNOVA_CHECK(rejected(Patched(bytes, 16, UINT32_MAX), COUNT));
+	// The last record's tag runs past the tag table (offset, then length)
+	const size_t lastRecord = RECORDS + (COUNT - 1) * sizeof(TransformRecord);
+	SNOVA_CHECK(rejected(Patched(bytes, lastRecord + 40, UINT32_MAX), COUNT));
+	SNOVA_CHECK(rejected(Patched(bytes, lastRecord + 44, tagTableSize + 1), COUNT));
+
+	SNOVA_CHECK(Transform::DeserializeBatch(file, loadedList.data(), COUNT));
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		const Transform& a = *saved[i];
+		Transform& b = *loaded[i];
+		const QuatValue qa = a.GetRotation(), qb = b.GetRotation();
+		SNOVA_CHECK(b.GetPosition() == a.GetPosition() && b.GetScale() == a.GetScale());
+		SNOVA_CHECK(qb.w == qa.w && qb.x == qa.x && qb.y == qa.y && qb.z == qa.z);
+		SNOVA_CHECK(b.GetTag() == a.GetTag() && b.GetTagSet() == a.GetTagSet());
+
+		// The rotator member is current without GetRotator() unless the quat is authoritative
+		const Rotator expected = b.rotation.GetRotator();
+		if (!b.IsQuatAuthoritative())
+			SNOVA_CHECK(SameRotator(b.rotator, expected));
+		SNOVA_CHECK(SameRotator(b.GetRotator(), expected));
+	}
+	SNOVA_CHECK(Transform::FindAllWithTag("VerifyOld").empty());
+
+	// Editing the loaded rotator through the member keeps the loaded rotation
+	Transform& edited = *loaded[1];
+	const Rotator before = edited.GetRotator();
+	Rotator angles = edited.rotator;
+	angles.yaw += 5.f;
+	edited.rotator = angles;
+	SNOVA_CHECK(SameRotation(edited.rotation, Quat{ Rotator{ before.pitch, before.yaw + 5.f, before.roll } }));
+}
+
+/////////////////////////////////////////////////////
+// Snapshots
+
+// Write, map and read back; Promote() copy-on-write; and files the bounds
+// validation must refuse to map
+void CheckSnapshot()
+{
+	static constexpr size_t COUNT = 37;
+	const std::string path = (std::filesystem::temp_directory_path() / "SNovaVerify.snts").string();
+	const std::string corruptPath = path + ".corrupt";
+	Random random;
+
+	std::vector<std::unique_ptr<Transform>> saved(COUNT);
+	std::vector<const Transform*> savedList;
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		saved[i] = std::make_unique<Transform>();
+		saved[i]->SetPosition(random.Vector());
+		saved[i]->SetScale(random.Between(0.5f, 2.f));
+		saved[i]->SetRotation(QuatValue{ random.Quaternion() });
+		saved[i]->SetTag((i % 2) ? "VerifySnapshot" : std::string{});
+		savedList.push_back(saved[i].get());
+	}
+	SNOVA_CHECK(TransformSnapshot::Write(path, savedList.data(), COUNT));
+
+	TransformSnapshot snapshot;
+	if (!SNOVA_CHECK(snapshot.Open(path) && snapshot.IsOpen() && snapshot.Size() == COUNT))
+		return;
+
+	// Aligned, zero padded arrays with the saved values
+	SNOVA_CHECK(snapshot.Stride() >= COUNT && snapshot.Stride() % 16 == 0);
+	for (int array = 0; array < TransformSnapshot::ARRAY_COUNT; ++array)
+	{
+		const float* values = snapshot.GetArray(static_cast<TransformSnapshot::Array>(array));
+		SNOVA_CHECK(reinterpret_cast<uintptr_t>(values) % TransformSnapshotHeader::FILE_ALIGNMENT == 0);
+		for (size_t i = COUNT; i < snapshot.Stride(); ++i)
+			SNOVA_CHECK(values[i] == 0.f);
+	}
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		const QuatValue q = snapshot.GetRotation(i), expected = saved[i]->GetRotation();
+		SNOVA_CHECK(snapshot.GetPosition(i) == saved[i]->GetPosition() && snapshot.GetScale(i) == saved[i]->GetScale());
+		SNOVA_CHECK(q.w == expected.w && q.x == expected.x && q.y == expected.y && q.z == expected.z);
+		SNOVA_CHECK(snapshot.GetTag(i) == saved[i]->GetTag() && snapshot.GetArray(TransformSnapshot::POS_Y)[i] == saved[i]->GetPosY());
+	}
+
+	// Promote copies once; later changes show through the getters, not the mapped arrays
+	Transform& live = snapshot.Promote(3);
+	SNOVA_CHECK(&snapshot.Promote(3) == &live && snapshot.GetLive(3) == &live && snapshot.PromotedCount() == 1);
+	SNOVA_CHECK(live.GetPosition() == saved[3]->GetPosition() && live.GetTag() == saved[3]->GetTag());
+	live.SetPosition(Vec3{ 1.f, 2.f, 3.f });
+	live.SetTag("VerifyPromoted");
+	SNOVA_CHECK(snapshot.GetPosition(3) == Vec3(1.f, 2.f, 3.f) && snapshot.GetTag(3) == "VerifyPromoted");
+	SNOVA_CHECK(snapshot.GetArray(TransformSnapshot::POS_X)[3] == saved[3]->GetPosX());
+	SNOVA_CHECK(!snapshot.IsPromoted(4) && snapshot.GetPosition(4) == saved[4]->GetPosition());
+
+	snapshot.Close();
+	SNOVA_CHECK(!snapshot.IsOpen() && snapshot.PromotedCount() == 0 && Transform::FindAllWithTag("VerifyPromoted").empty());
+
+	// Files that must not map. A failed Open() leaves nothing open
+	const std::string bytes = ReadFile(path);
+	const auto refused = [&](const std::string& corrupt)
+	{
+		WriteFile(corruptPath, corrupt);
+		return !snapshot.Open(corruptPath) && !snapshot.IsOpen() && snapshot.Size() == 0;
+	};
+	const uint64_t tagsOffset = offsetof(TransformSnapshotHeader, tagsOffset);
+	const uint64_t count = offsetof(TransformSnapshotHeader, count);
+	uint64_t tagEntries;
+	std::memcpy(&tagEntries, &bytes[tagsOffset], sizeof(tagEntries));
+
+	SNOVA_CHECK(!snapshot.Open(path + ".missing"));
+	SNOVA_CHECK(refused(std::string{}));
+	SNOVA_CHECK(refused(bytes.substr(0, sizeof(TransformSnapshotHeader) - 1)));
+	SNOVA_CHECK(refused(bytes.substr(0, bytes.size() - 1)));
+	SNOVA_CHECK(refused(PatchedNative(bytes, 0, uint32_t{ 0 })));
+	SNOVA_CHECK(refused(PatchedNative(bytes, tagsOffset, uint64_t{ 0 } - TransformSnapshotHeader::FILE_ALIGNMENT)));
+	SNOVA_CHECK(refused(PatchedNative(bytes, tagsOffset, uint64_t{ sizeof(TransformSnapshotHeader) })));
+	SNOVA_CHECK(refused(PatchedNative(bytes, tagsOffset, tagEntries + 4)));
+	SNOVA_CHECK(refused(PatchedNative(bytes, count, uint32_t{ 0xFFFFFFFF })));
+	SNOVA_CHECK(refused(PatchedNative(PatchedNative(bytes, count, uint32_t{ 0x10000000 }), count + 4, uint32_t{ 0x10000000 })));
+	SNOVA_CHECK(refused(PatchedNative(bytes, offsetof(TransformSnapshotHeader, tagTextSize), uint64_t{ 0 })));
+	// A tag entry past the tag text
+	SNOVA_CHECK(refused(PatchedNative(bytes, static_cast<size_t>(tagEntries + 4), uint32_t{ 0xFFFFFFFF })));
+
+	// The intact file still maps after all that
+	SNOVA_CHECK(snapshot.Open(path) && snapshot.Size() == COUNT);
+	snapshot.Close();
+	std::remove(corruptPath.c_str());
+	std::remove(path.c_str());
+}
+
+/////////////////////////////////////////////////////
+// Frame buffer
+
+// Jobs write slots in parallel without touching the Transforms; Publish()
+// applies the writes and publishes a Frame that never changes afterwards,
+// even while a reader holds it across later frames or Frames are recycled
+void CheckFrameBuffer()
+{
+	static constexpr size_t COUNT = 600;
+	Random random;
+	TransformFrameBuffer buffer;
+	buffer.grainSize = 64;
+	SNOVA_CHECK(buffer.Acquire() && buffer.Acquire()->Size() == 0 && buffer.Acquire()->number == 0);
+
+	std::vector<std::unique_ptr<Transform>> transforms(COUNT);
+	std::vector<TransformFrameBuffer::SlotID> slots;
+	for (std::unique_ptr<Transform>& t : transforms)
+	{
+		t = std::make_unique<Transform>();
+		t->SetPosition(random.Vector());
+		t->rotation = random.Quaternion();
+		slots.push_back(buffer.Add(t.get()));
+	}
+	buffer.Publish();
+	const std::shared_ptr<const TransformFrameBuffer::Frame> first = buffer.Acquire();
+	if (!SNOVA_CHECK(first && first->number == 1 && first->Size() == COUNT))
+		return;
+	for (size_t i = 0; i < COUNT; ++i)
+		SNOVA_CHECK(buffer.GetTransform(slots[i]) == transforms[i].get() && FrameMatches(*first, slots[i], *transforms[i]));
+	const std::vector<Vec3> firstPositions = first->position;
+	const std::vector<Mtx44> firstMatrices = first->mtx;
+
+	// Jobs: a full write, a position then a rotation, or a scale written twice
+	std::vector<Vec3> positions(COUNT), scales(COUNT);
+	std::vector<QuatValue> rotations(COUNT);
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		positions[i] = random.Vector();
+		scales[i] = Vec3{ 1.f, 1.f, 1.f } * random.Between(0.5f, 2.f);
+		rotations[i] = QuatValue{ random.Quaternion() };
+	}
+	ParallelFor(COUNT, 16, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			if (i % 3 == 0)
+				buffer.Write(slots[i], positions[i], rotations[i], scales[i]);
+			else if (i % 3 == 1)
+			{
+				buffer.WritePosition(slots[i], positions[i]);
+				buffer.WriteRotation(slots[i], rotations[i]);
+			}
+			else
+			{
+				buffer.WriteScale(slots[i], Vec3{ 9.f, 9.f, 9.f });
+				buffer.WriteScale(slots[i], scales[i]);
+			}
+		}
+	});
+	SNOVA_CHECK(!SameVector(transforms[0]->GetPosition(), positions[0]) && buffer.Acquire() == first);
+
+	// A direct edit since the last Publish() is picked up too
+	transforms[2]->SetPosX(-1.f);
+	const Vec3 unchangedScale = transforms[1]->GetScale();
+	buffer.Publish();
+	const std::shared_ptr<const TransformFrameBuffer::Frame> second = buffer.Acquire();
+	SNOVA_CHECK(second != first && second->number == 2);
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		const Transform& t = *transforms[i];
+		if (i % 3 != 2)
+			SNOVA_CHECK(SameVector(t.GetPosition(), positions[i]) && t.GetRotation() == rotations[i]);
+		if (i % 3 != 1)
+			SNOVA_CHECK(SameVector(t.GetScale(), scales[i]));
+		SNOVA_CHECK(FrameMatches(*second, slots[i], t));
+	}
+	SNOVA_CHECK(SameVector(transforms[1]->GetScale(), unchangedScale) && transforms[2]->GetPosX() == -1.f);
+
+	// The first Frame is still as published
+	SNOVA_CHECK(first->number == 1 && first->position.size() == COUNT);
+	SNOVA_CHECK(std::memcmp(first->position.data(), firstPositions.data(), COUNT * sizeof(Vec3)) == 0);
+	SNOVA_CHECK(std::memcmp(first->mtx.data(), firstMatrices.data(), COUNT * sizeof(Mtx44)) == 0);
+
+	// Remove drops the pending write, and the slot is reused
+	const Vec3 kept = transforms[4]->GetPosition();
+	buffer.WritePosition(slots[4], Vec3{ 7.f, 7.f, 7.f });
+	buffer.Remove(slots[4]);
+	SNOVA_CHECK(buffer.Size() == COUNT - 1 && !buffer.GetTransform(slots[4]));
+	buffer.Publish();
+	SNOVA_CHECK(SameVector(transforms[4]->GetPosition(), kept));
+	Transform added;
+	SNOVA_CHECK(buffer.Add(&added) == slots[4] && buffer.Size() == COUNT);
+
+	// A reader on another thread, while unheld Frames are recycled: every
+	// Frame it sees is whole, all slots from the same Publish()
+	for (size_t i = 0; i < COUNT; ++i)
+		buffer.WritePosition(slots[i], Vec3{ -1.f, 0.f, 0.f });
+	buffer.Publish();
+	std::atomic<bool> done{ false };
+	std::atomic<size_t> torn{ 0 };
+	std::thread reader{ [&]()
+	{
+		while (!done)
+		{
+			const std::shared_ptr<const TransformFrameBuffer::Frame> frame = buffer.Acquire();
+			const float x = frame->position[0].x;
+			for (size_t i = 1; i < frame->Size(); i += 7)
+				if (frame->position[i].x != x)
+					++torn;
+		}
+	} };
+	for (int frame = 0; frame < 50; ++frame)
+	{
+		for (size_t i = 0; i < COUNT; ++i)
+			buffer.WritePosition(slots[i], Vec3{ static_cast<float>(frame), 0.f, 0.f });
+		buffer.Publish();
+	}
+	done = true;
+	reader.join();
+	SNOVA_CHECK(torn == 0);
+
+	// Recycled Frames carry over the slots nobody wrote
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		buffer.WriteScale(slots[frame], Vec3{ 3.f, 3.f, 3.f });
+		buffer.Publish();
+	}
+	const std::shared_ptr<const TransformFrameBuffer::Frame> last = buffer.Acquire();
+	SNOVA_CHECK(last->number == 57);
+	for (size_t i = 0; i < COUNT; ++i)
+		SNOVA_CHECK(FrameMatches(*last, slots[i], i == 4 ? added : *transforms[i]));
+	TransformNotifyQueue::Get().Dispatch();
+}
+
+/////////////////////////////////////////////////////
+// Hierarchy
+
+// World matrices match the product up the parent chain after every kind of
+// change, Update() recomputes only the changed subtrees, and a node added
+// since the last Update() reads as its local matrix
+void CheckHierarchy()
+{
+	static constexpr size_t COUNT = 2000;
+	Random random;
+	TransformHierarchy hierarchy;
+	hierarchy.grainSize = 16;
+
+	std::vector<std::unique_ptr<Transform>> transforms(COUNT);
+	std::vector<TransformHierarchy::NodeID> nodes;
+	for (size_t i = 0; i < COUNT; ++i)
+	{
+		transforms[i] = std::make_unique<Transform>();
+		transforms[i]->SetPosition(random.Vector() * 0.1f);
+		transforms[i]->rotation = random.Quaternion();
+		transforms[i]->SetScale(random.Between(0.9f, 1.1f));
+
+		// A few roots, then each node under a random earlier one
+		const TransformHierarchy::NodeID parent = (i < 4) ? TransformHierarchy::INVALID_NODE
+			: nodes[static_cast<size_t>(random.Between(0.f, static_cast<float>(i) - 0.5f))];
+		nodes.push_back(hierarchy.AddNode(transforms[i].get(), parent));
+		SNOVA_CHECK(hierarchy.GetParent(nodes.back()) == parent);
+	}
+	SNOVA_CHECK(hierarchy.Size() == COUNT);
+
+	// Not placed yet: the local matrix, not an unrelated slot
+	SNOVA_CHECK(NearMatrix(hierarchy.GetWorldMatrix(nodes[COUNT - 1]), transforms[COUNT - 1]->GetTransform()));
+
+	const auto worldMatches = [&]()
+	{
+		for (size_t i = 0; i < COUNT; ++i)
+		{
+			if (!transforms[i])
+				continue;
+			Mtx44 expected = transforms[i]->GetTransform();
+			for (TransformHierarchy::NodeID id = hierarchy.GetParent(nodes[i]); id != TransformHierarchy::INVALID_NODE; id = hierarchy.GetParent(id))
+				expected = hierarchy.GetTransform(id)->GetTransform() * expected;
+			if (!NearMatrix(hierarchy.GetWorldMatrix(nodes[i]), expected))
+				return false;
+		}
+		return true;
+	};
+	const auto subtreeSize = [&](TransformHierarchy::NodeID root)
+	{
+		size_t size = 0;
+		for (size_t i = 0; i < COUNT; ++i)
+			for (TransformHierarchy::NodeID id = nodes[i]; transforms[i] && id != TransformHierarchy::INVALID_NODE; id = hierarchy.GetParent(id))
+				if (id == root)
+				{
+					++size;
+					break;
+				}
+		return size;
+	};
+
+	hierarchy.Update();
+	SNOVA_CHECK(hierarchy.LastUpdateCount() == COUNT && worldMatches());
+	hierarchy.Update();
+	SNOVA_CHECK(hierarchy.LastUpdateCount() == 0);
+
+	// Only the changed node and its descendants
+	transforms[COUNT - 1]->SetPosX(1.f);
+	hierarchy.Update();
+	SNOVA_CHECK(hierarchy.LastUpdateCount() == 1 && worldMatches());
+	transforms[5]->rotator = random.Angles();
+	hierarchy.Update();
+	SNOVA_CHECK(hierarchy.LastUpdateCount() == subtreeSize(nodes[5]) && worldMatches());
+
+	// Reparenting: a cycle is refused, a valid move is recomputed
+	size_t descendant = 1;
+	while (descendant < COUNT && hierarchy.GetParent(nodes[descendant]) != nodes[0])
+		++descendant;
+	if (SNOVA_CHECK(descendant < COUNT))
+	{
+		hierarchy.SetParent(nodes[0], nodes[descendant]);
+		SNOVA_CHECK(hierarchy.GetParent(nodes[0]) == TransformHierarchy::INVALID_NODE);
+	}
+	hierarchy.SetParent(nodes[5], nodes[3]);
+	hierarchy.Update();
+	SNOVA_CHECK(worldMatches());
+
+	// Removal frees the subtree; a reused slot reads as its new local matrix
+	const size_t removed = subtreeSize(nodes[6]);
+	hierarchy.RemoveNode(nodes[6]);
+	for (size_t i = 0; i < COUNT; ++i)
+		if (transforms[i] && i != 6 && !hierarchy.GetTransform(nodes[i]))
+			transforms[i].reset();
+	transforms[6].reset();
+	SNOVA_CHECK(hierarchy.Size() == COUNT - removed);
+
+	Transform added;
+	added.SetPosition(Vec3{ 1.f, 2.f, 3.f });
+	const TransformHierarchy::NodeID addedNode = hierarchy.AddNode(&added, nodes[1]);
+	SNOVA_CHECK(NearMatrix(hierarchy.GetWorldMatrix(addedNode), added.GetTransform()));
+	hierarchy.Update();
+	SNOVA_CHECK(worldMatches());
+	SNOVA_CHECK(NearMatrix(hierarchy.GetWorldMatrix(addedNode), hierarchy.GetWorldMatrix(nodes[1]) * added.GetTransform()));
+
+	Mtx44 identity;
+	Mtx44Identity(identity);
+	SNOVA_CHECK(NearMatrix(hierarchy.GetWorldMatrix(TransformHierarchy::INVALID_NODE), identity));
+	TransformNotifyQueue::Get().Dispatch();
+}
+
+/////////////////////////////////////////////////////
+// Parallel loops
+
+// A chunk that throws reaches the caller once no other chunk is running,
+// and the pool still works afterwards. How many chunks started before the
+// throw depends on scheduling, so that is not checked
+void CheckParallelFor()
+{
+	static constexpr size_t COUNT = 4096, GRAIN = 16;
+
+	std::atomic<size_t> running{ 0 }, runningAtThrow{ 0 };
+	bool caught = false;
+	try
+	{
+		ThreadPool::Get().Run(COUNT, GRAIN, [&](size_t begin, size_t)
+		{
+			++running;
+			if (begin == GRAIN * 8)
+			{
+				--running;
+				throw std::runtime_error{ "chunk failed" };
+			}
+			std::this_thread::sleep_for(std::chrono::microseconds{ 50 });
+			--running;
+		});
+	}
+	catch (const std::runtime_error&)
+	{
+		caught = true;
+		runningAtThrow = running.load();
+	}
+	SNOVA_CHECK(caught && runningAtThrow == 0);
+
+	std::atomic<size_t> sum{ 0 };
+	ThreadPool::Get().Run(COUNT, GRAIN, [&](size_t begin, size_t end) { sum += end - begin; });
+	SNOVA_CHECK(sum == COUNT);
+}
+
+} // namespace Verify
+} // namespace SNova
\ No newline at end of file